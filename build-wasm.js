@@ -1,7 +1,18 @@
 import { execSync } from 'child_process';
 import { platform } from 'os';
 
-console.log('🔨 Building WebAssembly module...');
+// --threads builds the pthreads variant (SharedArrayBuffer + worker pool).
+// The *_MT kernels run single-threaded in the default build.
+const threads = process.argv.includes('--threads');
+// --node also targets Node.js, for the headless CLI (pnpm run bench)
+const node = process.argv.includes('--node');
+
+// worker: WasmWorkerHost runs the module in a Web Worker in every build
+const environments = ['web', 'worker', ...(node ? ['node'] : [])];
+// Evaluated in the generated JS at startup; Node before 21 has no navigator
+const PTHREAD_POOL_SIZE = `typeof navigator !== 'undefined' ? navigator.hardwareConcurrency : 4`;
+
+console.log(`🔨 Building WebAssembly module${threads ? ' (pthreads)' : ''}${node ? ' (web + node)' : ''}...`);
 console.log(`Platform: ${platform()}`);
 
 // Check if emcc is available in PATH
@@ -20,19 +31,67 @@ try {
   process.exit(1);
 }
 
+// EXPORTED_FUNCTIONS is generated from the source rather than kept by hand:
+// the preprocessed translation unit is scanned for EMSCRIPTEN_KEEPALIVE
+// (__attribute__((used))) definitions, so macro-generated shims such as the
+// typed kernels are picked up too. Linemarkers limit the scan to src/cpp.
+const SOURCE = 'src/cpp/array_processor.cpp';
+const RUNTIME_EXPORTS = ['_malloc', '_free'];
+
+function collectExportedFunctions(preprocessed) {
+  const names = new Set();
+  let inProject = false;
+  let chunk = [];
+  const flush = () => {
+    const text = chunk.join('\n');
+    for (const match of text.matchAll(/__attribute__\(\(used\)\)\s+[^;{}()]*?\b([A-Za-z_]\w*)\s*\(/g)) {
+      names.add(`_${match[1]}`);
+    }
+    chunk = [];
+  };
+  for (const line of preprocessed.split('\n')) {
+    const marker = /^# \d+ "([^"]+)"/.exec(line);
+    if (marker) {
+      flush();
+      inProject = marker[1].replace(/\\/g, '/').includes('src/cpp/');
+      continue;
+    }
+    if (inProject) {
+      chunk.push(line);
+    }
+  }
+  flush();
+  return [...RUNTIME_EXPORTS, ...[...names].sort()];
+}
+
+let exportedFunctions;
+try {
+  const preprocessed = execSync(`emcc -E -msimd128 ${threads ? '-pthread ' : ''}${SOURCE}`, {
+    maxBuffer: 256 * 1024 * 1024,
+  }).toString();
+  exportedFunctions = collectExportedFunctions(preprocessed);
+  console.log(`Exporting ${exportedFunctions.length - RUNTIME_EXPORTS.length} functions from ${SOURCE}`);
+} catch (error) {
+  console.error('❌ Failed to collect exported functions:', error.message);
+  process.exit(1);
+}
+
 // Emscripten compiler command with SIMD support
 // Output as ES6 module for direct Vite import
-const emccCommand = `emcc src/cpp/array_processor.cpp -o src/wasm/array_processor.js ` +
+const emccCommand = `emcc ${SOURCE} -o src/wasm/array_processor.js ` +
     `-s WASM=1 ` +
     `-s EXPORTED_RUNTIME_METHODS=['ccall','cwrap','getValue','setValue','HEAP8','HEAPU8','HEAP32','HEAPF32','HEAPU32','HEAPF64'] ` +
-    `-s EXPORTED_FUNCTIONS=['_malloc','_free','_sumArray','_findMax','_findMin','_calculateAverage','_multiplyArray','_countGreaterThan','_quickSort','_reverseArray','_calculateVariance','_binarySearch','_addToArray','_countUnique','_sumArraySIMD','_findMaxSIMD','_findMinSIMD','_calculateAverageSIMD','_multiplyArraySIMD','_addToArraySIMD','_countGreaterThanSIMD','_transformVectors','_transformVectorsSIMD','_sumBinaryTreeDfs','_sumBinaryTreeBfs','_sumNaryTreeDfs','_sumNaryTreeBfs','_createStringMapData','_freeStringMapData','_prepareStringMap','_freePreparedStringMap','_insertStringMapEntries','_lookupStringMapEntries','_deleteStringMapEntries','_prepareNumberTreeMap','_freePreparedNumberTreeMap','_insertNumberTreeMapEntries','_lookupNumberTreeMapEntries','_deleteNumberTreeMapEntries','_createTransformMatrix'] ` +
+    `-s EXPORTED_FUNCTIONS=[${exportedFunctions.map(name => `'${name}'`).join(',')}] ` +
+    // uint64_t results (sums) reach JS as exact BigInts, not truncated to 32 bits
+    `-s WASM_BIGINT=1 ` +
     `-s ALLOW_MEMORY_GROWTH=1 ` +
     `-s INITIAL_MEMORY=33554432 ` +
     `-s MAXIMUM_MEMORY=2147483648 ` +
     `-s MODULARIZE=1 ` +
     `-s EXPORT_NAME="createWasmModule" ` +
     `-s EXPORT_ES6=1 ` +
-    `-s ENVIRONMENT=web ` +
+    (threads ? `-pthread -s "PTHREAD_POOL_SIZE=${PTHREAD_POOL_SIZE}" ` : '') +
+    `-s ENVIRONMENT=${environments.join(',')} ` +
     `-msimd128 ` +
     `-O3 ` +
     `--no-entry`;
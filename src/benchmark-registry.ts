@@ -0,0 +1,54 @@
+/**
+ * Benchmark Registry
+ * Exposes the benchmarkTests suite through the framework testRegistry, so
+ * the framework runner and the headless CLI run the same tests as the page
+ */
+
+import { benchmarkTests, type BenchmarkTest } from './benchmark';
+import { testRegistry } from './framework/test-registry';
+import type { BenchmarkTest as FrameworkBenchmarkTest, TestModule } from './framework/types';
+
+let registered = false;
+
+function toFrameworkTest(test: BenchmarkTest): FrameworkBenchmarkTest {
+  return {
+    name: test.name,
+    nameChinese: test.name,
+    category: test.category,
+    prepare: (config) => test.prepare(config.arraySize),
+    tsImpl: test.tsFunc,
+    tsSetup: test.tsSetup,
+    wasmFuncName: test.wasmFuncName ?? test.name,
+    wasmImpl: test.wasmFunc,
+    wasmSetup: test.wasmSetup,
+    cleanup: test.cleanup,
+    sizeIndependent: test.sizeIndependent ?? false,
+  };
+}
+
+/**
+ * Group benchmarkTests into one module per category
+ */
+export function createBenchmarkModules(): TestModule[] {
+  const modules = new Map<string, TestModule>();
+  for (const test of benchmarkTests) {
+    let module = modules.get(test.category);
+    if (!module) {
+      module = { category: test.category, tests: [] };
+      modules.set(test.category, module);
+    }
+    module.tests.push(toFrameworkTest(test));
+  }
+  return Array.from(modules.values());
+}
+
+/**
+ * Register every benchmark test once
+ */
+export function registerBenchmarkTests(): void {
+  if (registered) {
+    return;
+  }
+  testRegistry.registerModules(createBenchmarkModules());
+  registered = true;
+}
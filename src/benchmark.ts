@@ -11,8 +11,33 @@ import {
   type PreparedWasmNumberTreeMapData,
   type PreparedWasmStringMap,
   type PreparedWasmStringMapData,
+  type WasmBinaryTreeLayout,
+  type WasmBitmap,
+  type WasmPipeline,
+  type WasmPreorderTree,
+  type WasmSoAVectors,
+  type BoundaryCallPath,
+  createWasmBitmap,
+  createWasmExternalSort,
+  createWasmPipeline,
+  createWasmSoAVectors,
+  createWasmStream,
   wasmAlgorithms,
+  wasmBoundary,
+  wasmBufferAlgorithms,
+  wasmFilter,
+  wasmTreeLayout,
 } from './wasm-algorithms';
+import { WasmBuffer } from './framework/wasm-buffer';
+import { readScratchStats, resetScratchStats, type ScratchStats } from './framework/wasm-bridge';
+import { profileWasmCalls, type WasmCallBreakdown } from './framework/wasm-profile';
+import {
+  DEFAULT_MEASUREMENT_ORDER,
+  type MeasurementOrder,
+  type MemorySample,
+} from './framework/measurement';
+import { collectSamples, DEFAULT_STATISTICS_OPTIONS, type MeasuredSide } from './framework/benchmark-runner';
+import type { StatisticsOptions } from './framework/types';
 
 export interface BenchmarkResult {
   testName: string;
@@ -32,12 +57,33 @@ export interface BenchmarkResult {
   wasmMedian: number;
   speedup: number;
   winner: 'TypeScript' | 'WASM';
+  // GC / heap counters per sample
+  tsMemory?: MemorySample[];
+  wasmMemory?: MemorySample[];
+  // WASM scratch arena counters over the measured samples (after warmup)
+  wasmScratch?: ScratchStats;
+  // Copy-in / kernel / copy-out split of a WASM call, from profiled calls
+  // run after sampling
+  wasmProfile?: WasmCallBreakdown;
 }
 
 export interface TestConfig {
   arraySize: number;
   iterations: number;
   warmupIterations: number;
+  // Sample ordering between TypeScript and WASM (default 'abba')
+  order?: MeasurementOrder;
+}
+
+// Replaces Math.random in generateRandomArray while set (differential runs)
+let randomArraySource: ((index: number) => number) | null = null;
+
+/**
+ * Fill generateRandomArray (and generateSortedArray) from source, e.g. with
+ * adversarial values; null restores the default 0..999999 values
+ */
+export function setRandomArraySource(source: ((index: number) => number) | null): void {
+  randomArraySource = source;
 }
 
 /**
@@ -45,12 +91,29 @@ export interface TestConfig {
  */
 export function generateRandomArray(size: number): Uint32Array {
   const arr = new Uint32Array(size);
+  if (randomArraySource) {
+    for (let i = 0; i < size; i++) {
+      arr[i] = randomArraySource(i);
+    }
+    return arr;
+  }
   for (let i = 0; i < size; i++) {
     arr[i] = Math.floor(Math.random() * 1000000);
   }
   return arr;
 }
 
+/**
+ * Generate random Uint32Array over the full 32-bit range (mostly distinct values)
+ */
+export function generateWideRandomArray(size: number): Uint32Array {
+  const arr = new Uint32Array(size);
+  for (let i = 0; i < size; i++) {
+    arr[i] = Math.floor(Math.random() * 2 ** 32);
+  }
+  return arr;
+}
+
 /**
  * Generate sorted Uint32Array
  */
@@ -72,7 +135,29 @@ export function generateRandomVectors(count: number): Float32Array {
 
 const TREE_NODE_COUNT = 1_000_000;
 const NARY_TREE_CHILDREN_PER_NODE = 4;
+// Depths counted per level by the tree stats tests (log4 of 1G nodes)
+const NARY_TREE_STATS_LEVELS = 16;
 const STRING_MAP_ENTRY_COUNT = 100_000;
+const SEARCH_QUERY_COUNT = 100_000;
+const BOUNDARY_CALL_COUNT = 100_000;
+// Elements behind the pointer of the pointer+length calls
+const BOUNDARY_ARRAY_LENGTH = 64;
+const SOA_BATCH_OBJECT_SIZE = 1_000;
+// Roughly L1-, L2- and beyond-LLC-resident tables
+const SEARCH_TABLE_SIZES = [1_000, 100_000, 1_000_000];
+// Histogram over the generateRandomArray value range
+const STATS_HISTOGRAM: tsAlgorithms.HistogramOptions = { bins: 64, min: 0, max: 999_999 };
+// multiplyArray -> addToArray -> countGreaterThan as one pipeline; about
+// half the generateRandomArray rows pass
+const PIPELINE_STAGES: tsAlgorithms.PipelineStage[] = [
+  { op: 'multiply', value: 3 },
+  { op: 'add', value: 7 },
+  { op: 'gt', value: 1_500_000 },
+];
+const PIPELINE_COUNT: tsAlgorithms.PipelineSpec = { stages: PIPELINE_STAGES, reduce: 'count' };
+const PIPELINE_SUM: tsAlgorithms.PipelineSpec = { stages: PIPELINE_STAGES, reduce: 'sum' };
+// Chunk (and merge memory) budget of the streaming tests: 256 KB
+const STREAM_CHUNK_LENGTH = 65_536;
 
 interface BinaryTreeBenchmarkData {
   values: Uint32Array;
@@ -84,6 +169,26 @@ interface NaryTreeBenchmarkData {
   wasmTree: PreparedWasmNaryTree;
 }
 
+// Heap-ordered trees keep their values; relaid ones hold the layout
+interface BinaryTreeLayoutBenchmarkData {
+  layout: tsAlgorithms.TreeLayout | null;
+  values: Uint32Array;
+  layoutValues: Uint32Array;
+  targets: Uint32Array;
+  wasmHeap: PreparedWasmBinaryTree;
+  wasmTree: WasmBinaryTreeLayout | null;
+  wasmTargets: WasmBuffer<Uint32Array>;
+}
+
+interface PreorderTreeBenchmarkData {
+  tree: tsAlgorithms.NaryTreeData;
+  preorder: tsAlgorithms.PreorderTreeData;
+  wasmTree: PreparedWasmNaryTree;
+  wasmPreorder: WasmPreorderTree;
+  sums: Float64Array;
+  wasmSums: WasmBuffer<Float64Array>;
+}
+
 interface StringMapBenchmarkData {
   data: tsAlgorithms.StringMapData;
   lookupMap: Map<string, number>;
@@ -102,6 +207,135 @@ interface NumberTreeMapBenchmarkData {
   wasmDeleteMap: PreparedWasmNumberTreeMap;
 }
 
+interface BufferBenchmarkData {
+  arr: Uint32Array;
+  buffer: WasmBuffer<Uint32Array>;
+}
+
+// The pipeline is compiled once and reused by every timed call
+interface PipelineBenchmarkData extends BufferBenchmarkData {
+  pipeline: WasmPipeline;
+}
+
+interface TypedBufferBenchmarkData<T extends tsAlgorithms.NumericArray> {
+  arr: T;
+  buffer: WasmBuffer<T>;
+}
+
+interface FilterBenchmarkData<T extends tsAlgorithms.FilterColumn> {
+  column: T;
+  buffer: WasmBuffer<T>;
+  bitmap: WasmBitmap;
+  scratch: WasmBitmap;
+  // Compaction targets; only the one a test writes is sized for a full selection
+  values: WasmBuffer<T>;
+  indices: WasmBuffer<Uint32Array>;
+}
+
+interface VectorBufferBenchmarkData {
+  vectors: Float32Array;
+  matrix: Float32Array;
+  vectorsBuffer: WasmBuffer<Float32Array>;
+  matrixBuffer: WasmBuffer<Float32Array>;
+}
+
+interface SearchBenchmarkData {
+  table: Uint32Array;
+  layout: Uint32Array;
+  targets: Uint32Array;
+  tableBuffer: WasmBuffer<Uint32Array>;
+  layoutBuffer: WasmBuffer<Uint32Array>;
+  targetsBuffer: WasmBuffer<Uint32Array>;
+  resultsBuffer: WasmBuffer<Int32Array>;
+}
+
+interface SoABenchmarkData {
+  vectors: Float32Array;
+  w: Float32Array;
+  matrix: Float32Array;
+  matrices: Float32Array;
+  offsets: Uint32Array;
+  soa: tsAlgorithms.SoAVectors;
+  vectorsBuffer: WasmBuffer<Float32Array>;
+  matrixBuffer: WasmBuffer<Float32Array>;
+  matricesBuffer: WasmBuffer<Float32Array>;
+  offsetsBuffer: WasmBuffer<Uint32Array>;
+  wasmSoa: WasmSoAVectors;
+}
+
+function prepareBufferBenchmarkData(arr: Uint32Array): BufferBenchmarkData {
+  return { arr, buffer: WasmBuffer.from(arr) };
+}
+
+function preparePipelineBenchmarkData(arr: Uint32Array, pipeline: tsAlgorithms.PipelineSpec): PipelineBenchmarkData {
+  return { arr, buffer: WasmBuffer.from(arr), pipeline: createWasmPipeline(pipeline) };
+}
+
+function disposePipelineBenchmarkData(data: PipelineBenchmarkData): void {
+  data.pipeline.dispose();
+  data.buffer.dispose();
+}
+
+function prepareTypedBufferBenchmarkData<T extends tsAlgorithms.NumericArray>(arr: T): TypedBufferBenchmarkData<T> {
+  return { arr, buffer: WasmBuffer.from(arr) };
+}
+
+function prepareFilterBenchmarkData<T extends tsAlgorithms.FilterColumn>(
+  column: T,
+  output: 'values' | 'indices'
+): FilterBenchmarkData<T> {
+  return {
+    column,
+    buffer: WasmBuffer.from(column),
+    bitmap: createWasmBitmap(column.length),
+    scratch: createWasmBitmap(column.length),
+    values: WasmBuffer.from(column.slice(0, output === 'values' ? column.length : 0) as T),
+    indices: WasmBuffer.uint32(output === 'indices' ? column.length : 0),
+  };
+}
+
+function disposeFilterBenchmarkData(data: FilterBenchmarkData<tsAlgorithms.FilterColumn>): void {
+  data.buffer.dispose();
+  data.bitmap.dispose();
+  data.scratch.dispose();
+  data.values.dispose();
+  data.indices.dispose();
+}
+
+// Predicates of the filter tests (generateRandomArray is uniform in [0, 1e6))
+const FILTER_GREATER_THAN: tsAlgorithms.FilterPredicate = { op: 'gt', value: 500000 };
+const FILTER_LOWER_HALF: tsAlgorithms.FilterPredicate = { op: 'between', low: 0, high: 499999 };
+const FILTER_IN_SET: tsAlgorithms.FilterPredicate = { op: 'in', values: Array.from({ length: 16 }, (_, i) => i * 1000) };
+const FILTER_FLOAT_RANGE: tsAlgorithms.FilterPredicate = { op: 'between', low: 250, high: 750 };
+
+// generateRandomArray values narrowed or scaled into the typed-kernel columns
+function generateInt8Array(size: number): Int8Array {
+  return Int8Array.from(generateRandomArray(size), value => (value % 256) - 128);
+}
+
+function generateInt16Array(size: number): Int16Array {
+  return Int16Array.from(generateRandomArray(size), value => (value % 65536) - 32768);
+}
+
+function generateFloat32Array(size: number): Float32Array {
+  return Float32Array.from(generateRandomArray(size), value => value * 0.001);
+}
+
+function generateFloat64Array(size: number): Float64Array {
+  return Float64Array.from(generateRandomArray(size), value => value * 0.001);
+}
+
+function prepareVectorBufferBenchmarkData(size: number): VectorBufferBenchmarkData {
+  const vectors = generateRandomVectors(size);
+  const matrix = tsAlgorithms.createTransformMatrix(2, 1.5, 1, 45, 10, 20, 5);
+  return {
+    vectors,
+    matrix,
+    vectorsBuffer: WasmBuffer.from(vectors),
+    matrixBuffer: WasmBuffer.from(matrix),
+  };
+}
+
 function generateTreeValues(size: number): Uint32Array {
   const values = new Uint32Array(size);
   for (let i = 0; i < size; i++) {
@@ -177,6 +411,227 @@ function prepareStringMapBenchmarkData(): StringMapBenchmarkData {
   };
 }
 
+function prepareFlatStringMapBenchmarkData(): StringMapBenchmarkData {
+  const data = generateStringMapData(STRING_MAP_ENTRY_COUNT);
+  const wasmData = wasmAlgorithms.prepareFlatStringMapData(data);
+  return {
+    data,
+    lookupMap: tsAlgorithms.createStringMap(data),
+    deleteMap: tsAlgorithms.createStringMap(data),
+    wasmData,
+    wasmLookupMap: wasmAlgorithms.prepareFlatStringMap(wasmData),
+    wasmDeleteMap: wasmAlgorithms.prepareFlatStringMap(wasmData),
+  };
+}
+
+function prepareSearchBenchmarkData(tableSize: number): SearchBenchmarkData {
+  const table = generateSortedArray(tableSize);
+  const layout = tsAlgorithms.eytzingerLayout(table);
+  // Half the queries hit, half are random values
+  const targets = new Uint32Array(SEARCH_QUERY_COUNT);
+  for (let i = 0; i < targets.length; i++) {
+    targets[i] = i % 2 === 0
+      ? table[Math.floor(Math.random() * table.length)]
+      : Math.floor(Math.random() * 1000000);
+  }
+  return {
+    table,
+    layout,
+    targets,
+    tableBuffer: WasmBuffer.from(table),
+    layoutBuffer: WasmBuffer.from(layout),
+    targetsBuffer: WasmBuffer.from(targets),
+    resultsBuffer: WasmBuffer.int32(targets.length),
+  };
+}
+
+function disposeSearchBenchmarkData(data: SearchBenchmarkData): void {
+  data.tableBuffer.dispose();
+  data.layoutBuffer.dispose();
+  data.targetsBuffer.dispose();
+  data.resultsBuffer.dispose();
+}
+
+function countHits(results: Int32Array): number {
+  let hits = 0;
+  for (let i = 0; i < results.length; i++) {
+    if (results[i] >= 0) hits++;
+  }
+  return hits;
+}
+
+/**
+ * One-at-a-time vs batched vs Eytzinger lookups against a fixed-size table
+ */
+function createSearchBenchmarkTests(tableSize: number): BenchmarkTest<SearchBenchmarkData>[] {
+  const label = `${tableSize.toLocaleString()} keys`;
+  return [
+    {
+      name: `Binary Search x${SEARCH_QUERY_COUNT.toLocaleString()} (single calls, ${label})`,
+      category: 'Batched Search',
+      tsFuncName: 'binarySearch',
+      wasmFuncName: 'wasmBufferAlgorithms.binarySearch',
+      prepare: () => prepareSearchBenchmarkData(tableSize),
+      sizeIndependent: true,
+      tsFunc: (data) => {
+        let hits = 0;
+        for (let i = 0; i < data.targets.length; i++) {
+          if (tsAlgorithms.binarySearch(data.table, data.targets[i]) >= 0) hits++;
+        }
+        return hits;
+      },
+      wasmFunc: (data) => {
+        let hits = 0;
+        for (let i = 0; i < data.targets.length; i++) {
+          if (wasmBufferAlgorithms.binarySearch(data.tableBuffer, data.targets[i]) >= 0) hits++;
+        }
+        return hits;
+      },
+      cleanup: disposeSearchBenchmarkData,
+    },
+    {
+      name: `Binary Search Batch (${label})`,
+      category: 'Batched Search',
+      tsFuncName: 'binarySearchBatch',
+      wasmFuncName: 'wasmBufferAlgorithms.binarySearchBatch',
+      prepare: () => prepareSearchBenchmarkData(tableSize),
+      sizeIndependent: true,
+      tsFunc: (data) => countHits(tsAlgorithms.binarySearchBatch(data.table, data.targets)),
+      wasmFunc: (data) => countHits(
+        wasmBufferAlgorithms.binarySearchBatch(data.tableBuffer, data.targetsBuffer, data.resultsBuffer)
+      ),
+      cleanup: disposeSearchBenchmarkData,
+    },
+    {
+      name: `Binary Search Batch Eytzinger (${label})`,
+      category: 'Batched Search',
+      tsFuncName: 'eytzingerSearchBatch',
+      wasmFuncName: 'wasmBufferAlgorithms.eytzingerSearchBatch',
+      prepare: () => prepareSearchBenchmarkData(tableSize),
+      sizeIndependent: true,
+      tsFunc: (data) => countHits(tsAlgorithms.eytzingerSearchBatch(data.layout, data.targets)),
+      wasmFunc: (data) => countHits(
+        wasmBufferAlgorithms.eytzingerSearchBatch(data.layoutBuffer, data.targetsBuffer, data.resultsBuffer)
+      ),
+      cleanup: disposeSearchBenchmarkData,
+    },
+  ];
+}
+
+const BOUNDARY_PATH_LABELS: Record<BoundaryCallPath, string> = { direct: 'Direct Export', ccall: 'ccall' };
+
+/**
+ * Fixed per-call cost: BOUNDARY_CALL_COUNT calls of a near-empty export per
+ * run, against the same loop over a plain JS function
+ */
+function createBoundaryBenchmarkTests(path: BoundaryCallPath): BenchmarkTest<BufferBenchmarkData>[] {
+  const label = BOUNDARY_PATH_LABELS[path];
+  const calls = `x${BOUNDARY_CALL_COUNT.toLocaleString()}`;
+  const prepare = () => prepareBufferBenchmarkData(generateRandomArray(BOUNDARY_ARRAY_LENGTH));
+  const cleanup = (data: BufferBenchmarkData) => data.buffer.dispose();
+  return [
+    {
+      name: `Empty Call ${calls} (${label})`,
+      category: 'Call Boundary',
+      tsFuncName: 'boundaryEmpty',
+      wasmFuncName: `wasmBoundary.emptyCalls (${path})`,
+      prepare,
+      sizeIndependent: true,
+      tsFunc: () => {
+        for (let i = 0; i < BOUNDARY_CALL_COUNT; i++) {
+          tsAlgorithms.boundaryEmpty();
+        }
+        return BOUNDARY_CALL_COUNT;
+      },
+      wasmFunc: () => wasmBoundary.emptyCalls(BOUNDARY_CALL_COUNT, path),
+      cleanup,
+    },
+    {
+      name: `Pointer+Length Call ${calls} (${label})`,
+      category: 'Call Boundary',
+      tsFuncName: 'boundaryPointerLength',
+      wasmFuncName: `wasmBoundary.pointerLengthCalls (${path})`,
+      prepare,
+      sizeIndependent: true,
+      tsFunc: (data) => {
+        let sum = 0;
+        for (let i = 0; i < BOUNDARY_CALL_COUNT; i++) {
+          sum += tsAlgorithms.boundaryPointerLength(data.arr, data.arr.length);
+        }
+        return sum;
+      },
+      wasmFunc: (data) => wasmBoundary.pointerLengthCalls(data.buffer, BOUNDARY_CALL_COUNT, path),
+      cleanup,
+    },
+    {
+      name: `64-bit Return ${calls} (${label})`,
+      category: 'Call Boundary',
+      tsFuncName: 'boundaryReturnU64',
+      wasmFuncName: `wasmBoundary.returnU64Calls (${path})`,
+      prepare,
+      sizeIndependent: true,
+      tsFunc: () => {
+        let folded = 0n;
+        for (let i = 0; i < BOUNDARY_CALL_COUNT; i++) {
+          folded ^= tsAlgorithms.boundaryReturnU64(i);
+        }
+        return folded;
+      },
+      wasmFunc: () => wasmBoundary.returnU64Calls(BOUNDARY_CALL_COUNT, path),
+      cleanup,
+    },
+  ];
+}
+
+/**
+ * Points plus one matrix per SOA_BATCH_OBJECT_SIZE points for the batch test
+ */
+function prepareSoABenchmarkData(size: number): SoABenchmarkData {
+  const vectors = generateRandomVectors(size);
+  const w = new Float32Array(size).fill(1);
+  const matrix = tsAlgorithms.createTransformMatrix(2, 1.5, 1, 45, 10, 20, 5);
+  const objectCount = Math.ceil(size / SOA_BATCH_OBJECT_SIZE);
+  const matrices = new Float32Array(objectCount * 16);
+  const offsets = new Uint32Array(objectCount + 1);
+  for (let k = 0; k < objectCount; k++) {
+    matrices.set(tsAlgorithms.createTransformMatrix(1 + (k % 3), 1.5, 1, k % 360, 10, 20, 5), k * 16);
+    offsets[k] = k * SOA_BATCH_OBJECT_SIZE;
+  }
+  offsets[objectCount] = size;
+
+  return {
+    vectors,
+    w,
+    matrix,
+    matrices,
+    offsets,
+    soa: tsAlgorithms.aosToSoa(vectors),
+    vectorsBuffer: WasmBuffer.from(vectors),
+    matrixBuffer: WasmBuffer.from(matrix),
+    matricesBuffer: WasmBuffer.from(matrices),
+    offsetsBuffer: WasmBuffer.from(offsets),
+    wasmSoa: createWasmSoAVectors(size, true),
+  };
+}
+
+function resetTsSoA(data: SoABenchmarkData): void {
+  data.soa = tsAlgorithms.aosToSoa(data.vectors);
+  data.soa.w = new Float32Array(data.w);
+}
+
+function resetWasmSoA(data: SoABenchmarkData): void {
+  wasmBufferAlgorithms.aosToSoa(data.vectorsBuffer, data.wasmSoa);
+  data.wasmSoa.w?.set(data.w);
+}
+
+function disposeSoABenchmarkData(data: SoABenchmarkData): void {
+  data.vectorsBuffer.dispose();
+  data.matrixBuffer.dispose();
+  data.matricesBuffer.dispose();
+  data.offsetsBuffer.dispose();
+  data.wasmSoa.dispose();
+}
+
 function prepareNumberTreeMapBenchmarkData(): NumberTreeMapBenchmarkData {
   const data = generateNumberMapData(STRING_MAP_ENTRY_COUNT);
   const wasmData = wasmAlgorithms.prepareNumberTreeMapData(data);
@@ -198,14 +653,111 @@ function prepareBinaryTreeBenchmarkData(): BinaryTreeBenchmarkData {
   };
 }
 
-function prepareNaryTreeBenchmarkData(): NaryTreeBenchmarkData {
-  const tree = generateNaryTree(TREE_NODE_COUNT);
+function prepareNaryTreeBenchmarkData(size: number = TREE_NODE_COUNT): NaryTreeBenchmarkData {
+  const tree = generateNaryTree(size);
   return {
     tree,
     wasmTree: wasmAlgorithms.prepareNaryTree(tree),
   };
 }
 
+/**
+ * Tree of `size` nodes in heap order, relaid when layout is set, plus
+ * leaf targets for root-to-leaf descents
+ */
+function prepareBinaryTreeLayoutBenchmarkData(
+  size: number,
+  layout: tsAlgorithms.TreeLayout | null
+): BinaryTreeLayoutBenchmarkData {
+  const values = generateTreeValues(size);
+  const leafCount = size - Math.floor(size / 2);
+  const targets = new Uint32Array(SEARCH_QUERY_COUNT);
+  for (let i = 0; i < targets.length; i++) {
+    targets[i] = Math.floor(size / 2) + Math.floor(Math.random() * Math.max(leafCount, 1));
+  }
+
+  const wasmHeap = wasmAlgorithms.prepareBinaryTree(values);
+  const heapBuffer = WasmBuffer.from(values);
+  try {
+    return {
+      layout,
+      values,
+      layoutValues: layout ? tsAlgorithms.relayoutBinaryTree(values, layout) : values,
+      targets,
+      wasmHeap,
+      wasmTree: layout ? wasmTreeLayout.relayoutBinary(heapBuffer, layout) : null,
+      wasmTargets: WasmBuffer.from(targets),
+    };
+  } finally {
+    heapBuffer.dispose();
+  }
+}
+
+function disposeBinaryTreeLayoutBenchmarkData(data: BinaryTreeLayoutBenchmarkData): void {
+  data.wasmHeap.dispose();
+  data.wasmTree?.dispose();
+  data.wasmTargets.dispose();
+}
+
+function preparePreorderTreeBenchmarkData(size: number): PreorderTreeBenchmarkData {
+  const tree = generateNaryTree(size);
+  const wasmTree = wasmAlgorithms.prepareNaryTree(tree);
+  return {
+    tree,
+    preorder: tsAlgorithms.relayoutNaryTreePreorder(tree),
+    wasmTree,
+    wasmPreorder: wasmTreeLayout.relayoutPreorder(wasmTree),
+    sums: new Float64Array(size),
+    wasmSums: WasmBuffer.float64(Math.max(size, 1)),
+  };
+}
+
+function disposePreorderTreeBenchmarkData(data: PreorderTreeBenchmarkData): void {
+  data.wasmTree.dispose();
+  data.wasmPreorder.dispose();
+  data.wasmSums.dispose();
+}
+
+const TREE_LAYOUT_LABELS = { heap: 'Heap Layout', veb: 'vEB Layout', blocked: 'Blocked Layout' };
+
+/**
+ * DFS and root-to-leaf descents over one binary tree layout; the tree
+ * follows the array size setting so it can exceed the caches
+ */
+function createBinaryTreeLayoutBenchmarkTests(
+  layout: tsAlgorithms.TreeLayout | null
+): BenchmarkTest<BinaryTreeLayoutBenchmarkData>[] {
+  const label = TREE_LAYOUT_LABELS[layout ?? 'heap'];
+  return [
+    {
+      name: `Binary Tree DFS (${label})`,
+      category: 'Tree Layout',
+      tsFuncName: layout ? 'sumBinaryTreeLayoutDfs' : 'sumBinaryTreeDfs',
+      wasmFuncName: layout ? 'wasmTreeLayout.sumDfs' : 'sumBinaryTreeDfs',
+      prepare: (size) => prepareBinaryTreeLayoutBenchmarkData(size, layout),
+      tsFunc: (data) => data.layout
+        ? tsAlgorithms.sumBinaryTreeLayoutDfs(data.layoutValues, data.values.length, data.layout)
+        : tsAlgorithms.sumBinaryTreeDfs(data.values),
+      wasmFunc: (data) => data.wasmTree
+        ? wasmTreeLayout.sumDfs(data.wasmTree)
+        : wasmAlgorithms.sumBinaryTreeDfs(data.wasmHeap),
+      cleanup: disposeBinaryTreeLayoutBenchmarkData,
+    },
+    {
+      name: `Binary Tree Paths (${label})`,
+      category: 'Tree Layout',
+      tsFuncName: layout ? 'sumBinaryTreeLayoutPaths' : 'sumBinaryTreePaths',
+      wasmFuncName: 'wasmTreeLayout.sumPaths',
+      prepare: (size) => prepareBinaryTreeLayoutBenchmarkData(size, layout),
+      tsFunc: (data) => data.layout
+        ? tsAlgorithms.sumBinaryTreeLayoutPaths(data.layoutValues, data.values.length, data.layout, data.targets)
+        : tsAlgorithms.sumBinaryTreePaths(data.values, data.targets),
+      wasmFunc: (data) => wasmTreeLayout.sumPaths(data.wasmTree ?? data.wasmHeap, data.wasmTargets),
+      cleanup: disposeBinaryTreeLayoutBenchmarkData,
+    },
+  ];
+}
+
 /**
  * Calculate median from array of numbers
  */
@@ -230,6 +782,23 @@ export function formatTime(ms: number): string {
   }
 }
 
+// Untimed WASM calls profiled after sampling for the copy / kernel split
+const WASM_PROFILE_CALLS = 5;
+
+/**
+ * Sampling options for exactly `iterations` single-call samples per side:
+ * no repetition batching, no early stop on a tight CI, no time budget
+ */
+function fixedSampleOptions(iterations: number): StatisticsOptions {
+  return {
+    ...DEFAULT_STATISTICS_OPTIONS,
+    minSampleTimeMs: 0,
+    maxSamples: iterations,
+    maxTimeMs: Infinity,
+    targetRelativeCI: -Infinity,
+  };
+}
+
 /**
  * Run a single benchmark test
  */
@@ -243,9 +812,6 @@ export async function runBenchmark(
   tsSetup?: () => void,
   wasmSetup?: () => void
 ): Promise<BenchmarkResult> {
-  const tsTimes: number[] = [];
-  const wasmTimes: number[] = [];
-
   // Warmup phase - JIT compilation
   console.log(`🔥 Warming up ${testName}...`);
   try {
@@ -260,35 +826,29 @@ export async function runBenchmark(
     throw new Error(`${testName} warmup failed: ${(error as Error).message}`);
   }
 
-  // TypeScript benchmark
-  console.log(`📊 Testing TypeScript ${testName}...`);
-  try {
-    for (let i = 0; i < config.iterations; i++) {
-      tsSetup?.();
-      const start = performance.now();
-      tsFunc();
-      const end = performance.now();
-      tsTimes.push(end - start);
+  // Failures name the side that threw
+  const guarded = (label: string, fn: () => unknown) => () => {
+    try {
+      return fn();
+    } catch (error) {
+      console.error(`❌ ${label} test failed for ${testName}:`, error);
+      throw new Error(`${testName} ${label} test failed: ${(error as Error).message}`);
     }
-  } catch (error) {
-    console.error(`❌ TypeScript test failed for ${testName}:`, error);
-    throw new Error(`${testName} TypeScript test failed: ${(error as Error).message}`);
-  }
+  };
+  const ts: MeasuredSide = { run: guarded('TypeScript', tsFunc), setup: tsSetup && guarded('TypeScript', tsSetup) };
+  const wasm: MeasuredSide = { run: guarded('WASM', wasmFunc), setup: wasmSetup && guarded('WASM', wasmSetup) };
 
-  // WASM benchmark
-  console.log(`📊 Testing WASM ${testName}...`);
-  try {
-    for (let i = 0; i < config.iterations; i++) {
-      wasmSetup?.();
-      const start = performance.now();
-      wasmFunc();
-      const end = performance.now();
-      wasmTimes.push(end - start);
-    }
-  } catch (error) {
-    console.error(`❌ WASM test failed for ${testName}:`, error);
-    throw new Error(`${testName} WASM test failed: ${(error as Error).message}`);
-  }
+  const order = config.order ?? DEFAULT_MEASUREMENT_ORDER;
+  console.log(`📊 Testing ${testName} (${order})...`);
+  resetScratchStats();
+  const options = fixedSampleOptions(config.iterations);
+  const [tsSet, wasmSet] = await collectSamples([ts, wasm], config.iterations, options, order);
+  const wasmScratch = readScratchStats();
+  const wasmProfile = profileWasmCalls(wasm.run, wasm.setup, WASM_PROFILE_CALLS);
+  const tsTimes = tsSet.samples;
+  const wasmTimes = wasmSet.samples;
+  const tsMemory = tsSet.memory;
+  const wasmMemory = wasmSet.memory;
 
   // Calculate statistics
   const tsAvg = tsTimes.reduce((a, b) => a + b, 0) / tsTimes.length;
@@ -320,6 +880,10 @@ export async function runBenchmark(
     wasmMedian,
     speedup,
     winner,
+    tsMemory,
+    wasmMemory,
+    wasmScratch,
+    wasmProfile,
   };
 }
 
@@ -328,9 +892,12 @@ export async function runBenchmark(
  */
 export interface BenchmarkTest<TData = any> {
   name: string;
+  category: string;
   tsFuncName?: string;
   wasmFuncName?: string;
   prepare: (size: number) => TData;
+  // Fixed-size data (trees, maps, search tables): prepare ignores the size and a size sweep runs the test once
+  sizeIndependent?: boolean;
   tsSetup?: (data: TData) => void;
   wasmSetup?: (data: TData) => void;
   tsFunc: (data: TData) => any;
@@ -341,60 +908,79 @@ export interface BenchmarkTest<TData = any> {
 export const benchmarkTests: BenchmarkTest[] = [
   {
     name: 'Sum Array',
+    category: 'Array Operations',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.sumArray(arr),
     wasmFunc: (arr) => wasmAlgorithms.sumArray(arr),
   },
   {
     name: 'Find Max',
+    category: 'Array Operations',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.findMax(arr),
     wasmFunc: (arr) => wasmAlgorithms.findMax(arr),
   },
   {
     name: 'Find Min',
+    category: 'Array Operations',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.findMin(arr),
     wasmFunc: (arr) => wasmAlgorithms.findMin(arr),
   },
   {
     name: 'Calculate Average',
+    category: 'Array Operations',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.calculateAverage(arr),
     wasmFunc: (arr) => wasmAlgorithms.calculateAverage(arr),
   },
   {
     name: 'Multiply Array',
+    category: 'Array Operations',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.multiplyArray(arr, 2),
     wasmFunc: (arr) => wasmAlgorithms.multiplyArray(arr, 2),
   },
   {
     name: 'Count Greater Than',
+    category: 'Array Operations',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.countGreaterThan(arr, 500000),
     wasmFunc: (arr) => wasmAlgorithms.countGreaterThan(arr, 500000),
   },
   {
     name: 'Quick Sort',
+    category: 'Array Operations',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.quickSort(arr),
     wasmFunc: (arr) => wasmAlgorithms.quickSort(arr),
   },
+  {
+    name: 'Radix Sort',
+    category: 'Array Operations',
+    tsFuncName: 'quickSort',
+    wasmFuncName: 'radixSortU32',
+    prepare: (size) => generateRandomArray(size),
+    tsFunc: (arr) => tsAlgorithms.quickSort(arr),
+    wasmFunc: (arr) => wasmAlgorithms.radixSortU32(arr),
+  },
   {
     name: 'Reverse Array',
+    category: 'Array Operations',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.reverseArray(arr),
     wasmFunc: (arr) => wasmAlgorithms.reverseArray(arr),
   },
   {
     name: 'Calculate Variance',
+    category: 'Array Operations',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.calculateVariance(arr),
     wasmFunc: (arr) => wasmAlgorithms.calculateVariance(arr),
   },
   {
     name: 'Binary Search',
+    category: 'Array Operations',
     prepare: (size) => {
       const arr = generateSortedArray(size);
       return { arr, target: arr[Math.floor(arr.length / 2)] };
@@ -403,58 +989,233 @@ export const benchmarkTests: BenchmarkTest[] = [
     wasmFunc: (data) => wasmAlgorithms.binarySearch(data.arr, data.target),
   },
 
+  // ========== BATCHED SEARCH TESTS ==========
+  // Fixed table sizes; the array size setting does not apply
+
+  ...SEARCH_TABLE_SIZES.flatMap(createSearchBenchmarkTests),
+
+  // ========== CALL BOUNDARY TESTS ==========
+  // Fixed cost of crossing into WASM, raw export vs ccall; sizes do not apply
+
+  ...createBoundaryBenchmarkTests('direct'),
+  ...createBoundaryBenchmarkTests('ccall'),
+
   // ========== SIMD OPTIMIZED TESTS ==========
 
   {
     name: 'Sum Array (SIMD)',
+    category: 'SIMD',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.sumArray(arr),
     wasmFunc: (arr) => wasmAlgorithms.sumArraySIMD(arr),
   },
   {
     name: 'Find Max (SIMD)',
+    category: 'SIMD',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.findMax(arr),
     wasmFunc: (arr) => wasmAlgorithms.findMaxSIMD(arr),
   },
   {
     name: 'Find Min (SIMD)',
+    category: 'SIMD',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.findMin(arr),
     wasmFunc: (arr) => wasmAlgorithms.findMinSIMD(arr),
   },
   {
     name: 'Calculate Average (SIMD)',
+    category: 'SIMD',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.calculateAverage(arr),
     wasmFunc: (arr) => wasmAlgorithms.calculateAverageSIMD(arr),
   },
   {
     name: 'Multiply Array (SIMD)',
+    category: 'SIMD',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.multiplyArray(arr, 2),
     wasmFunc: (arr) => wasmAlgorithms.multiplyArraySIMD(arr, 2),
   },
   {
     name: 'Add To Array (SIMD)',
+    category: 'SIMD',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.addToArray(arr, 100),
     wasmFunc: (arr) => wasmAlgorithms.addToArraySIMD(arr, 100),
   },
   {
     name: 'Count Greater Than (SIMD)',
+    category: 'SIMD',
     prepare: (size) => generateRandomArray(size),
     tsFunc: (arr) => tsAlgorithms.countGreaterThan(arr, 500000),
     wasmFunc: (arr) => wasmAlgorithms.countGreaterThanSIMD(arr, 500000),
   },
 
+  // ========== MULTITHREADED TESTS ==========
+  // Use every pool thread; call the *_MT wrappers with an explicit count for scaling curves
+
+  {
+    name: 'Sum Array (MT)',
+    category: 'Multithreaded',
+    tsFuncName: 'sumArray',
+    wasmFuncName: 'sumArray_MT',
+    prepare: (size) => generateRandomArray(size),
+    tsFunc: (arr) => tsAlgorithms.sumArray(arr),
+    wasmFunc: (arr) => wasmAlgorithms.sumArray_MT(arr),
+  },
+  {
+    name: 'Find Max (MT)',
+    category: 'Multithreaded',
+    tsFuncName: 'findMax',
+    wasmFuncName: 'findMax_MT',
+    prepare: (size) => generateRandomArray(size),
+    tsFunc: (arr) => tsAlgorithms.findMax(arr),
+    wasmFunc: (arr) => wasmAlgorithms.findMax_MT(arr),
+  },
+  {
+    name: 'Count Greater Than (MT)',
+    category: 'Multithreaded',
+    tsFuncName: 'countGreaterThan',
+    wasmFuncName: 'countGreaterThan_MT',
+    prepare: (size) => generateRandomArray(size),
+    tsFunc: (arr) => tsAlgorithms.countGreaterThan(arr, 500000),
+    wasmFunc: (arr) => wasmAlgorithms.countGreaterThan_MT(arr, 500000),
+  },
+  {
+    name: 'Merge Sort (MT)',
+    category: 'Multithreaded',
+    tsFuncName: 'quickSort',
+    wasmFuncName: 'mergeSort_MT',
+    prepare: (size) => generateRandomArray(size),
+    tsFunc: (arr) => tsAlgorithms.quickSort(arr),
+    wasmFunc: (arr) => wasmAlgorithms.mergeSort_MT(arr),
+  },
+  {
+    name: 'Compute Stats (MT)',
+    category: 'Multithreaded',
+    tsFuncName: 'computeStats',
+    wasmFuncName: 'computeStats_MT',
+    prepare: (size) => generateRandomArray(size),
+    tsFunc: (arr) => tsAlgorithms.computeStats(arr, STATS_HISTOGRAM),
+    wasmFunc: (arr) => wasmAlgorithms.computeStats_MT(arr, STATS_HISTOGRAM),
+  },
+  {
+    name: 'N-ary Tree BFS (MT)',
+    category: 'Multithreaded',
+    tsFuncName: 'sumNaryTreeBfs',
+    wasmFuncName: 'sumNaryTreeBfs_MT',
+    prepare: (size) => prepareNaryTreeBenchmarkData(size),
+    tsFunc: (data: NaryTreeBenchmarkData) => tsAlgorithms.sumNaryTreeBfs(data.tree),
+    wasmFunc: (data: NaryTreeBenchmarkData) => wasmAlgorithms.sumNaryTreeBfs_MT(data.wasmTree),
+    cleanup: (data: NaryTreeBenchmarkData) => data.wasmTree.dispose(),
+  },
+  {
+    name: 'N-ary Tree DFS (MT)',
+    category: 'Multithreaded',
+    tsFuncName: 'sumNaryTreeDfs',
+    wasmFuncName: 'sumNaryTreeDfs_MT',
+    prepare: (size) => prepareNaryTreeBenchmarkData(size),
+    tsFunc: (data: NaryTreeBenchmarkData) => tsAlgorithms.sumNaryTreeDfs(data.tree),
+    wasmFunc: (data: NaryTreeBenchmarkData) => wasmAlgorithms.sumNaryTreeDfs_MT(data.wasmTree),
+    cleanup: (data: NaryTreeBenchmarkData) => data.wasmTree.dispose(),
+  },
+  {
+    name: 'N-ary Tree Stats BFS (MT)',
+    category: 'Multithreaded',
+    tsFuncName: 'computeNaryTreeStats',
+    wasmFuncName: 'computeNaryTreeStatsBfs_MT',
+    prepare: (size) => prepareNaryTreeBenchmarkData(size),
+    tsFunc: (data: NaryTreeBenchmarkData) => tsAlgorithms.computeNaryTreeStats(data.tree, NARY_TREE_STATS_LEVELS),
+    wasmFunc: (data: NaryTreeBenchmarkData) =>
+      wasmAlgorithms.computeNaryTreeStatsBfs_MT(data.wasmTree, NARY_TREE_STATS_LEVELS),
+    cleanup: (data: NaryTreeBenchmarkData) => data.wasmTree.dispose(),
+  },
+  {
+    name: 'N-ary Tree Stats DFS (MT)',
+    category: 'Multithreaded',
+    tsFuncName: 'computeNaryTreeStats',
+    wasmFuncName: 'computeNaryTreeStatsDfs_MT',
+    prepare: (size) => prepareNaryTreeBenchmarkData(size),
+    tsFunc: (data: NaryTreeBenchmarkData) => tsAlgorithms.computeNaryTreeStats(data.tree, NARY_TREE_STATS_LEVELS),
+    wasmFunc: (data: NaryTreeBenchmarkData) =>
+      wasmAlgorithms.computeNaryTreeStatsDfs_MT(data.wasmTree, NARY_TREE_STATS_LEVELS),
+    cleanup: (data: NaryTreeBenchmarkData) => data.wasmTree.dispose(),
+  },
+
+  // ========== ZERO-COPY BUFFER TESTS ==========
+  // Input lives in a persistent WasmBuffer; in-place kernels reset it untimed
+
+  {
+    name: 'Sum Array (Zero-Copy)',
+    category: 'Zero-Copy',
+    tsFuncName: 'sumArray',
+    wasmFuncName: 'wasmBufferAlgorithms.sumArray',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.sumArray(data.arr),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.sumArray(data.buffer),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Count Greater Than (Zero-Copy SIMD)',
+    category: 'Zero-Copy',
+    tsFuncName: 'countGreaterThan',
+    wasmFuncName: 'wasmBufferAlgorithms.countGreaterThanSIMD',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.countGreaterThan(data.arr, 500000),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.countGreaterThanSIMD(data.buffer, 500000),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Multiply Array (Zero-Copy SIMD)',
+    category: 'Zero-Copy',
+    tsFuncName: 'multiplyArray',
+    wasmFuncName: 'wasmBufferAlgorithms.multiplyArraySIMD',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    wasmSetup: (data: BufferBenchmarkData) => data.buffer.set(data.arr),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.multiplyArray(data.arr, 2),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.multiplyArraySIMD(data.buffer, 2),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Quick Sort (Zero-Copy)',
+    category: 'Zero-Copy',
+    tsFuncName: 'quickSort',
+    wasmFuncName: 'wasmBufferAlgorithms.quickSort',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    wasmSetup: (data: BufferBenchmarkData) => data.buffer.set(data.arr),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.quickSort(data.arr),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.quickSort(data.buffer),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Matrix Transform (Zero-Copy SIMD)',
+    category: 'Zero-Copy',
+    tsFuncName: 'transformVectors',
+    wasmFuncName: 'wasmBufferAlgorithms.transformVectorsSIMD',
+    prepare: (size) => prepareVectorBufferBenchmarkData(size),
+    wasmSetup: (data: VectorBufferBenchmarkData) => data.vectorsBuffer.set(data.vectors),
+    tsFunc: (data: VectorBufferBenchmarkData) => {
+      const vectorsCopy = new Float32Array(data.vectors);
+      return tsAlgorithms.transformVectors(vectorsCopy, data.matrix);
+    },
+    wasmFunc: (data: VectorBufferBenchmarkData) =>
+      wasmBufferAlgorithms.transformVectorsSIMD(data.vectorsBuffer, data.matrixBuffer),
+    cleanup: (data: VectorBufferBenchmarkData) => {
+      data.vectorsBuffer.dispose();
+      data.matrixBuffer.dispose();
+    },
+  },
+
   // ========== STRING MAP TESTS ==========
 
   {
     name: 'String unordered_map Insert',
+    category: 'Maps',
     tsFuncName: 'insertStringMapEntries',
     wasmFuncName: 'insertStringMapEntries',
     prepare: () => prepareStringMapBenchmarkData(),
+    sizeIndependent: true,
     tsFunc: (data: StringMapBenchmarkData) => tsAlgorithms.insertStringMapEntries(data.data),
     wasmFunc: (data: StringMapBenchmarkData) => wasmAlgorithms.insertStringMapEntries(data.wasmData),
     cleanup: (data: StringMapBenchmarkData) => {
@@ -465,9 +1226,11 @@ export const benchmarkTests: BenchmarkTest[] = [
   },
   {
     name: 'String unordered_map Lookup',
+    category: 'Maps',
     tsFuncName: 'lookupStringMapEntries',
     wasmFuncName: 'lookupStringMapEntries',
     prepare: () => prepareStringMapBenchmarkData(),
+    sizeIndependent: true,
     tsSetup: (data: StringMapBenchmarkData) => {
       data.lookupMap = tsAlgorithms.createStringMap(data.data);
     },
@@ -484,9 +1247,11 @@ export const benchmarkTests: BenchmarkTest[] = [
   },
   {
     name: 'String unordered_map Delete',
+    category: 'Maps',
     tsFuncName: 'deleteStringMapEntries',
     wasmFuncName: 'deleteStringMapEntries',
     prepare: () => prepareStringMapBenchmarkData(),
+    sizeIndependent: true,
     tsSetup: (data: StringMapBenchmarkData) => {
       data.deleteMap = tsAlgorithms.createStringMap(data.data);
     },
@@ -502,10 +1267,69 @@ export const benchmarkTests: BenchmarkTest[] = [
     },
   },
   {
-    name: 'Int std::map Insert',
+    name: 'String flat_hash_map Insert',
+    category: 'Maps',
+    tsFuncName: 'insertStringMapEntries',
+    wasmFuncName: 'insertFlatStringMapEntries',
+    prepare: () => prepareFlatStringMapBenchmarkData(),
+    sizeIndependent: true,
+    tsFunc: (data: StringMapBenchmarkData) => tsAlgorithms.insertStringMapEntries(data.data),
+    wasmFunc: (data: StringMapBenchmarkData) => wasmAlgorithms.insertFlatStringMapEntries(data.wasmData),
+    cleanup: (data: StringMapBenchmarkData) => {
+      data.wasmLookupMap.dispose();
+      data.wasmDeleteMap.dispose();
+      data.wasmData.dispose();
+    },
+  },
+  {
+    name: 'String flat_hash_map Lookup',
+    category: 'Maps',
+    tsFuncName: 'lookupStringMapEntries',
+    wasmFuncName: 'lookupFlatStringMapEntries',
+    prepare: () => prepareFlatStringMapBenchmarkData(),
+    sizeIndependent: true,
+    tsSetup: (data: StringMapBenchmarkData) => {
+      data.lookupMap = tsAlgorithms.createStringMap(data.data);
+    },
+    wasmSetup: (data: StringMapBenchmarkData) => {
+      wasmAlgorithms.resetFlatStringMap(data.wasmLookupMap);
+    },
+    tsFunc: (data: StringMapBenchmarkData) => tsAlgorithms.lookupStringMapEntries(data.data, data.lookupMap),
+    wasmFunc: (data: StringMapBenchmarkData) => wasmAlgorithms.lookupFlatStringMapEntries(data.wasmLookupMap),
+    cleanup: (data: StringMapBenchmarkData) => {
+      data.wasmLookupMap.dispose();
+      data.wasmDeleteMap.dispose();
+      data.wasmData.dispose();
+    },
+  },
+  {
+    name: 'String flat_hash_map Delete',
+    category: 'Maps',
+    tsFuncName: 'deleteStringMapEntries',
+    wasmFuncName: 'deleteFlatStringMapEntries',
+    prepare: () => prepareFlatStringMapBenchmarkData(),
+    sizeIndependent: true,
+    tsSetup: (data: StringMapBenchmarkData) => {
+      data.deleteMap = tsAlgorithms.createStringMap(data.data);
+    },
+    wasmSetup: (data: StringMapBenchmarkData) => {
+      wasmAlgorithms.resetFlatStringMap(data.wasmDeleteMap);
+    },
+    tsFunc: (data: StringMapBenchmarkData) => tsAlgorithms.deleteStringMapEntries(data.data, data.deleteMap),
+    wasmFunc: (data: StringMapBenchmarkData) => wasmAlgorithms.deleteFlatStringMapEntries(data.wasmDeleteMap),
+    cleanup: (data: StringMapBenchmarkData) => {
+      data.wasmLookupMap.dispose();
+      data.wasmDeleteMap.dispose();
+      data.wasmData.dispose();
+    },
+  },
+  {
+    name: 'Int B+-tree Insert',
+    category: 'Maps',
     tsFuncName: 'insertNumberMapEntries',
     wasmFuncName: 'insertNumberTreeMapEntries',
     prepare: () => prepareNumberTreeMapBenchmarkData(),
+    sizeIndependent: true,
     tsFunc: (data: NumberTreeMapBenchmarkData) => tsAlgorithms.insertNumberMapEntries(data.data),
     wasmFunc: (data: NumberTreeMapBenchmarkData) => wasmAlgorithms.insertNumberTreeMapEntries(data.wasmData),
     cleanup: (data: NumberTreeMapBenchmarkData) => {
@@ -515,10 +1339,12 @@ export const benchmarkTests: BenchmarkTest[] = [
     },
   },
   {
-    name: 'Int std::map Lookup',
+    name: 'Int B+-tree Lookup',
+    category: 'Maps',
     tsFuncName: 'lookupNumberMapEntries',
     wasmFuncName: 'lookupNumberTreeMapEntries',
     prepare: () => prepareNumberTreeMapBenchmarkData(),
+    sizeIndependent: true,
     tsSetup: (data: NumberTreeMapBenchmarkData) => {
       data.lookupMap = tsAlgorithms.createNumberMap(data.data);
     },
@@ -534,10 +1360,12 @@ export const benchmarkTests: BenchmarkTest[] = [
     },
   },
   {
-    name: 'Int std::map Delete',
+    name: 'Int B+-tree Delete',
+    category: 'Maps',
     tsFuncName: 'deleteNumberMapEntries',
     wasmFuncName: 'deleteNumberTreeMapEntries',
     prepare: () => prepareNumberTreeMapBenchmarkData(),
+    sizeIndependent: true,
     tsSetup: (data: NumberTreeMapBenchmarkData) => {
       data.deleteMap = tsAlgorithms.createNumberMap(data.data);
     },
@@ -557,77 +1385,139 @@ export const benchmarkTests: BenchmarkTest[] = [
 
   {
     name: 'Binary Tree DFS Traversal Only',
+    category: 'Tree Traversal',
     tsFuncName: 'sumBinaryTreeDfs',
     wasmFuncName: 'sumBinaryTreeDfs',
     prepare: () => prepareBinaryTreeBenchmarkData(),
+    sizeIndependent: true,
     tsFunc: (data: BinaryTreeBenchmarkData) => tsAlgorithms.sumBinaryTreeDfs(data.values),
     wasmFunc: (data: BinaryTreeBenchmarkData) => wasmAlgorithms.sumBinaryTreeDfs(data.wasmTree),
     cleanup: (data: BinaryTreeBenchmarkData) => data.wasmTree.dispose(),
   },
   {
     name: 'Binary Tree BFS Traversal Only',
+    category: 'Tree Traversal',
     tsFuncName: 'sumBinaryTreeBfs',
     wasmFuncName: 'sumBinaryTreeBfs',
     prepare: () => prepareBinaryTreeBenchmarkData(),
+    sizeIndependent: true,
     tsFunc: (data: BinaryTreeBenchmarkData) => tsAlgorithms.sumBinaryTreeBfs(data.values),
     wasmFunc: (data: BinaryTreeBenchmarkData) => wasmAlgorithms.sumBinaryTreeBfs(data.wasmTree),
     cleanup: (data: BinaryTreeBenchmarkData) => data.wasmTree.dispose(),
   },
   {
     name: 'N-ary Tree DFS Traversal Only',
+    category: 'Tree Traversal',
     tsFuncName: 'sumNaryTreeDfs',
     wasmFuncName: 'sumNaryTreeDfs',
     prepare: () => prepareNaryTreeBenchmarkData(),
+    sizeIndependent: true,
     tsFunc: (data: NaryTreeBenchmarkData) => tsAlgorithms.sumNaryTreeDfs(data.tree),
     wasmFunc: (data: NaryTreeBenchmarkData) => wasmAlgorithms.sumNaryTreeDfs(data.wasmTree),
     cleanup: (data: NaryTreeBenchmarkData) => data.wasmTree.dispose(),
   },
   {
     name: 'N-ary Tree BFS Traversal Only',
+    category: 'Tree Traversal',
     tsFuncName: 'sumNaryTreeBfs',
     wasmFuncName: 'sumNaryTreeBfs',
     prepare: () => prepareNaryTreeBenchmarkData(),
+    sizeIndependent: true,
     tsFunc: (data: NaryTreeBenchmarkData) => tsAlgorithms.sumNaryTreeBfs(data.tree),
     wasmFunc: (data: NaryTreeBenchmarkData) => wasmAlgorithms.sumNaryTreeBfs(data.wasmTree),
     cleanup: (data: NaryTreeBenchmarkData) => data.wasmTree.dispose(),
   },
   {
     name: 'Binary Tree DFS End-to-End',
+    category: 'Tree Traversal',
     tsFuncName: 'sumBinaryTreeDfs',
     wasmFuncName: 'sumBinaryTreeDfsEndToEnd',
     prepare: () => generateTreeValues(TREE_NODE_COUNT),
+    sizeIndependent: true,
     tsFunc: (values: Uint32Array) => tsAlgorithms.sumBinaryTreeDfs(new Uint32Array(values)),
     wasmFunc: (values: Uint32Array) => wasmAlgorithms.sumBinaryTreeDfsEndToEnd(values),
   },
   {
     name: 'Binary Tree BFS End-to-End',
+    category: 'Tree Traversal',
     tsFuncName: 'sumBinaryTreeBfs',
     wasmFuncName: 'sumBinaryTreeBfsEndToEnd',
     prepare: () => generateTreeValues(TREE_NODE_COUNT),
+    sizeIndependent: true,
     tsFunc: (values: Uint32Array) => tsAlgorithms.sumBinaryTreeBfs(new Uint32Array(values)),
     wasmFunc: (values: Uint32Array) => wasmAlgorithms.sumBinaryTreeBfsEndToEnd(values),
   },
   {
     name: 'N-ary Tree DFS End-to-End',
+    category: 'Tree Traversal',
     tsFuncName: 'sumNaryTreeDfs',
     wasmFuncName: 'sumNaryTreeDfsEndToEnd',
     prepare: () => generateNaryTree(TREE_NODE_COUNT),
+    sizeIndependent: true,
     tsFunc: (tree: tsAlgorithms.NaryTreeData) => tsAlgorithms.sumNaryTreeDfs(cloneNaryTree(tree)),
     wasmFunc: (tree: tsAlgorithms.NaryTreeData) => wasmAlgorithms.sumNaryTreeDfsEndToEnd(tree),
   },
   {
     name: 'N-ary Tree BFS End-to-End',
+    category: 'Tree Traversal',
     tsFuncName: 'sumNaryTreeBfs',
     wasmFuncName: 'sumNaryTreeBfsEndToEnd',
     prepare: () => generateNaryTree(TREE_NODE_COUNT),
+    sizeIndependent: true,
     tsFunc: (tree: tsAlgorithms.NaryTreeData) => tsAlgorithms.sumNaryTreeBfs(cloneNaryTree(tree)),
     wasmFunc: (tree: tsAlgorithms.NaryTreeData) => wasmAlgorithms.sumNaryTreeBfsEndToEnd(tree),
   },
 
+  // ========== TREE LAYOUT TESTS ==========
+  // Sized by the array size setting; sweep to 10M+ nodes to leave the caches
+
+  ...[null, 'veb' as const, 'blocked' as const].flatMap(createBinaryTreeLayoutBenchmarkTests),
+  {
+    name: 'N-ary Tree BFS (CSR Layout)',
+    category: 'Tree Layout',
+    tsFuncName: 'sumNaryTreeBfs',
+    wasmFuncName: 'sumNaryTreeBfs',
+    prepare: (size) => preparePreorderTreeBenchmarkData(size),
+    tsFunc: (data: PreorderTreeBenchmarkData) => tsAlgorithms.sumNaryTreeBfs(data.tree),
+    wasmFunc: (data: PreorderTreeBenchmarkData) => wasmAlgorithms.sumNaryTreeBfs(data.wasmTree),
+    cleanup: disposePreorderTreeBenchmarkData,
+  },
+  {
+    name: 'N-ary Tree BFS (Preorder Layout)',
+    category: 'Tree Layout',
+    tsFuncName: 'sumNaryTreePreorderBfs',
+    wasmFuncName: 'wasmTreeLayout.sumPreorderBfs',
+    prepare: (size) => preparePreorderTreeBenchmarkData(size),
+    tsFunc: (data: PreorderTreeBenchmarkData) => tsAlgorithms.sumNaryTreePreorderBfs(data.preorder),
+    wasmFunc: (data: PreorderTreeBenchmarkData) => wasmTreeLayout.sumPreorderBfs(data.wasmPreorder),
+    cleanup: disposePreorderTreeBenchmarkData,
+  },
+  {
+    name: 'N-ary Subtree Sums (CSR Layout)',
+    category: 'Tree Layout',
+    tsFuncName: 'subtreeSumsNary',
+    wasmFuncName: 'wasmTreeLayout.subtreeSums',
+    prepare: (size) => preparePreorderTreeBenchmarkData(size),
+    tsFunc: (data: PreorderTreeBenchmarkData) => tsAlgorithms.subtreeSumsNary(data.tree, data.sums),
+    wasmFunc: (data: PreorderTreeBenchmarkData) => wasmTreeLayout.subtreeSums(data.wasmTree, data.wasmSums),
+    cleanup: disposePreorderTreeBenchmarkData,
+  },
+  {
+    name: 'N-ary Subtree Sums (Preorder Layout)',
+    category: 'Tree Layout',
+    tsFuncName: 'subtreeSumsPreorder',
+    wasmFuncName: 'wasmTreeLayout.subtreeSums',
+    prepare: (size) => preparePreorderTreeBenchmarkData(size),
+    tsFunc: (data: PreorderTreeBenchmarkData) => tsAlgorithms.subtreeSumsPreorder(data.preorder, data.sums),
+    wasmFunc: (data: PreorderTreeBenchmarkData) => wasmTreeLayout.subtreeSums(data.wasmPreorder, data.wasmSums),
+    cleanup: disposePreorderTreeBenchmarkData,
+  },
+
   // ========== MATRIX TRANSFORMATION TESTS ==========
 
   {
     name: 'Matrix Transform',
+    category: 'Matrix Transform',
     prepare: (size) => {
       const vectors = generateRandomVectors(size);
       const matrix = tsAlgorithms.createTransformMatrix(2, 1.5, 1, 45, 10, 20, 5);
@@ -644,6 +1534,7 @@ export const benchmarkTests: BenchmarkTest[] = [
   },
   {
     name: 'Matrix Transform (SIMD)',
+    category: 'Matrix Transform',
     prepare: (size) => {
       const vectors = generateRandomVectors(size);
       const matrix = tsAlgorithms.createTransformMatrix(2, 1.5, 1, 45, 10, 20, 5);
@@ -658,6 +1549,358 @@ export const benchmarkTests: BenchmarkTest[] = [
       return wasmAlgorithms.transformVectorsSIMD(data.vectors, data.matrix);
     },
   },
+  {
+    name: 'Matrix Transform (MT)',
+    category: 'Matrix Transform',
+    tsFuncName: 'transformVectors',
+    wasmFuncName: 'transformVectors_MT',
+    prepare: (size) => {
+      const vectors = generateRandomVectors(size);
+      const matrix = tsAlgorithms.createTransformMatrix(2, 1.5, 1, 45, 10, 20, 5);
+      return { vectors, matrix };
+    },
+    tsFunc: (data) => {
+      const vectorsCopy = new Float32Array(data.vectors);
+      return tsAlgorithms.transformVectors(vectorsCopy, data.matrix);
+    },
+    wasmFunc: (data) => wasmAlgorithms.transformVectors_MT(data.vectors, data.matrix),
+  },
+
+  // ========== SoA VECTOR TESTS ==========
+  // Component arrays live in persistent WasmBuffers; transforms are in place
+  // and both sides re-split their input untimed
+
+  {
+    name: 'AoS to SoA',
+    category: 'SoA Vectors',
+    tsFuncName: 'aosToSoa',
+    wasmFuncName: 'wasmBufferAlgorithms.aosToSoa',
+    prepare: (size) => prepareSoABenchmarkData(size),
+    tsFunc: (data: SoABenchmarkData) => tsAlgorithms.aosToSoa(data.vectors),
+    wasmFunc: (data: SoABenchmarkData) => wasmBufferAlgorithms.aosToSoa(data.vectorsBuffer, data.wasmSoa),
+    cleanup: disposeSoABenchmarkData,
+  },
+  {
+    name: 'Matrix Transform (SoA)',
+    category: 'SoA Vectors',
+    tsFuncName: 'transformVectorsSoA',
+    wasmFuncName: 'wasmBufferAlgorithms.transformVectorsSoA',
+    prepare: (size) => prepareSoABenchmarkData(size),
+    tsSetup: resetTsSoA,
+    wasmSetup: resetWasmSoA,
+    tsFunc: (data: SoABenchmarkData) => tsAlgorithms.transformVectorsSoA(data.soa, data.matrix),
+    wasmFunc: (data: SoABenchmarkData) => wasmBufferAlgorithms.transformVectorsSoA(data.wasmSoa, data.matrixBuffer),
+    cleanup: disposeSoABenchmarkData,
+  },
+  {
+    name: 'Matrix Transform 4x4 (SoA)',
+    category: 'SoA Vectors',
+    tsFuncName: 'transformVectors4SoA',
+    wasmFuncName: 'wasmBufferAlgorithms.transformVectors4SoA',
+    prepare: (size) => prepareSoABenchmarkData(size),
+    tsSetup: resetTsSoA,
+    wasmSetup: resetWasmSoA,
+    tsFunc: (data: SoABenchmarkData) => tsAlgorithms.transformVectors4SoA(data.soa, data.matrix),
+    wasmFunc: (data: SoABenchmarkData) => wasmBufferAlgorithms.transformVectors4SoA(data.wasmSoa, data.matrixBuffer),
+    cleanup: disposeSoABenchmarkData,
+  },
+  {
+    name: 'Matrix Transform Batch (SoA)',
+    category: 'SoA Vectors',
+    tsFuncName: 'transformVectorsSoABatch',
+    wasmFuncName: 'wasmBufferAlgorithms.transformVectorsSoABatch',
+    prepare: (size) => prepareSoABenchmarkData(size),
+    tsSetup: resetTsSoA,
+    wasmSetup: resetWasmSoA,
+    tsFunc: (data: SoABenchmarkData) =>
+      tsAlgorithms.transformVectorsSoABatch(data.soa, data.matrices, data.offsets),
+    wasmFunc: (data: SoABenchmarkData) =>
+      wasmBufferAlgorithms.transformVectorsSoABatch(data.wasmSoa, data.matricesBuffer, data.offsetsBuffer),
+    cleanup: disposeSoABenchmarkData,
+  },
+
+  // ========== STREAMING TESTS ==========
+  // Input is pushed through one STREAM_CHUNK_LENGTH WasmBuffer, as a dataset
+  // larger than WASM memory would be; compare against the in-memory kernels
+
+  {
+    name: 'Sum Array (Streaming)',
+    category: 'Streaming',
+    tsFuncName: 'sumArray',
+    wasmFuncName: 'beginStream/pushChunk/finishStream',
+    prepare: (size) => generateRandomArray(size),
+    tsFunc: (arr) => tsAlgorithms.sumArray(arr),
+    wasmFunc: (arr) => {
+      const stream = createWasmStream('sum', { chunkLength: STREAM_CHUNK_LENGTH });
+      stream.push(arr);
+      return stream.finish().sum;
+    },
+  },
+  {
+    name: 'External Merge Sort (Streaming)',
+    category: 'Streaming',
+    tsFuncName: 'quickSort',
+    wasmFuncName: 'createExternalMerge',
+    prepare: (size) => generateRandomArray(size),
+    tsFunc: (arr) => tsAlgorithms.quickSort(arr),
+    wasmFunc: (arr) => {
+      const sorted = new Uint32Array(arr.length);
+      let offset = 0;
+      const sort = createWasmExternalSort({ chunkLength: STREAM_CHUNK_LENGTH });
+      sort.push(arr);
+      sort.finish((part) => {
+        sorted.set(part, offset);
+        offset += part.length;
+      });
+      return sorted;
+    },
+  },
+
+  // ========== DISTINCT COUNTING TESTS ==========
+  // Sorting countUnique against the bitmap / hash set exact paths and the
+  // HyperLogLog estimate; sweep 1M-50M with the CLI --sizes option
+
+  {
+    name: 'Count Unique (Sort)',
+    category: 'Distinct Counting',
+    tsFuncName: 'countUnique',
+    wasmFuncName: 'wasmBufferAlgorithms.countUnique',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.countUnique(data.arr),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.countUnique(data.buffer),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Count Unique Exact (Bitmap)',
+    category: 'Distinct Counting',
+    tsFuncName: 'countUniqueExact',
+    wasmFuncName: 'wasmBufferAlgorithms.countUniqueExact',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.countUniqueExact(data.arr),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.countUniqueExact(data.buffer),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Count Unique Exact (Hash Set)',
+    category: 'Distinct Counting',
+    tsFuncName: 'countUniqueExact',
+    wasmFuncName: 'wasmBufferAlgorithms.countUniqueExact',
+    prepare: (size) => prepareBufferBenchmarkData(generateWideRandomArray(size)),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.countUniqueExact(data.arr),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.countUniqueExact(data.buffer),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Count Unique Approx (HyperLogLog)',
+    category: 'Distinct Counting',
+    tsFuncName: 'countUniqueApprox',
+    wasmFuncName: 'wasmBufferAlgorithms.countUniqueApprox',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.countUniqueApprox(data.arr),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.countUniqueApprox(data.buffer),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+
+  // ========== FUSED STATISTICS TESTS ==========
+  // One computeStats pass against the five kernels it replaces; both WASM
+  // sides read the same persistent buffer
+
+  {
+    name: 'Compute Stats (Zero-Copy)',
+    category: 'Fused Statistics',
+    tsFuncName: 'computeStats',
+    wasmFuncName: 'wasmBufferAlgorithms.computeStats',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.computeStats(data.arr),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.computeStats(data.buffer),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Compute Stats + Histogram (Zero-Copy)',
+    category: 'Fused Statistics',
+    tsFuncName: 'computeStats',
+    wasmFuncName: 'wasmBufferAlgorithms.computeStats',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.computeStats(data.arr, STATS_HISTOGRAM),
+    wasmFunc: (data: BufferBenchmarkData) => wasmBufferAlgorithms.computeStats(data.buffer, STATS_HISTOGRAM),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Separate Stats Calls (Zero-Copy)',
+    category: 'Fused Statistics',
+    tsFuncName: 'computeStats',
+    wasmFuncName: 'sumArray+findMin+findMax+calculateAverage+calculateVariance',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.computeStats(data.arr),
+    wasmFunc: (data: BufferBenchmarkData) => ({
+      sum: wasmBufferAlgorithms.sumArray(data.buffer),
+      min: wasmBufferAlgorithms.findMin(data.buffer),
+      max: wasmBufferAlgorithms.findMax(data.buffer),
+      mean: wasmBufferAlgorithms.calculateAverage(data.buffer),
+      variance: wasmBufferAlgorithms.calculateVariance(data.buffer),
+    }),
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+
+  // ========== FUSED PIPELINE TESTS ==========
+  // multiply -> add -> filter -> reduce compiled once and run in one pass,
+  // against the same chain as three zero-copy kernel calls (three memory
+  // passes, the first two writing the buffer back)
+
+  {
+    name: 'Pipeline Map → Filter → Count (Fused)',
+    category: 'Fused Pipeline',
+    tsFuncName: 'runPipeline',
+    wasmFuncName: 'runPipeline',
+    prepare: (size) => preparePipelineBenchmarkData(generateRandomArray(size), PIPELINE_COUNT),
+    tsFunc: (data: PipelineBenchmarkData) => tsAlgorithms.runPipeline(data.arr, PIPELINE_COUNT),
+    wasmFunc: (data: PipelineBenchmarkData) => data.pipeline.run(data.buffer),
+    cleanup: disposePipelineBenchmarkData,
+  },
+  {
+    name: 'Pipeline Map → Filter → Count (Separate Calls)',
+    category: 'Fused Pipeline',
+    tsFuncName: 'runPipeline',
+    wasmFuncName: 'multiplyArray+addToArray+countGreaterThan',
+    prepare: (size) => prepareBufferBenchmarkData(generateRandomArray(size)),
+    wasmSetup: (data: BufferBenchmarkData) => data.buffer.set(data.arr),
+    tsFunc: (data: BufferBenchmarkData) => tsAlgorithms.runPipeline(data.arr, PIPELINE_COUNT),
+    wasmFunc: (data: BufferBenchmarkData) => {
+      wasmBufferAlgorithms.multiplyArray(data.buffer, 3);
+      wasmBufferAlgorithms.addToArray(data.buffer, 7);
+      return wasmBufferAlgorithms.countGreaterThan(data.buffer, 1_500_000);
+    },
+    cleanup: (data: BufferBenchmarkData) => data.buffer.dispose(),
+  },
+  {
+    name: 'Pipeline Map → Filter → Sum (Fused, Multithreaded)',
+    category: 'Fused Pipeline',
+    tsFuncName: 'runPipeline',
+    wasmFuncName: 'runPipeline_MT',
+    prepare: (size) => preparePipelineBenchmarkData(generateRandomArray(size), PIPELINE_SUM),
+    tsFunc: (data: PipelineBenchmarkData) => tsAlgorithms.runPipeline(data.arr, PIPELINE_SUM),
+    wasmFunc: (data: PipelineBenchmarkData) => data.pipeline.run(data.buffer, 0),
+    cleanup: disposePipelineBenchmarkData,
+  },
+
+  // ========== TYPED KERNEL TESTS ==========
+  // reduce<T, Op> / map<T, Op> instantiations on non-uint32 columns, run in
+  // place on persistent buffers; narrow types pack 8-16 lanes per vector
+
+  {
+    name: 'Sum Array (Int8)',
+    category: 'Typed Kernels',
+    tsFuncName: 'sumArrayTyped',
+    wasmFuncName: 'wasmBufferAlgorithms.sumArrayTyped',
+    prepare: (size) => prepareTypedBufferBenchmarkData(generateInt8Array(size)),
+    tsFunc: (data: TypedBufferBenchmarkData<Int8Array>) => tsAlgorithms.sumArrayTyped(data.arr),
+    wasmFunc: (data: TypedBufferBenchmarkData<Int8Array>) => wasmBufferAlgorithms.sumArrayTyped(data.buffer),
+    cleanup: (data: TypedBufferBenchmarkData<Int8Array>) => data.buffer.dispose(),
+  },
+  {
+    name: 'Sum Array (Int16)',
+    category: 'Typed Kernels',
+    tsFuncName: 'sumArrayTyped',
+    wasmFuncName: 'wasmBufferAlgorithms.sumArrayTyped',
+    prepare: (size) => prepareTypedBufferBenchmarkData(generateInt16Array(size)),
+    tsFunc: (data: TypedBufferBenchmarkData<Int16Array>) => tsAlgorithms.sumArrayTyped(data.arr),
+    wasmFunc: (data: TypedBufferBenchmarkData<Int16Array>) => wasmBufferAlgorithms.sumArrayTyped(data.buffer),
+    cleanup: (data: TypedBufferBenchmarkData<Int16Array>) => data.buffer.dispose(),
+  },
+  {
+    name: 'Sum Array (Float64)',
+    category: 'Typed Kernels',
+    tsFuncName: 'sumArrayTyped',
+    wasmFuncName: 'wasmBufferAlgorithms.sumArrayTyped',
+    prepare: (size) => prepareTypedBufferBenchmarkData(generateFloat64Array(size)),
+    tsFunc: (data: TypedBufferBenchmarkData<Float64Array>) => tsAlgorithms.sumArrayTyped(data.arr),
+    wasmFunc: (data: TypedBufferBenchmarkData<Float64Array>) => wasmBufferAlgorithms.sumArrayTyped(data.buffer),
+    cleanup: (data: TypedBufferBenchmarkData<Float64Array>) => data.buffer.dispose(),
+  },
+  {
+    name: 'Find Min (Float32)',
+    category: 'Typed Kernels',
+    tsFuncName: 'findMinTyped',
+    wasmFuncName: 'wasmBufferAlgorithms.findMinTyped',
+    prepare: (size) => prepareTypedBufferBenchmarkData(generateFloat32Array(size)),
+    tsFunc: (data: TypedBufferBenchmarkData<Float32Array>) => tsAlgorithms.findMinTyped(data.arr),
+    wasmFunc: (data: TypedBufferBenchmarkData<Float32Array>) => wasmBufferAlgorithms.findMinTyped(data.buffer),
+    cleanup: (data: TypedBufferBenchmarkData<Float32Array>) => data.buffer.dispose(),
+  },
+  {
+    name: 'Find Max (Int16)',
+    category: 'Typed Kernels',
+    tsFuncName: 'findMaxTyped',
+    wasmFuncName: 'wasmBufferAlgorithms.findMaxTyped',
+    prepare: (size) => prepareTypedBufferBenchmarkData(generateInt16Array(size)),
+    tsFunc: (data: TypedBufferBenchmarkData<Int16Array>) => tsAlgorithms.findMaxTyped(data.arr),
+    wasmFunc: (data: TypedBufferBenchmarkData<Int16Array>) => wasmBufferAlgorithms.findMaxTyped(data.buffer),
+    cleanup: (data: TypedBufferBenchmarkData<Int16Array>) => data.buffer.dispose(),
+  },
+  {
+    name: 'Multiply Array (Int16)',
+    category: 'Typed Kernels',
+    tsFuncName: 'multiplyArrayTyped',
+    wasmFuncName: 'wasmBufferAlgorithms.multiplyArrayTyped',
+    prepare: (size) => prepareTypedBufferBenchmarkData(generateInt16Array(size)),
+    wasmSetup: (data: TypedBufferBenchmarkData<Int16Array>) => data.buffer.set(data.arr),
+    tsFunc: (data: TypedBufferBenchmarkData<Int16Array>) => tsAlgorithms.multiplyArrayTyped(data.arr, 3),
+    wasmFunc: (data: TypedBufferBenchmarkData<Int16Array>) => wasmBufferAlgorithms.multiplyArrayTyped(data.buffer, 3),
+    cleanup: (data: TypedBufferBenchmarkData<Int16Array>) => data.buffer.dispose(),
+  },
+  {
+    name: 'Add To Array (Float64)',
+    category: 'Typed Kernels',
+    tsFuncName: 'addToArrayTyped',
+    wasmFuncName: 'wasmBufferAlgorithms.addToArrayTyped',
+    prepare: (size) => prepareTypedBufferBenchmarkData(generateFloat64Array(size)),
+    wasmSetup: (data: TypedBufferBenchmarkData<Float64Array>) => data.buffer.set(data.arr),
+    tsFunc: (data: TypedBufferBenchmarkData<Float64Array>) => tsAlgorithms.addToArrayTyped(data.arr, 0.5),
+    wasmFunc: (data: TypedBufferBenchmarkData<Float64Array>) => wasmBufferAlgorithms.addToArrayTyped(data.buffer, 0.5),
+    cleanup: (data: TypedBufferBenchmarkData<Float64Array>) => data.buffer.dispose(),
+  },
+
+  // ========== FILTER TESTS ==========
+  // Columnar predicates: WASM writes bitmaps and compacts them into
+  // persistent output buffers; TS uses typed-array filter / index loops
+
+  {
+    name: 'Filter Greater Than (Gather)',
+    category: 'Filter',
+    tsFuncName: 'filterRows',
+    wasmFuncName: 'wasmFilter.where + gather',
+    prepare: (size) => prepareFilterBenchmarkData(generateRandomArray(size), 'values'),
+    tsFunc: (data: FilterBenchmarkData<Uint32Array>) => tsAlgorithms.filterRows(data.column, FILTER_GREATER_THAN),
+    wasmFunc: (data: FilterBenchmarkData<Uint32Array>) =>
+      wasmFilter.gather(data.buffer, wasmFilter.where(data.buffer, FILTER_GREATER_THAN, data.bitmap), data.values),
+    cleanup: disposeFilterBenchmarkData,
+  },
+  {
+    name: 'Filter BETWEEN AND IN (Select)',
+    category: 'Filter',
+    tsFuncName: 'selectRowsWhereAll',
+    wasmFuncName: 'wasmFilter.where + and + select',
+    prepare: (size) => prepareFilterBenchmarkData(generateRandomArray(size), 'indices'),
+    tsFunc: (data: FilterBenchmarkData<Uint32Array>) =>
+      tsAlgorithms.selectRowsWhereAll(data.column, [FILTER_LOWER_HALF, FILTER_IN_SET]),
+    wasmFunc: (data: FilterBenchmarkData<Uint32Array>) => {
+      wasmFilter.where(data.buffer, FILTER_LOWER_HALF, data.bitmap);
+      wasmFilter.where(data.buffer, FILTER_IN_SET, data.scratch);
+      return wasmFilter.select(wasmFilter.and(data.bitmap, data.scratch), data.indices);
+    },
+    cleanup: disposeFilterBenchmarkData,
+  },
+  {
+    name: 'Filter Range (Float32 Gather)',
+    category: 'Filter',
+    tsFuncName: 'filterRows',
+    wasmFuncName: 'wasmFilter.where + gather',
+    prepare: (size) => prepareFilterBenchmarkData(generateFloat32Array(size), 'values'),
+    tsFunc: (data: FilterBenchmarkData<Float32Array>) => tsAlgorithms.filterRows(data.column, FILTER_FLOAT_RANGE),
+    wasmFunc: (data: FilterBenchmarkData<Float32Array>) =>
+      wasmFilter.gather(data.buffer, wasmFilter.where(data.buffer, FILTER_FLOAT_RANGE, data.bitmap), data.values),
+    cleanup: disposeFilterBenchmarkData,
+  },
 ];
 
 /**
@@ -0,0 +1,363 @@
+/**
+ * Headless Benchmark CLI
+ * Runs testRegistry tests under Node across a size sweep, writes JSON/CSV
+ * reports and gates on regressions against a stored baseline
+ *
+ *   pnpm run build:wasm:node
+ *   pnpm run bench -- --filter "Sum Array" --sizes 100000,1000000 --json out.json
+ *   pnpm run bench -- --baseline baseline.json --max-slowdown 0.05
+ */
+
+import { execSync } from 'node:child_process';
+import { mkdirSync, readFileSync, writeFileSync } from 'node:fs';
+import { arch, cpus, platform, totalmem } from 'node:os';
+import { dirname } from 'node:path';
+import { parseArgs } from 'node:util';
+import { registerBenchmarkTests } from '../benchmark-registry';
+import { runBenchmark, formatTime } from '../framework/benchmark-runner';
+import type { MeasurementOrder } from '../framework/measurement';
+import {
+  DEFAULT_REGRESSION_THRESHOLDS,
+  compareToBaseline,
+  recordKey,
+  recordsToCsv,
+  toBenchmarkRecord,
+  type BenchmarkRecord,
+  type BenchmarkReport,
+  type EnvironmentInfo,
+  type RegressionMetric,
+} from '../framework/report';
+import { testRegistry } from '../framework/test-registry';
+import type { BenchmarkTest, TestConfig } from '../framework/types';
+import { getWasmModuleInstance, getWasmStartupTiming, initWasmModule } from '../framework/wasm-loader';
+import { WasmWorkerHost, measureWorkerDispatch, type WorkerDispatchStats } from '../framework/wasm-worker-host';
+import { wasmAlgorithms } from '../wasm-algorithms';
+
+const USAGE = `Usage: pnpm run bench -- [options]
+
+Selection
+  -f, --filter <text>      Run tests whose name contains text (or matches /regex/); repeatable
+  -c, --category <name>    Run tests of a category; repeatable
+      --list               List matching tests and exit
+
+Measurement
+  -s, --sizes <n,n,...>    Array sizes to sweep (default 100000,1000000)
+  -i, --iterations <n>     Minimum samples per side (default 10)
+  -w, --warmup <n>         Warmup iterations, 0 for none (default 3)
+      --order <order>      abba | random | sequential (default abba)
+      --max-time <ms>      Sampling budget per side (default 5000)
+      --worker             Also time batched kernel dispatch to a worker
+
+Output
+      --json <file>        Write the report as JSON
+      --csv <file>         Write the records as CSV
+
+Regression gating
+      --baseline <file>    Compare against a JSON report from an earlier run
+      --max-slowdown <r>   Allowed relative slowdown (default 0.1 = 10%)
+      --metric <m>         mean | median (default mean)
+      --gate <sides>       Sides to gate: wasm, ts or wasm,ts (default wasm)
+      --no-significance    Flag slowdowns even when the CIs overlap
+      --fail-on-noise      Exit non-zero when a result misses the noise threshold
+
+Exit status: 0 ok, 1 regression or noise, 2 usage or runtime error`;
+
+// Exit codes
+const EXIT_OK = 0;
+const EXIT_REGRESSION = 1;
+const EXIT_ERROR = 2;
+
+function parseNumberList(value: string, option: string): number[] {
+  const numbers = value.split(',').map(part => Number(part.trim()));
+  if (numbers.length === 0 || numbers.some(n => !Number.isFinite(n) || n <= 0)) {
+    throw new Error(`--${option} expects positive numbers, got "${value}"`);
+  }
+  return numbers;
+}
+
+function parsePositive(value: string, option: string): number {
+  return parseNumberList(value, option)[0];
+}
+
+function parseNonNegative(value: string, option: string): number {
+  const number = Number(value.trim());
+  if (!Number.isInteger(number) || number < 0) {
+    throw new Error(`--${option} expects a non-negative integer, got "${value}"`);
+  }
+  return number;
+}
+
+function createMatcher(pattern: string): (name: string) => boolean {
+  const regex = /^\/(.*)\/([a-z]*)$/.exec(pattern);
+  if (regex) {
+    const compiled = new RegExp(regex[1], regex[2]);
+    return name => compiled.test(name);
+  }
+  const needle = pattern.toLowerCase();
+  return name => name.toLowerCase().includes(needle);
+}
+
+/**
+ * Registry tests matching every --filter (any of them) and --category
+ */
+function selectTests(filters: string[], categories: string[]): BenchmarkTest[] {
+  const matchers = filters.map(createMatcher);
+  const wanted = new Set(categories.map(category => category.toLowerCase()));
+  return testRegistry.getAllTests().filter(test =>
+    (matchers.length === 0 || matchers.some(match => match(test.name))) &&
+    (wanted.size === 0 || wanted.has(test.category.toLowerCase()))
+  );
+}
+
+function readGitCommit(): string | null {
+  try {
+    return execSync('git rev-parse --short HEAD', { stdio: ['ignore', 'pipe', 'ignore'] }).toString().trim();
+  } catch {
+    return null;
+  }
+}
+
+function readWasmThreads(): number | null {
+  try {
+    return wasmAlgorithms.getMaxThreads();
+  } catch {
+    return null;
+  }
+}
+
+function collectEnvironment(): EnvironmentInfo {
+  const cpuList = cpus();
+  return {
+    timestamp: new Date().toISOString(),
+    runtime: 'node',
+    runtimeVersion: process.version,
+    platform: platform(),
+    arch: arch(),
+    cpuModel: cpuList[0]?.model ?? 'unknown',
+    cpuCount: cpuList.length,
+    totalMemoryBytes: totalmem(),
+    gitCommit: readGitCommit(),
+    wasmThreads: readWasmThreads(),
+    // After readWasmThreads, so the thread pool start is included
+    wasmStartup: getWasmStartupTiming(),
+  };
+}
+
+function writeOutput(path: string, content: string): void {
+  mkdirSync(dirname(path), { recursive: true });
+  writeFileSync(path, content);
+  console.log(`📝 Wrote ${path}`);
+}
+
+function formatChange(change: number): string {
+  return `${change >= 0 ? '+' : ''}${(change * 100).toFixed(1)}%`;
+}
+
+function printRecords(records: BenchmarkRecord[]): void {
+  console.log('');
+  for (const record of records) {
+    console.log(
+      `${record.noisy ? '⚠️ ' : '  '}${recordKey(record).padEnd(64)} ` +
+      `TS ${formatTime(record.tsMean).padStart(10)}  WASM ${formatTime(record.wasmMean).padStart(10)}  ` +
+      `${record.speedup.toFixed(2)}x [${record.speedupLow.toFixed(2)}, ${record.speedupHigh.toFixed(2)}]` +
+      // Steady-state WASM calls should not reach the heap for scratch
+      (record.wasmScratchGrows ? `  scratch grows ${record.wasmScratchGrows}` : '')
+    );
+    if (record.wasmKernelMs) {
+      console.log(
+        `${' '.repeat(66)}in ${formatTime(record.wasmCopyInMs ?? 0)} + kernel ${formatTime(record.wasmKernelMs)}` +
+        ` + out ${formatTime(record.wasmCopyOutMs ?? 0)}` +
+        (record.wasmKernelGBps
+          ? `  ${record.wasmKernelGBps.toFixed(1)} GB/s (${((record.wasmBandwidthShare ?? 0) * 100).toFixed(0)}% of read bandwidth)`
+          : '')
+      );
+    }
+  }
+}
+
+async function runWorkerDispatch(arraySize: number): Promise<WorkerDispatchStats> {
+  const host = await WasmWorkerHost.create();
+  try {
+    return await measureWorkerDispatch(host, getWasmModuleInstance(), { arraySize });
+  } finally {
+    host.terminate();
+  }
+}
+
+function printWorkerDispatch(stats: WorkerDispatchStats): void {
+  console.log(
+    `\n🧵 Worker dispatch @ ${stats.arraySize.toLocaleString()} (${stats.shared ? 'shared' : 'cloned'} input): ` +
+    `round trip ${formatTime(stats.roundTripMs)}, sumArray on this thread ${formatTime(stats.localKernelMs)}`
+  );
+  for (const batch of stats.batches) {
+    console.log(
+      `  batch ${String(batch.batchSize).padStart(4)}: ${formatTime(batch.wallMs).padStart(10)} per batch, ` +
+      `worker ${formatTime(batch.workerMs).padStart(10)}, overhead ${formatTime(batch.overheadPerKernelMs)} per kernel, ` +
+      `${Math.round(batch.kernelsPerSecond).toLocaleString()} kernels/s`
+    );
+  }
+}
+
+async function main(): Promise<number> {
+  const { values } = parseArgs({
+    options: {
+      filter: { type: 'string', short: 'f', multiple: true, default: [] },
+      category: { type: 'string', short: 'c', multiple: true, default: [] },
+      list: { type: 'boolean', default: false },
+      sizes: { type: 'string', short: 's', default: '100000,1000000' },
+      iterations: { type: 'string', short: 'i', default: '10' },
+      warmup: { type: 'string', short: 'w', default: '3' },
+      order: { type: 'string', default: 'abba' },
+      'max-time': { type: 'string', default: '5000' },
+      worker: { type: 'boolean', default: false },
+      json: { type: 'string' },
+      csv: { type: 'string' },
+      baseline: { type: 'string' },
+      'max-slowdown': { type: 'string', default: String(DEFAULT_REGRESSION_THRESHOLDS.maxSlowdown) },
+      metric: { type: 'string', default: DEFAULT_REGRESSION_THRESHOLDS.metric },
+      gate: { type: 'string', default: DEFAULT_REGRESSION_THRESHOLDS.sides.join(',') },
+      'no-significance': { type: 'boolean', default: false },
+      'fail-on-noise': { type: 'boolean', default: false },
+      help: { type: 'boolean', short: 'h', default: false },
+    },
+  });
+
+  if (values.help) {
+    console.log(USAGE);
+    return EXIT_OK;
+  }
+
+  registerBenchmarkTests();
+  const tests = selectTests(values.filter, values.category);
+  if (values.list) {
+    for (const test of tests) {
+      console.log(`${test.category.padEnd(20)} ${test.name}`);
+    }
+    return EXIT_OK;
+  }
+  if (tests.length === 0) {
+    throw new Error('No tests match the given --filter / --category');
+  }
+
+  const order = values.order as MeasurementOrder;
+  if (!['abba', 'random', 'sequential'].includes(order)) {
+    throw new Error(`--order expects abba, random or sequential, got "${order}"`);
+  }
+  const metric = values.metric as RegressionMetric;
+  if (metric !== 'mean' && metric !== 'median') {
+    throw new Error(`--metric expects mean or median, got "${metric}"`);
+  }
+  const sides = values.gate.split(',').map(side => side.trim());
+  if (sides.length === 0 || sides.some(side => side !== 'ts' && side !== 'wasm')) {
+    throw new Error(`--gate expects wasm, ts or wasm,ts, got "${values.gate}"`);
+  }
+
+  const sizes = parseNumberList(values.sizes, 'sizes');
+  const maxSlowdown = parsePositive(values['max-slowdown'], 'max-slowdown');
+  const baseConfig: Omit<TestConfig, 'arraySize'> = {
+    iterations: parsePositive(values.iterations, 'iterations'),
+    warmupIterations: parseNonNegative(values.warmup, 'warmup'),
+    order,
+    statistics: {
+      maxTimeMs: parsePositive(values['max-time'], 'max-time'),
+      // Noise is reported per record and gated below
+      failOnNoise: false,
+    },
+  };
+
+  try {
+    await initWasmModule();
+  } catch (error) {
+    console.error('The WASM module could not be loaded in Node; build it with `pnpm run build:wasm:node`.');
+    throw error;
+  }
+  const environment = collectEnvironment();
+
+  // Fixed-size tests run once, at the first size
+  const plan = sizes.flatMap((size, index) =>
+    tests
+      .filter(test => index === 0 || !test.sizeIndependent)
+      .map(test => ({ test, size }))
+  );
+
+  const records: BenchmarkRecord[] = [];
+  for (let i = 0; i < plan.length; i++) {
+    const { test, size } = plan[i];
+    console.log(`[${i + 1}/${plan.length}] ${test.name}${test.sizeIndependent ? '' : ` @ ${size.toLocaleString()}`}`);
+    const result = await runBenchmark(test, { ...baseConfig, arraySize: size });
+    records.push(toBenchmarkRecord(result, test.sizeIndependent ? null : size));
+  }
+  printRecords(records);
+
+  let workerDispatch: WorkerDispatchStats | undefined;
+  if (values.worker) {
+    workerDispatch = await runWorkerDispatch(sizes[0]);
+    printWorkerDispatch(workerDispatch);
+  }
+
+  const report: BenchmarkReport = {
+    environment,
+    config: { ...baseConfig, sizes },
+    records,
+    workerDispatch,
+  };
+  if (values.json) {
+    writeOutput(values.json, JSON.stringify(report, null, 2) + '\n');
+  }
+  if (values.csv) {
+    writeOutput(values.csv, recordsToCsv(records));
+  }
+
+  let exitCode = EXIT_OK;
+  const noisy = records.filter(record => record.noisy);
+  if (noisy.length > 0) {
+    console.warn(`\n⚠️ ${noisy.length} result(s) above the noise threshold: ${noisy.map(recordKey).join(', ')}`);
+    if (values['fail-on-noise']) {
+      exitCode = EXIT_REGRESSION;
+    }
+  }
+
+  if (values.baseline) {
+    const baseline = JSON.parse(readFileSync(values.baseline, 'utf8')) as BenchmarkReport;
+    const comparison = compareToBaseline(records, baseline.records, {
+      maxSlowdown,
+      metric,
+      requireSignificance: !values['no-significance'],
+      sides: sides as Array<'ts' | 'wasm'>,
+    });
+
+    console.log(`\n📏 Baseline ${values.baseline} (${baseline.environment.gitCommit ?? 'unknown commit'})`);
+    for (const entry of comparison.comparisons) {
+      if (entry.status === 'unchanged') {
+        continue;
+      }
+      console.log(
+        `${entry.status === 'regression' ? '❌' : '✅'} ${recordKey(entry)} [${entry.side}] ` +
+        `${formatTime(entry.baseline)} -> ${formatTime(entry.current)} (${formatChange(entry.change)})`
+      );
+    }
+    if (comparison.added.length > 0) {
+      console.log(`➕ Not in baseline: ${comparison.added.join(', ')}`);
+    }
+    if (comparison.missing.length > 0) {
+      console.log(`➖ Not run: ${comparison.missing.join(', ')}`);
+    }
+
+    if (comparison.regressions.length > 0) {
+      console.error(`\n❌ ${comparison.regressions.length} regression(s) above ${formatChange(maxSlowdown)}`);
+      exitCode = EXIT_REGRESSION;
+    } else {
+      console.log('\n✅ No regressions');
+    }
+  }
+
+  return exitCode;
+}
+
+main().then(
+  code => process.exit(code),
+  error => {
+    console.error(`❌ ${(error as Error).message}`);
+    process.exit(EXIT_ERROR);
+  }
+);
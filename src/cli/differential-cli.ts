@@ -0,0 +1,194 @@
+/**
+ * Differential Test CLI
+ * Runs the TypeScript and WASM sides of every benchmarkTests entry on the
+ * same input and checks that they agree. Each round draws a random size
+ * (every third one short, so the SIMD tails are hit) and fills the uint32
+ * inputs with each value distribution in turn, including adversarial ones
+ * (all 0xFFFFFFFF, alternating extremes, full 32-bit range). The native
+ * differential test (ctest) covers pointer alignment and sizes up to 100M.
+ *
+ *   pnpm run build:wasm:node
+ *   pnpm run test:diff
+ *   pnpm run test:diff -- --filter SIMD --rounds 20 --seed 7
+ */
+
+import { parseArgs } from 'node:util';
+import { benchmarkTests, setRandomArraySource, type BenchmarkTest } from '../benchmark';
+import { compareResults, isComparableResult, type ResultMismatch } from '../framework/differential';
+import { mulberry32 } from '../framework/statistics';
+import { initWasmModule } from '../framework/wasm-loader';
+
+const USAGE = `Usage: pnpm run test:diff -- [options]
+
+  -f, --filter <text>      Run tests whose name contains text; repeatable
+  -c, --category <name>    Run tests of a category; repeatable
+  -r, --rounds <n>         Random sizes per test (default 4)
+      --max-size <n>       Largest random size (default 20000)
+      --seed <n>           Seed for sizes and values (default 1)
+      --distribution <d>   Only this value distribution; repeatable
+
+Exit status: 0 all equal, 1 mismatch, 2 usage or runtime error`;
+
+const EXIT_OK = 0;
+const EXIT_MISMATCH = 1;
+const EXIT_ERROR = 2;
+
+// Rounds below this size exercise every tail length of a vector loop
+const SHORT_SIZE = 67;
+
+type ValueSource = (random: () => number) => (index: number) => number;
+
+// uint32 inputs of generateRandomArray, by distribution
+const DISTRIBUTIONS: Record<string, ValueSource> = {
+  'default': random => () => random() % 1000000,
+  'full-range': random => () => random(),
+  'zeros': () => () => 0,
+  'all-max': () => () => 0xffffffff,
+  'alternating-extremes': () => index => (index % 2 === 0 ? 0xffffffff : 0),
+  'few-distinct': random => () => (random() % 4) * 0x40000000,
+  'high-bit': random => () => (0x80000000 | (random() & 0xff)) >>> 0,
+};
+
+interface DifferentialFailure {
+  test: string;
+  size: number | null;
+  distribution: string;
+  mismatch?: ResultMismatch;
+  error?: string;
+}
+
+interface PairOutcome {
+  // False when a side returns nothing to compare
+  compared: boolean;
+  mismatch: ResultMismatch | null;
+}
+
+/**
+ * Run both sides of test on one prepared input
+ */
+function runPair(test: BenchmarkTest, size: number): PairOutcome {
+  const data = test.prepare(size);
+  try {
+    test.tsSetup?.(data);
+    const expected = test.tsFunc(data);
+    test.wasmSetup?.(data);
+    const actual = test.wasmFunc(data);
+    if (!isComparableResult(expected) || !isComparableResult(actual)) {
+      return { compared: false, mismatch: null };
+    }
+    return { compared: true, mismatch: compareResults(expected, actual) };
+  } finally {
+    test.cleanup?.(data);
+  }
+}
+
+async function main(): Promise<number> {
+  const { values } = parseArgs({
+    options: {
+      filter: { type: 'string', short: 'f', multiple: true, default: [] },
+      category: { type: 'string', short: 'c', multiple: true, default: [] },
+      rounds: { type: 'string', short: 'r', default: '4' },
+      'max-size': { type: 'string', default: '20000' },
+      seed: { type: 'string', default: '1' },
+      distribution: { type: 'string', multiple: true, default: [] },
+      help: { type: 'boolean', short: 'h', default: false },
+    },
+  });
+
+  if (values.help) {
+    console.log(USAGE);
+    return EXIT_OK;
+  }
+
+  const rounds = Number(values.rounds);
+  const maxSize = Number(values['max-size']);
+  const seed = Number(values.seed);
+  if (![rounds, maxSize, seed].every(Number.isInteger) || rounds <= 0 || maxSize <= 0) {
+    throw new Error('--rounds, --max-size and --seed expect integers (rounds and max-size positive)');
+  }
+  const distributions = values.distribution.length > 0 ? values.distribution : Object.keys(DISTRIBUTIONS);
+  const unknown = distributions.filter(name => !(name in DISTRIBUTIONS));
+  if (unknown.length > 0) {
+    throw new Error(`Unknown --distribution ${unknown.join(', ')}; expected ${Object.keys(DISTRIBUTIONS).join(', ')}`);
+  }
+
+  const needles = values.filter.map(filter => filter.toLowerCase());
+  const categories = new Set(values.category.map(category => category.toLowerCase()));
+  const tests = benchmarkTests.filter(test =>
+    (needles.length === 0 || needles.some(needle => test.name.toLowerCase().includes(needle))) &&
+    (categories.size === 0 || categories.has(test.category.toLowerCase()))
+  );
+  if (tests.length === 0) {
+    throw new Error('No tests match the given --filter / --category');
+  }
+
+  try {
+    await initWasmModule();
+  } catch (error) {
+    console.error('The WASM module could not be loaded in Node; build it with `pnpm run build:wasm:node`.');
+    throw error;
+  }
+
+  const random = mulberry32(seed);
+  const failures: DifferentialFailure[] = [];
+  let compared = 0;
+  let skipped = 0;
+
+  for (const test of tests) {
+    // Fixed-size suites run once
+    const sizeIndependent = test.sizeIndependent === true;
+    let testFailures = 0;
+    let testCompared = 0;
+
+    for (let round = 0; round < (sizeIndependent ? 1 : rounds); round++) {
+      const size = round % 3 === 0 ? 1 + (random() % SHORT_SIZE) : 1 + (random() % maxSize);
+      for (const distribution of sizeIndependent ? ['default'] : distributions) {
+        setRandomArraySource(DISTRIBUTIONS[distribution](random));
+        try {
+          const outcome = runPair(test, size);
+          if (!outcome.compared) {
+            skipped++;
+            continue;
+          }
+          testCompared++;
+          if (outcome.mismatch) {
+            testFailures++;
+            failures.push({ test: test.name, size: sizeIndependent ? null : size, distribution, mismatch: outcome.mismatch });
+          }
+        } catch (error) {
+          testFailures++;
+          failures.push({ test: test.name, size: sizeIndependent ? null : size, distribution, error: (error as Error).message });
+        } finally {
+          setRandomArraySource(null);
+        }
+      }
+    }
+
+    compared += testCompared;
+    console.log(`${testFailures > 0 ? '❌' : testCompared > 0 ? '✅' : '➖'} ${test.name.padEnd(48)} ${testCompared} compared` +
+      (testFailures > 0 ? `, ${testFailures} mismatched` : ''));
+  }
+
+  if (failures.length > 0) {
+    console.error('');
+    for (const failure of failures) {
+      const where = `${failure.test}${failure.size === null ? '' : ` @ ${failure.size}`} [${failure.distribution}]`;
+      console.error(failure.mismatch
+        ? `❌ ${where}: ${failure.mismatch.path} expected ${failure.mismatch.expected}, got ${failure.mismatch.actual}`
+        : `❌ ${where}: threw ${failure.error}`);
+    }
+    console.error(`\n❌ ${failures.length} mismatch(es) in ${compared} comparisons (seed ${seed})`);
+    return EXIT_MISMATCH;
+  }
+
+  console.log(`\n✅ ${compared} comparisons equal${skipped > 0 ? `, ${skipped} without a comparable result` : ''} (seed ${seed})`);
+  return EXIT_OK;
+}
+
+main().then(
+  code => process.exit(code),
+  error => {
+    console.error(`❌ ${(error as Error).message}`);
+    process.exit(EXIT_ERROR);
+  }
+);
@@ -2,10 +2,18 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
-#include <map>
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <wasm_simd128.h>
+#include <vector>
+#include "thread_pool.h"
+#include "scratch_arena.h"
+#include "kernel_profiler.h"
+#include "tree_parallel.h"
+#include "typed_kernels.h"
+#include "fused_pipeline.h"
 extern "C"
 {
 
@@ -18,6 +26,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint64_t sumArray(const uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         uint64_t sum = 0;
         for (uint32_t i = 0; i < length; i++)
         {
@@ -35,6 +44,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t findMax(const uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         if (length == 0)
             return 0;
         uint32_t max = arr[0];
@@ -58,6 +68,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t findMin(const uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         if (length == 0)
             return 0;
         uint32_t min = arr[0];
@@ -80,6 +91,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     double calculateAverage(const uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         if (length == 0)
             return 0.0;
         uint64_t sum = sumArray(arr, length);
@@ -95,6 +107,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     void multiplyArray(uint32_t *arr, uint32_t length, uint32_t factor)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 8);
         for (uint32_t i = 0; i < length; i++)
         {
             arr[i] *= factor;
@@ -111,6 +124,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t countGreaterThan(const uint32_t *arr, uint32_t length, uint32_t threshold)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         uint32_t count = 0;
         for (uint32_t i = 0; i < length; i++)
         {
@@ -122,71 +136,529 @@ extern "C"
         return count;
     }
 
+    // ========== PERSISTENT BUFFERS ==========
+    // Long-lived, 16-byte aligned heap regions owned by a handle. JS keeps a
+    // typed-array view over `data` and runs kernels on it in place, instead
+    // of malloc + copy-in + copy-out around every call.
+
+    static const uint32_t BUFFER_ALIGNMENT = 16;
+
+    struct BufferHandle
+    {
+        uint8_t *data;
+        uint32_t byteLength;
+        uint32_t capacity;
+    };
+
+    static uint8_t *allocateBufferStorage(uint32_t capacity)
+    {
+        return static_cast<uint8_t *>(std::aligned_alloc(BUFFER_ALIGNMENT, capacity));
+    }
+
+    static uint32_t roundBufferCapacity(uint32_t byteLength)
+    {
+        uint32_t capacity = (byteLength + BUFFER_ALIGNMENT - 1) & ~(BUFFER_ALIGNMENT - 1);
+        return capacity > 0 ? capacity : BUFFER_ALIGNMENT;
+    }
+
+    /**
+     * Create a persistent buffer
+     * @param byteLength Size in bytes (contents are zeroed)
+     * @return Buffer handle, or null if allocation failed
+     */
+    EMSCRIPTEN_KEEPALIVE
+    BufferHandle *createBuffer(uint32_t byteLength)
+    {
+        uint32_t capacity = roundBufferCapacity(byteLength);
+        uint8_t *data = allocateBufferStorage(capacity);
+        if (!data)
+            return nullptr;
+        std::memset(data, 0, capacity);
+
+        BufferHandle *handle = new BufferHandle;
+        handle->data = data;
+        handle->byteLength = byteLength;
+        handle->capacity = capacity;
+        return handle;
+    }
+
+    /**
+     * Resize a buffer, keeping its contents up to the smaller size.
+     * Storage only moves when capacity is exceeded (capacity at least doubles).
+     * @param handle Buffer handle
+     * @param byteLength New size in bytes
+     * @return 1 on success, 0 if allocation failed (buffer left unchanged)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t resizeBuffer(BufferHandle *handle, uint32_t byteLength)
+    {
+        if (byteLength > handle->capacity)
+        {
+            uint32_t doubled = handle->capacity <= UINT32_MAX / 2 ? handle->capacity * 2 : byteLength;
+            uint32_t capacity = roundBufferCapacity(std::max(byteLength, doubled));
+            uint8_t *data = allocateBufferStorage(capacity);
+            if (!data)
+                return 0;
+            std::memcpy(data, handle->data, handle->byteLength);
+            std::memset(data + handle->byteLength, 0, capacity - handle->byteLength);
+            std::free(handle->data);
+            handle->data = data;
+            handle->capacity = capacity;
+        }
+        else if (byteLength > handle->byteLength)
+        {
+            std::memset(handle->data + handle->byteLength, 0, byteLength - handle->byteLength);
+        }
+        handle->byteLength = byteLength;
+        return 1;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    void freeBuffer(BufferHandle *handle)
+    {
+        if (!handle)
+            return;
+        std::free(handle->data);
+        delete handle;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    uint8_t *getBufferData(BufferHandle *handle)
+    {
+        return handle->data;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t getBufferByteLength(BufferHandle *handle)
+    {
+        return handle->byteLength;
+    }
+
+    // ========== SCRATCH MEMORY ==========
+    // Kernel temporaries (traversal stacks, sort buffers, distinct-count
+    // tables) come from per-thread arenas (scratch_arena.h) instead of
+    // new[] / delete[] per call. The counters show whether a benchmark's
+    // steady state still reaches the heap.
+
+    /**
+     * Scratch arena counters, shared with JS as 5 doubles (read via HEAPF64)
+     */
+    struct ScratchStats
+    {
+        // Bytes handed out by the arenas since the last reset
+        double bytesRequested;
+        // Heap bytes the arenas hold right now
+        double bytesReserved;
+        // Heap allocations made by the arenas since the last reset
+        double grows;
+        // Most scratch one thread had in use at once since the last reset
+        double highWater;
+        // WASM linear memory size (0 in native builds)
+        double memoryBytes;
+    };
+
+    /**
+     * Read the scratch counters
+     * @param stats Receives the counters
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void getScratchStats(ScratchStats *stats)
+    {
+        ScratchCounters &counters = ScratchCounters::instance();
+        stats->bytesRequested = static_cast<double>(counters.bytesRequested.load());
+        stats->bytesReserved = static_cast<double>(counters.bytesReserved.load());
+        stats->grows = static_cast<double>(counters.grows.load());
+        stats->highWater = static_cast<double>(counters.highWater.load());
+#ifdef __EMSCRIPTEN__
+        stats->memoryBytes = static_cast<double>(__builtin_wasm_memory_size(0)) * 65536.0;
+#else
+        stats->memoryBytes = 0;
+#endif
+    }
+
+    /**
+     * Zero bytesRequested, grows and highWater (bytesReserved is live state)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void resetScratchStats()
+    {
+        ScratchCounters::instance().reset();
+    }
+
+    /**
+     * Return the calling thread's idle arena to the heap; worker arenas
+     * keep their blocks
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void trimScratch()
+    {
+        ScratchArena::local().trim();
+    }
+
+    // ========== PROFILING ==========
+    // Kernels open a PROFILE_KERNEL scope (kernel_profiler.h). With
+    // profiling on, each outermost call adds to its kernel's counters and
+    // leaves an event in the ring buffer, so JS can separate kernel time
+    // from marshaling.
+
+    /**
+     * The profile buffer (ProfileBuffer layout), valid for the module's
+     * lifetime. This is the single read path for counters and events.
+     */
+    EMSCRIPTEN_KEEPALIVE
+    ProfileBuffer *getProfileBuffer()
+    {
+        return &KernelProfiler::buffer();
+    }
+
+    /**
+     * Turn kernel timing on or off; off costs one load per call
+     * @param enabled Non-zero to record calls
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void setProfilingEnabled(uint32_t enabled)
+    {
+        KernelProfiler::buffer().enabled = enabled != 0;
+    }
+
+    /**
+     * Zero the kernel counters and drop the recorded events
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void resetProfile()
+    {
+        KernelProfiler::reset();
+    }
+
+    /**
+     * Streaming read bandwidth of this build, the ceiling for a kernel's
+     * GB/s. A buffer of byteLength bytes is summed with 128-bit loads.
+     * @param byteLength Bytes read per pass (rounded down to 64)
+     * @param passes Timed passes; the fastest one is reported
+     * @return GB/s (1e9 bytes per second), 0 when nothing could be timed
+     */
+    EMSCRIPTEN_KEEPALIVE
+    double measureReadBandwidth(uint32_t byteLength, uint32_t passes)
+    {
+        uint32_t length = byteLength / 64 * 16;
+        if (length == 0)
+            return 0.0;
+
+        // A one-off calibration: kept off the scratch arenas so their
+        // high-water mark stays that of the kernels
+        std::vector<uint32_t> buffer(length);
+        const uint32_t *data = buffer.data();
+        for (uint32_t i = 0; i < length; i++)
+            buffer[i] = i;
+
+        // Four accumulators keep the adds off the critical path
+        v128_t sum0 = wasm_i32x4_splat(0);
+        v128_t sum1 = sum0;
+        v128_t sum2 = sum0;
+        v128_t sum3 = sum0;
+        double bestMs = 0.0;
+        for (uint32_t pass = 0; pass < passes; pass++)
+        {
+            double start = emscripten_get_now();
+            for (uint32_t i = 0; i < length; i += 16)
+            {
+                sum0 = wasm_i32x4_add(sum0, wasm_v128_load(data + i));
+                sum1 = wasm_i32x4_add(sum1, wasm_v128_load(data + i + 4));
+                sum2 = wasm_i32x4_add(sum2, wasm_v128_load(data + i + 8));
+                sum3 = wasm_i32x4_add(sum3, wasm_v128_load(data + i + 12));
+            }
+            double elapsed = emscripten_get_now() - start;
+            if (elapsed > 0 && (bestMs == 0.0 || elapsed < bestMs))
+                bestMs = elapsed;
+        }
+
+        // Keep the loads alive: a volatile store and its read-back cannot be
+        // dropped, so neither can the sums feeding them
+        uint32_t lanes[4];
+        wasm_v128_store(lanes, wasm_i32x4_add(wasm_i32x4_add(sum0, sum1), wasm_i32x4_add(sum2, sum3)));
+        volatile uint32_t sink = lanes[0] ^ lanes[1] ^ lanes[2] ^ lanes[3];
+        (void)sink;
+
+        if (bestMs == 0.0)
+            return 0.0;
+        return static_cast<double>(length) * 4 / (bestMs * 1e6);
+    }
+
+    // ========== CALL BOUNDARY ==========
+    // Near-empty exports: calling them in a loop measures the fixed cost of
+    // crossing from JS into WASM per signature (no profiling scope, which
+    // would be the larger part of the cost).
+
+    /**
+     * Does nothing
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void boundaryEmpty()
+    {
+    }
+
+    /**
+     * The last element, so the pointer is really dereferenced
+     * @return arr[length - 1], 0 for an empty array
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t boundaryPointerLength(const uint32_t *arr, uint32_t length)
+    {
+        return length == 0 ? 0 : arr[length - 1];
+    }
+
     /**
-     * Helper function for quicksort - partition
+     * A 64-bit result, which reaches JS as a BigInt
+     * @return value in both 32-bit halves
      */
-    int partition(uint32_t *arr, int low, int high)
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t boundaryReturnU64(uint32_t value)
     {
-        uint32_t pivot = arr[high];
-        int i = low - 1;
+        return static_cast<uint64_t>(value) << 32 | value;
+    }
+
+    // ========== SORT ENGINE ==========
+
+    // Below this length insertion sort beats everything else
+    static const uint32_t INSERTION_SORT_MAX_LENGTH = 32;
+
+    // Below this length introsort wins over the four 8-bit radix passes
+    static const uint32_t RADIX_SORT_MIN_LENGTH = 4096;
 
-        for (int j = low; j < high; j++)
+    /**
+     * Helper function for sorting - insertion sort on arr[low..high)
+     */
+    static void insertionSort(uint32_t *arr, uint32_t low, uint32_t high)
+    {
+        for (uint32_t i = low + 1; i < high; i++)
         {
-            if (arr[j] <= pivot)
+            uint32_t value = arr[i];
+            uint32_t j = i;
+            while (j > low && arr[j - 1] > value)
             {
+                arr[j] = arr[j - 1];
+                j--;
+            }
+            arr[j] = value;
+        }
+    }
+
+    /**
+     * Helper function for introsort - median-of-three Hoare partition of arr[low..high)
+     * @return Split point p: arr[low..p) <= pivot <= arr[p..high)
+     */
+    static uint32_t partition(uint32_t *arr, uint32_t low, uint32_t high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        uint32_t last = high - 1;
+        if (arr[mid] < arr[low])
+            std::swap(arr[mid], arr[low]);
+        if (arr[last] < arr[low])
+            std::swap(arr[last], arr[low]);
+        if (arr[last] < arr[mid])
+            std::swap(arr[last], arr[mid]);
+        uint32_t pivot = arr[mid];
+
+        // Equal keys stop both scans, so duplicate-heavy input still splits evenly
+        uint32_t i = low;
+        uint32_t j = last;
+        while (true)
+        {
+            while (arr[i] < pivot)
                 i++;
-                std::swap(arr[i], arr[j]);
+            while (arr[j] > pivot)
+                j--;
+            if (i >= j)
+                return j + 1;
+            std::swap(arr[i], arr[j]);
+            i++;
+            j--;
+        }
+    }
+
+    /**
+     * Introsort (in-place): quicksort with heapsort fallback once recursion
+     * depth exceeds 2*log2(n), insertion sort for short ranges
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     */
+    static void introSort(uint32_t *arr, uint32_t length)
+    {
+        struct Range
+        {
+            uint32_t low;
+            uint32_t high;
+            uint32_t depth;
+        };
+
+        uint32_t depthLimit = 0;
+        for (uint32_t n = length; n > 1; n >>= 1)
+            depthLimit += 2;
+
+        // Larger half is pushed, smaller half is looped on: stack depth <= log2(n)
+        Range stack[64];
+        uint32_t top = 0;
+        stack[top++] = {0, length, depthLimit};
+
+        while (top > 0)
+        {
+            Range range = stack[--top];
+
+            while (range.high - range.low > INSERTION_SORT_MAX_LENGTH)
+            {
+                if (range.depth == 0)
+                {
+                    std::make_heap(arr + range.low, arr + range.high);
+                    std::sort_heap(arr + range.low, arr + range.high);
+                    break;
+                }
+                range.depth--;
+
+                uint32_t split = partition(arr, range.low, range.high);
+                if (split - range.low < range.high - split)
+                {
+                    stack[top++] = {split, range.high, range.depth};
+                    range.high = split;
+                }
+                else
+                {
+                    stack[top++] = {range.low, split, range.depth};
+                    range.low = split;
+                }
             }
+
+            if (range.high - range.low <= INSERTION_SORT_MAX_LENGTH)
+                insertionSort(arr, range.low, range.high);
         }
-        std::swap(arr[i + 1], arr[high]);
-        return i + 1;
     }
 
     /**
-     * Quick sort (in-place) - Iterative version to avoid stack overflow
+     * LSD radix sort (in-place, 8-bit digits, stable)
+     * Uses a module-level scratch buffer that is reused across calls.
+     * Digit passes where every key shares the same byte are skipped, so
+     * narrow value ranges cost fewer than four passes.
      * @param arr Pointer to uint32_t array
      * @param length Array length
      */
     EMSCRIPTEN_KEEPALIVE
-    void quickSort(uint32_t *arr, uint32_t length)
+    void radixSortU32(uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 8);
         if (length <= 1)
             return;
 
-        // Create an auxiliary stack for iterative quicksort
-        int *stack = new int[length];
-        int top = -1;
+        // All four histograms in one read pass
+        uint32_t counts[4][256] = {};
+        for (uint32_t i = 0; i < length; i++)
+        {
+            uint32_t value = arr[i];
+            counts[0][value & 0xFF]++;
+            counts[1][(value >> 8) & 0xFF]++;
+            counts[2][(value >> 16) & 0xFF]++;
+            counts[3][value >> 24]++;
+        }
 
-        // Push initial values of low and high to stack
-        stack[++top] = 0;
-        stack[++top] = length - 1;
+        ScratchScope scratch;
+        uint32_t *src = arr;
+        uint32_t *dst = scratch.allocate<uint32_t>(length);
 
-        // Keep popping from stack while it's not empty
-        while (top >= 0)
+        for (uint32_t pass = 0; pass < 4; pass++)
         {
-            // Pop high and low
-            int high = stack[top--];
-            int low = stack[top--];
+            uint32_t *count = counts[pass];
+            uint32_t shift = pass * 8;
 
-            // Set pivot element at its correct position
-            int pi = partition(arr, low, high);
+            // Every key has the same digit: this pass would be a plain copy
+            if (count[(src[0] >> shift) & 0xFF] == length)
+                continue;
 
-            // If there are elements on left side of pivot, push left side to stack
-            if (pi - 1 > low)
+            uint32_t offset = 0;
+            for (uint32_t digit = 0; digit < 256; digit++)
             {
-                stack[++top] = low;
-                stack[++top] = pi - 1;
+                uint32_t c = count[digit];
+                count[digit] = offset;
+                offset += c;
             }
 
-            // If there are elements on right side of pivot, push right side to stack
-            if (pi + 1 < high)
+            for (uint32_t i = 0; i < length; i++)
             {
-                stack[++top] = pi + 1;
-                stack[++top] = high;
+                uint32_t value = src[i];
+                dst[count[(value >> shift) & 0xFF]++] = value;
             }
+
+            std::swap(src, dst);
+        }
+
+        if (src != arr)
+        {
+            std::copy(src, src + length, arr);
+        }
+    }
+
+    /**
+     * Number of 8-bit radix passes needed: bytes in which at least two keys differ
+     */
+    static uint32_t countRadixPasses(const uint32_t *arr, uint32_t length)
+    {
+        uint32_t anyBits = 0;
+        uint32_t allBits = 0xFFFFFFFFu;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            anyBits |= arr[i];
+            allBits &= arr[i];
+        }
+        uint32_t varying = anyBits ^ allBits;
+
+        uint32_t passes = 0;
+        for (uint32_t shift = 0; shift < 32; shift += 8)
+        {
+            if ((varying >> shift) & 0xFF)
+                passes++;
+        }
+        return passes;
+    }
+
+    /**
+     * Sort (in-place) - picks the algorithm from size and key entropy:
+     * insertion sort for tiny arrays, a linear scan for already sorted
+     * input, LSD radix sort for large arrays or keys with few varying
+     * bytes, introsort otherwise
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void quickSort(uint32_t *arr, uint32_t length)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 8);
+        if (length <= 1)
+            return;
+
+        if (length <= INSERTION_SORT_MAX_LENGTH)
+        {
+            insertionSort(arr, 0, length);
+            return;
+        }
+
+        // Presorted input was the Lomuto worst case; detect it in one pass
+        uint32_t ascending = 1;
+        while (ascending < length && arr[ascending - 1] <= arr[ascending])
+            ascending++;
+        if (ascending == length)
+            return;
+
+        if (length >= RADIX_SORT_MIN_LENGTH)
+        {
+            radixSortU32(arr, length);
+            return;
+        }
+
+        // Mid-sized input: radix only pays off when few digit passes are needed
+        if (countRadixPasses(arr, length) <= 2)
+        {
+            radixSortU32(arr, length);
+            return;
         }
 
-        delete[] stack;
+        introSort(arr, length);
     }
 
     /**
@@ -197,6 +669,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     void reverseArray(uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 8);
         for (uint32_t i = 0; i < length / 2; i++)
         {
             std::swap(arr[i], arr[length - 1 - i]);
@@ -212,6 +685,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     double calculateVariance(const uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         if (length == 0)
             return 0.0;
 
@@ -270,6 +744,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     void addToArray(uint32_t *arr, uint32_t length, uint32_t value)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 8);
         for (uint32_t i = 0; i < length; i++)
         {
             arr[i] += value;
@@ -285,11 +760,13 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t countUnique(uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         if (length == 0)
             return 0;
 
         // Create a copy and sort it
-        uint32_t *temp = new uint32_t[length];
+        ScratchScope scratch;
+        uint32_t *temp = scratch.allocate<uint32_t>(length);
         for (uint32_t i = 0; i < length; i++)
         {
             temp[i] = arr[i];
@@ -306,14 +783,154 @@ extern "C"
             }
         }
 
-        delete[] temp;
         return unique;
     }
 
+    // ========== BATCHED SEARCH ==========
+    // Many lookups against one sorted table per call. Queries advance in
+    // groups that move in lockstep, so the loads of a group overlap instead
+    // of each query waiting on its own cache misses. The descent is
+    // branchless: the compare picks the next base with a conditional move.
+
+    // Queries interleaved per group
+    static const uint32_t SEARCH_BATCH_LANES = 8;
+
+    static inline void prefetchRead(const void *address)
+    {
+        // Lowers to nothing on wasm32; real prefetches in the native build
+        __builtin_prefetch(address, 0, 0);
+    }
+
+    /**
+     * Look up many targets in a sorted array
+     * @param arr Pointer to sorted uint32_t array
+     * @param length Array length
+     * @param targets Values to find
+     * @param count Number of targets
+     * @param out Receives, per target, the index of its first occurrence or -1
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void binarySearchBatch(const uint32_t *arr, uint32_t length, const uint32_t *targets, uint32_t count, int32_t *out)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 8);
+        if (length == 0)
+        {
+            for (uint32_t i = 0; i < count; i++)
+                out[i] = -1;
+            return;
+        }
+
+        for (uint32_t first = 0; first < count; first += SEARCH_BATCH_LANES)
+        {
+            uint32_t lanes = std::min(SEARCH_BATCH_LANES, count - first);
+            const uint32_t *base[SEARCH_BATCH_LANES];
+            for (uint32_t lane = 0; lane < lanes; lane++)
+                base[lane] = arr;
+
+            // Every lane shares the same sequence of interval lengths
+            uint32_t n = length;
+            while (n > 1)
+            {
+                uint32_t half = n / 2;
+                uint32_t nextHalf = (n - half) / 2;
+                for (uint32_t lane = 0; lane < lanes; lane++)
+                {
+                    // Both candidates for the next probe
+                    prefetchRead(base[lane] + nextHalf);
+                    prefetchRead(base[lane] + half + nextHalf);
+                    base[lane] = base[lane][half] < targets[first + lane] ? base[lane] + half : base[lane];
+                }
+                n -= half;
+            }
+
+            for (uint32_t lane = 0; lane < lanes; lane++)
+            {
+                uint32_t target = targets[first + lane];
+                uint32_t index = static_cast<uint32_t>(base[lane] - arr) + (*base[lane] < target);
+                out[first + lane] = (index < length && arr[index] == target) ? static_cast<int32_t>(index) : -1;
+            }
+        }
+    }
+
+    static void eytzingerFill(const uint32_t *sorted, uint32_t length, uint32_t *out, uint32_t &cursor, uint32_t node)
+    {
+        // In-order walk of the implicit tree (node k has children 2k, 2k+1)
+        if (node > length)
+            return;
+        eytzingerFill(sorted, length, out, cursor, node * 2);
+        out[node - 1] = sorted[cursor++];
+        eytzingerFill(sorted, length, out, cursor, node * 2 + 1);
+    }
+
+    /**
+     * Permute an array into Eytzinger (BFS) order: element i's children are
+     * 2i+1 and 2i+2, so the first levels of every search share cache lines.
+     * Any parallel array (values for the keys) can be permuted the same way.
+     * @param sorted Pointer to sorted uint32_t array
+     * @param length Array length
+     * @param out Receives the permuted array (length elements)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void eytzingerLayout(const uint32_t *sorted, uint32_t length, uint32_t *out)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 8);
+        uint32_t cursor = 0;
+        eytzingerFill(sorted, length, out, cursor, 1);
+    }
+
+    /**
+     * Look up many targets in an array produced by eytzingerLayout
+     * @param layout Pointer to Eytzinger-ordered uint32_t array
+     * @param length Array length
+     * @param targets Values to find
+     * @param count Number of targets
+     * @param out Receives, per target, its index in the layout array or -1
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void eytzingerSearchBatch(const uint32_t *layout, uint32_t length, const uint32_t *targets, uint32_t count, int32_t *out)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 8);
+        // Levels every descent is guaranteed to complete (the full part of the tree)
+        uint32_t fullLevels = 0;
+        while ((2u << fullLevels) - 1 <= length && fullLevels < 31)
+            fullLevels++;
+
+        for (uint32_t first = 0; first < count; first += SEARCH_BATCH_LANES)
+        {
+            uint32_t lanes = std::min(SEARCH_BATCH_LANES, count - first);
+            uint32_t node[SEARCH_BATCH_LANES];
+            for (uint32_t lane = 0; lane < lanes; lane++)
+                node[lane] = 1;
+
+            for (uint32_t level = 0; level < fullLevels; level++)
+            {
+                for (uint32_t lane = 0; lane < lanes; lane++)
+                {
+                    // Descendants four levels down sit in one 64-byte line
+                    prefetchRead(layout + 16 * static_cast<size_t>(node[lane]) - 1);
+                    node[lane] = 2 * node[lane] + (layout[node[lane] - 1] < targets[first + lane]);
+                }
+            }
+
+            for (uint32_t lane = 0; lane < lanes; lane++)
+            {
+                uint32_t target = targets[first + lane];
+                uint64_t k = node[lane];
+                if (k <= length)
+                    k = 2 * k + (layout[k - 1] < target);
+                // Undo the trailing right turns to reach the lower_bound node
+                k >>= __builtin_ctzll(~k) + 1;
+                out[first + lane] = (k != 0 && layout[k - 1] == target) ? static_cast<int32_t>(k - 1) : -1;
+            }
+        }
+    }
+
     // ========== SIMD OPTIMIZED VERSIONS ==========
 
     /**
-     * SIMD Sum all elements using SIMD (processes 4 elements at once)
+     * SIMD Sum all elements using SIMD (processes 8 elements at once)
+     * Lanes are widened to u64 before they are added, so the sum is exact
+     * for any length, like the scalar sumArray
      * @param arr Pointer to uint32_t array
      * @param length Array length
      * @return Sum of all elements
@@ -321,26 +938,36 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint64_t sumArraySIMD(const uint32_t *arr, uint32_t length)
     {
-        uint64_t sum = 0;
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         uint32_t i = 0;
 
-        // Process 4 elements at a time with SIMD
-        v128_t sum_vec = wasm_i32x4_splat(0);
-
-        for (; i + 4 <= length; i += 4)
+        // Two vectors per step, four u64x2 accumulators to hide the add latency
+        v128_t sum0 = wasm_i64x2_splat(0);
+        v128_t sum1 = sum0;
+        v128_t sum2 = sum0;
+        v128_t sum3 = sum0;
+        for (; i + 8 <= length; i += 8)
         {
-            v128_t data = wasm_v128_load(&arr[i]);
-            sum_vec = wasm_i32x4_add(sum_vec, data);
+            v128_t data0 = wasm_v128_load(&arr[i]);
+            v128_t data1 = wasm_v128_load(&arr[i + 4]);
+            sum0 = wasm_i64x2_add(sum0, wasm_u64x2_extend_low_u32x4(data0));
+            sum1 = wasm_i64x2_add(sum1, wasm_u64x2_extend_high_u32x4(data0));
+            sum2 = wasm_i64x2_add(sum2, wasm_u64x2_extend_low_u32x4(data1));
+            sum3 = wasm_i64x2_add(sum3, wasm_u64x2_extend_high_u32x4(data1));
         }
-
-        // Extract and sum the 4 lanes
-        uint32_t lanes[4];
-        wasm_v128_store(lanes, sum_vec);
-        for (int j = 0; j < 4; j++)
+        if (i + 4 <= length)
         {
-            sum += lanes[j];
+            v128_t data = wasm_v128_load(&arr[i]);
+            sum0 = wasm_i64x2_add(sum0, wasm_u64x2_extend_low_u32x4(data));
+            sum1 = wasm_i64x2_add(sum1, wasm_u64x2_extend_high_u32x4(data));
+            i += 4;
         }
 
+        // Extract and sum the 2 lanes
+        uint64_t lanes[2];
+        wasm_v128_store(lanes, wasm_i64x2_add(wasm_i64x2_add(sum0, sum1), wasm_i64x2_add(sum2, sum3)));
+        uint64_t sum = lanes[0] + lanes[1];
+
         // Handle remaining elements
         for (; i < length; i++)
         {
@@ -359,6 +986,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t findMaxSIMD(const uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         if (length == 0)
             return 0;
 
@@ -408,6 +1036,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t findMinSIMD(const uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         if (length == 0)
             return 0;
 
@@ -457,6 +1086,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     void multiplyArraySIMD(uint32_t *arr, uint32_t length, uint32_t factor)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 8);
         uint32_t i = 0;
 
         // Create a vector with factor repeated 4 times
@@ -486,6 +1116,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     void addToArraySIMD(uint32_t *arr, uint32_t length, uint32_t value)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 8);
         uint32_t i = 0;
 
         // Create a vector with value repeated 4 times
@@ -515,6 +1146,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     double calculateAverageSIMD(const uint32_t *arr, uint32_t length)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         if (length == 0)
             return 0.0;
         uint64_t sum = sumArraySIMD(arr, length);
@@ -531,6 +1163,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t countGreaterThanSIMD(const uint32_t *arr, uint32_t length, uint32_t threshold)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
         uint32_t count = 0;
         uint32_t i = 0;
 
@@ -576,6 +1209,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     void transformVectors(float *vectors, const float *matrix, uint32_t count)
     {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 24);
         for (uint32_t i = 0; i < count; i++)
         {
             float x = vectors[i * 3 + 0];
@@ -590,103 +1224,81 @@ extern "C"
     }
 
     /**
-     * SIMD SIMD optimized transformation
-     * Process 4 vectors at once using SIMD
+     * Transpose 4 interleaved points [x0 y0 z0 x1][y1 z1 x2 y2][z2 x3 y3 z3]
+     * into one register per component
      */
-    EMSCRIPTEN_KEEPALIVE
-    void transformVectorsSIMD(float *vectors, const float *matrix, uint32_t count)
+    static inline void transposeXyz4ToSoa(v128_t a, v128_t b, v128_t c, v128_t &x, v128_t &y, v128_t &z)
+    {
+        x = wasm_i32x4_shuffle(wasm_i32x4_shuffle(a, b, 0, 3, 6, 0), c, 0, 1, 2, 5);
+        y = wasm_i32x4_shuffle(wasm_i32x4_shuffle(a, b, 1, 4, 7, 0), c, 0, 1, 2, 6);
+        z = wasm_i32x4_shuffle(wasm_i32x4_shuffle(a, b, 2, 5, 0, 0), c, 0, 1, 4, 7);
+    }
+
+    /**
+     * Inverse of transposeXyz4ToSoa
+     */
+    static inline void transposeSoaToXyz4(v128_t x, v128_t y, v128_t z, v128_t &a, v128_t &b, v128_t &c)
+    {
+        a = wasm_i32x4_shuffle(wasm_i32x4_shuffle(x, y, 0, 4, 0, 1), z, 0, 1, 4, 3);
+        b = wasm_i32x4_shuffle(wasm_i32x4_shuffle(y, z, 1, 5, 0, 2), x, 0, 1, 6, 3);
+        c = wasm_i32x4_shuffle(z, wasm_i32x4_shuffle(x, y, 3, 7, 0, 0), 2, 4, 5, 3);
+    }
+
+    /**
+     * Column-major 4x4 matrix with every element splatted across a register
+     */
+    struct SplatMatrix4
     {
-        // Extract matrix elements for SIMD operations
-        v128_t m00 = wasm_f32x4_splat(matrix[0]);
-        v128_t m10 = wasm_f32x4_splat(matrix[1]);
-        v128_t m20 = wasm_f32x4_splat(matrix[2]);
+        v128_t m[16];
 
-        v128_t m01 = wasm_f32x4_splat(matrix[4]);
-        v128_t m11 = wasm_f32x4_splat(matrix[5]);
-        v128_t m21 = wasm_f32x4_splat(matrix[6]);
+        explicit SplatMatrix4(const float *matrix)
+        {
+            for (int i = 0; i < 16; i++)
+                m[i] = wasm_f32x4_splat(matrix[i]);
+        }
+
+        // Output row `row` for 4 points (w = 1)
+        v128_t affine(int row, v128_t x, v128_t y, v128_t z) const
+        {
+            return wasm_f32x4_add(
+                wasm_f32x4_add(wasm_f32x4_mul(x, m[row]), wasm_f32x4_mul(y, m[4 + row])),
+                wasm_f32x4_add(wasm_f32x4_mul(z, m[8 + row]), m[12 + row]));
+        }
 
-        v128_t m02 = wasm_f32x4_splat(matrix[8]);
-        v128_t m12 = wasm_f32x4_splat(matrix[9]);
-        v128_t m22 = wasm_f32x4_splat(matrix[10]);
+        // Output row `row` for 4 points with explicit w
+        v128_t full(int row, v128_t x, v128_t y, v128_t z, v128_t w) const
+        {
+            return wasm_f32x4_add(
+                wasm_f32x4_add(wasm_f32x4_mul(x, m[row]), wasm_f32x4_mul(y, m[4 + row])),
+                wasm_f32x4_add(wasm_f32x4_mul(z, m[8 + row]), wasm_f32x4_mul(w, m[12 + row])));
+        }
+    };
 
-        v128_t m03 = wasm_f32x4_splat(matrix[12]);
-        v128_t m13 = wasm_f32x4_splat(matrix[13]);
-        v128_t m23 = wasm_f32x4_splat(matrix[14]);
+    /**
+     * SIMD SIMD optimized transformation
+     * Process 4 vectors at once using SIMD: three 128-bit loads cover 4
+     * interleaved points, shuffles transpose them in registers
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void transformVectorsSIMD(float *vectors, const float *matrix, uint32_t count)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 24);
+        SplatMatrix4 m(matrix);
 
         uint32_t i = 0;
 
-        // Process 4 vectors at a time
+        // Process 4 vectors (12 floats) at a time
         for (; i + 4 <= count; i += 4)
         {
-            // Extract x, y, z components for 4 vectors
-            float xs[4] = {
-                vectors[i * 3 + 0],
-                vectors[(i + 1) * 3 + 0],
-                vectors[(i + 2) * 3 + 0],
-                vectors[(i + 3) * 3 + 0]};
-            float ys[4] = {
-                vectors[i * 3 + 1],
-                vectors[(i + 1) * 3 + 1],
-                vectors[(i + 2) * 3 + 1],
-                vectors[(i + 3) * 3 + 1]};
-            float zs[4] = {
-                vectors[i * 3 + 2],
-                vectors[(i + 1) * 3 + 2],
-                vectors[(i + 2) * 3 + 2],
-                vectors[(i + 3) * 3 + 2]};
-
-            v128_t x = wasm_v128_load(xs);
-            v128_t y = wasm_v128_load(ys);
-            v128_t z = wasm_v128_load(zs);
-
-            // Calculate new x: m00*x + m01*y + m02*z + m03
-            v128_t nx = wasm_f32x4_add(
-                wasm_f32x4_add(
-                    wasm_f32x4_mul(x, m00),
-                    wasm_f32x4_mul(y, m01)),
-                wasm_f32x4_add(
-                    wasm_f32x4_mul(z, m02),
-                    m03));
-
-            // Calculate new y: m10*x + m11*y + m12*z + m13
-            v128_t ny = wasm_f32x4_add(
-                wasm_f32x4_add(
-                    wasm_f32x4_mul(x, m10),
-                    wasm_f32x4_mul(y, m11)),
-                wasm_f32x4_add(
-                    wasm_f32x4_mul(z, m12),
-                    m13));
-
-            // Calculate new z: m20*x + m21*y + m22*z + m23
-            v128_t nz = wasm_f32x4_add(
-                wasm_f32x4_add(
-                    wasm_f32x4_mul(x, m20),
-                    wasm_f32x4_mul(y, m21)),
-                wasm_f32x4_add(
-                    wasm_f32x4_mul(z, m22),
-                    m23));
-
-            // Store results back
-            float nxs[4], nys[4], nzs[4];
-            wasm_v128_store(nxs, nx);
-            wasm_v128_store(nys, ny);
-            wasm_v128_store(nzs, nz);
-
-            vectors[i * 3 + 0] = nxs[0];
-            vectors[i * 3 + 1] = nys[0];
-            vectors[i * 3 + 2] = nzs[0];
-
-            vectors[(i + 1) * 3 + 0] = nxs[1];
-            vectors[(i + 1) * 3 + 1] = nys[1];
-            vectors[(i + 1) * 3 + 2] = nzs[1];
-
-            vectors[(i + 2) * 3 + 0] = nxs[2];
-            vectors[(i + 2) * 3 + 1] = nys[2];
-            vectors[(i + 2) * 3 + 2] = nzs[2];
-
-            vectors[(i + 3) * 3 + 0] = nxs[3];
-            vectors[(i + 3) * 3 + 1] = nys[3];
-            vectors[(i + 3) * 3 + 2] = nzs[3];
+            float *block = vectors + static_cast<size_t>(i) * 3;
+            v128_t x, y, z;
+            transposeXyz4ToSoa(wasm_v128_load(block), wasm_v128_load(block + 4), wasm_v128_load(block + 8), x, y, z);
+
+            v128_t a, b, c;
+            transposeSoaToXyz4(m.affine(0, x, y, z), m.affine(1, x, y, z), m.affine(2, x, y, z), a, b, c);
+            wasm_v128_store(block, a);
+            wasm_v128_store(block + 4, b);
+            wasm_v128_store(block + 8, c);
         }
 
         // Handle remaining vectors
@@ -750,136 +1362,2718 @@ extern "C"
         matrix[15] = 1.0f;
     }
 
-    EMSCRIPTEN_KEEPALIVE
-    uint64_t sumBinaryTreeDfs(const uint32_t *values, uint32_t nodeCount)
+    // ========== TYPED KERNELS ==========
+    // Shims over typed_kernels.h, one set per element type (suffixes I8,
+    // I16, I32, U32, U64, F32, F64): sumArrayI8, findMinI8, findMaxI8,
+    // addToArrayI8, multiplyArrayI8, ... Results and operands cross the
+    // boundary as doubles, exact up to 2^53 for the 64-bit types.
+
+#define TYPED_KERNEL_EXPORTS(T, Suffix)                                                                    \
+    EMSCRIPTEN_KEEPALIVE                                                                                   \
+    double sumArray##Suffix(const T *arr, uint32_t length)                                                 \
+    {                                                                                                      \
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * sizeof(T));                                         \
+        return static_cast<double>(typed_kernels::reduce<T, typed_kernels::Sum>(arr, length));             \
+    }                                                                                                      \
+                                                                                                           \
+    EMSCRIPTEN_KEEPALIVE                                                                                   \
+    double findMin##Suffix(const T *arr, uint32_t length)                                                  \
+    {                                                                                                      \
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * sizeof(T));                                         \
+        if (length == 0)                                                                                   \
+            return 0.0;                                                                                    \
+        return static_cast<double>(typed_kernels::reduce<T, typed_kernels::Min>(arr, length));             \
+    }                                                                                                      \
+                                                                                                           \
+    EMSCRIPTEN_KEEPALIVE                                                                                   \
+    double findMax##Suffix(const T *arr, uint32_t length)                                                  \
+    {                                                                                                      \
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * sizeof(T));                                         \
+        if (length == 0)                                                                                   \
+            return 0.0;                                                                                    \
+        return static_cast<double>(typed_kernels::reduce<T, typed_kernels::Max>(arr, length));             \
+    }                                                                                                      \
+                                                                                                           \
+    EMSCRIPTEN_KEEPALIVE                                                                                   \
+    void addToArray##Suffix(T *arr, uint32_t length, double value)                                         \
+    {                                                                                                      \
+        PROFILE_KERNEL(2 * static_cast<uint64_t>(length) * sizeof(T));                                     \
+        typed_kernels::map<T, typed_kernels::Add>(arr, length, typed_kernels::fromDouble<T>(value));       \
+    }                                                                                                      \
+                                                                                                           \
+    EMSCRIPTEN_KEEPALIVE                                                                                   \
+    void multiplyArray##Suffix(T *arr, uint32_t length, double factor)                                     \
+    {                                                                                                      \
+        PROFILE_KERNEL(2 * static_cast<uint64_t>(length) * sizeof(T));                                     \
+        typed_kernels::map<T, typed_kernels::Multiply>(arr, length, typed_kernels::fromDouble<T>(factor)); \
+    }
+
+    TYPED_KERNEL_EXPORTS(int8_t, I8)
+    TYPED_KERNEL_EXPORTS(int16_t, I16)
+    TYPED_KERNEL_EXPORTS(int32_t, I32)
+    TYPED_KERNEL_EXPORTS(uint32_t, U32)
+    TYPED_KERNEL_EXPORTS(uint64_t, U64)
+    TYPED_KERNEL_EXPORTS(float, F32)
+    TYPED_KERNEL_EXPORTS(double, F64)
+
+#undef TYPED_KERNEL_EXPORTS
+
+    // ========== FILTER ENGINE ==========
+    // Predicates over uint32 / float columns write selection bitmaps: bit
+    // i % 32 of word i / 32 is row i, (length + 31) / 32 words per bitmap,
+    // bits past the last row always clear. Bitmaps combine with AND / OR /
+    // NOT, and compaction turns one into a selection vector (row indices) or
+    // a gathered copy of the matching values. Every kernel returns the
+    // number of selected rows so JS can size the compaction output.
+
+    enum FilterOp
     {
-        if (nodeCount == 0)
-            return 0;
+        FILTER_GREATER = 0,
+        FILTER_LESS = 1,
+        FILTER_EQUAL = 2,
+        // low <= value <= high
+        FILTER_BETWEEN = 3
+    };
 
-        uint64_t sum = 0;
-        uint32_t *stack = new uint32_t[nodeCount];
-        uint32_t stackSize = 0;
-        stack[stackSize++] = 0;
+    static inline uint32_t bitmapWordCount(uint32_t length)
+    {
+        return length / 32 + (length % 32 != 0 ? 1 : 0);
+    }
 
-        while (stackSize > 0)
+    // Valid bits of the last word (all ones when length is a multiple of 32)
+    static inline uint32_t bitmapTailMask(uint32_t length)
+    {
+        return length % 32 == 0 ? 0xFFFFFFFFu : (1u << (length % 32)) - 1;
+    }
+
+    static inline uint32_t popcountLanes(v128_t words)
+    {
+        uint64_t halves[2];
+        wasm_v128_store(halves, words);
+        return static_cast<uint32_t>(__builtin_popcountll(halves[0]) + __builtin_popcountll(halves[1]));
+    }
+
+    /**
+     * Rows where a uint32 column compares true
+     * @param column Pointer to uint32_t column
+     * @param length Row count
+     * @param op FilterOp
+     * @param value Comparison value (lower bound for BETWEEN)
+     * @param high Upper bound for BETWEEN (inclusive), ignored otherwise
+     * @param bitmap Receives the selection bitmap
+     * @return Number of selected rows (0 and an empty bitmap for an unknown op)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t filterU32(const uint32_t *column, uint32_t length, uint32_t op, uint32_t value, uint32_t high, uint32_t *bitmap)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4 + (static_cast<uint64_t>(length) + 31) / 32 * 4);
+        using namespace typed_kernels;
+        switch (op)
         {
-            uint32_t nodeIndex = stack[--stackSize];
-            sum += values[nodeIndex];
+        case FILTER_GREATER:
+            return compareToBitmap(column, length, GreaterThan<uint32_t>(value), bitmap);
+        case FILTER_LESS:
+            return compareToBitmap(column, length, LessThan<uint32_t>(value), bitmap);
+        case FILTER_EQUAL:
+            return compareToBitmap(column, length, EqualTo<uint32_t>(value), bitmap);
+        case FILTER_BETWEEN:
+            return compareToBitmap(column, length, Between<uint32_t>(value, high), bitmap);
+        }
+        std::fill(bitmap, bitmap + bitmapWordCount(length), 0u);
+        return 0;
+    }
 
-            uint64_t rightChild = static_cast<uint64_t>(nodeIndex) * 2 + 2;
-            uint64_t leftChild = static_cast<uint64_t>(nodeIndex) * 2 + 1;
+    /**
+     * Rows where a float column compares true; NaN rows never match
+     * @param column Pointer to float column
+     * @param length Row count
+     * @param op FilterOp
+     * @param value Comparison value (lower bound for BETWEEN)
+     * @param high Upper bound for BETWEEN (inclusive), ignored otherwise
+     * @param bitmap Receives the selection bitmap
+     * @return Number of selected rows (0 and an empty bitmap for an unknown op)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t filterF32(const float *column, uint32_t length, uint32_t op, float value, float high, uint32_t *bitmap)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4 + (static_cast<uint64_t>(length) + 31) / 32 * 4);
+        using namespace typed_kernels;
+        switch (op)
+        {
+        case FILTER_GREATER:
+            return compareToBitmap(column, length, GreaterThan<float>(value), bitmap);
+        case FILTER_LESS:
+            return compareToBitmap(column, length, LessThan<float>(value), bitmap);
+        case FILTER_EQUAL:
+            return compareToBitmap(column, length, EqualTo<float>(value), bitmap);
+        case FILTER_BETWEEN:
+            return compareToBitmap(column, length, Between<float>(value, high), bitmap);
+        }
+        std::fill(bitmap, bitmap + bitmapWordCount(length), 0u);
+        return 0;
+    }
 
-            if (rightChild < nodeCount)
-            {
-                stack[stackSize++] = static_cast<uint32_t>(rightChild);
-            }
-            if (leftChild < nodeCount)
-            {
-                stack[stackSize++] = static_cast<uint32_t>(leftChild);
-            }
+    /**
+     * Rows whose value is one of `values` (SQL IN). Up to 16 values are
+     * matched with lane compares; larger sets are sorted and searched.
+     * @param column Pointer to uint32_t column
+     * @param length Row count
+     * @param values Set members (any order, duplicates allowed)
+     * @param valueCount Number of set members
+     * @param bitmap Receives the selection bitmap
+     * @return Number of selected rows
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t filterInU32(const uint32_t *column, uint32_t length, const uint32_t *values, uint32_t valueCount, uint32_t *bitmap)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4 + (static_cast<uint64_t>(length) + 31) / 32 * 4);
+        using namespace typed_kernels;
+        if (valueCount <= IN_SET_VECTOR_MAX)
+            return compareToBitmap(column, length, InSmallSet<uint32_t>(values, valueCount), bitmap);
+
+        std::vector<uint32_t> sorted(values, values + valueCount);
+        std::sort(sorted.begin(), sorted.end());
+        return compareToBitmap(column, length, InSortedSet<uint32_t>(sorted.data(), valueCount), bitmap);
+    }
+
+    /**
+     * filterInU32 for float columns; NaN members never match
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t filterInF32(const float *column, uint32_t length, const float *values, uint32_t valueCount, uint32_t *bitmap)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4 + (static_cast<uint64_t>(length) + 31) / 32 * 4);
+        using namespace typed_kernels;
+        if (valueCount <= IN_SET_VECTOR_MAX)
+            return compareToBitmap(column, length, InSmallSet<float>(values, valueCount), bitmap);
+
+        // NaN has no place in a sorted order
+        std::vector<float> sorted;
+        sorted.reserve(valueCount);
+        for (uint32_t i = 0; i < valueCount; i++)
+        {
+            if (values[i] == values[i])
+                sorted.push_back(values[i]);
         }
+        std::sort(sorted.begin(), sorted.end());
+        return compareToBitmap(column, length, InSortedSet<float>(sorted.data(), static_cast<uint32_t>(sorted.size())), bitmap);
+    }
 
-        delete[] stack;
-        return sum;
+    /**
+     * out = a AND b (out may alias either input)
+     * @param length Row count
+     * @return Number of selected rows
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t bitmapAnd(const uint32_t *a, const uint32_t *b, uint32_t *out, uint32_t length)
+    {
+        PROFILE_KERNEL((static_cast<uint64_t>(length) + 31) / 32 * 4 * 3);
+        uint32_t words = bitmapWordCount(length);
+        uint32_t count = 0;
+        uint32_t w = 0;
+        for (; w + 4 <= words; w += 4)
+        {
+            v128_t result = wasm_v128_and(wasm_v128_load(a + w), wasm_v128_load(b + w));
+            wasm_v128_store(out + w, result);
+            count += popcountLanes(result);
+        }
+        for (; w < words; w++)
+        {
+            out[w] = a[w] & b[w];
+            count += static_cast<uint32_t>(__builtin_popcount(out[w]));
+        }
+        return count;
     }
 
+    /**
+     * out = a OR b (out may alias either input)
+     * @param length Row count
+     * @return Number of selected rows
+     */
     EMSCRIPTEN_KEEPALIVE
-    uint64_t sumBinaryTreeBfs(const uint32_t *values, uint32_t nodeCount)
+    uint32_t bitmapOr(const uint32_t *a, const uint32_t *b, uint32_t *out, uint32_t length)
     {
-        if (nodeCount == 0)
+        PROFILE_KERNEL((static_cast<uint64_t>(length) + 31) / 32 * 4 * 3);
+        uint32_t words = bitmapWordCount(length);
+        uint32_t count = 0;
+        uint32_t w = 0;
+        for (; w + 4 <= words; w += 4)
+        {
+            v128_t result = wasm_v128_or(wasm_v128_load(a + w), wasm_v128_load(b + w));
+            wasm_v128_store(out + w, result);
+            count += popcountLanes(result);
+        }
+        for (; w < words; w++)
+        {
+            out[w] = a[w] | b[w];
+            count += static_cast<uint32_t>(__builtin_popcount(out[w]));
+        }
+        return count;
+    }
+
+    /**
+     * out = NOT a, keeping the bits past the last row clear
+     * @param length Row count
+     * @return Number of selected rows
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t bitmapNot(const uint32_t *a, uint32_t *out, uint32_t length)
+    {
+        PROFILE_KERNEL((static_cast<uint64_t>(length) + 31) / 32 * 4 * 2);
+        uint32_t words = bitmapWordCount(length);
+        if (words == 0)
             return 0;
+        uint32_t count = 0;
+        uint32_t w = 0;
+        for (; w + 4 <= words; w += 4)
+            wasm_v128_store(out + w, wasm_v128_not(wasm_v128_load(a + w)));
+        for (; w < words; w++)
+            out[w] = ~a[w];
+        out[words - 1] &= bitmapTailMask(length);
+        for (w = 0; w < words; w++)
+            count += static_cast<uint32_t>(__builtin_popcount(out[w]));
+        return count;
+    }
 
-        uint64_t sum = 0;
-        uint32_t *queue = new uint32_t[nodeCount];
-        uint32_t head = 0;
-        uint32_t tail = 0;
-        queue[tail++] = 0;
+    /**
+     * Number of selected rows in a bitmap
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t bitmapCount(const uint32_t *bitmap, uint32_t length)
+    {
+        PROFILE_KERNEL((static_cast<uint64_t>(length) + 31) / 32 * 4);
+        uint32_t words = bitmapWordCount(length);
+        uint32_t count = 0;
+        for (uint32_t w = 0; w < words; w++)
+        {
+            uint32_t bits = w + 1 == words ? bitmap[w] & bitmapTailMask(length) : bitmap[w];
+            count += static_cast<uint32_t>(__builtin_popcount(bits));
+        }
+        return count;
+    }
 
-        while (head < tail)
+    // Byte shuffles that pack the 32-bit lanes selected by a 4-bit mask to
+    // the front of a vector (unused lanes get index 0x80, i.e. zero), plus
+    // the number of lanes each mask keeps
+    struct CompactShuffleTable
+    {
+        uint8_t bytes[16][16];
+        uint8_t counts[16];
+
+        CompactShuffleTable()
         {
-            uint32_t nodeIndex = queue[head++];
-            sum += values[nodeIndex];
+            for (uint32_t mask = 0; mask < 16; mask++)
+            {
+                uint32_t slot = 0;
+                for (uint32_t lane = 0; lane < 4; lane++)
+                {
+                    if (mask & (1u << lane))
+                    {
+                        for (uint32_t b = 0; b < 4; b++)
+                            bytes[mask][slot * 4 + b] = static_cast<uint8_t>(lane * 4 + b);
+                        slot++;
+                    }
+                }
+                counts[mask] = static_cast<uint8_t>(slot);
+                for (; slot < 4; slot++)
+                {
+                    for (uint32_t b = 0; b < 4; b++)
+                        bytes[mask][slot * 4 + b] = 0x80;
+                }
+            }
+        }
+    };
 
-            uint64_t leftChild = static_cast<uint64_t>(nodeIndex) * 2 + 1;
-            uint64_t rightChild = static_cast<uint64_t>(nodeIndex) * 2 + 2;
+    static const CompactShuffleTable COMPACT_SHUFFLES;
+    static const uint32_t COMPACT_LANE_INDICES[4] = {0, 1, 2, 3};
 
-            if (leftChild < nodeCount)
+    /**
+     * Write the selected rows of a bitmap, 4 rows per step: the row nibble
+     * picks a shuffle that packs the selected lanes, the store always writes
+     * a full vector and the output advances by the nibble's lane count.
+     * Words with 32 rows and 32 free slots run all 8 steps without branches;
+     * the last word and the capacity boundary go row by row.
+     * @param column 32-bit column to gather from, or null for row indices
+     * @return Rows written (at most capacity)
+     */
+    static uint32_t compactBitmap(const uint32_t *column, const uint32_t *bitmap, uint32_t length, uint32_t *out, uint32_t capacity)
+    {
+        const uint32_t words = bitmapWordCount(length);
+        const v128_t laneIndices = wasm_v128_load(COMPACT_LANE_INDICES);
+        uint32_t written = 0;
+
+        for (uint32_t w = 0; w < words && written < capacity; w++)
+        {
+            const uint32_t base = w * 32;
+            uint32_t bits = w + 1 == words ? bitmap[w] & bitmapTailMask(length) : bitmap[w];
+            if (bits == 0)
+                continue;
+
+            if (length - base >= 32 && capacity - written >= 32)
             {
-                queue[tail++] = static_cast<uint32_t>(leftChild);
+                for (uint32_t k = 0; k < 8; k++)
+                {
+                    const uint32_t nibble = (bits >> (k * 4)) & 15;
+                    const uint32_t row = base + k * 4;
+                    v128_t lanes = column ? wasm_v128_load(column + row)
+                                          : wasm_i32x4_add(wasm_i32x4_splat(static_cast<int32_t>(row)), laneIndices);
+                    v128_t shuffle = wasm_v128_load(COMPACT_SHUFFLES.bytes[nibble]);
+                    wasm_v128_store(out + written, wasm_i8x16_swizzle(lanes, shuffle));
+                    written += COMPACT_SHUFFLES.counts[nibble];
+                }
+                continue;
             }
-            if (rightChild < nodeCount)
+
+            for (uint32_t row = base; bits != 0 && written < capacity; row++, bits >>= 1)
             {
-                queue[tail++] = static_cast<uint32_t>(rightChild);
+                if (bits & 1)
+                    out[written++] = column ? column[row] : row;
             }
         }
+        return written;
+    }
 
-        delete[] queue;
-        return sum;
+    /**
+     * Selection vector: the indices of the selected rows, ascending
+     * @param bitmap Selection bitmap
+     * @param length Row count
+     * @param out Receives up to capacity row indices
+     * @param capacity Size of out (the bitmap's count fits exactly)
+     * @return Indices written
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t bitmapToSelection(const uint32_t *bitmap, uint32_t length, uint32_t *out, uint32_t capacity)
+    {
+        PROFILE_KERNEL((static_cast<uint64_t>(length) + 31) / 32 * 4);
+        return compactBitmap(nullptr, bitmap, length, out, capacity);
     }
 
+    /**
+     * Gather the selected rows of a 32-bit column (uint32 or float, copied
+     * by bit pattern) into a dense array
+     * @param column Column the bitmap was built over
+     * @param bitmap Selection bitmap
+     * @param length Row count
+     * @param out Receives up to capacity values
+     * @param capacity Size of out (the bitmap's count fits exactly)
+     * @return Values written
+     */
     EMSCRIPTEN_KEEPALIVE
-    uint64_t sumNaryTreeDfs(
-        const uint32_t *values,
-        const uint32_t *childOffsets,
-        const uint32_t *children,
-        uint32_t nodeCount)
+    uint32_t gatherSelected(const uint32_t *column, const uint32_t *bitmap, uint32_t length, uint32_t *out, uint32_t capacity)
     {
-        if (nodeCount == 0)
-            return 0;
+        PROFILE_KERNEL((static_cast<uint64_t>(length) + 31) / 32 * 4 + static_cast<uint64_t>(length) * 4);
+        return compactBitmap(column, bitmap, length, out, capacity);
+    }
 
-        uint64_t sum = 0;
-        uint32_t *stack = new uint32_t[nodeCount];
-        uint32_t stackSize = 0;
-        stack[stackSize++] = 0;
+    // ========== FUSED STATISTICS ==========
+    // sum/min/max/mean/variance (and optionally a histogram) for one memory
+    // pass instead of five separate kernels. Input is consumed in L1-sized
+    // blocks: the first sweep of a block takes the exact sum and min/max,
+    // the second re-reads it from cache for the squared deviations around the
+    // block mean. Blocks, streamed calls, chunks and threads are combined
+    // with Chan's pairwise update, so the variance does not suffer the
+    // cancellation of the sum-of-squares formula.
 
-        while (stackSize > 0)
-        {
-            uint32_t nodeIndex = stack[--stackSize];
-            sum += values[nodeIndex];
+    /**
+     * Running statistics, shared with JS as 7 doubles (read via HEAPF64).
+     * Every field is 0 while count is 0.
+     */
+    struct ArrayStats
+    {
+        double count;
+        double sum;
+        double min;
+        double max;
+        double mean;
+        // Sum of squared deviations from the mean
+        double m2;
+        // Population variance (m2 / count), as calculateVariance
+        double variance;
+    };
 
-            uint32_t start = childOffsets[nodeIndex];
-            uint32_t end = childOffsets[nodeIndex + 1];
-            for (uint32_t childCursor = end; childCursor > start; childCursor--)
-            {
-                stack[stackSize++] = children[childCursor - 1];
-            }
-        }
+    // 16 KB of input, so the second sweep of a block hits L1
+    static const uint32_t STATS_BLOCK_LENGTH = 4096;
 
-        delete[] stack;
-        return sum;
+    /**
+     * Pairwise (Chan et al.) merge of a partial result into `into`
+     */
+    static void mergeStatsPartial(ArrayStats *into, double count, double sum, double min, double max, double mean, double m2)
+    {
+        if (count == 0)
+            return;
+
+        if (into->count == 0)
+        {
+            into->count = count;
+            into->sum = sum;
+            into->min = min;
+            into->max = max;
+            into->mean = mean;
+            into->m2 = m2;
+        }
+        else
+        {
+            double total = into->count + count;
+            double delta = mean - into->mean;
+            into->m2 += m2 + delta * delta * (into->count * count / total);
+            into->count = total;
+            into->sum += sum;
+            into->min = std::min(into->min, min);
+            into->max = std::max(into->max, max);
+            // sum is exact below 2^53, so this beats the running update
+            into->mean = into->sum / total;
+        }
+        into->variance = into->m2 / into->count;
     }
 
-    EMSCRIPTEN_KEEPALIVE
-    uint64_t sumNaryTreeBfs(
-        const uint32_t *values,
-        const uint32_t *childOffsets,
-        const uint32_t *children,
-        uint32_t nodeCount)
+    /**
+     * Add one cache-resident block (length > 0) to the running statistics
+     */
+    static void accumulateStatsBlock(ArrayStats *stats, const uint32_t *block, uint32_t length)
     {
-        if (nodeCount == 0)
-            return 0;
+        // Sweep 1: exact 64-bit sum and min/max
+        v128_t sumLow = wasm_i32x4_splat(0);
+        v128_t sumHigh = wasm_i32x4_splat(0);
+        v128_t minVec = wasm_i32x4_splat(-1);
+        v128_t maxVec = wasm_i32x4_splat(0);
+        uint32_t i = 0;
+        for (; i + 4 <= length; i += 4)
+        {
+            v128_t data = wasm_v128_load(&block[i]);
+            sumLow = wasm_i64x2_add(sumLow, wasm_u64x2_extend_low_u32x4(data));
+            sumHigh = wasm_i64x2_add(sumHigh, wasm_u64x2_extend_high_u32x4(data));
+            minVec = wasm_u32x4_min(minVec, data);
+            maxVec = wasm_u32x4_max(maxVec, data);
+        }
 
-        uint64_t sum = 0;
-        uint32_t *queue = new uint32_t[nodeCount];
-        uint32_t head = 0;
-        uint32_t tail = 0;
-        queue[tail++] = 0;
+        uint64_t sumLanes[2];
+        uint32_t minLanes[4];
+        uint32_t maxLanes[4];
+        wasm_v128_store(sumLanes, wasm_i64x2_add(sumLow, sumHigh));
+        wasm_v128_store(minLanes, minVec);
+        wasm_v128_store(maxLanes, maxVec);
+        uint64_t sum = sumLanes[0] + sumLanes[1];
+        uint32_t minVal = std::min(std::min(minLanes[0], minLanes[1]), std::min(minLanes[2], minLanes[3]));
+        uint32_t maxVal = std::max(std::max(maxLanes[0], maxLanes[1]), std::max(maxLanes[2], maxLanes[3]));
+        for (; i < length; i++)
+        {
+            sum += block[i];
+            minVal = std::min(minVal, block[i]);
+            maxVal = std::max(maxVal, block[i]);
+        }
 
-        while (head < tail)
+        // Sweep 2: squared deviations around the block mean, from L1
+        double mean = static_cast<double>(sum) / length;
+        v128_t meanVec = wasm_f64x2_splat(mean);
+        v128_t m2Low = wasm_f64x2_splat(0.0);
+        v128_t m2High = wasm_f64x2_splat(0.0);
+        i = 0;
+        for (; i + 4 <= length; i += 4)
         {
-            uint32_t nodeIndex = queue[head++];
-            sum += values[nodeIndex];
+            v128_t data = wasm_v128_load(&block[i]);
+            v128_t low = wasm_f64x2_sub(wasm_f64x2_convert_low_u32x4(data), meanVec);
+            v128_t high = wasm_f64x2_sub(wasm_f64x2_convert_low_u32x4(wasm_i32x4_shuffle(data, data, 2, 3, 2, 3)), meanVec);
+            m2Low = wasm_f64x2_add(m2Low, wasm_f64x2_mul(low, low));
+            m2High = wasm_f64x2_add(m2High, wasm_f64x2_mul(high, high));
+        }
 
-            uint32_t start = childOffsets[nodeIndex];
-            uint32_t end = childOffsets[nodeIndex + 1];
-            for (uint32_t childCursor = start; childCursor < end; childCursor++)
+        double m2Lanes[2];
+        wasm_v128_store(m2Lanes, wasm_f64x2_add(m2Low, m2High));
+        double m2 = m2Lanes[0] + m2Lanes[1];
+        for (; i < length; i++)
+        {
+            double delta = block[i] - mean;
+            m2 += delta * delta;
+        }
+
+        mergeStatsPartial(stats, length, static_cast<double>(sum), minVal, maxVal, mean, m2);
+    }
+
+    /**
+     * Count a cache-resident block into binCount equal bins over
+     * [histogramMin, histogramMax]; values outside land in the edge bins
+     */
+    static void accumulateHistogramBlock(
+        const uint32_t *block, uint32_t length,
+        uint32_t *bins, uint32_t binCount, uint32_t histogramMin, uint32_t histogramMax)
+    {
+        double scale = binCount / (static_cast<double>(histogramMax) - histogramMin + 1.0);
+        uint32_t lastBin = binCount - 1;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            uint32_t value = block[i];
+            uint32_t bin = 0;
+            if (value > histogramMin)
             {
-                queue[tail++] = children[childCursor];
+                double offset = (value - histogramMin) * scale;
+                bin = offset < lastBin ? static_cast<uint32_t>(offset) : lastBin;
             }
+            bins[bin]++;
         }
+    }
 
-        delete[] queue;
-        return sum;
+    /**
+     * Reset statistics before streaming chunks into them with accumulateStats
+     * @param stats Pointer to an ArrayStats (7 doubles)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void resetStats(ArrayStats *stats)
+    {
+        std::memset(stats, 0, sizeof(ArrayStats));
+    }
+
+    /**
+     * Add one chunk of a stream to running statistics and histogram
+     * @param stats Running statistics (resetStats or a previous call)
+     * @param arr Pointer to the chunk
+     * @param length Chunk length
+     * @param bins Running histogram counts (binCount uint32s), or null
+     * @param binCount Number of bins
+     * @param histogramMin Lower edge of the first bin
+     * @param histogramMax Upper edge (inclusive) of the last bin
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void accumulateStats(
+        ArrayStats *stats, const uint32_t *arr, uint32_t length,
+        uint32_t *bins, uint32_t binCount, uint32_t histogramMin, uint32_t histogramMax)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        bool histogram = bins != nullptr && binCount > 0 && histogramMin <= histogramMax;
+        for (uint32_t start = 0; start < length; start += STATS_BLOCK_LENGTH)
+        {
+            uint32_t blockLength = std::min(STATS_BLOCK_LENGTH, length - start);
+            accumulateStatsBlock(stats, arr + start, blockLength);
+            if (histogram)
+                accumulateHistogramBlock(arr + start, blockLength, bins, binCount, histogramMin, histogramMax);
+        }
+    }
+
+    /**
+     * Merge statistics of another chunk or thread. Histogram bins live
+     * outside ArrayStats; callers with the same bin layout add them bin by bin.
+     * @param into Statistics to update
+     * @param from Statistics to fold in
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void mergeStats(ArrayStats *into, const ArrayStats *from)
+    {
+        mergeStatsPartial(into, from->count, from->sum, from->min, from->max, from->mean, from->m2);
+    }
+
+    /**
+     * Fused sum/min/max/mean/variance and optional histogram in one pass
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param stats Receives the statistics
+     * @param bins Receives binCount histogram counts, or null for none
+     * @param binCount Number of bins
+     * @param histogramMin Lower edge of the first bin
+     * @param histogramMax Upper edge (inclusive) of the last bin
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void computeStats(
+        const uint32_t *arr, uint32_t length, ArrayStats *stats,
+        uint32_t *bins, uint32_t binCount, uint32_t histogramMin, uint32_t histogramMax)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        resetStats(stats);
+        if (bins != nullptr)
+            std::memset(bins, 0, static_cast<size_t>(binCount) * sizeof(uint32_t));
+        accumulateStats(stats, arr, length, bins, binCount, histogramMin, histogramMax);
+    }
+
+    // ========== FUSED PIPELINES ==========
+    // A chain like multiplyArray -> addToArray -> countGreaterThan as one
+    // call and one memory pass: JS describes the stages once
+    // (createPipeline), then runs the compiled pipeline over any number of
+    // arrays. The engine is in fused_pipeline.h.
+
+    static fused_pipeline::Partial runPipelineRange(const fused_pipeline::Pipeline *pipeline, const uint32_t *arr, uint32_t length)
+    {
+        ScratchScope scratch;
+        uint32_t *values = scratch.allocate<uint32_t>(fused_pipeline::BLOCK_LENGTH);
+        uint32_t *mask = scratch.allocate<uint32_t>(fused_pipeline::BLOCK_LENGTH);
+        return fused_pipeline::run(*pipeline, arr, length, values, mask);
+    }
+
+    /**
+     * Compile a pipeline
+     * @param stages stageCount stages of 3 uint32 each: op (fused_pipeline::Op), operand, operand2
+     * @param stageCount Number of stages (at most 32)
+     * @param reduce fused_pipeline::Reduce (sum, count, min, max)
+     * @return Pipeline handle, or null for an unknown op or reduction
+     */
+    EMSCRIPTEN_KEEPALIVE
+    fused_pipeline::Pipeline *createPipeline(const uint32_t *stages, uint32_t stageCount, uint32_t reduce)
+    {
+        fused_pipeline::Pipeline *pipeline = new fused_pipeline::Pipeline;
+        if (!fused_pipeline::compile(stages, stageCount, reduce, *pipeline))
+        {
+            delete pipeline;
+            return nullptr;
+        }
+        return pipeline;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    void freePipeline(fused_pipeline::Pipeline *pipeline)
+    {
+        delete pipeline;
+    }
+
+    /**
+     * Run a compiled pipeline over an array (the array is not modified)
+     * @param pipeline Pipeline handle
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @return Sum (64-bit), count, min or max of the kept rows; 0 for min / max with none kept
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t runPipeline(const fused_pipeline::Pipeline *pipeline, const uint32_t *arr, uint32_t length)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        return fused_pipeline::result(*pipeline, runPipelineRange(pipeline, arr, length));
+    }
+
+    // ========== STREAMING SESSIONS ==========
+    // Reductions over data that never has to be resident at once: the caller
+    // refills one chunk-sized buffer and pushes it, so peak WASM memory is the
+    // chunk size rather than the dataset (which may exceed MAXIMUM_MEMORY).
+    //
+    //   session = beginStream(kind, threshold)
+    //   pushChunk(session, chunk, length)   // any number of times
+    //   finishStream(session, result)       // fills result, frees session
+    //
+    // STREAM_SORT_RUNS sorts each pushed chunk in place into a run for the
+    // caller to spill; createExternalMerge then merges the spilled runs.
+
+    enum StreamKind
+    {
+        STREAM_SUM = 0,
+        STREAM_MIN_MAX = 1,
+        STREAM_COUNT_GREATER_THAN = 2,
+        STREAM_STATS = 3,
+        STREAM_SORT_RUNS = 4,
+    };
+
+    /**
+     * Result of finishStream (88 bytes); fields a kind does not compute stay 0
+     */
+    struct StreamResult
+    {
+        // Elements pushed
+        uint64_t count;
+        // STREAM_SUM
+        uint64_t sum;
+        // STREAM_COUNT_GREATER_THAN: matches; STREAM_SORT_RUNS: runs pushed
+        uint64_t matched;
+        // STREAM_MIN_MAX (0 / 0 for an empty stream)
+        uint32_t min;
+        uint32_t max;
+        // STREAM_STATS
+        ArrayStats stats;
+    };
+
+    struct StreamSession
+    {
+        uint32_t kind;
+        uint32_t threshold;
+        StreamResult result;
+    };
+
+    /**
+     * Min and max of a non-empty array in one SIMD pass
+     */
+    static void findMinMaxSIMD(const uint32_t *arr, uint32_t length, uint32_t &minOut, uint32_t &maxOut)
+    {
+        v128_t minVec = wasm_i32x4_splat(-1);
+        v128_t maxVec = wasm_i32x4_splat(0);
+        uint32_t i = 0;
+        for (; i + 4 <= length; i += 4)
+        {
+            v128_t data = wasm_v128_load(&arr[i]);
+            minVec = wasm_u32x4_min(minVec, data);
+            maxVec = wasm_u32x4_max(maxVec, data);
+        }
+
+        uint32_t minLanes[4];
+        uint32_t maxLanes[4];
+        wasm_v128_store(minLanes, minVec);
+        wasm_v128_store(maxLanes, maxVec);
+        uint32_t minVal = std::min(std::min(minLanes[0], minLanes[1]), std::min(minLanes[2], minLanes[3]));
+        uint32_t maxVal = std::max(std::max(maxLanes[0], maxLanes[1]), std::max(maxLanes[2], maxLanes[3]));
+        for (; i < length; i++)
+        {
+            minVal = std::min(minVal, arr[i]);
+            maxVal = std::max(maxVal, arr[i]);
+        }
+        minOut = minVal;
+        maxOut = maxVal;
+    }
+
+    /**
+     * Start a streaming session
+     * @param kind StreamKind
+     * @param threshold Threshold for STREAM_COUNT_GREATER_THAN (ignored otherwise)
+     * @return Session handle, or null for an unknown kind
+     */
+    EMSCRIPTEN_KEEPALIVE
+    StreamSession *beginStream(uint32_t kind, uint32_t threshold)
+    {
+        if (kind > STREAM_SORT_RUNS)
+            return nullptr;
+
+        StreamSession *session = new StreamSession;
+        std::memset(session, 0, sizeof(StreamSession));
+        session->kind = kind;
+        session->threshold = threshold;
+        return session;
+    }
+
+    /**
+     * Fold one chunk into a session. For STREAM_SORT_RUNS the chunk is
+     * sorted in place and becomes the next run.
+     * @param session Session handle
+     * @param chunk Pointer to the chunk
+     * @param length Chunk length
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void pushChunk(StreamSession *session, uint32_t *chunk, uint32_t length)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        if (length == 0)
+            return;
+
+        StreamResult &result = session->result;
+        switch (session->kind)
+        {
+        case STREAM_SUM:
+            result.sum += sumArray(chunk, length);
+            break;
+        case STREAM_MIN_MAX:
+        {
+            uint32_t minVal, maxVal;
+            findMinMaxSIMD(chunk, length, minVal, maxVal);
+            result.min = result.count == 0 ? minVal : std::min(result.min, minVal);
+            result.max = result.count == 0 ? maxVal : std::max(result.max, maxVal);
+            break;
+        }
+        case STREAM_COUNT_GREATER_THAN:
+            result.matched += countGreaterThanSIMD(chunk, length, session->threshold);
+            break;
+        case STREAM_STATS:
+            accumulateStats(&result.stats, chunk, length, nullptr, 0, 0, 0);
+            break;
+        case STREAM_SORT_RUNS:
+            quickSort(chunk, length);
+            result.matched++;
+            break;
+        }
+        result.count += length;
+    }
+
+    /**
+     * End a session
+     * @param session Session handle (freed)
+     * @param result Receives the StreamResult, or null to discard it
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void finishStream(StreamSession *session, StreamResult *result)
+    {
+        if (!session)
+            return;
+        if (result)
+            *result = session->result;
+        delete session;
+    }
+
+    /**
+     * k-way merge of sorted runs that live outside WASM memory. Each run is
+     * read through a window of windowLength elements that the caller refills
+     * when the merge reports it as starved; merged output comes back in an
+     * output window of the same size. Peak memory: (runs + 1) * windowLength.
+     */
+    struct ExternalMergeHandle
+    {
+        uint32_t runCount;
+        uint32_t windowLength;
+        // runCount windows, then the output window
+        uint32_t *windows;
+        uint32_t *windowPos;
+        uint32_t *windowFill;
+        uint8_t *exhausted;
+        // (value << 32 | run), smallest on top: ties resolve to the lower run
+        std::vector<uint64_t> heap;
+        int32_t starvedRun;
+        uint32_t pendingRuns;
+    };
+
+    static bool externalMergeHeapOrder(uint64_t a, uint64_t b)
+    {
+        return a > b;
+    }
+
+    static void siftDownMergeHeap(uint64_t *heap, uint32_t size)
+    {
+        uint64_t item = heap[0];
+        uint32_t i = 0;
+        for (;;)
+        {
+            uint32_t child = 2 * i + 1;
+            if (child >= size)
+                break;
+            if (child + 1 < size && heap[child + 1] < heap[child])
+                child++;
+            if (heap[child] >= item)
+                break;
+            heap[i] = heap[child];
+            i = child;
+        }
+        heap[i] = item;
+    }
+
+    /**
+     * Create a merge over runCount runs. Fill every run once with
+     * fillExternalMergeRun before the first externalMergeNext.
+     * @param runCount Number of sorted runs
+     * @param windowLength Elements per run window (and per output batch)
+     * @return Merge handle, or null if the windows could not be allocated
+     */
+    EMSCRIPTEN_KEEPALIVE
+    ExternalMergeHandle *createExternalMerge(uint32_t runCount, uint32_t windowLength)
+    {
+        if (runCount == 0 || windowLength == 0)
+            return nullptr;
+
+        uint64_t windowBytes = (static_cast<uint64_t>(runCount) + 1) * windowLength * sizeof(uint32_t);
+        if (windowBytes > UINT32_MAX - BUFFER_ALIGNMENT)
+            return nullptr;
+        uint32_t *windows = static_cast<uint32_t *>(std::aligned_alloc(BUFFER_ALIGNMENT, roundBufferCapacity(static_cast<uint32_t>(windowBytes))));
+        if (!windows)
+            return nullptr;
+
+        ExternalMergeHandle *handle = new ExternalMergeHandle;
+        handle->runCount = runCount;
+        handle->windowLength = windowLength;
+        handle->windows = windows;
+        handle->windowPos = new uint32_t[runCount]();
+        handle->windowFill = new uint32_t[runCount]();
+        handle->exhausted = new uint8_t[runCount]();
+        handle->heap.reserve(runCount);
+        handle->starvedRun = -1;
+        handle->pendingRuns = runCount;
+        return handle;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    void freeExternalMerge(ExternalMergeHandle *handle)
+    {
+        if (!handle)
+            return;
+        std::free(handle->windows);
+        delete[] handle->windowPos;
+        delete[] handle->windowFill;
+        delete[] handle->exhausted;
+        delete handle;
+    }
+
+    /**
+     * Window to copy the next part of a run into
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t *getExternalMergeWindow(ExternalMergeHandle *handle, uint32_t run)
+    {
+        return handle->windows + static_cast<size_t>(run) * handle->windowLength;
+    }
+
+    /**
+     * Output window; externalMergeNext returns how many elements it holds
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t *getExternalMergeOutput(ExternalMergeHandle *handle)
+    {
+        return handle->windows + static_cast<size_t>(handle->runCount) * handle->windowLength;
+    }
+
+    /**
+     * Report that a run's window has been (re)filled
+     * @param handle Merge handle
+     * @param run Run index
+     * @param length Elements copied into the window; 0 marks the run as finished
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void fillExternalMergeRun(ExternalMergeHandle *handle, uint32_t run, uint32_t length)
+    {
+        if (handle->starvedRun == static_cast<int32_t>(run))
+            handle->starvedRun = -1;
+        else if (handle->pendingRuns > 0)
+            handle->pendingRuns--;
+
+        handle->windowPos[run] = 0;
+        handle->windowFill[run] = std::min(length, handle->windowLength);
+        if (handle->windowFill[run] == 0)
+        {
+            handle->exhausted[run] = 1;
+            return;
+        }
+
+        uint32_t value = getExternalMergeWindow(handle, run)[0];
+        handle->heap.push_back((static_cast<uint64_t>(value) << 32) | run);
+        std::push_heap(handle->heap.begin(), handle->heap.end(), externalMergeHeapOrder);
+    }
+
+    /**
+     * Run which must be refilled before the merge can continue
+     * @return Run index, or -1 when no run is starved
+     */
+    EMSCRIPTEN_KEEPALIVE
+    int32_t getExternalMergeStarvedRun(ExternalMergeHandle *handle)
+    {
+        return handle->starvedRun;
+    }
+
+    /**
+     * Merge into the output window until it is full or a run window runs dry
+     * @param handle Merge handle
+     * @return Elements written to the output window. 0 with no starved run
+     *         means the merge is complete.
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t externalMergeNext(ExternalMergeHandle *handle)
+    {
+        PROFILE_KERNEL(0);
+        if (handle->starvedRun >= 0 || handle->pendingRuns > 0)
+            return 0;
+
+        uint32_t *output = getExternalMergeOutput(handle);
+        std::vector<uint64_t> &heap = handle->heap;
+        uint32_t written = 0;
+        while (written < handle->windowLength && !heap.empty())
+        {
+            uint64_t top = heap[0];
+            uint32_t run = static_cast<uint32_t>(top);
+            output[written++] = static_cast<uint32_t>(top >> 32);
+
+            uint32_t pos = ++handle->windowPos[run];
+            if (pos < handle->windowFill[run])
+            {
+                // Replace the top in place: one sift instead of pop + push
+                uint32_t value = getExternalMergeWindow(handle, run)[pos];
+                heap[0] = (static_cast<uint64_t>(value) << 32) | run;
+                siftDownMergeHeap(heap.data(), static_cast<uint32_t>(heap.size()));
+                continue;
+            }
+
+            heap[0] = heap.back();
+            heap.pop_back();
+            if (!heap.empty())
+                siftDownMergeHeap(heap.data(), static_cast<uint32_t>(heap.size()));
+            if (!handle->exhausted[run])
+            {
+                // Its next element may be the smallest left; wait for a refill
+                handle->starvedRun = static_cast<int32_t>(run);
+                break;
+            }
+        }
+        return written;
+    }
+
+    // ========== DISTINCT COUNTING ==========
+    // countUnique sorts a full copy of its input. countUniqueExact marks
+    // values in a bitmap when their range is small, and otherwise in an
+    // open-addressing hash set that grows with the distinct count rather
+    // than the input length (sorting only high-cardinality inputs).
+    // HyperLogLog sketches estimate the count in 2^precision bytes (standard
+    // error 1.04 / sqrt(2^precision), 0.8% at the default precision 14) and
+    // merge register by register, so chunks, streams and threads can each
+    // fill their own sketch.
+
+    // Bitmap up to 2 MB, or up to one byte per input element
+    static const uint64_t DISTINCT_BITMAP_MIN_BITS = 1u << 24;
+    static const uint32_t DISTINCT_BITMAP_BITS_PER_ELEMENT = 8;
+    static const uint32_t DISTINCT_HASH_MIN_CAPACITY = 1024;
+    // Every 64th element decides between the hash set and sorting
+    static const uint32_t DISTINCT_SAMPLE_STRIDE = 64;
+
+    static const uint32_t HLL_MIN_PRECISION = 4;
+    static const uint32_t HLL_MAX_PRECISION = 16;
+    static const uint32_t HLL_DEFAULT_PRECISION = 14;
+
+    /**
+     * murmur3 fmix32: a bijection on uint32, so distinct inputs never collide
+     */
+    static inline uint32_t mixHash32(uint32_t h)
+    {
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    static inline v128_t mixHash32x4(v128_t h)
+    {
+        h = wasm_v128_xor(h, wasm_u32x4_shr(h, 16));
+        h = wasm_i32x4_mul(h, wasm_i32x4_splat(static_cast<int32_t>(0x85ebca6bu)));
+        h = wasm_v128_xor(h, wasm_u32x4_shr(h, 13));
+        h = wasm_i32x4_mul(h, wasm_i32x4_splat(static_cast<int32_t>(0xc2b2ae35u)));
+        h = wasm_v128_xor(h, wasm_u32x4_shr(h, 16));
+        return h;
+    }
+
+    static uint32_t countUniqueBitmap(const uint32_t *arr, uint32_t length, uint32_t minVal, uint64_t range)
+    {
+        ScratchScope scratch;
+        size_t wordCount = static_cast<size_t>((range + 63) / 64);
+        uint64_t *words = scratch.allocate<uint64_t>(wordCount);
+        std::fill(words, words + wordCount, 0);
+        uint32_t unique = 0;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            uint32_t offset = arr[i] - minVal;
+            uint64_t &word = words[offset >> 6];
+            uint64_t bit = 1ull << (offset & 63);
+            unique += (word & bit) == 0;
+            word |= bit;
+        }
+        return unique;
+    }
+
+    /**
+     * Rehash into a table twice the size; the old table stays in the
+     * caller's scratch scope until it closes
+     */
+    static void growDistinctHashSet(ScratchScope &scratch, uint32_t *&table, size_t &tableSize)
+    {
+        size_t grownSize = tableSize * 2;
+        uint32_t *grown = scratch.allocate<uint32_t>(grownSize);
+        std::fill(grown, grown + grownSize, 0u);
+        size_t mask = grownSize - 1;
+        for (size_t i = 0; i < tableSize; i++)
+        {
+            uint32_t value = table[i];
+            if (value == 0)
+                continue;
+            size_t slot = mixHash32(value) & mask;
+            while (grown[slot] != 0)
+                slot = (slot + 1) & mask;
+            grown[slot] = value;
+        }
+        table = grown;
+        tableSize = grownSize;
+    }
+
+    static uint32_t countUniqueHashSet(const uint32_t *arr, uint32_t length, size_t capacity)
+    {
+        // 0 marks an empty slot; the value 0 itself is tracked separately
+        ScratchScope scratch;
+        size_t tableSize = capacity;
+        uint32_t *table = scratch.allocate<uint32_t>(tableSize);
+        std::fill(table, table + tableSize, 0u);
+        size_t mask = tableSize - 1;
+        uint32_t unique = 0;
+        bool hasZero = false;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            uint32_t value = arr[i];
+            if (value == 0)
+            {
+                hasZero = true;
+                continue;
+            }
+
+            size_t slot = mixHash32(value) & mask;
+            while (table[slot] != 0 && table[slot] != value)
+                slot = (slot + 1) & mask;
+            if (table[slot] != 0)
+                continue;
+
+            table[slot] = value;
+            // Keep the load factor at or below 1/2
+            if (++unique * static_cast<size_t>(2) > tableSize)
+            {
+                growDistinctHashSet(scratch, table, tableSize);
+                mask = tableSize - 1;
+            }
+        }
+        return unique + (hasZero ? 1 : 0);
+    }
+
+    /**
+     * Exact distinct count: a bitmap over [min, max] when the range is small,
+     * otherwise a hash set. When a sample shows mostly distinct values the
+     * set would outgrow a sorted copy (8 bytes per value at load 1/2 against
+     * 4 per element), so those inputs fall back to countUnique's radix sort.
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @return Count of unique values
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t countUniqueExact(const uint32_t *arr, uint32_t length)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        if (length == 0)
+            return 0;
+
+        uint32_t minVal, maxVal;
+        findMinMaxSIMD(arr, length, minVal, maxVal);
+        uint64_t range = static_cast<uint64_t>(maxVal) - minVal + 1;
+        uint64_t bitmapLimit = std::max(DISTINCT_BITMAP_MIN_BITS, static_cast<uint64_t>(length) * DISTINCT_BITMAP_BITS_PER_ELEMENT);
+        if (range <= bitmapLimit)
+            return countUniqueBitmap(arr, length, minVal, range);
+
+        uint32_t sampleLength = (length + DISTINCT_SAMPLE_STRIDE - 1) / DISTINCT_SAMPLE_STRIDE;
+        uint32_t sampleUnique;
+        {
+            ScratchScope scratch;
+            uint32_t *sample = scratch.allocate<uint32_t>(sampleLength);
+            for (uint32_t i = 0; i < sampleLength; i++)
+                sample[i] = arr[static_cast<size_t>(i) * DISTINCT_SAMPLE_STRIDE];
+            sampleUnique = countUniqueHashSet(sample, sampleLength, DISTINCT_HASH_MIN_CAPACITY);
+        }
+        if (sampleUnique * static_cast<uint64_t>(2) > sampleLength)
+            return countUnique(const_cast<uint32_t *>(arr), length);
+
+        // Every sampled value is in the set, so start at least that large
+        size_t capacity = DISTINCT_HASH_MIN_CAPACITY;
+        while (capacity < static_cast<size_t>(sampleUnique) * 4)
+            capacity *= 2;
+        return countUniqueHashSet(arr, length, capacity);
+    }
+
+    struct HyperLogLogHandle
+    {
+        uint32_t precision;
+        uint8_t *registers;
+    };
+
+    /**
+     * Add hashes of arr to 2^precision registers (SIMD hash, scalar update)
+     */
+    static void hyperLogLogAddTo(uint8_t *registers, uint32_t precision, const uint32_t *arr, uint32_t length)
+    {
+        uint32_t indexShift = 32 - precision;
+        // Guard bit: a hash whose remaining bits are all 0 ranks 33 - precision
+        uint32_t guard = 1u << (precision - 1);
+        uint32_t i = 0;
+        for (; i + 4 <= length; i += 4)
+        {
+            uint32_t hashes[4];
+            wasm_v128_store(hashes, mixHash32x4(wasm_v128_load(&arr[i])));
+            for (int j = 0; j < 4; j++)
+            {
+                uint8_t &reg = registers[hashes[j] >> indexShift];
+                uint8_t rank = static_cast<uint8_t>(__builtin_clz((hashes[j] << precision) | guard) + 1);
+                reg = std::max(reg, rank);
+            }
+        }
+
+        for (; i < length; i++)
+        {
+            uint32_t hash = mixHash32(arr[i]);
+            uint8_t &reg = registers[hash >> indexShift];
+            reg = std::max(reg, static_cast<uint8_t>(__builtin_clz((hash << precision) | guard) + 1));
+        }
+    }
+
+    /**
+     * HyperLogLog estimate with linear counting for small cardinalities and
+     * the 32-bit hash-space correction for large ones
+     */
+    static double hyperLogLogEstimateRegisters(const uint8_t *registers, uint32_t precision)
+    {
+        uint32_t m = 1u << precision;
+        double inverseSum = 0.0;
+        uint32_t zeros = 0;
+        for (uint32_t j = 0; j < m; j++)
+        {
+            inverseSum += std::ldexp(1.0, -static_cast<int>(registers[j]));
+            zeros += registers[j] == 0;
+        }
+
+        double alpha = m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / m);
+        double estimate = alpha * m * m / inverseSum;
+        const double hashSpace = 4294967296.0;
+        if (estimate <= 2.5 * m && zeros > 0)
+            estimate = m * std::log(static_cast<double>(m) / zeros);
+        else if (estimate > hashSpace / 30.0)
+            estimate = estimate < hashSpace ? -hashSpace * std::log(1.0 - estimate / hashSpace) : hashSpace;
+        return estimate;
+    }
+
+    /**
+     * Create an empty HyperLogLog sketch
+     * @param precision Index bits (4-16); 2^precision one-byte registers
+     * @return Sketch handle, or null for an unsupported precision
+     */
+    EMSCRIPTEN_KEEPALIVE
+    HyperLogLogHandle *createHyperLogLog(uint32_t precision)
+    {
+        if (precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION)
+            return nullptr;
+
+        HyperLogLogHandle *handle = new HyperLogLogHandle;
+        handle->precision = precision;
+        handle->registers = new uint8_t[1u << precision]();
+        return handle;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    void freeHyperLogLog(HyperLogLogHandle *handle)
+    {
+        if (!handle)
+            return;
+        delete[] handle->registers;
+        delete handle;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    void clearHyperLogLog(HyperLogLogHandle *handle)
+    {
+        std::memset(handle->registers, 0, 1u << handle->precision);
+    }
+
+    /**
+     * Registers (2^precision bytes), e.g. to ship a sketch between workers
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint8_t *getHyperLogLogRegisters(HyperLogLogHandle *handle)
+    {
+        return handle->registers;
+    }
+
+    /**
+     * Add values to a sketch
+     * @param handle Sketch handle
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void hyperLogLogAdd(HyperLogLogHandle *handle, const uint32_t *arr, uint32_t length)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        hyperLogLogAddTo(handle->registers, handle->precision, arr, length);
+    }
+
+    /**
+     * Merge a sketch into another (register-wise max); the result counts the
+     * union of both inputs
+     * @param into Sketch to update
+     * @param from Sketch to fold in
+     * @return 1 on success, 0 if the precisions differ
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t mergeHyperLogLog(HyperLogLogHandle *into, const HyperLogLogHandle *from)
+    {
+        if (into->precision != from->precision)
+            return 0;
+
+        uint32_t m = 1u << into->precision;
+        uint32_t j = 0;
+        for (; j + 16 <= m; j += 16)
+        {
+            v128_t merged = wasm_u8x16_max(wasm_v128_load(into->registers + j), wasm_v128_load(from->registers + j));
+            wasm_v128_store(into->registers + j, merged);
+        }
+        for (; j < m; j++)
+            into->registers[j] = std::max(into->registers[j], from->registers[j]);
+        return 1;
+    }
+
+    /**
+     * Estimated number of distinct values added to a sketch
+     */
+    EMSCRIPTEN_KEEPALIVE
+    double hyperLogLogEstimate(const HyperLogLogHandle *handle)
+    {
+        return hyperLogLogEstimateRegisters(handle->registers, handle->precision);
+    }
+
+    /**
+     * Approximate distinct count in one call
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param precision Sketch precision (4-16, 0 = 14)
+     * @return Estimated count of unique values (-1 for an unsupported precision)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    double countUniqueApprox(const uint32_t *arr, uint32_t length, uint32_t precision)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        if (precision == 0)
+            precision = HLL_DEFAULT_PRECISION;
+        if (precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION)
+            return -1.0;
+
+        std::vector<uint8_t> registers(1u << precision, 0);
+        hyperLogLogAddTo(registers.data(), precision, arr, length);
+        return hyperLogLogEstimateRegisters(registers.data(), precision);
+    }
+
+    // ========== STRUCTURE-OF-ARRAYS VECTORS ==========
+    // Points stored as separate x[], y[], z[] (and optional w[]) arrays so
+    // every kernel step is a full 128-bit load or store of one component for
+    // 4 points. Convert once with aosToSoa, transform every frame, and
+    // convert back only when an interleaved copy is needed.
+
+    /**
+     * Split interleaved [x,y,z,...] points into component arrays
+     * @param aos Pointer to count * 3 floats
+     * @param count Number of points
+     * @param xs Receives x components (count floats)
+     * @param ys Receives y components
+     * @param zs Receives z components
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void aosToSoa(const float *aos, uint32_t count, float *xs, float *ys, float *zs)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 24);
+        uint32_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const float *block = aos + static_cast<size_t>(i) * 3;
+            v128_t x, y, z;
+            transposeXyz4ToSoa(wasm_v128_load(block), wasm_v128_load(block + 4), wasm_v128_load(block + 8), x, y, z);
+            wasm_v128_store(xs + i, x);
+            wasm_v128_store(ys + i, y);
+            wasm_v128_store(zs + i, z);
+        }
+
+        for (; i < count; i++)
+        {
+            xs[i] = aos[i * 3 + 0];
+            ys[i] = aos[i * 3 + 1];
+            zs[i] = aos[i * 3 + 2];
+        }
+    }
+
+    /**
+     * Interleave component arrays back into [x,y,z,...] points
+     * @param xs Pointer to x components
+     * @param ys Pointer to y components
+     * @param zs Pointer to z components
+     * @param count Number of points
+     * @param aos Receives count * 3 floats
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void soaToAos(const float *xs, const float *ys, const float *zs, uint32_t count, float *aos)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 24);
+        uint32_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            float *block = aos + static_cast<size_t>(i) * 3;
+            v128_t a, b, c;
+            transposeSoaToXyz4(wasm_v128_load(xs + i), wasm_v128_load(ys + i), wasm_v128_load(zs + i), a, b, c);
+            wasm_v128_store(block, a);
+            wasm_v128_store(block + 4, b);
+            wasm_v128_store(block + 8, c);
+        }
+
+        for (; i < count; i++)
+        {
+            aos[i * 3 + 0] = xs[i];
+            aos[i * 3 + 1] = ys[i];
+            aos[i * 3 + 2] = zs[i];
+        }
+    }
+
+    static void transformSoaRange(float *xs, float *ys, float *zs, const float *matrix, uint32_t start, uint32_t end)
+    {
+        SplatMatrix4 m(matrix);
+
+        uint32_t i = start;
+        for (; i + 4 <= end; i += 4)
+        {
+            v128_t x = wasm_v128_load(xs + i);
+            v128_t y = wasm_v128_load(ys + i);
+            v128_t z = wasm_v128_load(zs + i);
+            wasm_v128_store(xs + i, m.affine(0, x, y, z));
+            wasm_v128_store(ys + i, m.affine(1, x, y, z));
+            wasm_v128_store(zs + i, m.affine(2, x, y, z));
+        }
+
+        for (; i < end; i++)
+        {
+            float x = xs[i];
+            float y = ys[i];
+            float z = zs[i];
+            xs[i] = matrix[0] * x + matrix[4] * y + matrix[8] * z + matrix[12];
+            ys[i] = matrix[1] * x + matrix[5] * y + matrix[9] * z + matrix[13];
+            zs[i] = matrix[2] * x + matrix[6] * y + matrix[10] * z + matrix[14];
+        }
+    }
+
+    /**
+     * Apply a 4x4 matrix to SoA points in place (assuming w = 1)
+     * @param xs Pointer to x components
+     * @param ys Pointer to y components
+     * @param zs Pointer to z components
+     * @param matrix Column-major 4x4 matrix (16 floats)
+     * @param count Number of points
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void transformVectorsSoA(float *xs, float *ys, float *zs, const float *matrix, uint32_t count)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 24);
+        transformSoaRange(xs, ys, zs, matrix, 0, count);
+    }
+
+    /**
+     * Apply a full 4x4 matrix to homogeneous SoA points in place
+     * (w is read and written, e.g. for projection)
+     * @param xs Pointer to x components
+     * @param ys Pointer to y components
+     * @param zs Pointer to z components
+     * @param ws Pointer to w components
+     * @param matrix Column-major 4x4 matrix (16 floats)
+     * @param count Number of points
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void transformVectors4SoA(float *xs, float *ys, float *zs, float *ws, const float *matrix, uint32_t count)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 32);
+        SplatMatrix4 m(matrix);
+
+        uint32_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            v128_t x = wasm_v128_load(xs + i);
+            v128_t y = wasm_v128_load(ys + i);
+            v128_t z = wasm_v128_load(zs + i);
+            v128_t w = wasm_v128_load(ws + i);
+            wasm_v128_store(xs + i, m.full(0, x, y, z, w));
+            wasm_v128_store(ys + i, m.full(1, x, y, z, w));
+            wasm_v128_store(zs + i, m.full(2, x, y, z, w));
+            wasm_v128_store(ws + i, m.full(3, x, y, z, w));
+        }
+
+        for (; i < count; i++)
+        {
+            float x = xs[i];
+            float y = ys[i];
+            float z = zs[i];
+            float w = ws[i];
+            xs[i] = matrix[0] * x + matrix[4] * y + matrix[8] * z + matrix[12] * w;
+            ys[i] = matrix[1] * x + matrix[5] * y + matrix[9] * z + matrix[13] * w;
+            zs[i] = matrix[2] * x + matrix[6] * y + matrix[10] * z + matrix[14] * w;
+            ws[i] = matrix[3] * x + matrix[7] * y + matrix[11] * z + matrix[15] * w;
+        }
+    }
+
+    /**
+     * Transform many objects in one call: points [offsets[k], offsets[k + 1])
+     * get matrix k (assuming w = 1)
+     * @param xs Pointer to x components
+     * @param ys Pointer to y components
+     * @param zs Pointer to z components
+     * @param matrices matrixCount column-major 4x4 matrices (16 floats each)
+     * @param offsets matrixCount + 1 ascending point offsets
+     * @param matrixCount Number of matrices
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void transformVectorsSoABatch(
+        float *xs,
+        float *ys,
+        float *zs,
+        const float *matrices,
+        const uint32_t *offsets,
+        uint32_t matrixCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(matrixCount > 0 ? offsets[matrixCount] - offsets[0] : 0) * 24);
+        for (uint32_t k = 0; k < matrixCount; k++)
+        {
+            transformSoaRange(xs, ys, zs, matrices + static_cast<size_t>(k) * 16, offsets[k], offsets[k + 1]);
+        }
+    }
+
+    // ========== MULTITHREADED VERSIONS ==========
+    // Only run in parallel in the pthreads build (node build-wasm.js --threads)
+    // or natively; the default build executes them on the calling thread.
+    // threadCount = 0 uses every pool thread.
+
+    // Chunks smaller than this are not worth a task
+    static const uint32_t MT_MIN_CHUNK_LENGTH = 16384;
+
+    // Tasks per thread, so stealing can even out uneven chunks
+    static const uint32_t MT_TASKS_PER_THREAD = 4;
+
+    struct ChunkPlan
+    {
+        uint32_t threads;
+        uint32_t chunks;
+        uint32_t chunkLength;
+    };
+
+    /**
+     * Split [0, length) into chunks of a multiple of `alignment` elements
+     */
+    static ChunkPlan planChunks(uint32_t length, uint32_t threadCount, uint32_t alignment)
+    {
+        ChunkPlan plan;
+        plan.threads = WorkStealingPool::instance().resolveThreadCount(threadCount);
+
+        uint32_t maxChunks = length / MT_MIN_CHUNK_LENGTH;
+        uint32_t chunks = plan.threads * MT_TASKS_PER_THREAD;
+        if (plan.threads <= 1 || maxChunks <= 1)
+            chunks = 1;
+        else if (chunks > maxChunks)
+            chunks = maxChunks;
+
+        uint32_t chunkLength = length / chunks + (length % chunks != 0);
+        chunkLength = (chunkLength + alignment - 1) / alignment * alignment;
+        plan.chunkLength = chunkLength > 0 ? chunkLength : alignment;
+        plan.chunks = length == 0 ? 1 : (length + plan.chunkLength - 1) / plan.chunkLength;
+        return plan;
+    }
+
+    /**
+     * Get the number of threads the *_MT kernels can use (1 without pthreads)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t getMaxThreads()
+    {
+        return WorkStealingPool::instance().maxThreads();
+    }
+
+    /**
+     * Multithreaded sum
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param threadCount Threads to use (0 = all)
+     * @return Sum of all elements
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumArray_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        ChunkPlan plan = planChunks(length, threadCount, 4);
+        std::vector<uint64_t> partial(plan.chunks, 0);
+        WorkStealingPool::instance().parallelFor(plan.chunks, plan.threads, [&](uint32_t chunk)
+        {
+            uint32_t start = chunk * plan.chunkLength;
+            uint32_t end = std::min(length, start + plan.chunkLength);
+            partial[chunk] = start < end ? sumArray(arr + start, end - start) : 0;
+        });
+
+        uint64_t sum = 0;
+        for (uint64_t value : partial)
+            sum += value;
+        return sum;
+    }
+
+    /**
+     * Multithreaded average
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param threadCount Threads to use (0 = all)
+     * @return Average value
+     */
+    EMSCRIPTEN_KEEPALIVE
+    double calculateAverage_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        if (length == 0)
+            return 0.0;
+        return static_cast<double>(sumArray_MT(arr, length, threadCount)) / length;
+    }
+
+    /**
+     * Multithreaded maximum (SIMD per chunk)
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param threadCount Threads to use (0 = all)
+     * @return Maximum value
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t findMax_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        if (length == 0)
+            return 0;
+
+        ChunkPlan plan = planChunks(length, threadCount, 4);
+        std::vector<uint32_t> partial(plan.chunks, 0);
+        WorkStealingPool::instance().parallelFor(plan.chunks, plan.threads, [&](uint32_t chunk)
+        {
+            uint32_t start = chunk * plan.chunkLength;
+            uint32_t end = std::min(length, start + plan.chunkLength);
+            partial[chunk] = start < end ? findMaxSIMD(arr + start, end - start) : 0;
+        });
+
+        return *std::max_element(partial.begin(), partial.end());
+    }
+
+    /**
+     * Multithreaded minimum (SIMD per chunk)
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param threadCount Threads to use (0 = all)
+     * @return Minimum value
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t findMin_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        if (length == 0)
+            return 0;
+
+        ChunkPlan plan = planChunks(length, threadCount, 4);
+        std::vector<uint32_t> partial(plan.chunks, UINT32_MAX);
+        WorkStealingPool::instance().parallelFor(plan.chunks, plan.threads, [&](uint32_t chunk)
+        {
+            uint32_t start = chunk * plan.chunkLength;
+            uint32_t end = std::min(length, start + plan.chunkLength);
+            if (start < end)
+                partial[chunk] = findMinSIMD(arr + start, end - start);
+        });
+
+        return *std::min_element(partial.begin(), partial.end());
+    }
+
+    /**
+     * Multithreaded count of elements greater than threshold (SIMD per chunk)
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param threshold Threshold value
+     * @param threadCount Threads to use (0 = all)
+     * @return Count of elements > threshold
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t countGreaterThan_MT(const uint32_t *arr, uint32_t length, uint32_t threshold, uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        ChunkPlan plan = planChunks(length, threadCount, 4);
+        std::vector<uint32_t> partial(plan.chunks, 0);
+        WorkStealingPool::instance().parallelFor(plan.chunks, plan.threads, [&](uint32_t chunk)
+        {
+            uint32_t start = chunk * plan.chunkLength;
+            uint32_t end = std::min(length, start + plan.chunkLength);
+            partial[chunk] = start < end ? countGreaterThanSIMD(arr + start, end - start, threshold) : 0;
+        });
+
+        uint32_t count = 0;
+        for (uint32_t value : partial)
+            count += value;
+        return count;
+    }
+
+    /**
+     * Multithreaded computeStats: per-chunk statistics and histograms merged
+     * in chunk order, so the result does not depend on scheduling
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param stats Receives the statistics
+     * @param bins Receives binCount histogram counts, or null for none
+     * @param binCount Number of bins
+     * @param histogramMin Lower edge of the first bin
+     * @param histogramMax Upper edge (inclusive) of the last bin
+     * @param threadCount Threads to use (0 = all)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void computeStats_MT(
+        const uint32_t *arr, uint32_t length, ArrayStats *stats,
+        uint32_t *bins, uint32_t binCount, uint32_t histogramMin, uint32_t histogramMax,
+        uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        ChunkPlan plan = planChunks(length, threadCount, 4);
+        if (plan.chunks == 1)
+        {
+            computeStats(arr, length, stats, bins, binCount, histogramMin, histogramMax);
+            return;
+        }
+
+        uint32_t chunkBinCount = bins != nullptr ? binCount : 0;
+        std::vector<ArrayStats> partial(plan.chunks);
+        std::vector<uint32_t> partialBins(static_cast<size_t>(plan.chunks) * chunkBinCount);
+        WorkStealingPool::instance().parallelFor(plan.chunks, plan.threads, [&](uint32_t chunk)
+        {
+            uint32_t start = chunk * plan.chunkLength;
+            uint32_t end = std::min(length, start + plan.chunkLength);
+            uint32_t *chunkBins = chunkBinCount > 0 ? &partialBins[static_cast<size_t>(chunk) * chunkBinCount] : nullptr;
+            computeStats(arr + start, start < end ? end - start : 0, &partial[chunk], chunkBins, chunkBinCount, histogramMin, histogramMax);
+        });
+
+        resetStats(stats);
+        for (const ArrayStats &chunkStats : partial)
+            mergeStats(stats, &chunkStats);
+
+        if (chunkBinCount > 0)
+        {
+            std::memset(bins, 0, static_cast<size_t>(binCount) * sizeof(uint32_t));
+            for (uint32_t chunk = 0; chunk < plan.chunks; chunk++)
+            {
+                const uint32_t *chunkBins = &partialBins[static_cast<size_t>(chunk) * chunkBinCount];
+                for (uint32_t bin = 0; bin < binCount; bin++)
+                    bins[bin] += chunkBins[bin];
+            }
+        }
+    }
+
+    /**
+     * Multithreaded runPipeline: chunk partials combined in chunk order
+     * @param pipeline Pipeline handle
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param threadCount Threads to use (0 = all)
+     * @return As runPipeline
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t runPipeline_MT(const fused_pipeline::Pipeline *pipeline, const uint32_t *arr, uint32_t length, uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 4);
+        ChunkPlan plan = planChunks(length, threadCount, fused_pipeline::BLOCK_LENGTH);
+        std::vector<fused_pipeline::Partial> partial(plan.chunks, fused_pipeline::Partial{0, 0});
+        WorkStealingPool::instance().parallelFor(plan.chunks, plan.threads, [&](uint32_t chunk)
+        {
+            uint32_t start = chunk * plan.chunkLength;
+            uint32_t end = std::min(length, start + plan.chunkLength);
+            if (start < end)
+                partial[chunk] = runPipelineRange(pipeline, arr + start, end - start);
+        });
+
+        fused_pipeline::Partial total = {0, 0};
+        for (const fused_pipeline::Partial &part : partial)
+            fused_pipeline::combine(pipeline->reduce, total, part);
+        return fused_pipeline::result(*pipeline, total);
+    }
+
+    /**
+     * Multithreaded transformVectorsSIMD over chunks of whole vector groups
+     * @param vectors Input array of 3D vectors (x,y,z repeated)
+     * @param matrix 4x4 transformation matrix (16 elements)
+     * @param count Number of vectors (length / 3)
+     * @param threadCount Threads to use (0 = all)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void transformVectors_MT(float *vectors, const float *matrix, uint32_t count, uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 24);
+        ChunkPlan plan = planChunks(count, threadCount, 4);
+        WorkStealingPool::instance().parallelFor(plan.chunks, plan.threads, [&](uint32_t chunk)
+        {
+            uint32_t start = chunk * plan.chunkLength;
+            uint32_t end = std::min(count, start + plan.chunkLength);
+            if (start < end)
+                transformVectorsSIMD(vectors + static_cast<size_t>(start) * 3, matrix, end - start);
+        });
+    }
+
+    /**
+     * Merge path split: number of elements taken from `a` among the first
+     * `diagonal` outputs of a stable merge of a and b
+     */
+    static uint32_t mergePathSplit(const uint32_t *a, uint32_t aLength, const uint32_t *b, uint32_t bLength, uint32_t diagonal)
+    {
+        uint32_t low = diagonal > bLength ? diagonal - bLength : 0;
+        uint32_t high = std::min(diagonal, aLength);
+        while (low < high)
+        {
+            uint32_t mid = low + (high - low) / 2;
+            if (a[mid] <= b[diagonal - mid - 1])
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return low;
+    }
+
+    /**
+     * Multithreaded sort: one run per thread sorted with quickSort, then
+     * pairwise merge rounds where every merge is split into equal output
+     * segments (merge path) so all threads stay busy until the last round
+     * @param arr Pointer to uint32_t array
+     * @param length Array length
+     * @param threadCount Threads to use (0 = all)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void mergeSort_MT(uint32_t *arr, uint32_t length, uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(length) * 8);
+        WorkStealingPool &pool = WorkStealingPool::instance();
+        uint32_t threads = pool.resolveThreadCount(threadCount);
+        uint32_t runCount = std::min(threads, length / MT_MIN_CHUNK_LENGTH);
+        if (runCount <= 1)
+        {
+            quickSort(arr, length);
+            return;
+        }
+
+        std::vector<uint32_t> bounds(runCount + 1);
+        for (uint32_t run = 0; run <= runCount; run++)
+            bounds[run] = static_cast<uint32_t>(static_cast<uint64_t>(length) * run / runCount);
+
+        pool.parallelFor(runCount, threads, [&](uint32_t run)
+        {
+            quickSort(arr + bounds[run], bounds[run + 1] - bounds[run]);
+        });
+
+        // Merge buffer from the calling thread's arena; the run sorts above
+        // used their own threads' arenas
+        ScratchScope scratch;
+        uint32_t *mergeBuffer = scratch.allocate<uint32_t>(length);
+
+        struct MergeSegment
+        {
+            const uint32_t *a;
+            uint32_t aLength;
+            const uint32_t *b;
+            uint32_t bLength;
+            uint32_t *out;
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        uint32_t segmentLength = std::max(MT_MIN_CHUNK_LENGTH, length / (threads * MT_TASKS_PER_THREAD));
+        uint32_t *src = arr;
+        uint32_t *dst = mergeBuffer;
+        std::vector<MergeSegment> segments;
+
+        for (uint32_t width = 1; width < runCount; width *= 2)
+        {
+            segments.clear();
+            for (uint32_t left = 0; left < runCount; left += 2 * width)
+            {
+                uint32_t aStart = bounds[left];
+                uint32_t bStart = bounds[std::min(left + width, runCount)];
+                uint32_t bEnd = bounds[std::min(left + 2 * width, runCount)];
+                uint32_t total = bEnd - aStart;
+                for (uint32_t begin = 0; begin < total; begin += segmentLength)
+                {
+                    segments.push_back(MergeSegment{
+                        src + aStart, bStart - aStart,
+                        src + bStart, bEnd - bStart,
+                        dst + aStart,
+                        begin, std::min(total, begin + segmentLength)});
+                }
+            }
+
+            pool.parallelFor(static_cast<uint32_t>(segments.size()), threads, [&](uint32_t index)
+            {
+                const MergeSegment &seg = segments[index];
+                uint32_t aBegin = mergePathSplit(seg.a, seg.aLength, seg.b, seg.bLength, seg.begin);
+                uint32_t aEnd = mergePathSplit(seg.a, seg.aLength, seg.b, seg.bLength, seg.end);
+                std::merge(seg.a + aBegin, seg.a + aEnd,
+                           seg.b + (seg.begin - aBegin), seg.b + (seg.end - aEnd),
+                           seg.out + seg.begin);
+            });
+
+            std::swap(src, dst);
+        }
+
+        if (src != arr)
+        {
+            ChunkPlan plan = planChunks(length, threads, 4);
+            pool.parallelFor(plan.chunks, plan.threads, [&](uint32_t chunk)
+            {
+                uint32_t start = chunk * plan.chunkLength;
+                uint32_t end = std::min(length, start + plan.chunkLength);
+                if (start < end)
+                    std::copy(src + start, src + end, arr + start);
+            });
+        }
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumBinaryTreeDfs(const uint32_t *values, uint32_t nodeCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 4);
+        if (nodeCount == 0)
+            return 0;
+
+        uint64_t sum = 0;
+        ScratchScope scratch;
+        uint32_t *stack = scratch.allocate<uint32_t>(nodeCount);
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            uint32_t nodeIndex = stack[--stackSize];
+            sum += values[nodeIndex];
+
+            uint64_t rightChild = static_cast<uint64_t>(nodeIndex) * 2 + 2;
+            uint64_t leftChild = static_cast<uint64_t>(nodeIndex) * 2 + 1;
+
+            if (rightChild < nodeCount)
+            {
+                stack[stackSize++] = static_cast<uint32_t>(rightChild);
+            }
+            if (leftChild < nodeCount)
+            {
+                stack[stackSize++] = static_cast<uint32_t>(leftChild);
+            }
+        }
+
+        return sum;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumBinaryTreeBfs(const uint32_t *values, uint32_t nodeCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 4);
+        if (nodeCount == 0)
+            return 0;
+
+        uint64_t sum = 0;
+        ScratchScope scratch;
+        uint32_t *queue = scratch.allocate<uint32_t>(nodeCount);
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        queue[tail++] = 0;
+
+        while (head < tail)
+        {
+            uint32_t nodeIndex = queue[head++];
+            sum += values[nodeIndex];
+
+            uint64_t leftChild = static_cast<uint64_t>(nodeIndex) * 2 + 1;
+            uint64_t rightChild = static_cast<uint64_t>(nodeIndex) * 2 + 2;
+
+            if (leftChild < nodeCount)
+            {
+                queue[tail++] = static_cast<uint32_t>(leftChild);
+            }
+            if (rightChild < nodeCount)
+            {
+                queue[tail++] = static_cast<uint32_t>(rightChild);
+            }
+        }
+
+        return sum;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumNaryTreeDfs(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 12);
+        if (nodeCount == 0)
+            return 0;
+
+        uint64_t sum = 0;
+        ScratchScope scratch;
+        uint32_t *stack = scratch.allocate<uint32_t>(nodeCount);
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            uint32_t nodeIndex = stack[--stackSize];
+            sum += values[nodeIndex];
+
+            uint32_t start = childOffsets[nodeIndex];
+            uint32_t end = childOffsets[nodeIndex + 1];
+            for (uint32_t childCursor = end; childCursor > start; childCursor--)
+            {
+                stack[stackSize++] = children[childCursor - 1];
+            }
+        }
+
+        return sum;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumNaryTreeBfs(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 12);
+        if (nodeCount == 0)
+            return 0;
+
+        uint64_t sum = 0;
+        ScratchScope scratch;
+        uint32_t *queue = scratch.allocate<uint32_t>(nodeCount);
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        queue[tail++] = 0;
+
+        while (head < tail)
+        {
+            uint32_t nodeIndex = queue[head++];
+            sum += values[nodeIndex];
+
+            uint32_t start = childOffsets[nodeIndex];
+            uint32_t end = childOffsets[nodeIndex + 1];
+            for (uint32_t childCursor = start; childCursor < end; childCursor++)
+            {
+                queue[tail++] = children[childCursor];
+            }
+        }
+
+        return sum;
+    }
+
+    // ========== TREE LAYOUTS ==========
+
+    enum TreeLayout
+    {
+        TREE_LAYOUT_VEB = 0,
+        TREE_LAYOUT_BLOCKED = 1
+    };
+
+    static const uint32_t TREE_MAX_LEVELS = 32;
+    // Levels per block of the blocked layout: 15 nodes, 60 bytes
+    static const uint32_t TREE_BLOCK_LEVELS = 4;
+
+    /**
+     * One depth of a recursive layout of a perfect binary tree (Brodal,
+     * Fagerberg & Jacob). Every depth d >= 1 is the first level of the
+     * bottom trees of exactly one top/bottom split. The top tree of that
+     * split is rooted at depth topDepth and holds topSize nodes. The bottom
+     * trees hold bottomSize nodes each and follow the top tree left to
+     * right. A node's position is then its ancestor's position at topDepth
+     * plus a table lookup, so traversals need neither child links nor the
+     * permutation.
+     */
+    struct TreeLayoutLevel
+    {
+        uint32_t topDepth;
+        uint32_t topSize;
+        // Selects the node's bottom tree from its 1-based heap index
+        uint32_t bottomIndexMask;
+        uint32_t bottomSize;
+    };
+
+    struct TreeLayoutTables
+    {
+        uint32_t levels;
+        TreeLayoutLevel depths[TREE_MAX_LEVELS];
+    };
+
+    static void splitTreeLayout(TreeLayoutTables &tables, uint32_t layout, uint32_t rootDepth, uint32_t levels)
+    {
+        if (levels <= 1)
+            return;
+
+        // van Emde Boas halves the height. Blocked peels 4-level blocks
+        // off the bottom, and within a block peeling single levels gives
+        // heap order.
+        uint32_t bottomLevels;
+        if (layout == TREE_LAYOUT_VEB)
+            bottomLevels = levels - levels / 2;
+        else
+            bottomLevels = levels > TREE_BLOCK_LEVELS ? TREE_BLOCK_LEVELS : 1;
+        uint32_t topLevels = levels - bottomLevels;
+
+        TreeLayoutLevel &split = tables.depths[rootDepth + topLevels];
+        split.topDepth = rootDepth;
+        split.topSize = (1u << topLevels) - 1;
+        split.bottomIndexMask = (1u << topLevels) - 1;
+        split.bottomSize = (1u << bottomLevels) - 1;
+
+        splitTreeLayout(tables, layout, rootDepth, topLevels);
+        splitTreeLayout(tables, layout, rootDepth + topLevels, bottomLevels);
+    }
+
+    static uint32_t treeLevels(uint32_t nodeCount)
+    {
+        return nodeCount == 0 ? 0 : 32 - __builtin_clz(nodeCount);
+    }
+
+    static void buildTreeLayoutTables(uint32_t nodeCount, uint32_t layout, TreeLayoutTables &tables)
+    {
+        tables.levels = treeLevels(nodeCount);
+        splitTreeLayout(tables, layout, 0, tables.levels);
+    }
+
+    /**
+     * Position of a node given the positions of its ancestors by depth
+     */
+    static inline uint32_t treeLayoutChildPosition(const TreeLayoutLevel &level, const uint32_t *positions, uint32_t node)
+    {
+        return positions[level.topDepth] + level.topSize + (node & level.bottomIndexMask) * level.bottomSize;
+    }
+
+    /**
+     * Position of a node, walking up the split depths (O(log log n) steps)
+     */
+    static inline uint32_t treeLayoutPosition(const TreeLayoutTables &tables, uint32_t node)
+    {
+        uint32_t depth = 31 - __builtin_clz(node);
+        uint32_t position = 0;
+        while (depth > 0)
+        {
+            const TreeLayoutLevel &level = tables.depths[depth];
+            position += level.topSize + (node & level.bottomIndexMask) * level.bottomSize;
+            node >>= depth - level.topDepth;
+            depth = level.topDepth;
+        }
+        return position;
+    }
+
+    /**
+     * Slots of a relaid binary tree: the perfect tree holding nodeCount
+     * nodes, at most 2 * nodeCount - 1
+     * @param nodeCount Node count of the heap-ordered tree
+     * @return Slot count, 0 for an empty tree
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t binaryTreeLayoutCapacity(uint32_t nodeCount)
+    {
+        uint32_t levels = treeLevels(nodeCount);
+        return levels >= 32 ? UINT32_MAX : (1u << levels) - 1;
+    }
+
+    /**
+     * Relayout a heap-ordered binary tree (children of i at 2i+1, 2i+2) in
+     * van Emde Boas or blocked order. The tree is laid out as the perfect
+     * tree of the same height, so slots of missing last-level nodes are
+     * zero and never visited.
+     * @param values Node values in heap order
+     * @param nodeCount Number of nodes
+     * @param layout TREE_LAYOUT_VEB or TREE_LAYOUT_BLOCKED
+     * @param out Output of binaryTreeLayoutCapacity(nodeCount) slots
+     * @return Slots written, 0 for an unknown layout
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t relayoutBinaryTree(const uint32_t *values, uint32_t nodeCount, uint32_t layout, uint32_t *out)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 8);
+        if (layout > TREE_LAYOUT_BLOCKED)
+            return 0;
+
+        uint32_t capacity = binaryTreeLayoutCapacity(nodeCount);
+        TreeLayoutTables tables;
+        buildTreeLayoutTables(nodeCount, layout, tables);
+
+        std::fill(out, out + capacity, 0u);
+        for (uint32_t i = 0; i < nodeCount; i++)
+            out[treeLayoutPosition(tables, i + 1)] = values[i];
+        return capacity;
+    }
+
+    /**
+     * Preorder DFS sum over a tree from relayoutBinaryTree, visiting nodes
+     * in the same order as sumBinaryTreeDfs. Children's positions are
+     * derived from the ancestor positions kept per depth when they are
+     * pushed, so the stack is bounded by the height.
+     * @param layoutValues Relaid values
+     * @param nodeCount Node count of the original tree
+     * @param layout Layout passed to relayoutBinaryTree
+     * @return Sum of the node values, 0 for an unknown layout
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumBinaryTreeLayoutDfs(const uint32_t *layoutValues, uint32_t nodeCount, uint32_t layout)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 4);
+        if (nodeCount == 0 || layout > TREE_LAYOUT_BLOCKED)
+            return 0;
+
+        TreeLayoutTables tables;
+        buildTreeLayoutTables(nodeCount, layout, tables);
+
+        struct PendingNode
+        {
+            // 1-based heap index
+            uint32_t node;
+            uint32_t position;
+            uint32_t depth;
+        };
+        uint32_t positions[TREE_MAX_LEVELS];
+        // Pushing both children and popping one keeps at most one pending
+        // sibling per level
+        PendingNode stack[TREE_MAX_LEVELS + 1];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = {1, 0, 0};
+
+        uint64_t sum = 0;
+        while (stackSize > 0)
+        {
+            PendingNode current = stack[--stackSize];
+            positions[current.depth] = current.position;
+            sum += layoutValues[current.position];
+
+            uint64_t leftChild = static_cast<uint64_t>(current.node) * 2;
+            if (leftChild > nodeCount)
+                continue;
+            const TreeLayoutLevel &level = tables.depths[current.depth + 1];
+            uint32_t left = static_cast<uint32_t>(leftChild);
+            if (leftChild + 1 <= nodeCount)
+                stack[stackSize++] = {left + 1, treeLayoutChildPosition(level, positions, left + 1), current.depth + 1};
+            stack[stackSize++] = {left, treeLayoutChildPosition(level, positions, left), current.depth + 1};
+        }
+
+        return sum;
+    }
+
+    /**
+     * Sum the values on the root-to-node path of every target in a
+     * heap-ordered binary tree, walking down from the root. Baseline for
+     * sumBinaryTreeLayoutPaths: every level of a descent lands on a new
+     * cache line once the tree is large.
+     * @param values Node values in heap order
+     * @param nodeCount Number of nodes
+     * @param targets Target node indices (< nodeCount)
+     * @param count Number of targets
+     * @return Sum over all paths
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumBinaryTreePaths(const uint32_t *values, uint32_t nodeCount, const uint32_t *targets, uint32_t count)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 4);
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (targets[i] >= nodeCount)
+                continue;
+            uint32_t node = targets[i] + 1;
+            uint32_t depth = 31 - __builtin_clz(node);
+            for (uint32_t d = 0; d <= depth; d++)
+                sum += values[(node >> (depth - d)) - 1];
+        }
+        return sum;
+    }
+
+    /**
+     * sumBinaryTreePaths over a tree from relayoutBinaryTree. A descent
+     * stays inside one recursive subtree for several levels, so it touches
+     * O(log_B n) cache lines instead of O(log n).
+     * @param layoutValues Relaid values
+     * @param nodeCount Node count of the original tree
+     * @param layout Layout passed to relayoutBinaryTree
+     * @param targets Target node indices in heap numbering (< nodeCount)
+     * @param count Number of targets
+     * @return Sum over all paths, 0 for an unknown layout
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumBinaryTreeLayoutPaths(
+        const uint32_t *layoutValues,
+        uint32_t nodeCount,
+        uint32_t layout,
+        const uint32_t *targets,
+        uint32_t count)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(count) * 4);
+        if (nodeCount == 0 || layout > TREE_LAYOUT_BLOCKED)
+            return 0;
+
+        TreeLayoutTables tables;
+        buildTreeLayoutTables(nodeCount, layout, tables);
+
+        uint32_t positions[TREE_MAX_LEVELS];
+        positions[0] = 0;
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (targets[i] >= nodeCount)
+                continue;
+            uint32_t node = targets[i] + 1;
+            uint32_t depth = 31 - __builtin_clz(node);
+            sum += layoutValues[0];
+            for (uint32_t d = 1; d <= depth; d++)
+            {
+                uint32_t position = treeLayoutChildPosition(tables.depths[d], positions, node >> (depth - d));
+                positions[d] = position;
+                sum += layoutValues[position];
+            }
+        }
+        return sum;
+    }
+
+    /**
+     * Relayout a CSR tree rooted at node 0 in DFS preorder with subtree
+     * sizes. Node p's first child is at p + 1, and each next sibling starts
+     * subtreeSizes[c] after the previous sibling c, so the layout needs no
+     * child lists and every subtree is a contiguous range. Children keep
+     * their CSR order, and nodes unreachable from node 0 are dropped.
+     * @param values Node values
+     * @param childOffsets nodeCount + 1 offsets into children
+     * @param children Child node indices
+     * @param nodeCount Number of nodes
+     * @param outValues Output values in preorder (nodeCount slots)
+     * @param outSubtreeSizes Output subtree sizes in preorder (nodeCount slots)
+     * @return Nodes written
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t relayoutNaryTreePreorder(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount,
+        uint32_t *outValues,
+        uint32_t *outSubtreeSizes)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 20);
+        if (nodeCount == 0)
+            return 0;
+
+        ScratchScope scratch;
+        uint32_t *stack = scratch.allocate<uint32_t>(nodeCount);
+        // Preorder position of each stacked node's parent, then of each
+        // written node's parent
+        uint32_t *stackParents = scratch.allocate<uint32_t>(nodeCount);
+        uint32_t *parents = scratch.allocate<uint32_t>(nodeCount);
+        uint32_t stackSize = 0;
+        stack[stackSize] = 0;
+        stackParents[stackSize++] = 0;
+
+        uint32_t written = 0;
+        while (stackSize > 0)
+        {
+            stackSize--;
+            uint32_t nodeIndex = stack[stackSize];
+            parents[written] = stackParents[stackSize];
+            outValues[written] = values[nodeIndex];
+            outSubtreeSizes[written] = 1;
+
+            uint32_t start = childOffsets[nodeIndex];
+            uint32_t end = childOffsets[nodeIndex + 1];
+            for (uint32_t childCursor = end; childCursor > start; childCursor--)
+            {
+                stack[stackSize] = children[childCursor - 1];
+                stackParents[stackSize++] = written;
+            }
+            written++;
+        }
+
+        // Children follow their parents, so one backward pass totals sizes
+        for (uint32_t position = written - 1; position > 0; position--)
+            outSubtreeSizes[parents[position]] += outSubtreeSizes[position];
+        return written;
+    }
+
+    /**
+     * BFS sum over a tree from relayoutNaryTreePreorder, visiting nodes in
+     * the same order as sumNaryTreeBfs. (Preorder DFS over this layout is a
+     * sequential scan of the values.)
+     * @param values Values in preorder
+     * @param subtreeSizes Subtree sizes in preorder
+     * @param nodeCount Number of nodes
+     * @return Sum of the node values
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumNaryTreePreorderBfs(const uint32_t *values, const uint32_t *subtreeSizes, uint32_t nodeCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 8);
+        if (nodeCount == 0)
+            return 0;
+
+        uint64_t sum = 0;
+        ScratchScope scratch;
+        uint32_t *queue = scratch.allocate<uint32_t>(nodeCount);
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        queue[tail++] = 0;
+
+        while (head < tail)
+        {
+            uint32_t position = queue[head++];
+            sum += values[position];
+
+            uint32_t end = position + subtreeSizes[position];
+            for (uint32_t child = position + 1; child < end; child += subtreeSizes[child])
+            {
+                queue[tail++] = child;
+            }
+        }
+
+        return sum;
+    }
+
+    /**
+     * Sum of every subtree of a CSR tree rooted at node 0
+     * @param values Node values
+     * @param childOffsets nodeCount + 1 offsets into children
+     * @param children Child node indices
+     * @param nodeCount Number of nodes
+     * @param out Output subtree sums by node index (nodeCount slots)
+     * @return Sum of the whole tree
+     */
+    EMSCRIPTEN_KEEPALIVE
+    double subtreeSumsNary(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount,
+        double *out)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 20);
+        if (nodeCount == 0)
+            return 0.0;
+
+        ScratchScope scratch;
+        uint32_t *stack = scratch.allocate<uint32_t>(nodeCount);
+        uint32_t *order = scratch.allocate<uint32_t>(nodeCount);
+        uint32_t stackSize = 0;
+        uint32_t visited = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            uint32_t nodeIndex = stack[--stackSize];
+            order[visited++] = nodeIndex;
+
+            uint32_t start = childOffsets[nodeIndex];
+            uint32_t end = childOffsets[nodeIndex + 1];
+            for (uint32_t childCursor = end; childCursor > start; childCursor--)
+            {
+                stack[stackSize++] = children[childCursor - 1];
+            }
+        }
+
+        // Reverse preorder reaches every child before its parent
+        for (uint32_t i = visited; i > 0; i--)
+        {
+            uint32_t nodeIndex = order[i - 1];
+            double sum = values[nodeIndex];
+            for (uint32_t childCursor = childOffsets[nodeIndex]; childCursor < childOffsets[nodeIndex + 1]; childCursor++)
+                sum += out[children[childCursor]];
+            out[nodeIndex] = sum;
+        }
+
+        return out[0];
+    }
+
+    /**
+     * Sum of every subtree of a tree from relayoutNaryTreePreorder
+     * @param values Values in preorder
+     * @param subtreeSizes Subtree sizes in preorder
+     * @param nodeCount Number of nodes
+     * @param out Output subtree sums by preorder position (nodeCount slots)
+     * @return Sum of the whole tree
+     */
+    EMSCRIPTEN_KEEPALIVE
+    double subtreeSumsPreorder(const uint32_t *values, const uint32_t *subtreeSizes, uint32_t nodeCount, double *out)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 16);
+        if (nodeCount == 0)
+            return 0.0;
+
+        for (uint32_t position = nodeCount; position > 0; position--)
+        {
+            uint32_t node = position - 1;
+            double sum = values[node];
+            uint32_t end = node + subtreeSizes[node];
+            for (uint32_t child = node + 1; child < end; child += subtreeSizes[child])
+                sum += out[child];
+            out[node] = sum;
+        }
+
+        return out[0];
+    }
+
+    // ========== PARALLEL TREE TRAVERSAL ==========
+
+    /**
+     * Aggregates of a CSR tree (all doubles for the JS side)
+     */
+    struct NaryTreeStats
+    {
+        double sum;
+        double nodeCount;
+        double maxDepth;
+    };
+
+    struct NaryTreeSumVisitor
+    {
+        const uint32_t *values;
+        uint64_t sum;
+
+        void visit(uint32_t node, uint32_t)
+        {
+            sum += values[node];
+        }
+    };
+
+    struct NaryTreeStatsVisitor
+    {
+        const uint32_t *values;
+        // This visitor's row of per-level counts
+        uint32_t *levelCounts;
+        uint32_t levelCapacity;
+        uint32_t maxDepth;
+        uint64_t sum;
+        uint64_t nodeCount;
+
+        void visit(uint32_t node, uint32_t depth)
+        {
+            sum += values[node];
+            nodeCount++;
+            maxDepth = std::max(maxDepth, depth);
+            if (depth < levelCapacity)
+                levelCounts[depth]++;
+        }
+    };
+
+    static uint64_t sumNaryTreeParallel(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount,
+        uint32_t threadCount,
+        bool depthFirst)
+    {
+        CsrTree tree = {childOffsets, children, nodeCount};
+        uint32_t visitorCount = treeTraversalVisitors(threadCount);
+        ScratchScope scratch;
+        NaryTreeSumVisitor *visitors = scratch.allocate<NaryTreeSumVisitor>(visitorCount);
+        std::fill(visitors, visitors + visitorCount, NaryTreeSumVisitor{values, 0});
+
+        if (depthFirst)
+            parallelTreeDfs(tree, threadCount, visitors);
+        else
+            parallelTreeBfs(tree, threadCount, visitors);
+
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < visitorCount; i++)
+            sum += visitors[i].sum;
+        return sum;
+    }
+
+    static void computeNaryTreeStatsParallel(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount,
+        NaryTreeStats *stats,
+        uint32_t *levelCounts,
+        uint32_t levelCapacity,
+        uint32_t threadCount,
+        bool depthFirst)
+    {
+        CsrTree tree = {childOffsets, children, nodeCount};
+        uint32_t visitorCount = treeTraversalVisitors(threadCount);
+        if (!levelCounts)
+            levelCapacity = 0;
+        // Pad rows to a cache line so visitors do not share one
+        uint32_t rowLength = (levelCapacity + 15) & ~15u;
+
+        ScratchScope scratch;
+        NaryTreeStatsVisitor *visitors = scratch.allocate<NaryTreeStatsVisitor>(visitorCount);
+        uint32_t *rows = scratch.allocate<uint32_t>(static_cast<size_t>(visitorCount) * rowLength);
+        std::fill(rows, rows + static_cast<size_t>(visitorCount) * rowLength, 0u);
+        for (uint32_t i = 0; i < visitorCount; i++)
+            visitors[i] = NaryTreeStatsVisitor{values, rows + static_cast<size_t>(i) * rowLength, levelCapacity, 0, 0, 0};
+
+        if (depthFirst)
+            parallelTreeDfs(tree, threadCount, visitors);
+        else
+            parallelTreeBfs(tree, threadCount, visitors);
+
+        uint64_t sum = 0;
+        uint64_t visited = 0;
+        uint32_t maxDepth = 0;
+        if (levelCapacity > 0)
+            std::fill(levelCounts, levelCounts + levelCapacity, 0u);
+        for (uint32_t i = 0; i < visitorCount; i++)
+        {
+            sum += visitors[i].sum;
+            visited += visitors[i].nodeCount;
+            maxDepth = std::max(maxDepth, visitors[i].maxDepth);
+            for (uint32_t level = 0; level < levelCapacity; level++)
+                levelCounts[level] += visitors[i].levelCounts[level];
+        }
+
+        stats->sum = static_cast<double>(sum);
+        stats->nodeCount = static_cast<double>(visited);
+        stats->maxDepth = visited > 0 ? maxDepth : 0;
+    }
+
+    /**
+     * Level-synchronous parallel BFS sum of a CSR tree rooted at node 0
+     * @param values Node values
+     * @param childOffsets nodeCount + 1 offsets into children
+     * @param children Child node indices
+     * @param nodeCount Number of nodes
+     * @param threadCount Threads to use (0 = all)
+     * @return Sum of the node values
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumNaryTreeBfs_MT(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount,
+        uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 12);
+        return sumNaryTreeParallel(values, childOffsets, children, nodeCount, threadCount, false);
+    }
+
+    /**
+     * Work-stealing parallel DFS sum of a CSR tree rooted at node 0
+     * @param values Node values
+     * @param childOffsets nodeCount + 1 offsets into children
+     * @param children Child node indices
+     * @param nodeCount Number of nodes
+     * @param threadCount Threads to use (0 = all)
+     * @return Sum of the node values
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t sumNaryTreeDfs_MT(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount,
+        uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 12);
+        return sumNaryTreeParallel(values, childOffsets, children, nodeCount, threadCount, true);
+    }
+
+    /**
+     * Value sum, node count, maximum depth and nodes per level of a CSR tree
+     * rooted at node 0, with the level-synchronous parallel BFS
+     * @param values Node values
+     * @param childOffsets nodeCount + 1 offsets into children
+     * @param children Child node indices
+     * @param nodeCount Number of nodes
+     * @param stats Output aggregates
+     * @param levelCounts Output nodes per depth (may be null)
+     * @param levelCapacity Depths counted in levelCounts; deeper levels only
+     *                      count towards maxDepth
+     * @param threadCount Threads to use (0 = all)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void computeNaryTreeStatsBfs_MT(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount,
+        NaryTreeStats *stats,
+        uint32_t *levelCounts,
+        uint32_t levelCapacity,
+        uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 12);
+        computeNaryTreeStatsParallel(
+            values, childOffsets, children, nodeCount, stats, levelCounts, levelCapacity, threadCount, false);
+    }
+
+    /**
+     * computeNaryTreeStatsBfs_MT with the work-stealing parallel DFS
+     * @param values Node values
+     * @param childOffsets nodeCount + 1 offsets into children
+     * @param children Child node indices
+     * @param nodeCount Number of nodes
+     * @param stats Output aggregates
+     * @param levelCounts Output nodes per depth (may be null)
+     * @param levelCapacity Depths counted in levelCounts
+     * @param threadCount Threads to use (0 = all)
+     */
+    EMSCRIPTEN_KEEPALIVE
+    void computeNaryTreeStatsDfs_MT(
+        const uint32_t *values,
+        const uint32_t *childOffsets,
+        const uint32_t *children,
+        uint32_t nodeCount,
+        NaryTreeStats *stats,
+        uint32_t *levelCounts,
+        uint32_t levelCapacity,
+        uint32_t threadCount)
+    {
+        PROFILE_KERNEL(static_cast<uint64_t>(nodeCount) * 12);
+        computeNaryTreeStatsParallel(
+            values, childOffsets, children, nodeCount, stats, levelCounts, levelCapacity, threadCount, true);
     }
 
     struct StringMapDataHandle
@@ -895,14 +4089,6 @@ extern "C"
         std::unordered_map<std::string, uint32_t> *map;
     };
 
-    struct PreparedNumberTreeMapHandle
-    {
-        const uint32_t *keys;
-        const uint32_t *values;
-        uint32_t count;
-        std::map<uint32_t, uint32_t> *map;
-    };
-
     EMSCRIPTEN_KEEPALIVE
     StringMapDataHandle *createStringMapData(
         const char *keyBytes,
@@ -962,6 +4148,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t insertStringMapEntries(StringMapDataHandle *data)
     {
+        PROFILE_KERNEL(0);
         std::unordered_map<std::string, uint32_t> map;
         map.reserve(data->count);
         for (uint32_t i = 0; i < data->count; i++)
@@ -974,6 +4161,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint64_t lookupStringMapEntries(PreparedStringMapHandle *handle)
     {
+        PROFILE_KERNEL(0);
         uint64_t checksum = 0;
         for (uint32_t i = 0; i < handle->data->count; i++)
         {
@@ -989,6 +4177,7 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t deleteStringMapEntries(PreparedStringMapHandle *handle)
     {
+        PROFILE_KERNEL(0);
         for (uint32_t i = 0; i < handle->data->count; i++)
         {
             handle->map->erase(handle->data->keys[i]);
@@ -996,6 +4185,675 @@ extern "C"
         return static_cast<uint32_t>(handle->map->size());
     }
 
+    // ========== FLAT STRING HASH MAP ==========
+    // Open-addressing table in the Swiss-table style: one control byte per
+    // slot (7-bit hash tag, EMPTY or DELETED) probed 16 at a time with SIMD
+    // byte compares. Keys are (pointer, length) views into one contiguous
+    // key arena, so entries need no per-key heap allocation.
+
+    static const int8_t FLAT_CTRL_EMPTY = static_cast<int8_t>(0x80);
+    static const int8_t FLAT_CTRL_DELETED = static_cast<int8_t>(0xFE);
+    static const uint32_t FLAT_GROUP_WIDTH = 16;
+
+    struct FlatStringMapDataHandle
+    {
+        char *keyArena;
+        uint32_t *keyOffsets;
+        uint32_t *values;
+        uint32_t count;
+    };
+
+    struct FlatStringSlot
+    {
+        const char *key;
+        uint32_t keyLength;
+        uint32_t value;
+    };
+
+    static inline uint64_t mixHash64(uint64_t h)
+    {
+        h ^= h >> 32;
+        h *= 0xD6E8FEB86659FD93ull;
+        h ^= h >> 32;
+        return h;
+    }
+
+    /**
+     * Fast 64-bit string hash, 8 bytes per step
+     */
+    static inline uint64_t hashKeyBytes(const char *bytes, uint32_t length)
+    {
+        uint64_t h = 0x9E3779B97F4A7C15ull ^ length;
+        while (length >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            h = (h ^ (word * 0xBF58476D1CE4E5B9ull)) * 0x94D049BB133111EBull;
+            h ^= h >> 29;
+            bytes += 8;
+            length -= 8;
+        }
+        if (length > 0)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes, length);
+            h = (h ^ (word * 0xBF58476D1CE4E5B9ull)) * 0x94D049BB133111EBull;
+        }
+        return mixHash64(h);
+    }
+
+    struct FlatStringMap
+    {
+        int8_t *ctrl;
+        FlatStringSlot *slots;
+        uint32_t groupMask;
+        uint32_t capacity;
+        uint32_t size;
+        uint32_t growthLeft;
+
+        void init(uint32_t expected)
+        {
+            // Max load factor 7/8, at least one group
+            uint32_t groups = 1;
+            while (groups * FLAT_GROUP_WIDTH * 7 / 8 < expected)
+                groups *= 2;
+            capacity = groups * FLAT_GROUP_WIDTH;
+            groupMask = groups - 1;
+            ctrl = new int8_t[capacity];
+            slots = new FlatStringSlot[capacity];
+            std::memset(ctrl, FLAT_CTRL_EMPTY, capacity);
+            size = 0;
+            growthLeft = capacity * 7 / 8;
+        }
+
+        void destroy()
+        {
+            delete[] ctrl;
+            delete[] slots;
+        }
+
+        static uint32_t tagOf(uint64_t hash)
+        {
+            return static_cast<uint32_t>(hash & 0x7F);
+        }
+
+        uint32_t groupOf(uint64_t hash) const
+        {
+            return static_cast<uint32_t>(hash >> 7) & groupMask;
+        }
+
+        /**
+         * Slot index of key, or UINT32_MAX if absent
+         */
+        uint32_t find(const char *key, uint32_t keyLength, uint64_t hash) const
+        {
+            v128_t tag = wasm_i8x16_splat(static_cast<int8_t>(tagOf(hash)));
+            v128_t empty = wasm_i8x16_splat(FLAT_CTRL_EMPTY);
+            uint32_t group = groupOf(hash);
+
+            for (uint32_t probe = 1;; probe++)
+            {
+                uint32_t base = group * FLAT_GROUP_WIDTH;
+                v128_t control = wasm_v128_load(ctrl + base);
+
+                uint32_t matches = wasm_i8x16_bitmask(wasm_i8x16_eq(control, tag));
+                while (matches)
+                {
+                    uint32_t index = base + __builtin_ctz(matches);
+                    const FlatStringSlot &slot = slots[index];
+                    if (slot.keyLength == keyLength && std::memcmp(slot.key, key, keyLength) == 0)
+                        return index;
+                    matches &= matches - 1;
+                }
+
+                if (wasm_i8x16_bitmask(wasm_i8x16_eq(control, empty)))
+                    return UINT32_MAX;
+
+                // Triangular probing visits every group when the count is a power of two
+                group = (group + probe) & groupMask;
+            }
+        }
+
+        /**
+         * First EMPTY or DELETED slot on the probe path of hash
+         */
+        uint32_t findInsertSlot(uint64_t hash) const
+        {
+            uint32_t group = groupOf(hash);
+            for (uint32_t probe = 1;; probe++)
+            {
+                uint32_t base = group * FLAT_GROUP_WIDTH;
+                // EMPTY and DELETED are the only control bytes with the sign bit set
+                uint32_t free = wasm_i8x16_bitmask(wasm_v128_load(ctrl + base));
+                if (free)
+                    return base + __builtin_ctz(free);
+                group = (group + probe) & groupMask;
+            }
+        }
+
+        void rehash(uint32_t expected)
+        {
+            int8_t *oldCtrl = ctrl;
+            FlatStringSlot *oldSlots = slots;
+            uint32_t oldCapacity = capacity;
+
+            init(expected);
+            for (uint32_t i = 0; i < oldCapacity; i++)
+            {
+                if (oldCtrl[i] >= 0)
+                {
+                    const FlatStringSlot &slot = oldSlots[i];
+                    uint64_t hash = hashKeyBytes(slot.key, slot.keyLength);
+                    uint32_t index = findInsertSlot(hash);
+                    ctrl[index] = static_cast<int8_t>(tagOf(hash));
+                    slots[index] = slot;
+                    size++;
+                    growthLeft--;
+                }
+            }
+
+            delete[] oldCtrl;
+            delete[] oldSlots;
+        }
+
+        void insertOrAssign(const char *key, uint32_t keyLength, uint32_t value)
+        {
+            uint64_t hash = hashKeyBytes(key, keyLength);
+            uint32_t index = find(key, keyLength, hash);
+            if (index != UINT32_MAX)
+            {
+                slots[index].value = value;
+                return;
+            }
+
+            index = findInsertSlot(hash);
+            if (growthLeft == 0 && ctrl[index] == FLAT_CTRL_EMPTY)
+            {
+                // Out of room: double if mostly live, otherwise rebuild at the
+                // same capacity to clear tombstones
+                rehash(size * 2 > capacity * 7 / 8 ? capacity : capacity * 7 / 8);
+                index = findInsertSlot(hash);
+            }
+
+            if (ctrl[index] == FLAT_CTRL_EMPTY)
+                growthLeft--;
+            ctrl[index] = static_cast<int8_t>(tagOf(hash));
+            slots[index] = FlatStringSlot{key, keyLength, value};
+            size++;
+        }
+
+        bool erase(const char *key, uint32_t keyLength)
+        {
+            uint64_t hash = hashKeyBytes(key, keyLength);
+            uint32_t index = find(key, keyLength, hash);
+            if (index == UINT32_MAX)
+                return false;
+
+            // Probes stop at a group holding an EMPTY, so if this group
+            // already has one the slot can go straight back to EMPTY
+            uint32_t base = index & ~(FLAT_GROUP_WIDTH - 1);
+            v128_t control = wasm_v128_load(ctrl + base);
+            if (wasm_i8x16_bitmask(wasm_i8x16_eq(control, wasm_i8x16_splat(FLAT_CTRL_EMPTY))))
+            {
+                ctrl[index] = FLAT_CTRL_EMPTY;
+                growthLeft++;
+            }
+            else
+            {
+                ctrl[index] = FLAT_CTRL_DELETED;
+            }
+            size--;
+            return true;
+        }
+    };
+
+    struct PreparedFlatStringMapHandle
+    {
+        FlatStringMapDataHandle *data;
+        FlatStringMap map;
+    };
+
+    /**
+     * Copy the encoded keys into one arena (single memcpy, no per-key strings)
+     * @param keyBytes UTF-8 bytes of all keys back to back
+     * @param keyOffsets count + 1 offsets into keyBytes
+     * @param values Value per key
+     * @param count Number of entries
+     */
+    EMSCRIPTEN_KEEPALIVE
+    FlatStringMapDataHandle *createFlatStringMapData(
+        const char *keyBytes,
+        const uint32_t *keyOffsets,
+        const uint32_t *values,
+        uint32_t count)
+    {
+        uint32_t arenaSize = keyOffsets[count];
+        FlatStringMapDataHandle *handle = new FlatStringMapDataHandle;
+        handle->keyArena = new char[arenaSize > 0 ? arenaSize : 1];
+        handle->keyOffsets = new uint32_t[count + 1];
+        handle->values = new uint32_t[count];
+        handle->count = count;
+
+        if (arenaSize > 0)
+            std::memcpy(handle->keyArena, keyBytes, arenaSize);
+        std::memcpy(handle->keyOffsets, keyOffsets, (count + 1) * sizeof(uint32_t));
+        if (count > 0)
+            std::memcpy(handle->values, values, count * sizeof(uint32_t));
+        return handle;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    void freeFlatStringMapData(FlatStringMapDataHandle *handle)
+    {
+        if (!handle)
+            return;
+        delete[] handle->keyArena;
+        delete[] handle->keyOffsets;
+        delete[] handle->values;
+        delete handle;
+    }
+
+    static void insertFlatStringMapData(FlatStringMap &map, const FlatStringMapDataHandle *data)
+    {
+        for (uint32_t i = 0; i < data->count; i++)
+        {
+            uint32_t start = data->keyOffsets[i];
+            map.insertOrAssign(data->keyArena + start, data->keyOffsets[i + 1] - start, data->values[i]);
+        }
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    PreparedFlatStringMapHandle *prepareFlatStringMap(FlatStringMapDataHandle *data)
+    {
+        PreparedFlatStringMapHandle *handle = new PreparedFlatStringMapHandle;
+        handle->data = data;
+        handle->map.init(data->count);
+        insertFlatStringMapData(handle->map, data);
+        return handle;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    void freePreparedFlatStringMap(PreparedFlatStringMapHandle *handle)
+    {
+        if (!handle)
+            return;
+        handle->map.destroy();
+        delete handle;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t insertFlatStringMapEntries(FlatStringMapDataHandle *data)
+    {
+        PROFILE_KERNEL(0);
+        FlatStringMap map;
+        map.init(data->count);
+        insertFlatStringMapData(map, data);
+        uint32_t size = map.size;
+        map.destroy();
+        return size;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    uint64_t lookupFlatStringMapEntries(PreparedFlatStringMapHandle *handle)
+    {
+        PROFILE_KERNEL(0);
+        const FlatStringMapDataHandle *data = handle->data;
+        uint64_t checksum = 0;
+        for (uint32_t i = 0; i < data->count; i++)
+        {
+            uint32_t start = data->keyOffsets[i];
+            uint32_t keyLength = data->keyOffsets[i + 1] - start;
+            const char *key = data->keyArena + start;
+            uint32_t index = handle->map.find(key, keyLength, hashKeyBytes(key, keyLength));
+            if (index != UINT32_MAX)
+            {
+                checksum += handle->map.slots[index].value;
+            }
+        }
+        return checksum;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t deleteFlatStringMapEntries(PreparedFlatStringMapHandle *handle)
+    {
+        PROFILE_KERNEL(0);
+        const FlatStringMapDataHandle *data = handle->data;
+        for (uint32_t i = 0; i < data->count; i++)
+        {
+            uint32_t start = data->keyOffsets[i];
+            handle->map.erase(data->keyArena + start, data->keyOffsets[i + 1] - start);
+        }
+        return handle->map.size;
+    }
+
+    // ========== B+-TREE NUMBER MAP ==========
+    // Ordered uint32 -> uint32 map. A node's key block is exactly one 64-byte
+    // cache line (16 keys) and is searched with SIMD compares. Nodes come
+    // from a pooled array and link to each other by index, so the tree is a
+    // few allocations rather than one per entry. Leaves are chained
+    // left-to-right for range scans.
+    //
+    // Deletes do not rebalance. Underfull or empty leaves stay in the chain
+    // and scans skip them, and inner separators remain valid routing bounds.
+    // A tree that becomes empty is reset.
+
+    static const uint32_t BTREE_NODE_KEYS = 16;
+    static const uint32_t BTREE_NULL = UINT32_MAX;
+
+    struct alignas(64) BTreeNode
+    {
+        uint32_t keys[BTREE_NODE_KEYS];
+        // Leaf: values. Inner: child node indices (count + 1 in use)
+        uint32_t slots[BTREE_NODE_KEYS + 1];
+        uint32_t count;
+        // Leaf: next leaf to the right. Pooled: next free node
+        uint32_t next;
+        uint32_t isLeaf;
+    };
+
+    /**
+     * Bit mask covering the first `count` lanes of a 16-lane byte bitmask
+     * built from four i32x4 compares (4 bits per lane)
+     */
+    static inline uint64_t btreeLaneMask(uint32_t count)
+    {
+        return count >= BTREE_NODE_KEYS ? ~0ull : (1ull << (count * 4)) - 1;
+    }
+
+    /**
+     * Number of keys[0..count) strictly below target (lower_bound position)
+     */
+    static inline uint32_t btreeCountLess(const uint32_t *keys, uint32_t count, uint32_t target)
+    {
+        v128_t needle = wasm_i32x4_splat(static_cast<int32_t>(target));
+        uint64_t mask = 0;
+        for (uint32_t i = 0; i < BTREE_NODE_KEYS; i += 4)
+        {
+            v128_t less = wasm_u32x4_gt(needle, wasm_v128_load(keys + i));
+            mask |= static_cast<uint64_t>(wasm_i8x16_bitmask(less)) << (i * 4);
+        }
+        return static_cast<uint32_t>(__builtin_popcountll(mask & btreeLaneMask(count))) / 4;
+    }
+
+    /**
+     * Number of keys[0..count) at or below target (upper_bound position)
+     */
+    static inline uint32_t btreeCountLessEqual(const uint32_t *keys, uint32_t count, uint32_t target)
+    {
+        v128_t needle = wasm_i32x4_splat(static_cast<int32_t>(target));
+        uint64_t mask = 0;
+        for (uint32_t i = 0; i < BTREE_NODE_KEYS; i += 4)
+        {
+            v128_t greater = wasm_u32x4_gt(wasm_v128_load(keys + i), needle);
+            mask |= static_cast<uint64_t>(wasm_i8x16_bitmask(greater)) << (i * 4);
+        }
+        return count - static_cast<uint32_t>(__builtin_popcountll(mask & btreeLaneMask(count))) / 4;
+    }
+
+    struct BPlusTree
+    {
+        std::vector<BTreeNode> nodes;
+        uint32_t root;
+        uint32_t size;
+
+        void init(uint32_t expected)
+        {
+            nodes.clear();
+            nodes.reserve(expected / (BTREE_NODE_KEYS / 2) + 2);
+            size = 0;
+            root = allocateNode(true);
+        }
+
+        uint32_t allocateNode(bool leaf)
+        {
+            // Insert-only tree: nodes are never freed, so they are appended
+            uint32_t index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+            BTreeNode &node = nodes[index];
+            std::memset(&node, 0, sizeof(BTreeNode));
+            node.next = BTREE_NULL;
+            node.isLeaf = leaf ? 1 : 0;
+            return index;
+        }
+
+        uint32_t findLeaf(uint32_t key) const
+        {
+            uint32_t index = root;
+            while (!nodes[index].isLeaf)
+            {
+                const BTreeNode &inner = nodes[index];
+                index = inner.slots[btreeCountLessEqual(inner.keys, inner.count, key)];
+            }
+            return index;
+        }
+
+        bool find(uint32_t key, uint32_t &value) const
+        {
+            const BTreeNode &leaf = nodes[findLeaf(key)];
+            uint32_t pos = btreeCountLess(leaf.keys, leaf.count, key);
+            if (pos < leaf.count && leaf.keys[pos] == key)
+            {
+                value = leaf.slots[pos];
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Position of the first entry with key >= target, following the leaf
+         * chain past empty leaves. Returns false when there is none.
+         */
+        bool lowerBound(uint32_t key, uint32_t &leafIndex, uint32_t &pos) const
+        {
+            leafIndex = findLeaf(key);
+            pos = btreeCountLess(nodes[leafIndex].keys, nodes[leafIndex].count, key);
+            while (pos >= nodes[leafIndex].count)
+            {
+                leafIndex = nodes[leafIndex].next;
+                if (leafIndex == BTREE_NULL)
+                    return false;
+                pos = 0;
+            }
+            return true;
+        }
+
+        static void insertIntoNode(BTreeNode &node, uint32_t pos, uint32_t key, uint32_t slot)
+        {
+            // Leaves keep the slot beside its key; inner nodes keep the new
+            // child to the right of its separator
+            uint32_t slotPos = node.isLeaf ? pos : pos + 1;
+            std::memmove(node.keys + pos + 1, node.keys + pos, (node.count - pos) * sizeof(uint32_t));
+            std::memmove(node.slots + slotPos + 1, node.slots + slotPos,
+                         (node.count + (node.isLeaf ? 0 : 1) - slotPos) * sizeof(uint32_t));
+            node.keys[pos] = key;
+            node.slots[slotPos] = slot;
+            node.count++;
+        }
+
+        /**
+         * Insert into the subtree rooted at nodeIndex. When that node splits,
+         * returns true with the new right sibling and its separator key.
+         */
+        bool insertInto(uint32_t nodeIndex, uint32_t key, uint32_t value, uint32_t &splitKey, uint32_t &splitNode)
+        {
+            const uint32_t half = BTREE_NODE_KEYS / 2;
+
+            if (nodes[nodeIndex].isLeaf)
+            {
+                BTreeNode *leaf = &nodes[nodeIndex];
+                uint32_t pos = btreeCountLess(leaf->keys, leaf->count, key);
+                if (pos < leaf->count && leaf->keys[pos] == key)
+                {
+                    leaf->slots[pos] = value;
+                    return false;
+                }
+                size++;
+                if (leaf->count < BTREE_NODE_KEYS)
+                {
+                    insertIntoNode(*leaf, pos, key, value);
+                    return false;
+                }
+
+                uint32_t rightIndex = allocateNode(true);
+                leaf = &nodes[nodeIndex];
+                BTreeNode *right = &nodes[rightIndex];
+                std::memcpy(right->keys, leaf->keys + half, half * sizeof(uint32_t));
+                std::memcpy(right->slots, leaf->slots + half, half * sizeof(uint32_t));
+                right->count = half;
+                leaf->count = half;
+                right->next = leaf->next;
+                leaf->next = rightIndex;
+
+                if (pos <= half)
+                    insertIntoNode(*leaf, pos, key, value);
+                else
+                    insertIntoNode(*right, pos - half, key, value);
+
+                splitKey = right->keys[0];
+                splitNode = rightIndex;
+                return true;
+            }
+
+            uint32_t childPos = btreeCountLessEqual(nodes[nodeIndex].keys, nodes[nodeIndex].count, key);
+            uint32_t childKey;
+            uint32_t childNode;
+            if (!insertInto(nodes[nodeIndex].slots[childPos], key, value, childKey, childNode))
+                return false;
+
+            BTreeNode *inner = &nodes[nodeIndex];
+            if (inner->count < BTREE_NODE_KEYS)
+            {
+                insertIntoNode(*inner, childPos, childKey, childNode);
+                return false;
+            }
+
+            // Full inner node: lay out all 17 separators / 18 children, keep
+            // the lower half, push the middle separator up
+            uint32_t keys[BTREE_NODE_KEYS + 1];
+            uint32_t children[BTREE_NODE_KEYS + 2];
+            std::memcpy(keys, inner->keys, childPos * sizeof(uint32_t));
+            keys[childPos] = childKey;
+            std::memcpy(keys + childPos + 1, inner->keys + childPos, (BTREE_NODE_KEYS - childPos) * sizeof(uint32_t));
+            std::memcpy(children, inner->slots, (childPos + 1) * sizeof(uint32_t));
+            children[childPos + 1] = childNode;
+            std::memcpy(children + childPos + 2, inner->slots + childPos + 1, (BTREE_NODE_KEYS - childPos) * sizeof(uint32_t));
+
+            uint32_t rightIndex = allocateNode(false);
+            inner = &nodes[nodeIndex];
+            BTreeNode *right = &nodes[rightIndex];
+
+            std::memcpy(inner->keys, keys, half * sizeof(uint32_t));
+            std::memcpy(inner->slots, children, (half + 1) * sizeof(uint32_t));
+            inner->count = half;
+
+            std::memcpy(right->keys, keys + half + 1, half * sizeof(uint32_t));
+            std::memcpy(right->slots, children + half + 1, (half + 1) * sizeof(uint32_t));
+            right->count = half;
+
+            splitKey = keys[half];
+            splitNode = rightIndex;
+            return true;
+        }
+
+        void insertOrAssign(uint32_t key, uint32_t value)
+        {
+            uint32_t splitKey;
+            uint32_t splitNode;
+            if (insertInto(root, key, value, splitKey, splitNode))
+            {
+                uint32_t newRoot = allocateNode(false);
+                BTreeNode &node = nodes[newRoot];
+                node.keys[0] = splitKey;
+                node.slots[0] = root;
+                node.slots[1] = splitNode;
+                node.count = 1;
+                root = newRoot;
+            }
+        }
+
+        bool erase(uint32_t key)
+        {
+            BTreeNode &leaf = nodes[findLeaf(key)];
+            uint32_t pos = btreeCountLess(leaf.keys, leaf.count, key);
+            if (pos >= leaf.count || leaf.keys[pos] != key)
+                return false;
+
+            std::memmove(leaf.keys + pos, leaf.keys + pos + 1, (leaf.count - pos - 1) * sizeof(uint32_t));
+            std::memmove(leaf.slots + pos, leaf.slots + pos + 1, (leaf.count - pos - 1) * sizeof(uint32_t));
+            leaf.count--;
+            size--;
+            if (size == 0)
+                init(0);
+            return true;
+        }
+
+        /**
+         * Build the tree bottom-up from strictly ascending keys: full leaves,
+         * then each inner level over the one below
+         */
+        void bulkLoad(const uint32_t *keys, const uint32_t *values, uint32_t count)
+        {
+            init(count);
+            if (count == 0)
+                return;
+            // Drop the empty root leaf init() created
+            nodes.clear();
+
+            std::vector<uint32_t> level;
+            std::vector<uint32_t> levelMinKeys;
+            uint32_t previousLeaf = BTREE_NULL;
+            for (uint32_t start = 0; start < count; start += BTREE_NODE_KEYS)
+            {
+                uint32_t leafCount = std::min(BTREE_NODE_KEYS, count - start);
+                uint32_t leafIndex = allocateNode(true);
+                BTreeNode &leaf = nodes[leafIndex];
+                std::memcpy(leaf.keys, keys + start, leafCount * sizeof(uint32_t));
+                std::memcpy(leaf.slots, values + start, leafCount * sizeof(uint32_t));
+                leaf.count = leafCount;
+                if (previousLeaf != BTREE_NULL)
+                    nodes[previousLeaf].next = leafIndex;
+                previousLeaf = leafIndex;
+                level.push_back(leafIndex);
+                levelMinKeys.push_back(keys[start]);
+            }
+
+            const uint32_t fanout = BTREE_NODE_KEYS + 1;
+            while (level.size() > 1)
+            {
+                std::vector<uint32_t> parents;
+                std::vector<uint32_t> parentMinKeys;
+                for (size_t start = 0; start < level.size(); start += fanout)
+                {
+                    uint32_t childCount = static_cast<uint32_t>(std::min<size_t>(fanout, level.size() - start));
+                    uint32_t innerIndex = allocateNode(false);
+                    BTreeNode &inner = nodes[innerIndex];
+                    for (uint32_t c = 0; c < childCount; c++)
+                    {
+                        inner.slots[c] = level[start + c];
+                        if (c > 0)
+                            inner.keys[c - 1] = levelMinKeys[start + c];
+                    }
+                    inner.count = childCount - 1;
+                    parents.push_back(innerIndex);
+                    parentMinKeys.push_back(levelMinKeys[start]);
+                }
+                level.swap(parents);
+                levelMinKeys.swap(parentMinKeys);
+            }
+
+            root = level[0];
+            size = count;
+        }
+    };
+
+    struct PreparedNumberTreeMapHandle
+    {
+        const uint32_t *keys;
+        const uint32_t *values;
+        uint32_t count;
+        BPlusTree *map;
+    };
+
     EMSCRIPTEN_KEEPALIVE
     PreparedNumberTreeMapHandle *prepareNumberTreeMap(const uint32_t *keys, const uint32_t *values, uint32_t count)
     {
@@ -1003,11 +4861,29 @@ extern "C"
         handle->keys = keys;
         handle->values = values;
         handle->count = count;
-        handle->map = new std::map<uint32_t, uint32_t>();
+        handle->map = new BPlusTree();
+
+        // Sort (key, input index) pairs; the last index of a run of equal
+        // keys is the value a sequence of inserts would have kept
+        std::vector<uint64_t> order(count);
+        for (uint32_t i = 0; i < count; i++)
+            order[i] = (static_cast<uint64_t>(keys[i]) << 32) | i;
+        std::sort(order.begin(), order.end());
+
+        std::vector<uint32_t> sortedKeys;
+        std::vector<uint32_t> sortedValues;
+        sortedKeys.reserve(count);
+        sortedValues.reserve(count);
         for (uint32_t i = 0; i < count; i++)
         {
-            (*handle->map)[keys[i]] = values[i];
+            uint32_t key = static_cast<uint32_t>(order[i] >> 32);
+            if (i + 1 < count && static_cast<uint32_t>(order[i + 1] >> 32) == key)
+                continue;
+            sortedKeys.push_back(key);
+            sortedValues.push_back(values[static_cast<uint32_t>(order[i])]);
         }
+
+        handle->map->bulkLoad(sortedKeys.data(), sortedValues.data(), static_cast<uint32_t>(sortedKeys.size()));
         return handle;
     }
 
@@ -1023,24 +4899,27 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t insertNumberTreeMapEntries(const uint32_t *keys, const uint32_t *values, uint32_t count)
     {
-        std::map<uint32_t, uint32_t> map;
+        PROFILE_KERNEL(0);
+        BPlusTree map;
+        map.init(count);
         for (uint32_t i = 0; i < count; i++)
         {
-            map[keys[i]] = values[i];
+            map.insertOrAssign(keys[i], values[i]);
         }
-        return static_cast<uint32_t>(map.size());
+        return map.size;
     }
 
     EMSCRIPTEN_KEEPALIVE
     uint64_t lookupNumberTreeMapEntries(PreparedNumberTreeMapHandle *handle)
     {
+        PROFILE_KERNEL(0);
         uint64_t checksum = 0;
         for (uint32_t i = 0; i < handle->count; i++)
         {
-            auto found = handle->map->find(handle->keys[i]);
-            if (found != handle->map->end())
+            uint32_t value;
+            if (handle->map->find(handle->keys[i], value))
             {
-                checksum += found->second;
+                checksum += value;
             }
         }
         return checksum;
@@ -1049,11 +4928,76 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE
     uint32_t deleteNumberTreeMapEntries(PreparedNumberTreeMapHandle *handle)
     {
+        PROFILE_KERNEL(0);
         for (uint32_t i = 0; i < handle->count; i++)
         {
             handle->map->erase(handle->keys[i]);
         }
-        return static_cast<uint32_t>(handle->map->size());
+        return handle->map->size;
+    }
+
+    /**
+     * Find the first entry whose key is >= key
+     * @param handle Prepared map
+     * @param key Search key
+     * @param outEntry Receives [key, value] of the entry found (2 x uint32_t)
+     * @return 1 if an entry was found, 0 if every key is below `key`
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t lowerBoundNumberTreeMap(PreparedNumberTreeMapHandle *handle, uint32_t key, uint32_t *outEntry)
+    {
+        const BPlusTree &map = *handle->map;
+        uint32_t leafIndex;
+        uint32_t pos;
+        if (!map.lowerBound(key, leafIndex, pos))
+            return 0;
+        outEntry[0] = map.nodes[leafIndex].keys[pos];
+        outEntry[1] = map.nodes[leafIndex].slots[pos];
+        return 1;
+    }
+
+    /**
+     * Copy entries with minKey <= key <= maxKey in ascending key order
+     * @param handle Prepared map
+     * @param minKey Inclusive lower bound
+     * @param maxKey Inclusive upper bound
+     * @param outKeys Receives up to maxCount keys
+     * @param outValues Receives the matching values
+     * @param maxCount Capacity of the output arrays
+     * @return Number of entries written
+     */
+    EMSCRIPTEN_KEEPALIVE
+    uint32_t rangeScanNumberTreeMap(
+        PreparedNumberTreeMapHandle *handle,
+        uint32_t minKey,
+        uint32_t maxKey,
+        uint32_t *outKeys,
+        uint32_t *outValues,
+        uint32_t maxCount)
+    {
+        PROFILE_KERNEL(0);
+        const BPlusTree &map = *handle->map;
+        uint32_t leafIndex;
+        uint32_t pos;
+        if (minKey > maxKey || maxCount == 0 || !map.lowerBound(minKey, leafIndex, pos))
+            return 0;
+
+        uint32_t written = 0;
+        while (leafIndex != BTREE_NULL)
+        {
+            const BTreeNode &leaf = map.nodes[leafIndex];
+            for (; pos < leaf.count; pos++)
+            {
+                if (leaf.keys[pos] > maxKey || written == maxCount)
+                    return written;
+                outKeys[written] = leaf.keys[pos];
+                outValues[written] = leaf.slots[pos];
+                written++;
+            }
+            leafIndex = leaf.next;
+            pos = 0;
+        }
+        return written;
     }
 
 } // extern "C"
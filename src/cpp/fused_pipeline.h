@@ -0,0 +1,324 @@
+/**
+ * Fused map -> filter -> reduce pipelines over uint32 arrays
+ *
+ * A Pipeline is a validated list of stages (elementwise maps and row
+ * predicates) ending in one reduction. run() streams the input through it
+ * in blocks of BLOCK_LENGTH elements: a block is copied into an L1-resident
+ * buffer, every stage sweeps it there with SIMD, and the reduction folds it
+ * into a Partial. The array is read from memory once however many stages
+ * there are, and the stage dispatch (one switch) is paid per block, not
+ * per element.
+ *
+ * Maps wrap modulo 2^32 like addToArray / multiplyArray. Predicates clear
+ * rows in a lane mask (0 / ~0 per row); later maps still touch masked rows,
+ * the reduction skips them.
+ *
+ * Templates cannot have C linkage, so the exported shims live in
+ * array_processor.cpp (FUSED PIPELINES section and runPipeline_MT).
+ */
+
+#ifndef ARRAY_PROCESSOR_FUSED_PIPELINE_H
+#define ARRAY_PROCESSOR_FUSED_PIPELINE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <wasm_simd128.h>
+
+namespace fused_pipeline
+{
+
+enum Op
+{
+    OP_ADD = 0,
+    OP_MULTIPLY = 1,
+    OP_AND = 2,
+    OP_XOR = 3,
+    OP_SHIFT_RIGHT = 4,
+    // Clamp to at most / at least the operand
+    OP_MIN = 5,
+    OP_MAX = 6,
+    // Predicates keep the rows where they hold (FilterOp order, offset by 16)
+    OP_KEEP_GREATER = 16,
+    OP_KEEP_LESS = 17,
+    OP_KEEP_EQUAL = 18,
+    // operand <= value <= operand2
+    OP_KEEP_BETWEEN = 19
+};
+
+enum Reduce
+{
+    REDUCE_SUM = 0,
+    REDUCE_COUNT = 1,
+    REDUCE_MIN = 2,
+    REDUCE_MAX = 3
+};
+
+// Stages arrive from JS as STAGE_WORDS uint32 each: op, operand, operand2
+static const uint32_t STAGE_WORDS = 3;
+static const uint32_t MAX_STAGES = 32;
+// 8 KB of values and 8 KB of row mask stay in L1 across the stages
+static const uint32_t BLOCK_LENGTH = 2048;
+
+struct Stage
+{
+    uint32_t op;
+    uint32_t operand;
+    uint32_t operand2;
+};
+
+struct Pipeline
+{
+    uint32_t stageCount;
+    uint32_t reduce;
+    // Some stage is a predicate, so every block needs the row mask
+    bool filtered;
+    Stage stages[MAX_STAGES];
+};
+
+// Reduction over part of the input; value means nothing while count is 0
+struct Partial
+{
+    uint64_t value;
+    uint64_t count;
+};
+
+static inline bool isPredicate(uint32_t op)
+{
+    return op >= OP_KEEP_GREATER && op <= OP_KEEP_BETWEEN;
+}
+
+/**
+ * Validate stageCount stages of STAGE_WORDS words into pipeline
+ * @return false for an unknown op or reduction or too many stages
+ */
+static inline bool compile(const uint32_t *words, uint32_t stageCount, uint32_t reduce, Pipeline &pipeline)
+{
+    if (stageCount > MAX_STAGES || reduce > REDUCE_MAX)
+        return false;
+
+    pipeline.stageCount = stageCount;
+    pipeline.reduce = reduce;
+    pipeline.filtered = false;
+    for (uint32_t s = 0; s < stageCount; s++)
+    {
+        Stage stage = {words[s * STAGE_WORDS], words[s * STAGE_WORDS + 1], words[s * STAGE_WORDS + 2]};
+        if (stage.op > OP_MAX && !isPredicate(stage.op))
+            return false;
+        // wasm shifts by the count modulo 32; the scalar reference does too
+        if (stage.op == OP_SHIFT_RIGHT)
+            stage.operand &= 31;
+        pipeline.filtered = pipeline.filtered || isPredicate(stage.op);
+        pipeline.stages[s] = stage;
+    }
+    return true;
+}
+
+/**
+ * values[i] = map(values[i]); length is a multiple of 4
+ */
+template <typename Map>
+static inline void mapBlock(uint32_t *values, uint32_t length, Map map)
+{
+    for (uint32_t i = 0; i < length; i += 4)
+        wasm_v128_store(values + i, map(wasm_v128_load(values + i)));
+}
+
+/**
+ * mask[i] &= keep(values[i]); length is a multiple of 4
+ */
+template <typename Keep>
+static inline void maskBlock(const uint32_t *values, uint32_t *mask, uint32_t length, Keep keep)
+{
+    for (uint32_t i = 0; i < length; i += 4)
+        wasm_v128_store(mask + i, wasm_v128_and(wasm_v128_load(mask + i), keep(wasm_v128_load(values + i))));
+}
+
+static inline void applyStage(const Stage &stage, uint32_t *values, uint32_t *mask, uint32_t length)
+{
+    const v128_t a = wasm_i32x4_splat(static_cast<int32_t>(stage.operand));
+    const v128_t b = wasm_i32x4_splat(static_cast<int32_t>(stage.operand2));
+    const uint32_t shift = stage.operand;
+    switch (stage.op)
+    {
+    case OP_ADD:
+        mapBlock(values, length, [a](v128_t v) { return wasm_i32x4_add(v, a); });
+        break;
+    case OP_MULTIPLY:
+        mapBlock(values, length, [a](v128_t v) { return wasm_i32x4_mul(v, a); });
+        break;
+    case OP_AND:
+        mapBlock(values, length, [a](v128_t v) { return wasm_v128_and(v, a); });
+        break;
+    case OP_XOR:
+        mapBlock(values, length, [a](v128_t v) { return wasm_v128_xor(v, a); });
+        break;
+    case OP_SHIFT_RIGHT:
+        mapBlock(values, length, [shift](v128_t v) { return wasm_u32x4_shr(v, shift); });
+        break;
+    case OP_MIN:
+        mapBlock(values, length, [a](v128_t v) { return wasm_u32x4_min(v, a); });
+        break;
+    case OP_MAX:
+        mapBlock(values, length, [a](v128_t v) { return wasm_u32x4_max(v, a); });
+        break;
+    case OP_KEEP_GREATER:
+        maskBlock(values, mask, length, [a](v128_t v) { return wasm_u32x4_gt(v, a); });
+        break;
+    case OP_KEEP_LESS:
+        maskBlock(values, mask, length, [a](v128_t v) { return wasm_u32x4_gt(a, v); });
+        break;
+    case OP_KEEP_EQUAL:
+        maskBlock(values, mask, length, [a](v128_t v) { return wasm_i32x4_eq(v, a); });
+        break;
+    case OP_KEEP_BETWEEN:
+        maskBlock(values, mask, length, [a, b](v128_t v) {
+            return wasm_v128_not(wasm_v128_or(wasm_u32x4_gt(a, v), wasm_u32x4_gt(v, b)));
+        });
+        break;
+    }
+}
+
+static inline uint64_t sumLanes64(v128_t acc)
+{
+    uint64_t lanes[2];
+    wasm_v128_store(lanes, acc);
+    return lanes[0] + lanes[1];
+}
+
+static inline uint32_t foldLanes32(v128_t acc, bool takeMin)
+{
+    uint32_t lanes[4];
+    wasm_v128_store(lanes, acc);
+    uint32_t result = lanes[0];
+    for (uint32_t j = 1; j < 4; j++)
+        result = takeMin ? std::min(result, lanes[j]) : std::max(result, lanes[j]);
+    return result;
+}
+
+/**
+ * Reduce one block; mask is null when every row of the block is kept
+ * (no predicate and no padding). length is a multiple of 4.
+ */
+static inline Partial reduceBlock(uint32_t reduce, const uint32_t *values, const uint32_t *mask, uint32_t length)
+{
+    Partial partial = {0, length};
+    if (mask != nullptr)
+    {
+        // Kept rows are ~0: the top bit counts them
+        v128_t counts = wasm_i32x4_splat(0);
+        for (uint32_t i = 0; i < length; i += 4)
+            counts = wasm_i32x4_add(counts, wasm_u32x4_shr(wasm_v128_load(mask + i), 31));
+        partial.count = sumLanes64(wasm_u64x2_extend_low_u32x4(counts)) + sumLanes64(wasm_u64x2_extend_high_u32x4(counts));
+    }
+
+    switch (reduce)
+    {
+    case REDUCE_SUM:
+    {
+        v128_t low = wasm_i64x2_splat(0);
+        v128_t high = wasm_i64x2_splat(0);
+        for (uint32_t i = 0; i < length; i += 4)
+        {
+            v128_t v = wasm_v128_load(values + i);
+            if (mask != nullptr)
+                v = wasm_v128_and(v, wasm_v128_load(mask + i));
+            low = wasm_i64x2_add(low, wasm_u64x2_extend_low_u32x4(v));
+            high = wasm_i64x2_add(high, wasm_u64x2_extend_high_u32x4(v));
+        }
+        partial.value = sumLanes64(low) + sumLanes64(high);
+        break;
+    }
+    case REDUCE_MIN:
+    {
+        // Dropped rows become 0xFFFFFFFF, the identity of min
+        v128_t acc = wasm_i32x4_splat(-1);
+        for (uint32_t i = 0; i < length; i += 4)
+        {
+            v128_t v = wasm_v128_load(values + i);
+            if (mask != nullptr)
+                v = wasm_v128_or(v, wasm_v128_not(wasm_v128_load(mask + i)));
+            acc = wasm_u32x4_min(acc, v);
+        }
+        partial.value = foldLanes32(acc, true);
+        break;
+    }
+    case REDUCE_MAX:
+    {
+        // Dropped rows become 0, the identity of max
+        v128_t acc = wasm_i32x4_splat(0);
+        for (uint32_t i = 0; i < length; i += 4)
+        {
+            v128_t v = wasm_v128_load(values + i);
+            if (mask != nullptr)
+                v = wasm_v128_and(v, wasm_v128_load(mask + i));
+            acc = wasm_u32x4_max(acc, v);
+        }
+        partial.value = foldLanes32(acc, false);
+        break;
+    }
+    default:
+        break;
+    }
+    return partial;
+}
+
+static inline void combine(uint32_t reduce, Partial &into, const Partial &part)
+{
+    if (part.count == 0)
+        return;
+    if (into.count == 0)
+        into.value = part.value;
+    else if (reduce == REDUCE_SUM)
+        into.value += part.value;
+    else if (reduce == REDUCE_MIN)
+        into.value = std::min(into.value, part.value);
+    else if (reduce == REDUCE_MAX)
+        into.value = std::max(into.value, part.value);
+    into.count += part.count;
+}
+
+/**
+ * Run pipeline over arr[0, length)
+ * @param values Scratch of BLOCK_LENGTH uint32, 16-byte aligned
+ * @param mask Scratch of BLOCK_LENGTH uint32, 16-byte aligned
+ */
+static inline Partial run(const Pipeline &pipeline, const uint32_t *arr, uint32_t length, uint32_t *values, uint32_t *mask)
+{
+    Partial total = {0, 0};
+    for (uint32_t start = 0; start < length; start += BLOCK_LENGTH)
+    {
+        uint32_t rows = std::min(BLOCK_LENGTH, length - start);
+        uint32_t padded = (rows + 3) & ~3u;
+        std::memcpy(values, arr + start, static_cast<size_t>(rows) * sizeof(uint32_t));
+        std::fill(values + rows, values + padded, 0u);
+
+        // The padding lanes of a short last block are masked off too
+        bool masked = pipeline.filtered || padded != rows;
+        if (masked)
+        {
+            std::fill(mask, mask + rows, 0xFFFFFFFFu);
+            std::fill(mask + rows, mask + padded, 0u);
+        }
+
+        for (uint32_t s = 0; s < pipeline.stageCount; s++)
+            applyStage(pipeline.stages[s], values, mask, padded);
+        combine(pipeline.reduce, total, reduceBlock(pipeline.reduce, values, masked ? mask : nullptr, padded));
+    }
+    return total;
+}
+
+/**
+ * Value returned to JS: the kept row count for COUNT, 0 for MIN / MAX
+ * with no kept rows
+ */
+static inline uint64_t result(const Pipeline &pipeline, const Partial &total)
+{
+    if (pipeline.reduce == REDUCE_COUNT)
+        return total.count;
+    return total.count == 0 ? 0 : total.value;
+}
+
+} // namespace fused_pipeline
+
+#endif // ARRAY_PROCESSOR_FUSED_PIPELINE_H
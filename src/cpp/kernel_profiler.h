@@ -0,0 +1,189 @@
+/**
+ * In-module kernel instrumentation
+ *
+ * An export starts with PROFILE_KERNEL(bytes). While profiling is enabled,
+ * the scope times the call with emscripten_get_now(). It adds the call,
+ * the bytes processed and the time to that kernel's counters, and it
+ * writes one event into a fixed ring. Scopes nested inside another
+ * profiled call are not recorded, so kernel time is never counted twice.
+ *
+ * Everything lives in one static ProfileBuffer. JS finds it through
+ * getProfileBuffer() and reads it straight from the heap. Only the thread
+ * that calls into the module records: scopes opened on WorkStealingPool
+ * workers (quickSort inside mergeSort_MT, ...) do nothing, so the buffer
+ * has a single writer. The nesting depth is per thread.
+ */
+
+#ifndef ARRAY_PROCESSOR_KERNEL_PROFILER_H
+#define ARRAY_PROCESSOR_KERNEL_PROFILER_H
+
+#include <emscripten.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "thread_pool.h"
+
+#if ARRAY_PROCESSOR_THREADS
+#include <mutex>
+#endif
+
+// Build with -DARRAY_PROCESSOR_PROFILING=0 to compile the scopes out
+#ifndef ARRAY_PROCESSOR_PROFILING
+#define ARRAY_PROCESSOR_PROFILING 1
+#endif
+
+static const uint32_t PROFILE_MAX_KERNELS = 128;
+static const uint32_t PROFILE_EVENT_CAPACITY = 4096;
+static const uint32_t PROFILE_NAME_BYTES = 48;
+
+/**
+ * Counters of one kernel since the last reset. The name is NUL-terminated.
+ */
+struct ProfileKernel
+{
+    char name[PROFILE_NAME_BYTES];
+    double calls;
+    double bytes;
+    double totalMs;
+};
+
+struct ProfileEvent
+{
+    uint32_t kernel;
+    uint32_t reserved;
+    double startMs;
+    double durationMs;
+    double bytes;
+};
+
+/**
+ * Layout read by src/framework/wasm-profile.ts
+ */
+struct ProfileBuffer
+{
+    uint32_t enabled;
+    uint32_t kernelCount;
+    uint32_t eventCapacity;
+    uint32_t reserved;
+    // Events written since the last reset; event i is in slot
+    // i % eventCapacity, and the newest eventCapacity events are kept
+    double eventCount;
+    ProfileKernel kernels[PROFILE_MAX_KERNELS];
+    ProfileEvent events[PROFILE_EVENT_CAPACITY];
+};
+
+// wasm-profile.ts reads these at fixed offsets
+static_assert(sizeof(ProfileKernel) == 72 && sizeof(ProfileEvent) == 32, "profile layout changed");
+static_assert(offsetof(ProfileBuffer, kernels) == 24, "profile layout changed");
+
+class KernelProfiler
+{
+public:
+    static ProfileBuffer &buffer()
+    {
+        static ProfileBuffer profile = {0, 0, PROFILE_EVENT_CAPACITY, 0, 0, {}, {}};
+        return profile;
+    }
+
+    /**
+     * Kernel slot for name; kernels past PROFILE_MAX_KERNELS share the last
+     * slot, which is labelled "(other)"
+     */
+    static uint32_t registerKernel(const char *name)
+    {
+#if ARRAY_PROCESSOR_THREADS
+        // A kernel's first call may come from a pool worker, concurrently
+        // with another kernel's
+        static std::mutex registerMutex;
+        std::lock_guard<std::mutex> lock(registerMutex);
+#endif
+        ProfileBuffer &profile = buffer();
+        if (profile.kernelCount == PROFILE_MAX_KERNELS)
+            return PROFILE_MAX_KERNELS - 1;
+
+        uint32_t id = profile.kernelCount++;
+        if (id == PROFILE_MAX_KERNELS - 1)
+            name = "(other)";
+        std::strncpy(profile.kernels[id].name, name, PROFILE_NAME_BYTES - 1);
+        return id;
+    }
+
+    /**
+     * Zero the counters and events; registered names are kept
+     */
+    static void reset()
+    {
+        ProfileBuffer &profile = buffer();
+        for (uint32_t i = 0; i < profile.kernelCount; i++)
+        {
+            profile.kernels[i].calls = 0;
+            profile.kernels[i].bytes = 0;
+            profile.kernels[i].totalMs = 0;
+        }
+        profile.eventCount = 0;
+    }
+
+    static void record(uint32_t kernel, double startMs, double durationMs, double bytes)
+    {
+        ProfileBuffer &profile = buffer();
+        ProfileKernel &counters = profile.kernels[kernel];
+        counters.calls++;
+        counters.bytes += bytes;
+        counters.totalMs += durationMs;
+
+        uint64_t index = static_cast<uint64_t>(profile.eventCount);
+        profile.events[index % PROFILE_EVENT_CAPACITY] = ProfileEvent{kernel, 0, startMs, durationMs, bytes};
+        profile.eventCount = static_cast<double>(index + 1);
+    }
+
+    // Profiled calls currently open on the calling thread
+    static uint32_t &depth()
+    {
+        static thread_local uint32_t openScopes = 0;
+        return openScopes;
+    }
+};
+
+/**
+ * Times one kernel call when profiling is on, no profiled call is open on
+ * this thread and the thread is not a pool worker
+ */
+class KernelProfileScope
+{
+public:
+    KernelProfileScope(uint32_t kernel, double bytes) : kernel_(kernel), bytes_(bytes), startMs_(NOT_PROFILING)
+    {
+        if (!WorkStealingPool::onWorkerThread() && KernelProfiler::buffer().enabled)
+            startMs_ = KernelProfiler::depth()++ == 0 ? emscripten_get_now() : NESTED;
+    }
+
+    ~KernelProfileScope()
+    {
+        if (startMs_ == NOT_PROFILING)
+            return;
+        if (startMs_ != NESTED)
+            KernelProfiler::record(kernel_, startMs_, emscripten_get_now() - startMs_, bytes_);
+        KernelProfiler::depth()--;
+    }
+
+    KernelProfileScope(const KernelProfileScope &) = delete;
+    KernelProfileScope &operator=(const KernelProfileScope &) = delete;
+
+private:
+    static constexpr double NOT_PROFILING = -1;
+    static constexpr double NESTED = -2;
+
+    uint32_t kernel_;
+    double bytes_;
+    double startMs_;
+};
+
+#if ARRAY_PROCESSOR_PROFILING
+#define PROFILE_KERNEL(bytes)                                                                  \
+    static const uint32_t profileKernelId = KernelProfiler::registerKernel(__func__);         \
+    KernelProfileScope profileScope(profileKernelId, static_cast<double>(bytes))
+#else
+#define PROFILE_KERNEL(bytes) ((void)0)
+#endif
+
+#endif // ARRAY_PROCESSOR_KERNEL_PROFILER_H
@@ -0,0 +1,976 @@
+/**
+ * Native benchmark driver for array_processor.cpp
+ * Runs the exported kernels against the host compiler build and prints the
+ * same statistics as runBenchmark (avg/min/max/median, in ms) as JSON, so
+ * native numbers can be lined up against the WASM results by function name.
+ *
+ * Usage:
+ *   array_processor_bench [--size N] [--iterations N] [--warmup N]
+ *                         [--seed N] [--threads N] [--filter TEXT]
+ *                         [--output FILE] [--help]
+ */
+
+#include <emscripten.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+struct StringMapDataHandle;
+struct PreparedStringMapHandle;
+struct PreparedNumberTreeMapHandle;
+struct FlatStringMapDataHandle;
+struct PreparedFlatStringMapHandle;
+struct StreamSession;
+struct ExternalMergeHandle;
+
+// Same layout as ArrayStats in array_processor.cpp
+struct ArrayStats
+{
+    double count;
+    double sum;
+    double min;
+    double max;
+    double mean;
+    double m2;
+    double variance;
+};
+
+// Same layout as NaryTreeStats in array_processor.cpp
+struct NaryTreeStats
+{
+    double sum;
+    double nodeCount;
+    double maxDepth;
+};
+
+// Same layout as StreamResult in array_processor.cpp
+struct StreamResult
+{
+    uint64_t count;
+    uint64_t sum;
+    uint64_t matched;
+    uint32_t min;
+    uint32_t max;
+    ArrayStats stats;
+};
+
+// Same layout as ScratchStats in array_processor.cpp
+struct ScratchStats
+{
+    double bytesRequested;
+    double bytesReserved;
+    double grows;
+    double highWater;
+    double memoryBytes;
+};
+
+extern "C"
+{
+    void getScratchStats(ScratchStats *stats);
+    void resetScratchStats();
+
+    uint64_t sumArray(const uint32_t *arr, uint32_t length);
+    uint32_t findMax(const uint32_t *arr, uint32_t length);
+    uint32_t findMin(const uint32_t *arr, uint32_t length);
+    double calculateAverage(const uint32_t *arr, uint32_t length);
+    void multiplyArray(uint32_t *arr, uint32_t length, uint32_t factor);
+    uint32_t countGreaterThan(const uint32_t *arr, uint32_t length, uint32_t threshold);
+    void quickSort(uint32_t *arr, uint32_t length);
+    void radixSortU32(uint32_t *arr, uint32_t length);
+    void reverseArray(uint32_t *arr, uint32_t length);
+    double calculateVariance(const uint32_t *arr, uint32_t length);
+    int binarySearch(const uint32_t *arr, uint32_t length, uint32_t target);
+    void binarySearchBatch(const uint32_t *arr, uint32_t length, const uint32_t *targets, uint32_t count, int32_t *out);
+    void eytzingerLayout(const uint32_t *sorted, uint32_t length, uint32_t *out);
+    void eytzingerSearchBatch(const uint32_t *layout, uint32_t length, const uint32_t *targets, uint32_t count, int32_t *out);
+    void addToArray(uint32_t *arr, uint32_t length, uint32_t value);
+    uint32_t countUnique(uint32_t *arr, uint32_t length);
+    uint32_t countUniqueExact(const uint32_t *arr, uint32_t length);
+    double countUniqueApprox(const uint32_t *arr, uint32_t length, uint32_t precision);
+
+    uint64_t sumArraySIMD(const uint32_t *arr, uint32_t length);
+    uint32_t findMaxSIMD(const uint32_t *arr, uint32_t length);
+    uint32_t findMinSIMD(const uint32_t *arr, uint32_t length);
+    void multiplyArraySIMD(uint32_t *arr, uint32_t length, uint32_t factor);
+    void addToArraySIMD(uint32_t *arr, uint32_t length, uint32_t value);
+    double calculateAverageSIMD(const uint32_t *arr, uint32_t length);
+    uint32_t countGreaterThanSIMD(const uint32_t *arr, uint32_t length, uint32_t threshold);
+
+    double sumArrayI8(const int8_t *arr, uint32_t length);
+    double sumArrayI16(const int16_t *arr, uint32_t length);
+    double sumArrayF64(const double *arr, uint32_t length);
+    double findMinF32(const float *arr, uint32_t length);
+    double findMaxI16(const int16_t *arr, uint32_t length);
+    void multiplyArrayI16(int16_t *arr, uint32_t length, double factor);
+    void addToArrayF64(double *arr, uint32_t length, double value);
+
+    uint32_t filterU32(const uint32_t *column, uint32_t length, uint32_t op, uint32_t value, uint32_t high, uint32_t *bitmap);
+    uint32_t filterF32(const float *column, uint32_t length, uint32_t op, float value, float high, uint32_t *bitmap);
+    uint32_t filterInU32(const uint32_t *column, uint32_t length, const uint32_t *values, uint32_t valueCount, uint32_t *bitmap);
+    uint32_t bitmapAnd(const uint32_t *a, const uint32_t *b, uint32_t *out, uint32_t length);
+    uint32_t bitmapToSelection(const uint32_t *bitmap, uint32_t length, uint32_t *out, uint32_t capacity);
+    uint32_t gatherSelected(const uint32_t *column, const uint32_t *bitmap, uint32_t length, uint32_t *out, uint32_t capacity);
+
+    void computeStats(
+        const uint32_t *arr, uint32_t length, ArrayStats *stats,
+        uint32_t *bins, uint32_t binCount, uint32_t histogramMin, uint32_t histogramMax);
+
+    void transformVectors(float *vectors, const float *matrix, uint32_t count);
+    void transformVectorsSIMD(float *vectors, const float *matrix, uint32_t count);
+    void aosToSoa(const float *aos, uint32_t count, float *xs, float *ys, float *zs);
+    void soaToAos(const float *xs, const float *ys, const float *zs, uint32_t count, float *aos);
+    void transformVectorsSoA(float *xs, float *ys, float *zs, const float *matrix, uint32_t count);
+    void transformVectors4SoA(float *xs, float *ys, float *zs, float *ws, const float *matrix, uint32_t count);
+    void transformVectorsSoABatch(
+        float *xs, float *ys, float *zs, const float *matrices, const uint32_t *offsets, uint32_t matrixCount);
+    void createTransformMatrix(
+        float *matrix,
+        float scale_x, float scale_y, float scale_z,
+        float angle_deg,
+        float trans_x, float trans_y, float trans_z);
+
+    uint32_t getMaxThreads();
+    uint64_t sumArray_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount);
+    double calculateAverage_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount);
+    uint32_t findMax_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount);
+    uint32_t findMin_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount);
+    uint32_t countGreaterThan_MT(const uint32_t *arr, uint32_t length, uint32_t threshold, uint32_t threadCount);
+    void transformVectors_MT(float *vectors, const float *matrix, uint32_t count, uint32_t threadCount);
+    void mergeSort_MT(uint32_t *arr, uint32_t length, uint32_t threadCount);
+    void computeStats_MT(
+        const uint32_t *arr, uint32_t length, ArrayStats *stats,
+        uint32_t *bins, uint32_t binCount, uint32_t histogramMin, uint32_t histogramMax,
+        uint32_t threadCount);
+    uint64_t sumNaryTreeBfs_MT(
+        const uint32_t *values, const uint32_t *childOffsets, const uint32_t *children, uint32_t nodeCount,
+        uint32_t threadCount);
+    uint64_t sumNaryTreeDfs_MT(
+        const uint32_t *values, const uint32_t *childOffsets, const uint32_t *children, uint32_t nodeCount,
+        uint32_t threadCount);
+    void computeNaryTreeStatsBfs_MT(
+        const uint32_t *values, const uint32_t *childOffsets, const uint32_t *children, uint32_t nodeCount,
+        NaryTreeStats *stats, uint32_t *levelCounts, uint32_t levelCapacity, uint32_t threadCount);
+    void computeNaryTreeStatsDfs_MT(
+        const uint32_t *values, const uint32_t *childOffsets, const uint32_t *children, uint32_t nodeCount,
+        NaryTreeStats *stats, uint32_t *levelCounts, uint32_t levelCapacity, uint32_t threadCount);
+
+    StreamSession *beginStream(uint32_t kind, uint32_t threshold);
+    void pushChunk(StreamSession *session, uint32_t *chunk, uint32_t length);
+    void finishStream(StreamSession *session, StreamResult *result);
+    ExternalMergeHandle *createExternalMerge(uint32_t runCount, uint32_t windowLength);
+    void freeExternalMerge(ExternalMergeHandle *handle);
+    uint32_t *getExternalMergeWindow(ExternalMergeHandle *handle, uint32_t run);
+    uint32_t *getExternalMergeOutput(ExternalMergeHandle *handle);
+    void fillExternalMergeRun(ExternalMergeHandle *handle, uint32_t run, uint32_t length);
+    int32_t getExternalMergeStarvedRun(ExternalMergeHandle *handle);
+    uint32_t externalMergeNext(ExternalMergeHandle *handle);
+
+    uint64_t sumBinaryTreeDfs(const uint32_t *values, uint32_t nodeCount);
+    uint64_t sumBinaryTreeBfs(const uint32_t *values, uint32_t nodeCount);
+    uint64_t sumNaryTreeDfs(const uint32_t *values, const uint32_t *childOffsets, const uint32_t *children, uint32_t nodeCount);
+    uint64_t sumNaryTreeBfs(const uint32_t *values, const uint32_t *childOffsets, const uint32_t *children, uint32_t nodeCount);
+    uint32_t binaryTreeLayoutCapacity(uint32_t nodeCount);
+    uint32_t relayoutBinaryTree(const uint32_t *values, uint32_t nodeCount, uint32_t layout, uint32_t *out);
+    uint64_t sumBinaryTreeLayoutDfs(const uint32_t *layoutValues, uint32_t nodeCount, uint32_t layout);
+    uint64_t sumBinaryTreePaths(const uint32_t *values, uint32_t nodeCount, const uint32_t *targets, uint32_t count);
+    uint64_t sumBinaryTreeLayoutPaths(
+        const uint32_t *layoutValues, uint32_t nodeCount, uint32_t layout, const uint32_t *targets, uint32_t count);
+    uint32_t relayoutNaryTreePreorder(
+        const uint32_t *values, const uint32_t *childOffsets, const uint32_t *children, uint32_t nodeCount,
+        uint32_t *outValues, uint32_t *outSubtreeSizes);
+    uint64_t sumNaryTreePreorderBfs(const uint32_t *values, const uint32_t *subtreeSizes, uint32_t nodeCount);
+    double subtreeSumsNary(
+        const uint32_t *values, const uint32_t *childOffsets, const uint32_t *children, uint32_t nodeCount, double *out);
+    double subtreeSumsPreorder(const uint32_t *values, const uint32_t *subtreeSizes, uint32_t nodeCount, double *out);
+
+    StringMapDataHandle *createStringMapData(const char *keyBytes, const uint32_t *keyOffsets, const uint32_t *values, uint32_t count);
+    void freeStringMapData(StringMapDataHandle *handle);
+    PreparedStringMapHandle *prepareStringMap(StringMapDataHandle *data);
+    void freePreparedStringMap(PreparedStringMapHandle *handle);
+    uint32_t insertStringMapEntries(StringMapDataHandle *data);
+    uint64_t lookupStringMapEntries(PreparedStringMapHandle *handle);
+    uint32_t deleteStringMapEntries(PreparedStringMapHandle *handle);
+
+    FlatStringMapDataHandle *createFlatStringMapData(const char *keyBytes, const uint32_t *keyOffsets, const uint32_t *values, uint32_t count);
+    void freeFlatStringMapData(FlatStringMapDataHandle *handle);
+    PreparedFlatStringMapHandle *prepareFlatStringMap(FlatStringMapDataHandle *data);
+    void freePreparedFlatStringMap(PreparedFlatStringMapHandle *handle);
+    uint32_t insertFlatStringMapEntries(FlatStringMapDataHandle *data);
+    uint64_t lookupFlatStringMapEntries(PreparedFlatStringMapHandle *handle);
+    uint32_t deleteFlatStringMapEntries(PreparedFlatStringMapHandle *handle);
+
+    PreparedNumberTreeMapHandle *prepareNumberTreeMap(const uint32_t *keys, const uint32_t *values, uint32_t count);
+    void freePreparedNumberTreeMap(PreparedNumberTreeMapHandle *handle);
+    uint32_t insertNumberTreeMapEntries(const uint32_t *keys, const uint32_t *values, uint32_t count);
+    uint64_t lookupNumberTreeMapEntries(PreparedNumberTreeMapHandle *handle);
+    uint32_t deleteNumberTreeMapEntries(PreparedNumberTreeMapHandle *handle);
+    uint32_t lowerBoundNumberTreeMap(PreparedNumberTreeMapHandle *handle, uint32_t key, uint32_t *outEntry);
+    uint32_t rangeScanNumberTreeMap(
+        PreparedNumberTreeMapHandle *handle, uint32_t minKey, uint32_t maxKey,
+        uint32_t *outKeys, uint32_t *outValues, uint32_t maxCount);
+}
+
+namespace
+{
+    // Same fixed sizes as src/benchmark.ts
+    const uint32_t TREE_NODE_COUNT = 1000000;
+    const uint32_t NARY_TREE_CHILDREN_PER_NODE = 4;
+    const uint32_t NARY_TREE_STATS_LEVELS = 16;
+    const uint32_t STRING_MAP_ENTRY_COUNT = 100000;
+    const uint32_t SEARCH_QUERY_COUNT = 100000;
+    const uint32_t SOA_BATCH_OBJECT_SIZE = 1000;
+    const uint32_t STATS_HISTOGRAM_BINS = 64;
+    const uint32_t STREAM_CHUNK_LENGTH = 65536;
+    const uint32_t STREAM_SUM = 0;
+    const uint32_t STREAM_SORT_RUNS = 4;
+
+    struct DriverConfig
+    {
+        uint32_t arraySize = 500000;
+        uint32_t iterations = 5;
+        uint32_t warmupIterations = 2;
+        uint32_t seed = 12345;
+        uint32_t threads = 0;
+        std::string filter;
+        std::string output;
+        // --help / -h: print the usage and exit 0
+        bool help = false;
+    };
+
+    /**
+     * One benchmark case: setup runs untimed before every sample (mirrors
+     * tsSetup/wasmSetup), run is the timed body and returns a checksum so
+     * the optimizer cannot drop the call.
+     */
+    struct BenchmarkCase
+    {
+        std::string name;
+        std::string function;
+        std::function<void()> setup;
+        std::function<uint64_t()> run;
+    };
+
+    struct BenchmarkStats
+    {
+        std::vector<double> times;
+        double avg;
+        double min;
+        double max;
+        double median;
+        uint64_t checksum;
+        // Scratch arena heap allocations and peak use during the timed runs
+        uint64_t scratchGrows;
+        uint64_t scratchHighWater;
+    };
+
+    volatile uint64_t g_sink = 0;
+
+    double calculateMedian(std::vector<double> times)
+    {
+        std::sort(times.begin(), times.end());
+        size_t mid = times.size() / 2;
+        return times.size() % 2 == 0
+                   ? (times[mid - 1] + times[mid]) / 2
+                   : times[mid];
+    }
+
+    BenchmarkStats runCase(const BenchmarkCase &test, const DriverConfig &config)
+    {
+        BenchmarkStats stats{};
+
+        for (uint32_t i = 0; i < config.warmupIterations; i++)
+        {
+            if (test.setup)
+                test.setup();
+            g_sink = g_sink + test.run();
+        }
+
+        resetScratchStats();
+        for (uint32_t i = 0; i < config.iterations; i++)
+        {
+            if (test.setup)
+                test.setup();
+            double start = emscripten_get_now();
+            uint64_t checksum = test.run();
+            double end = emscripten_get_now();
+            g_sink = g_sink + checksum;
+            stats.checksum = checksum;
+            stats.times.push_back(end - start);
+        }
+
+        ScratchStats scratch;
+        getScratchStats(&scratch);
+        stats.scratchGrows = static_cast<uint64_t>(scratch.grows);
+        stats.scratchHighWater = static_cast<uint64_t>(scratch.highWater);
+
+        double total = 0.0;
+        for (double t : stats.times)
+            total += t;
+        stats.avg = total / stats.times.size();
+        stats.min = *std::min_element(stats.times.begin(), stats.times.end());
+        stats.max = *std::max_element(stats.times.begin(), stats.times.end());
+        stats.median = calculateMedian(stats.times);
+        return stats;
+    }
+
+    std::vector<uint32_t> generateRandomArray(std::mt19937 &rng, uint32_t size)
+    {
+        std::uniform_int_distribution<uint32_t> dist(0, 999999);
+        std::vector<uint32_t> arr(size);
+        for (uint32_t i = 0; i < size; i++)
+            arr[i] = dist(rng);
+        return arr;
+    }
+
+    std::vector<float> generateRandomVectors(std::mt19937 &rng, uint32_t count)
+    {
+        std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+        std::vector<float> arr(static_cast<size_t>(count) * 3);
+        for (float &v : arr)
+            v = dist(rng);
+        return arr;
+    }
+
+    std::vector<uint32_t> generateTreeValues(uint32_t size)
+    {
+        std::vector<uint32_t> values(size);
+        for (uint32_t i = 0; i < size; i++)
+            values[i] = (i * 2654435761u) % 1000000;
+        return values;
+    }
+
+    struct NaryTree
+    {
+        std::vector<uint32_t> values;
+        std::vector<uint32_t> childOffsets;
+        std::vector<uint32_t> children;
+    };
+
+    NaryTree generateNaryTree(uint32_t size)
+    {
+        NaryTree tree;
+        tree.values = generateTreeValues(size);
+        tree.childOffsets.resize(static_cast<size_t>(size) + 1);
+        tree.children.resize(size > 0 ? size - 1 : 0);
+        uint32_t childCursor = 0;
+
+        for (uint32_t nodeIndex = 0; nodeIndex < size; nodeIndex++)
+        {
+            tree.childOffsets[nodeIndex] = childCursor;
+            uint64_t firstChild = static_cast<uint64_t>(nodeIndex) * NARY_TREE_CHILDREN_PER_NODE + 1;
+            uint64_t endChild = std::min<uint64_t>(size, firstChild + NARY_TREE_CHILDREN_PER_NODE);
+            for (uint64_t childIndex = firstChild; childIndex < endChild; childIndex++)
+                tree.children[childCursor++] = static_cast<uint32_t>(childIndex);
+        }
+        tree.childOffsets[size] = childCursor;
+        return tree;
+    }
+
+    std::string toBase36(uint32_t value)
+    {
+        const char *digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+        if (value == 0)
+            return "0";
+        std::string out;
+        while (value > 0)
+        {
+            out.insert(out.begin(), digits[value % 36]);
+            value /= 36;
+        }
+        return out;
+    }
+
+    struct StringMapInput
+    {
+        std::string keyBytes;
+        std::vector<uint32_t> keyOffsets;
+        std::vector<uint32_t> values;
+    };
+
+    StringMapInput generateStringMapData(uint32_t size)
+    {
+        StringMapInput data;
+        data.keyOffsets.resize(static_cast<size_t>(size) + 1);
+        data.values.resize(size);
+        for (uint32_t i = 0; i < size; i++)
+        {
+            char index[16];
+            std::snprintf(index, sizeof(index), "%06u", i);
+            data.keyOffsets[i] = static_cast<uint32_t>(data.keyBytes.size());
+            data.keyBytes += "key_";
+            data.keyBytes += index;
+            data.keyBytes += "_";
+            data.keyBytes += toBase36(i * 2654435761u);
+            data.values[i] = (i * 17 + 23) % 1000000;
+        }
+        data.keyOffsets[size] = static_cast<uint32_t>(data.keyBytes.size());
+        return data;
+    }
+
+    /**
+     * Same flow as createWasmStream: copy through one chunk buffer
+     */
+    uint64_t streamSum(const std::vector<uint32_t> &input, std::vector<uint32_t> &chunk)
+    {
+        StreamSession *session = beginStream(STREAM_SUM, 0);
+        for (size_t offset = 0; offset < input.size(); offset += chunk.size())
+        {
+            uint32_t length = static_cast<uint32_t>(std::min(chunk.size(), input.size() - offset));
+            std::copy(input.begin() + offset, input.begin() + offset + length, chunk.begin());
+            pushChunk(session, chunk.data(), length);
+        }
+        StreamResult result;
+        finishStream(session, &result);
+        return result.sum;
+    }
+
+    /**
+     * Same flow as createWasmExternalSort: sorted runs are spilled out of the
+     * chunk buffer, then merged through windows that share the chunk budget
+     */
+    void externalSort(const std::vector<uint32_t> &input, std::vector<uint32_t> &chunk, std::vector<uint32_t> &output)
+    {
+        std::vector<std::vector<uint32_t>> runs;
+        StreamSession *session = beginStream(STREAM_SORT_RUNS, 0);
+        for (size_t offset = 0; offset < input.size(); offset += chunk.size())
+        {
+            uint32_t length = static_cast<uint32_t>(std::min(chunk.size(), input.size() - offset));
+            std::copy(input.begin() + offset, input.begin() + offset + length, chunk.begin());
+            pushChunk(session, chunk.data(), length);
+            runs.emplace_back(chunk.begin(), chunk.begin() + length);
+        }
+        finishStream(session, nullptr);
+        if (runs.empty())
+            return;
+
+        uint32_t runCount = static_cast<uint32_t>(runs.size());
+        uint32_t windowLength = std::max<uint32_t>(1024, static_cast<uint32_t>(chunk.size()) / (runCount + 1));
+        ExternalMergeHandle *merge = createExternalMerge(runCount, windowLength);
+        std::vector<size_t> offsets(runCount, 0);
+        auto fill = [&](uint32_t run)
+        {
+            uint32_t length = static_cast<uint32_t>(std::min<size_t>(windowLength, runs[run].size() - offsets[run]));
+            std::copy(runs[run].begin() + offsets[run], runs[run].begin() + offsets[run] + length, getExternalMergeWindow(merge, run));
+            offsets[run] += length;
+            fillExternalMergeRun(merge, run, length);
+        };
+        for (uint32_t run = 0; run < runCount; run++)
+            fill(run);
+
+        size_t written = 0;
+        const uint32_t *mergeOutput = getExternalMergeOutput(merge);
+        for (;;)
+        {
+            uint32_t count = externalMergeNext(merge);
+            std::copy(mergeOutput, mergeOutput + count, output.begin() + written);
+            written += count;
+            int32_t starved = getExternalMergeStarvedRun(merge);
+            if (starved >= 0)
+                fill(static_cast<uint32_t>(starved));
+            else if (count == 0)
+                break;
+        }
+        freeExternalMerge(merge);
+    }
+
+    void printJsonString(FILE *out, const std::string &text)
+    {
+        std::fputc('"', out);
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                std::fputc('\\', out);
+            std::fputc(c, out);
+        }
+        std::fputc('"', out);
+    }
+
+    void printUsage(FILE *out, const char *program)
+    {
+        std::fprintf(out,
+                     "Usage: %s [--size N] [--iterations N] [--warmup N] [--seed N] [--threads N] [--filter TEXT] [--output FILE] [--help]\n",
+                     program);
+    }
+
+    bool parseArgs(int argc, char **argv, DriverConfig &config)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h")
+            {
+                config.help = true;
+                return true;
+            }
+            if (i + 1 >= argc)
+            {
+                std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+                return false;
+            }
+            const char *value = argv[++i];
+            if (arg == "--size")
+                config.arraySize = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (arg == "--iterations")
+                config.iterations = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (arg == "--warmup")
+                config.warmupIterations = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (arg == "--seed")
+                config.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (arg == "--threads")
+                config.threads = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (arg == "--filter")
+                config.filter = value;
+            else if (arg == "--output")
+                config.output = value;
+            else
+            {
+                std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+                return false;
+            }
+        }
+        if (config.iterations == 0)
+        {
+            std::fprintf(stderr, "--iterations must be at least 1\n");
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    DriverConfig config;
+    if (!parseArgs(argc, argv, config))
+    {
+        printUsage(stderr, argv[0]);
+        return 1;
+    }
+    if (config.help)
+    {
+        printUsage(stdout, argv[0]);
+        return 0;
+    }
+
+    std::mt19937 rng(config.seed);
+    const uint32_t size = config.arraySize;
+
+    // Shared inputs; in-place kernels copy into `work` during setup
+    std::vector<uint32_t> source = generateRandomArray(rng, size);
+    std::vector<uint32_t> work(source);
+    // Full 32-bit range: pushes countUniqueExact onto its hash set path
+    std::vector<uint32_t> wideSource(size);
+    for (uint32_t &value : wideSource)
+        value = rng();
+    // Typed-kernel columns derived from the same random values
+    std::vector<int8_t> int8Source(size);
+    std::vector<int16_t> int16Source(size);
+    std::vector<float> float32Source(size);
+    std::vector<double> float64Source(size);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        int8Source[i] = static_cast<int8_t>(source[i] % 256 - 128);
+        int16Source[i] = static_cast<int16_t>(source[i] % 65536 - 32768);
+        float32Source[i] = static_cast<float>(source[i]) * 0.001f;
+        float64Source[i] = static_cast<double>(source[i]) * 0.001;
+    }
+    std::vector<int16_t> int16Work(int16Source);
+    std::vector<double> float64Work(float64Source);
+    // Filter bitmaps and compaction output (same predicates as benchmark.ts)
+    std::vector<uint32_t> filterBitmap((size + 31) / 32 + 1);
+    std::vector<uint32_t> filterScratch(filterBitmap.size());
+    std::vector<uint32_t> filterOut(size + 1);
+    std::vector<uint32_t> filterInSet(16);
+    for (uint32_t i = 0; i < 16; i++)
+        filterInSet[i] = i * 1000;
+    std::vector<uint32_t> sorted(source);
+    std::sort(sorted.begin(), sorted.end());
+    uint32_t searchTarget = sorted.empty() ? 0 : sorted[sorted.size() / 2];
+
+    // Batched search: half the queries hit, half are random
+    std::vector<uint32_t> searchTargets(SEARCH_QUERY_COUNT);
+    for (uint32_t i = 0; i < SEARCH_QUERY_COUNT; i++)
+        searchTargets[i] = (i % 2 == 0 && size > 0) ? sorted[rng() % size] : rng() % 1000000;
+    std::vector<int32_t> searchResults(SEARCH_QUERY_COUNT);
+    std::vector<uint32_t> eytzinger(size);
+    eytzingerLayout(sorted.data(), size, eytzinger.data());
+
+    std::vector<float> vectors = generateRandomVectors(rng, size);
+    std::vector<float> vectorsWork(vectors);
+    std::vector<float> soaX(size), soaY(size), soaZ(size), soaW(size);
+
+    // Per-object batch: one matrix per SOA_BATCH_OBJECT_SIZE points
+    const uint32_t batchObjects = (size + SOA_BATCH_OBJECT_SIZE - 1) / SOA_BATCH_OBJECT_SIZE;
+    std::vector<float> batchMatrices(static_cast<size_t>(batchObjects) * 16);
+    std::vector<uint32_t> batchOffsets(batchObjects + 1);
+    for (uint32_t k = 0; k < batchObjects; k++)
+    {
+        createTransformMatrix(batchMatrices.data() + static_cast<size_t>(k) * 16,
+                              1.0f + k % 3, 1.5f, 1.0f, static_cast<float>(k % 360), 10.0f, 20.0f, 5.0f);
+        batchOffsets[k] = k * SOA_BATCH_OBJECT_SIZE;
+    }
+    batchOffsets[batchObjects] = size;
+    float matrix[16];
+    createTransformMatrix(matrix, 2.0f, 1.5f, 1.0f, 45.0f, 10.0f, 20.0f, 5.0f);
+
+    std::vector<uint32_t> treeValues = generateTreeValues(TREE_NODE_COUNT);
+    NaryTree naryTree = generateNaryTree(TREE_NODE_COUNT);
+
+    // Layout cases follow --size so they can run on 10M+ node trees
+    const uint32_t TREE_LAYOUT_VEB = 0;
+    const uint32_t TREE_LAYOUT_BLOCKED = 1;
+    std::vector<uint32_t> heapTree = generateTreeValues(size);
+    std::vector<uint32_t> vebTree(binaryTreeLayoutCapacity(size));
+    std::vector<uint32_t> blockedTree(vebTree.size());
+    relayoutBinaryTree(heapTree.data(), size, TREE_LAYOUT_VEB, vebTree.data());
+    relayoutBinaryTree(heapTree.data(), size, TREE_LAYOUT_BLOCKED, blockedTree.data());
+    // Root-to-leaf descents: targets in the bottom half are leaves
+    std::vector<uint32_t> leafTargets(SEARCH_QUERY_COUNT);
+    for (uint32_t &target : leafTargets)
+        target = size / 2 + rng() % std::max<uint32_t>(1, size - size / 2);
+    NaryTree csrTree = generateNaryTree(size);
+    std::vector<uint32_t> preorderValues(size);
+    std::vector<uint32_t> preorderSizes(size);
+    relayoutNaryTreePreorder(csrTree.values.data(), csrTree.childOffsets.data(), csrTree.children.data(), size,
+                             preorderValues.data(), preorderSizes.data());
+    std::vector<double> subtreeSums(size);
+
+    StringMapInput stringInput = generateStringMapData(STRING_MAP_ENTRY_COUNT);
+    StringMapDataHandle *stringData = createStringMapData(
+        stringInput.keyBytes.data(), stringInput.keyOffsets.data(), stringInput.values.data(), STRING_MAP_ENTRY_COUNT);
+    PreparedStringMapHandle *stringMap = nullptr;
+    FlatStringMapDataHandle *flatStringData = createFlatStringMapData(
+        stringInput.keyBytes.data(), stringInput.keyOffsets.data(), stringInput.values.data(), STRING_MAP_ENTRY_COUNT);
+    PreparedFlatStringMapHandle *flatStringMap = nullptr;
+
+    std::vector<uint32_t> numberKeys(STRING_MAP_ENTRY_COUNT);
+    std::vector<uint32_t> numberValues(STRING_MAP_ENTRY_COUNT);
+    for (uint32_t i = 0; i < STRING_MAP_ENTRY_COUNT; i++)
+    {
+        numberKeys[i] = i * 2654435761u;
+        numberValues[i] = (i * 17 + 23) % 1000000;
+    }
+    PreparedNumberTreeMapHandle *numberMap = nullptr;
+    std::vector<uint32_t> scanKeys(STRING_MAP_ENTRY_COUNT);
+    std::vector<uint32_t> scanValues(STRING_MAP_ENTRY_COUNT);
+
+    auto resetWork = [&]()
+    { std::copy(source.begin(), source.end(), work.begin()); };
+    auto resetTypedWork = [&]()
+    {
+        std::copy(int16Source.begin(), int16Source.end(), int16Work.begin());
+        std::copy(float64Source.begin(), float64Source.end(), float64Work.begin());
+    };
+    auto resetVectors = [&]()
+    { std::copy(vectors.begin(), vectors.end(), vectorsWork.begin()); };
+    auto resetSoaVectors = [&]()
+    {
+        aosToSoa(vectors.data(), size, soaX.data(), soaY.data(), soaZ.data());
+        std::fill(soaW.begin(), soaW.end(), 1.0f);
+    };
+    auto resetStringMap = [&]()
+    {
+        freePreparedStringMap(stringMap);
+        stringMap = prepareStringMap(stringData);
+    };
+    auto resetFlatStringMap = [&]()
+    {
+        freePreparedFlatStringMap(flatStringMap);
+        flatStringMap = prepareFlatStringMap(flatStringData);
+    };
+    auto resetNumberMap = [&]()
+    {
+        freePreparedNumberTreeMap(numberMap);
+        numberMap = prepareNumberTreeMap(numberKeys.data(), numberValues.data(), STRING_MAP_ENTRY_COUNT);
+    };
+
+    ArrayStats stats{};
+    NaryTreeStats treeStats{};
+    std::vector<uint32_t> treeLevels(NARY_TREE_STATS_LEVELS);
+    std::vector<uint32_t> streamChunk(STREAM_CHUNK_LENGTH);
+    std::vector<uint32_t> histogram(STATS_HISTOGRAM_BINS);
+
+    const uint32_t *src = source.data();
+    std::vector<BenchmarkCase> cases = {
+        {"Sum Array", "sumArray", nullptr, [&]()
+         { return sumArray(src, size); }},
+        {"Find Max", "findMax", nullptr, [&]()
+         { return static_cast<uint64_t>(findMax(src, size)); }},
+        {"Find Min", "findMin", nullptr, [&]()
+         { return static_cast<uint64_t>(findMin(src, size)); }},
+        {"Calculate Average", "calculateAverage", nullptr, [&]()
+         { return static_cast<uint64_t>(calculateAverage(src, size)); }},
+        {"Multiply Array", "multiplyArray", resetWork, [&]()
+         { multiplyArray(work.data(), size, 2); return static_cast<uint64_t>(work.empty() ? 0 : work[0]); }},
+        {"Count Greater Than", "countGreaterThan", nullptr, [&]()
+         { return static_cast<uint64_t>(countGreaterThan(src, size, 500000)); }},
+        {"Quick Sort", "quickSort", resetWork, [&]()
+         { quickSort(work.data(), size); return static_cast<uint64_t>(work.empty() ? 0 : work[0]); }},
+        {"Radix Sort", "radixSortU32", resetWork, [&]()
+         { radixSortU32(work.data(), size); return static_cast<uint64_t>(work.empty() ? 0 : work[0]); }},
+        {"Reverse Array", "reverseArray", resetWork, [&]()
+         { reverseArray(work.data(), size); return static_cast<uint64_t>(work.empty() ? 0 : work[0]); }},
+        {"Calculate Variance", "calculateVariance", nullptr, [&]()
+         { return static_cast<uint64_t>(calculateVariance(src, size)); }},
+        {"Binary Search", "binarySearch", nullptr, [&]()
+         { return static_cast<uint64_t>(binarySearch(sorted.data(), size, searchTarget)); }},
+        {"Binary Search (single calls)", "binarySearch", nullptr, [&]()
+         {
+             uint64_t hits = 0;
+             for (uint32_t i = 0; i < SEARCH_QUERY_COUNT; i++)
+                 hits += binarySearch(sorted.data(), size, searchTargets[i]) >= 0;
+             return hits;
+         }},
+        {"Binary Search Batch", "binarySearchBatch", nullptr, [&]()
+         {
+             binarySearchBatch(sorted.data(), size, searchTargets.data(), SEARCH_QUERY_COUNT, searchResults.data());
+             return static_cast<uint64_t>(std::count_if(searchResults.begin(), searchResults.end(), [](int32_t r)
+                                                        { return r >= 0; }));
+         }},
+        {"Binary Search Batch (Eytzinger)", "eytzingerSearchBatch", nullptr, [&]()
+         {
+             eytzingerSearchBatch(eytzinger.data(), size, searchTargets.data(), SEARCH_QUERY_COUNT, searchResults.data());
+             return static_cast<uint64_t>(std::count_if(searchResults.begin(), searchResults.end(), [](int32_t r)
+                                                        { return r >= 0; }));
+         }},
+        {"Add To Array", "addToArray", resetWork, [&]()
+         { addToArray(work.data(), size, 100); return static_cast<uint64_t>(work.empty() ? 0 : work[0]); }},
+        {"Count Unique", "countUnique", nullptr, [&]()
+         { return static_cast<uint64_t>(countUnique(source.data(), size)); }},
+        {"Count Unique Exact (Bitmap)", "countUniqueExact", nullptr, [&]()
+         { return static_cast<uint64_t>(countUniqueExact(src, size)); }},
+        {"Count Unique Exact (Hash Set)", "countUniqueExact", nullptr, [&]()
+         { return static_cast<uint64_t>(countUniqueExact(wideSource.data(), size)); }},
+        {"Count Unique Approx (HyperLogLog)", "countUniqueApprox", nullptr, [&]()
+         { return static_cast<uint64_t>(countUniqueApprox(src, size, 14)); }},
+
+        {"Sum Array (Int8)", "sumArrayI8", nullptr, [&]()
+         { return static_cast<uint64_t>(sumArrayI8(int8Source.data(), size)); }},
+        {"Sum Array (Int16)", "sumArrayI16", nullptr, [&]()
+         { return static_cast<uint64_t>(sumArrayI16(int16Source.data(), size)); }},
+        {"Sum Array (Float64)", "sumArrayF64", nullptr, [&]()
+         { return static_cast<uint64_t>(sumArrayF64(float64Source.data(), size)); }},
+        {"Find Min (Float32)", "findMinF32", nullptr, [&]()
+         { return static_cast<uint64_t>(findMinF32(float32Source.data(), size)); }},
+        {"Find Max (Int16)", "findMaxI16", nullptr, [&]()
+         { return static_cast<uint64_t>(findMaxI16(int16Source.data(), size)); }},
+        {"Multiply Array (Int16)", "multiplyArrayI16", resetTypedWork, [&]()
+         { multiplyArrayI16(int16Work.data(), size, 3); return static_cast<uint64_t>(int16Work.empty() ? 0 : int16Work[0]); }},
+        {"Add To Array (Float64)", "addToArrayF64", resetTypedWork, [&]()
+         { addToArrayF64(float64Work.data(), size, 0.5); return static_cast<uint64_t>(float64Work.empty() ? 0 : float64Work[0]); }},
+
+        {"Filter Greater Than (Gather)", "filterU32 + gatherSelected", nullptr, [&]()
+         {
+             uint32_t count = filterU32(src, size, 0, 500000, 0, filterBitmap.data());
+             return static_cast<uint64_t>(gatherSelected(src, filterBitmap.data(), size, filterOut.data(), count));
+         }},
+        {"Filter BETWEEN AND IN (Select)", "filterU32 + filterInU32 + bitmapAnd + bitmapToSelection", nullptr, [&]()
+         {
+             filterU32(src, size, 3, 0, 499999, filterBitmap.data());
+             filterInU32(src, size, filterInSet.data(), 16, filterScratch.data());
+             uint32_t count = bitmapAnd(filterBitmap.data(), filterScratch.data(), filterBitmap.data(), size);
+             return static_cast<uint64_t>(bitmapToSelection(filterBitmap.data(), size, filterOut.data(), count));
+         }},
+        {"Filter Range (Float32 Gather)", "filterF32 + gatherSelected", nullptr, [&]()
+         {
+             uint32_t count = filterF32(float32Source.data(), size, 3, 250.0f, 750.0f, filterBitmap.data());
+             const uint32_t *bits = reinterpret_cast<const uint32_t *>(float32Source.data());
+             return static_cast<uint64_t>(gatherSelected(bits, filterBitmap.data(), size, filterOut.data(), count));
+         }},
+        {"Sum Array (SIMD)", "sumArraySIMD", nullptr, [&]()
+         { return sumArraySIMD(src, size); }},
+        {"Find Max (SIMD)", "findMaxSIMD", nullptr, [&]()
+         { return static_cast<uint64_t>(findMaxSIMD(src, size)); }},
+        {"Find Min (SIMD)", "findMinSIMD", nullptr, [&]()
+         { return static_cast<uint64_t>(findMinSIMD(src, size)); }},
+        {"Calculate Average (SIMD)", "calculateAverageSIMD", nullptr, [&]()
+         { return static_cast<uint64_t>(calculateAverageSIMD(src, size)); }},
+        {"Multiply Array (SIMD)", "multiplyArraySIMD", resetWork, [&]()
+         { multiplyArraySIMD(work.data(), size, 2); return static_cast<uint64_t>(work.empty() ? 0 : work[0]); }},
+        {"Add To Array (SIMD)", "addToArraySIMD", resetWork, [&]()
+         { addToArraySIMD(work.data(), size, 100); return static_cast<uint64_t>(work.empty() ? 0 : work[0]); }},
+        {"Count Greater Than (SIMD)", "countGreaterThanSIMD", nullptr, [&]()
+         { return static_cast<uint64_t>(countGreaterThanSIMD(src, size, 500000)); }},
+        {"Compute Stats", "computeStats", nullptr, [&]()
+         { computeStats(src, size, &stats, nullptr, 0, 0, 0); return static_cast<uint64_t>(stats.variance); }},
+        {"Compute Stats + Histogram", "computeStats", nullptr, [&]()
+         { computeStats(src, size, &stats, histogram.data(), STATS_HISTOGRAM_BINS, 0, 999999); return static_cast<uint64_t>(histogram[0]); }},
+
+        {"Sum Array (MT)", "sumArray_MT", nullptr, [&]()
+         { return sumArray_MT(src, size, config.threads); }},
+        {"Calculate Average (MT)", "calculateAverage_MT", nullptr, [&]()
+         { return static_cast<uint64_t>(calculateAverage_MT(src, size, config.threads)); }},
+        {"Find Max (MT)", "findMax_MT", nullptr, [&]()
+         { return static_cast<uint64_t>(findMax_MT(src, size, config.threads)); }},
+        {"Find Min (MT)", "findMin_MT", nullptr, [&]()
+         { return static_cast<uint64_t>(findMin_MT(src, size, config.threads)); }},
+        {"Count Greater Than (MT)", "countGreaterThan_MT", nullptr, [&]()
+         { return static_cast<uint64_t>(countGreaterThan_MT(src, size, 500000, config.threads)); }},
+        {"Merge Sort (MT)", "mergeSort_MT", resetWork, [&]()
+         { mergeSort_MT(work.data(), size, config.threads); return static_cast<uint64_t>(work.empty() ? 0 : work[0]); }},
+        {"Sum Array (Streaming)", "beginStream/pushChunk/finishStream", nullptr, [&]()
+         { return streamSum(source, streamChunk); }},
+        {"External Merge Sort (Streaming)", "createExternalMerge", nullptr, [&]()
+         { externalSort(source, streamChunk, work); return static_cast<uint64_t>(work.empty() ? 0 : work[0]); }},
+        {"Compute Stats (MT)", "computeStats_MT", nullptr, [&]()
+         { computeStats_MT(src, size, &stats, histogram.data(), STATS_HISTOGRAM_BINS, 0, 999999, config.threads); return static_cast<uint64_t>(stats.variance); }},
+        {"N-ary Tree BFS (MT)", "sumNaryTreeBfs_MT", nullptr, [&]()
+         { return sumNaryTreeBfs_MT(csrTree.values.data(), csrTree.childOffsets.data(), csrTree.children.data(), size, config.threads); }},
+        {"N-ary Tree DFS (MT)", "sumNaryTreeDfs_MT", nullptr, [&]()
+         { return sumNaryTreeDfs_MT(csrTree.values.data(), csrTree.childOffsets.data(), csrTree.children.data(), size, config.threads); }},
+        {"N-ary Tree Stats BFS (MT)", "computeNaryTreeStatsBfs_MT", nullptr, [&]()
+         { computeNaryTreeStatsBfs_MT(csrTree.values.data(), csrTree.childOffsets.data(), csrTree.children.data(), size,
+                                      &treeStats, treeLevels.data(), NARY_TREE_STATS_LEVELS, config.threads);
+           return static_cast<uint64_t>(treeStats.sum); }},
+        {"N-ary Tree Stats DFS (MT)", "computeNaryTreeStatsDfs_MT", nullptr, [&]()
+         { computeNaryTreeStatsDfs_MT(csrTree.values.data(), csrTree.childOffsets.data(), csrTree.children.data(), size,
+                                      &treeStats, treeLevels.data(), NARY_TREE_STATS_LEVELS, config.threads);
+           return static_cast<uint64_t>(treeStats.sum); }},
+
+        {"String unordered_map Insert", "insertStringMapEntries", nullptr, [&]()
+         { return static_cast<uint64_t>(insertStringMapEntries(stringData)); }},
+        {"String unordered_map Lookup", "lookupStringMapEntries", resetStringMap, [&]()
+         { return lookupStringMapEntries(stringMap); }},
+        {"String unordered_map Delete", "deleteStringMapEntries", resetStringMap, [&]()
+         { return static_cast<uint64_t>(deleteStringMapEntries(stringMap)); }},
+        {"String flat_hash_map Insert", "insertFlatStringMapEntries", nullptr, [&]()
+         { return static_cast<uint64_t>(insertFlatStringMapEntries(flatStringData)); }},
+        {"String flat_hash_map Lookup", "lookupFlatStringMapEntries", resetFlatStringMap, [&]()
+         { return lookupFlatStringMapEntries(flatStringMap); }},
+        {"String flat_hash_map Delete", "deleteFlatStringMapEntries", resetFlatStringMap, [&]()
+         { return static_cast<uint64_t>(deleteFlatStringMapEntries(flatStringMap)); }},
+        {"Int B+-tree Insert", "insertNumberTreeMapEntries", nullptr, [&]()
+         { return static_cast<uint64_t>(insertNumberTreeMapEntries(numberKeys.data(), numberValues.data(), STRING_MAP_ENTRY_COUNT)); }},
+        {"Int B+-tree Lookup", "lookupNumberTreeMapEntries", resetNumberMap, [&]()
+         { return lookupNumberTreeMapEntries(numberMap); }},
+        {"Int B+-tree Delete", "deleteNumberTreeMapEntries", resetNumberMap, [&]()
+         { return static_cast<uint64_t>(deleteNumberTreeMapEntries(numberMap)); }},
+        {"Int B+-tree Range Scan", "rangeScanNumberTreeMap", resetNumberMap, [&]()
+         { return static_cast<uint64_t>(rangeScanNumberTreeMap(
+               numberMap, 0, UINT32_MAX / 2, scanKeys.data(), scanValues.data(), STRING_MAP_ENTRY_COUNT)); }},
+        {"Int B+-tree Lower Bound", "lowerBoundNumberTreeMap", resetNumberMap, [&]()
+         {
+             uint64_t checksum = 0;
+             uint32_t entry[2];
+             for (uint32_t i = 0; i < STRING_MAP_ENTRY_COUNT; i++)
+             {
+                 if (lowerBoundNumberTreeMap(numberMap, numberKeys[i] + 1, entry))
+                     checksum += entry[1];
+             }
+             return checksum;
+         }},
+
+        {"Binary Tree DFS Traversal Only", "sumBinaryTreeDfs", nullptr, [&]()
+         { return sumBinaryTreeDfs(treeValues.data(), TREE_NODE_COUNT); }},
+        {"Binary Tree BFS Traversal Only", "sumBinaryTreeBfs", nullptr, [&]()
+         { return sumBinaryTreeBfs(treeValues.data(), TREE_NODE_COUNT); }},
+        {"N-ary Tree DFS Traversal Only", "sumNaryTreeDfs", nullptr, [&]()
+         { return sumNaryTreeDfs(naryTree.values.data(), naryTree.childOffsets.data(), naryTree.children.data(), TREE_NODE_COUNT); }},
+        {"N-ary Tree BFS Traversal Only", "sumNaryTreeBfs", nullptr, [&]()
+         { return sumNaryTreeBfs(naryTree.values.data(), naryTree.childOffsets.data(), naryTree.children.data(), TREE_NODE_COUNT); }},
+        {"Binary Tree DFS (Heap Layout)", "sumBinaryTreeDfs", nullptr, [&]()
+         { return sumBinaryTreeDfs(heapTree.data(), size); }},
+        {"Binary Tree DFS (vEB Layout)", "sumBinaryTreeLayoutDfs", nullptr, [&]()
+         { return sumBinaryTreeLayoutDfs(vebTree.data(), size, TREE_LAYOUT_VEB); }},
+        {"Binary Tree DFS (Blocked Layout)", "sumBinaryTreeLayoutDfs", nullptr, [&]()
+         { return sumBinaryTreeLayoutDfs(blockedTree.data(), size, TREE_LAYOUT_BLOCKED); }},
+        {"Binary Tree Paths (Heap Layout)", "sumBinaryTreePaths", nullptr, [&]()
+         { return sumBinaryTreePaths(heapTree.data(), size, leafTargets.data(), SEARCH_QUERY_COUNT); }},
+        {"Binary Tree Paths (vEB Layout)", "sumBinaryTreeLayoutPaths", nullptr, [&]()
+         { return sumBinaryTreeLayoutPaths(vebTree.data(), size, TREE_LAYOUT_VEB, leafTargets.data(), SEARCH_QUERY_COUNT); }},
+        {"Binary Tree Paths (Blocked Layout)", "sumBinaryTreeLayoutPaths", nullptr, [&]()
+         { return sumBinaryTreeLayoutPaths(blockedTree.data(), size, TREE_LAYOUT_BLOCKED, leafTargets.data(), SEARCH_QUERY_COUNT); }},
+        {"N-ary Tree BFS (CSR Layout)", "sumNaryTreeBfs", nullptr, [&]()
+         { return sumNaryTreeBfs(csrTree.values.data(), csrTree.childOffsets.data(), csrTree.children.data(), size); }},
+        {"N-ary Tree BFS (Preorder Layout)", "sumNaryTreePreorderBfs", nullptr, [&]()
+         { return sumNaryTreePreorderBfs(preorderValues.data(), preorderSizes.data(), size); }},
+        {"N-ary Subtree Sums (CSR Layout)", "subtreeSumsNary", nullptr, [&]()
+         { return static_cast<uint64_t>(subtreeSumsNary(
+               csrTree.values.data(), csrTree.childOffsets.data(), csrTree.children.data(), size, subtreeSums.data())); }},
+        {"N-ary Subtree Sums (Preorder Layout)", "subtreeSumsPreorder", nullptr, [&]()
+         { return static_cast<uint64_t>(subtreeSumsPreorder(preorderValues.data(), preorderSizes.data(), size, subtreeSums.data())); }},
+
+        {"Matrix Transform", "transformVectors", resetVectors, [&]()
+         { transformVectors(vectorsWork.data(), matrix, size); return static_cast<uint64_t>(vectorsWork.empty() ? 0 : vectorsWork[0]); }},
+        {"Matrix Transform (SIMD)", "transformVectorsSIMD", resetVectors, [&]()
+         { transformVectorsSIMD(vectorsWork.data(), matrix, size); return static_cast<uint64_t>(vectorsWork.empty() ? 0 : vectorsWork[0]); }},
+        {"Matrix Transform (MT)", "transformVectors_MT", resetVectors, [&]()
+         { transformVectors_MT(vectorsWork.data(), matrix, size, config.threads); return static_cast<uint64_t>(vectorsWork.empty() ? 0 : vectorsWork[0]); }},
+        {"AoS to SoA", "aosToSoa", nullptr, [&]()
+         { aosToSoa(vectors.data(), size, soaX.data(), soaY.data(), soaZ.data()); return static_cast<uint64_t>(soaX.empty() ? 0 : soaX[0]); }},
+        {"SoA to AoS", "soaToAos", resetSoaVectors, [&]()
+         { soaToAos(soaX.data(), soaY.data(), soaZ.data(), size, vectorsWork.data()); return static_cast<uint64_t>(vectorsWork.empty() ? 0 : vectorsWork[0]); }},
+        {"Matrix Transform (SoA)", "transformVectorsSoA", resetSoaVectors, [&]()
+         { transformVectorsSoA(soaX.data(), soaY.data(), soaZ.data(), matrix, size); return static_cast<uint64_t>(soaX.empty() ? 0 : soaX[0]); }},
+        {"Matrix Transform 4x4 (SoA)", "transformVectors4SoA", resetSoaVectors, [&]()
+         { transformVectors4SoA(soaX.data(), soaY.data(), soaZ.data(), soaW.data(), matrix, size); return static_cast<uint64_t>(soaX.empty() ? 0 : soaX[0]); }},
+        {"Matrix Transform Batch (SoA)", "transformVectorsSoABatch", resetSoaVectors, [&]()
+         { transformVectorsSoABatch(soaX.data(), soaY.data(), soaZ.data(), batchMatrices.data(), batchOffsets.data(), batchObjects); return static_cast<uint64_t>(soaX.empty() ? 0 : soaX[0]); }},
+    };
+
+    FILE *out = stdout;
+    if (!config.output.empty())
+    {
+        out = std::fopen(config.output.c_str(), "w");
+        if (!out)
+        {
+            std::fprintf(stderr, "Cannot open %s for writing\n", config.output.c_str());
+            return 1;
+        }
+    }
+
+    std::fprintf(out, "{\n  \"runtime\": \"native\",\n");
+#if defined(__clang__)
+    std::fprintf(out, "  \"compiler\": \"clang %s\",\n", __clang_version__);
+#elif defined(__GNUC__)
+    std::fprintf(out, "  \"compiler\": \"gcc %s\",\n", __VERSION__);
+#else
+    std::fprintf(out, "  \"compiler\": \"unknown\",\n");
+#endif
+    std::fprintf(out, "  \"config\": { \"arraySize\": %u, \"iterations\": %u, \"warmupIterations\": %u, \"seed\": %u, \"threads\": %u, \"maxThreads\": %u },\n",
+                 config.arraySize, config.iterations, config.warmupIterations, config.seed, config.threads, getMaxThreads());
+    std::fprintf(out, "  \"results\": [");
+
+    bool first = true;
+    for (const BenchmarkCase &test : cases)
+    {
+        if (!config.filter.empty() &&
+            test.name.find(config.filter) == std::string::npos &&
+            test.function.find(config.filter) == std::string::npos)
+            continue;
+
+        std::fprintf(stderr, "📊 Testing native %s...\n", test.name.c_str());
+        BenchmarkStats stats = runCase(test, config);
+
+        std::fprintf(out, "%s\n    { \"testName\": ", first ? "" : ",");
+        printJsonString(out, test.name);
+        std::fprintf(out, ", \"funcName\": ");
+        printJsonString(out, test.function);
+        std::fprintf(out, ", \"avg\": %.6f, \"min\": %.6f, \"max\": %.6f, \"median\": %.6f, \"checksum\": %llu, "
+                          "\"scratchGrows\": %llu, \"scratchHighWater\": %llu, \"times\": [",
+                     stats.avg, stats.min, stats.max, stats.median,
+                     static_cast<unsigned long long>(stats.checksum),
+                     static_cast<unsigned long long>(stats.scratchGrows),
+                     static_cast<unsigned long long>(stats.scratchHighWater));
+        for (size_t i = 0; i < stats.times.size(); i++)
+            std::fprintf(out, "%s%.6f", i == 0 ? "" : ", ", stats.times[i]);
+        std::fprintf(out, "] }");
+        first = false;
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout)
+        std::fclose(out);
+
+    freePreparedNumberTreeMap(numberMap);
+    freePreparedStringMap(stringMap);
+    freePreparedFlatStringMap(flatStringMap);
+    freeFlatStringMapData(flatStringData);
+    freeStringMapData(stringData);
+    return 0;
+}
@@ -0,0 +1,587 @@
+/**
+ * Differential test for array_processor.cpp
+ * Runs every scalar, SIMD, multithreaded and typed variant of a kernel on
+ * the same input and checks it against a plain reference loop. Inputs are
+ * randomized per round: the length (including tails of every size below a
+ * vector), the element offset of the data pointer, and the value
+ * distribution, which includes adversarial cases (all 0xFFFFFFFF,
+ * alternating extremes, sorted, few distinct values).
+ *
+ * Usage:
+ *   array_processor_differential_test [--rounds N] [--seed N] [--max-size N]
+ *                                     [--large N]
+ *
+ * --large runs the overflow check of the sums at N elements (e.g. 100000000);
+ * exits 1 on the first round with a mismatch.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "../fused_pipeline.h"
+
+// Same layout as ArrayStats in array_processor.cpp
+struct ArrayStats
+{
+    double count;
+    double sum;
+    double min;
+    double max;
+    double mean;
+    double m2;
+    double variance;
+};
+
+extern "C"
+{
+    uint64_t sumArray(const uint32_t *arr, uint32_t length);
+    uint32_t findMax(const uint32_t *arr, uint32_t length);
+    uint32_t findMin(const uint32_t *arr, uint32_t length);
+    double calculateAverage(const uint32_t *arr, uint32_t length);
+    void multiplyArray(uint32_t *arr, uint32_t length, uint32_t factor);
+    uint32_t countGreaterThan(const uint32_t *arr, uint32_t length, uint32_t threshold);
+    void radixSortU32(uint32_t *arr, uint32_t length);
+    void quickSort(uint32_t *arr, uint32_t length);
+    void reverseArray(uint32_t *arr, uint32_t length);
+    double calculateVariance(const uint32_t *arr, uint32_t length);
+    int binarySearch(const uint32_t *arr, uint32_t length, uint32_t target);
+    void addToArray(uint32_t *arr, uint32_t length, uint32_t value);
+    uint32_t countUnique(uint32_t *arr, uint32_t length);
+    uint32_t countUniqueExact(const uint32_t *arr, uint32_t length);
+
+    uint64_t sumArraySIMD(const uint32_t *arr, uint32_t length);
+    uint32_t findMaxSIMD(const uint32_t *arr, uint32_t length);
+    uint32_t findMinSIMD(const uint32_t *arr, uint32_t length);
+    void multiplyArraySIMD(uint32_t *arr, uint32_t length, uint32_t factor);
+    void addToArraySIMD(uint32_t *arr, uint32_t length, uint32_t value);
+    double calculateAverageSIMD(const uint32_t *arr, uint32_t length);
+    uint32_t countGreaterThanSIMD(const uint32_t *arr, uint32_t length, uint32_t threshold);
+
+    double sumArrayU32(const uint32_t *arr, uint32_t length);
+    double findMinU32(const uint32_t *arr, uint32_t length);
+    double findMaxU32(const uint32_t *arr, uint32_t length);
+    double findMinF32(const float *arr, uint32_t length);
+    double findMaxF32(const float *arr, uint32_t length);
+    double findMinF64(const double *arr, uint32_t length);
+    double findMaxF64(const double *arr, uint32_t length);
+
+    uint32_t filterU32(const uint32_t *column, uint32_t length, uint32_t op, uint32_t value, uint32_t high, uint32_t *bitmap);
+    uint32_t bitmapCount(const uint32_t *bitmap, uint32_t length);
+    uint32_t gatherSelected(const uint32_t *column, const uint32_t *bitmap, uint32_t length, uint32_t *out, uint32_t capacity);
+
+    void computeStats(
+        const uint32_t *arr, uint32_t length, ArrayStats *stats,
+        uint32_t *bins, uint32_t binCount, uint32_t histogramMin, uint32_t histogramMax);
+
+    uint64_t sumArray_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount);
+    double calculateAverage_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount);
+    uint32_t findMax_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount);
+    uint32_t findMin_MT(const uint32_t *arr, uint32_t length, uint32_t threadCount);
+    uint32_t countGreaterThan_MT(const uint32_t *arr, uint32_t length, uint32_t threshold, uint32_t threadCount);
+    void computeStats_MT(
+        const uint32_t *arr, uint32_t length, ArrayStats *stats,
+        uint32_t *bins, uint32_t binCount, uint32_t histogramMin, uint32_t histogramMax,
+        uint32_t threadCount);
+    void mergeSort_MT(uint32_t *arr, uint32_t length, uint32_t threadCount);
+
+    fused_pipeline::Pipeline *createPipeline(const uint32_t *stages, uint32_t stageCount, uint32_t reduce);
+    void freePipeline(fused_pipeline::Pipeline *pipeline);
+    uint64_t runPipeline(const fused_pipeline::Pipeline *pipeline, const uint32_t *arr, uint32_t length);
+    uint64_t runPipeline_MT(const fused_pipeline::Pipeline *pipeline, const uint32_t *arr, uint32_t length, uint32_t threadCount);
+}
+
+enum Distribution
+{
+    UNIFORM,
+    ZEROS,
+    ALL_MAX,
+    ALTERNATING_EXTREMES,
+    SORTED,
+    REVERSE_SORTED,
+    FEW_DISTINCT,
+    HIGH_BIT,
+    DISTRIBUTION_COUNT
+};
+
+static const char *const DISTRIBUTION_NAMES[DISTRIBUTION_COUNT] = {
+    "uniform", "zeros", "all-max", "alternating-extremes",
+    "sorted", "reverse-sorted", "few-distinct", "high-bit"};
+
+// Element offsets of the data pointer, so vector loads start misaligned
+static const uint32_t MAX_ALIGNMENT_OFFSET = 3;
+
+struct Options
+{
+    uint32_t rounds = 200;
+    uint32_t seed = 1;
+    uint32_t maxSize = 70000;
+    uint32_t large = 0;
+};
+
+/**
+ * Input of one round: values live at an element offset inside storage
+ */
+struct Input
+{
+    std::vector<uint32_t> storage;
+    uint32_t offset = 0;
+    uint32_t length = 0;
+    Distribution distribution = UNIFORM;
+
+    uint32_t *data() { return storage.data() + offset; }
+    const uint32_t *data() const { return storage.data() + offset; }
+    std::vector<uint32_t> values() const
+    {
+        return std::vector<uint32_t>(storage.begin() + offset, storage.begin() + offset + length);
+    }
+};
+
+static uint32_t g_failures = 0;
+static std::string g_context;
+
+static void fail(const char *kernel, const std::string &detail)
+{
+    g_failures++;
+    std::fprintf(stderr, "MISMATCH %s (%s): %s\n", kernel, g_context.c_str(), detail.c_str());
+}
+
+static void expectEqual(const char *kernel, uint64_t expected, uint64_t actual)
+{
+    if (expected != actual)
+        fail(kernel, "expected " + std::to_string(expected) + ", got " + std::to_string(actual));
+}
+
+static void expectClose(const char *kernel, double expected, double actual)
+{
+    double tolerance = 1e-9 * std::max(1.0, std::fabs(expected));
+    if (!(std::fabs(expected - actual) <= tolerance))
+        fail(kernel, "expected " + std::to_string(expected) + ", got " + std::to_string(actual));
+}
+
+static void expectArray(const char *kernel, const std::vector<uint32_t> &expected, const uint32_t *actual)
+{
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        if (expected[i] != actual[i])
+        {
+            fail(kernel, "index " + std::to_string(i) + ": expected " + std::to_string(expected[i]) +
+                             ", got " + std::to_string(actual[i]));
+            return;
+        }
+    }
+}
+
+static void fillValues(Input &input, std::mt19937 &rng)
+{
+    uint32_t *data = input.data();
+    std::uniform_int_distribution<uint32_t> any(0, UINT32_MAX);
+    for (uint32_t i = 0; i < input.length; i++)
+    {
+        switch (input.distribution)
+        {
+        case UNIFORM:
+        case SORTED:
+        case REVERSE_SORTED:
+            data[i] = any(rng);
+            break;
+        case ZEROS:
+            data[i] = 0;
+            break;
+        case ALL_MAX:
+            data[i] = UINT32_MAX;
+            break;
+        case ALTERNATING_EXTREMES:
+            data[i] = i % 2 == 0 ? UINT32_MAX : 0;
+            break;
+        case FEW_DISTINCT:
+            data[i] = any(rng) % 4 * 0x40000000u;
+            break;
+        case HIGH_BIT:
+            data[i] = 0x80000000u | (any(rng) & 0xFF);
+            break;
+        default:
+            break;
+        }
+    }
+    if (input.distribution == SORTED)
+        std::sort(data, data + input.length);
+    else if (input.distribution == REVERSE_SORTED)
+        std::sort(data, data + input.length, [](uint32_t a, uint32_t b) { return a > b; });
+}
+
+static void checkReductions(Input &input, uint32_t threadCount)
+{
+    const uint32_t *data = input.data();
+    uint32_t length = input.length;
+
+    uint64_t sum = 0;
+    uint32_t maxValue = 0;
+    uint32_t minValue = UINT32_MAX;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        sum += data[i];
+        maxValue = std::max(maxValue, data[i]);
+        minValue = std::min(minValue, data[i]);
+    }
+
+    expectEqual("sumArray", sum, sumArray(data, length));
+    expectEqual("sumArraySIMD", sum, sumArraySIMD(data, length));
+    expectEqual("sumArray_MT", sum, sumArray_MT(data, length, threadCount));
+    // Doubles hold the sum exactly below 2^53
+    expectEqual("sumArrayU32", sum, static_cast<uint64_t>(sumArrayU32(data, length)));
+
+    if (length == 0)
+        return;
+
+    expectEqual("findMax", maxValue, findMax(data, length));
+    expectEqual("findMaxSIMD", maxValue, findMaxSIMD(data, length));
+    expectEqual("findMax_MT", maxValue, findMax_MT(data, length, threadCount));
+    expectEqual("findMaxU32", maxValue, static_cast<uint64_t>(findMaxU32(data, length)));
+    expectEqual("findMin", minValue, findMin(data, length));
+    expectEqual("findMinSIMD", minValue, findMinSIMD(data, length));
+    expectEqual("findMin_MT", minValue, findMin_MT(data, length, threadCount));
+    expectEqual("findMinU32", minValue, static_cast<uint64_t>(findMinU32(data, length)));
+
+    double mean = static_cast<double>(sum) / length;
+    expectClose("calculateAverage", mean, calculateAverage(data, length));
+    expectClose("calculateAverageSIMD", mean, calculateAverageSIMD(data, length));
+    expectClose("calculateAverage_MT", mean, calculateAverage_MT(data, length, threadCount));
+
+    long double m2 = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        long double diff = data[i] - static_cast<long double>(mean);
+        m2 += diff * diff;
+    }
+    double variance = static_cast<double>(m2 / length);
+    expectClose("calculateVariance", variance, calculateVariance(data, length));
+
+    ArrayStats stats;
+    computeStats(data, length, &stats, nullptr, 0, 0, 0);
+    expectEqual("computeStats.sum", sum, static_cast<uint64_t>(stats.sum));
+    expectEqual("computeStats.min", minValue, static_cast<uint64_t>(stats.min));
+    expectEqual("computeStats.max", maxValue, static_cast<uint64_t>(stats.max));
+    expectClose("computeStats.variance", variance, stats.variance);
+    computeStats_MT(data, length, &stats, nullptr, 0, 0, 0, threadCount);
+    expectEqual("computeStats_MT.sum", sum, static_cast<uint64_t>(stats.sum));
+    expectEqual("computeStats_MT.min", minValue, static_cast<uint64_t>(stats.min));
+    expectEqual("computeStats_MT.max", maxValue, static_cast<uint64_t>(stats.max));
+    expectClose("computeStats_MT.variance", variance, stats.variance);
+}
+
+static void checkPredicates(Input &input, uint32_t threadCount, std::mt19937 &rng)
+{
+    const uint32_t *data = input.data();
+    uint32_t length = input.length;
+
+    // A threshold from the data hits the equal case; the extremes hit none / all
+    uint32_t thresholds[4] = {0, UINT32_MAX, static_cast<uint32_t>(rng()), length > 0 ? data[rng() % length] : 0};
+    for (uint32_t threshold : thresholds)
+    {
+        uint32_t count = 0;
+        std::vector<uint32_t> selected;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            if (data[i] > threshold)
+            {
+                count++;
+                selected.push_back(data[i]);
+            }
+        }
+        expectEqual("countGreaterThan", count, countGreaterThan(data, length, threshold));
+        expectEqual("countGreaterThanSIMD", count, countGreaterThanSIMD(data, length, threshold));
+        expectEqual("countGreaterThan_MT", count, countGreaterThan_MT(data, length, threshold, threadCount));
+
+        std::vector<uint32_t> bitmap((length + 31) / 32 + 1, 0xA5A5A5A5u);
+        expectEqual("filterU32", count, filterU32(data, length, 0, threshold, 0, bitmap.data()));
+        expectEqual("bitmapCount", count, bitmapCount(bitmap.data(), length));
+        std::vector<uint32_t> gathered(count + 1);
+        expectEqual("gatherSelected", count, gatherSelected(data, bitmap.data(), length, gathered.data(), count));
+        expectArray("gatherSelected", selected, gathered.data());
+    }
+
+    if (length > 0)
+    {
+        std::vector<uint32_t> sorted = input.values();
+        std::sort(sorted.begin(), sorted.end());
+        uint32_t targets[3] = {sorted[rng() % length], static_cast<uint32_t>(rng()), UINT32_MAX};
+        for (uint32_t target : targets)
+        {
+            bool present = std::binary_search(sorted.begin(), sorted.end(), target);
+            int index = binarySearch(sorted.data(), length, target);
+            if (present ? index < 0 || sorted[index] != target : index != -1)
+                fail("binarySearch", "target " + std::to_string(target) + " gave index " + std::to_string(index));
+        }
+    }
+}
+
+static void checkTransforms(const Input &input, uint32_t threadCount, std::mt19937 &rng)
+{
+    std::vector<uint32_t> values = input.values();
+    uint32_t length = input.length;
+    uint32_t factor = static_cast<uint32_t>(rng());
+    uint32_t addend = static_cast<uint32_t>(rng());
+
+    std::vector<uint32_t> multiplied(values);
+    std::vector<uint32_t> added(values);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        multiplied[i] *= factor;
+        added[i] += addend;
+    }
+
+    // In-place kernels work on a copy at the round's alignment
+    Input work = input;
+    multiplyArray(work.data(), length, factor);
+    expectArray("multiplyArray", multiplied, work.data());
+    work = input;
+    multiplyArraySIMD(work.data(), length, factor);
+    expectArray("multiplyArraySIMD", multiplied, work.data());
+    work = input;
+    addToArray(work.data(), length, addend);
+    expectArray("addToArray", added, work.data());
+    work = input;
+    addToArraySIMD(work.data(), length, addend);
+    expectArray("addToArraySIMD", added, work.data());
+
+    std::vector<uint32_t> reversed(values.rbegin(), values.rend());
+    work = input;
+    reverseArray(work.data(), length);
+    expectArray("reverseArray", reversed, work.data());
+
+    std::vector<uint32_t> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    work = input;
+    quickSort(work.data(), length);
+    expectArray("quickSort", sorted, work.data());
+    work = input;
+    radixSortU32(work.data(), length);
+    expectArray("radixSortU32", sorted, work.data());
+    work = input;
+    mergeSort_MT(work.data(), length, threadCount);
+    expectArray("mergeSort_MT", sorted, work.data());
+
+    uint32_t unique = static_cast<uint32_t>(std::set<uint32_t>(values.begin(), values.end()).size());
+    expectEqual("countUniqueExact", unique, countUniqueExact(input.data(), length));
+    work = input;
+    expectEqual("countUnique", unique, countUnique(work.data(), length));
+}
+
+/**
+ * Reference for one pipeline stage on one row; false drops the row
+ */
+static bool applyReferenceStage(const uint32_t *stage, uint32_t &value)
+{
+    using namespace fused_pipeline;
+    switch (stage[0])
+    {
+    case OP_ADD: value += stage[1]; return true;
+    case OP_MULTIPLY: value *= stage[1]; return true;
+    case OP_AND: value &= stage[1]; return true;
+    case OP_XOR: value ^= stage[1]; return true;
+    case OP_SHIFT_RIGHT: value >>= stage[1] & 31; return true;
+    case OP_MIN: value = std::min(value, stage[1]); return true;
+    case OP_MAX: value = std::max(value, stage[1]); return true;
+    case OP_KEEP_GREATER: return value > stage[1];
+    case OP_KEEP_LESS: return value < stage[1];
+    case OP_KEEP_EQUAL: return value == stage[1];
+    case OP_KEEP_BETWEEN: return value >= stage[1] && value <= stage[2];
+    }
+    return false;
+}
+
+/**
+ * Random chains of maps and predicates with each reduction, against a
+ * row-at-a-time loop
+ */
+static void checkPipelines(const Input &input, uint32_t threadCount, std::mt19937 &rng)
+{
+    using namespace fused_pipeline;
+    const uint32_t *data = input.data();
+    uint32_t length = input.length;
+    const uint32_t ops[11] = {OP_ADD, OP_MULTIPLY, OP_AND, OP_XOR, OP_SHIFT_RIGHT, OP_MIN, OP_MAX,
+                              OP_KEEP_GREATER, OP_KEEP_LESS, OP_KEEP_EQUAL, OP_KEEP_BETWEEN};
+
+    for (uint32_t reduce = REDUCE_SUM; reduce <= REDUCE_MAX; reduce++)
+    {
+        uint32_t stageCount = static_cast<uint32_t>(rng() % 6);
+        std::vector<uint32_t> stages(stageCount * STAGE_WORDS);
+        for (uint32_t s = 0; s < stageCount; s++)
+        {
+            uint32_t *stage = &stages[s * STAGE_WORDS];
+            stage[0] = ops[rng() % 11];
+            // Predicates on a value from the data hit the equal case
+            stage[1] = isPredicate(stage[0]) && length > 0 && rng() % 2 == 0 ? data[rng() % length] : static_cast<uint32_t>(rng());
+            stage[2] = static_cast<uint32_t>(rng());
+            if (stage[0] == OP_KEEP_BETWEEN && stage[1] > stage[2])
+                std::swap(stage[1], stage[2]);
+        }
+
+        uint64_t value = reduce == REDUCE_MIN ? UINT32_MAX : 0;
+        uint64_t kept = 0;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            uint32_t row = data[i];
+            bool keep = true;
+            for (uint32_t s = 0; s < stageCount; s++)
+                keep = applyReferenceStage(&stages[s * STAGE_WORDS], row) && keep;
+            if (!keep)
+                continue;
+            kept++;
+            if (reduce == REDUCE_SUM)
+                value += row;
+            else if (reduce == REDUCE_MIN)
+                value = std::min<uint64_t>(value, row);
+            else if (reduce == REDUCE_MAX)
+                value = std::max<uint64_t>(value, row);
+        }
+        uint64_t expected = reduce == REDUCE_COUNT ? kept : kept == 0 ? 0 : value;
+
+        Pipeline *pipeline = createPipeline(stages.data(), stageCount, reduce);
+        if (pipeline == nullptr)
+        {
+            fail("createPipeline", "rejected a valid pipeline");
+            continue;
+        }
+        expectEqual("runPipeline", expected, runPipeline(pipeline, data, length));
+        expectEqual("runPipeline_MT", expected, runPipeline_MT(pipeline, data, length, threadCount));
+        freePipeline(pipeline);
+    }
+
+    const uint32_t badStage[STAGE_WORDS] = {7, 0, 0};
+    if (createPipeline(badStage, 1, REDUCE_SUM) != nullptr || createPipeline(nullptr, 0, REDUCE_MAX + 1) != nullptr)
+        fail("createPipeline", "accepted an unknown op or reduction");
+}
+
+/**
+ * Float min / max of T with the input's values and some NaN: vector lanes
+ * and scalar tail both skip NaN, so the result is that of a loop that does
+ */
+template <typename T>
+static void checkFloatMinMax(const Input &input, std::mt19937 &rng, const char *minName, const char *maxName,
+                             double (*findMinT)(const T *, uint32_t), double (*findMaxT)(const T *, uint32_t))
+{
+    uint32_t length = input.length;
+    if (length == 0)
+        return;
+    std::vector<T> values(length);
+    const uint32_t *data = input.data();
+    // Every NaN in some rounds, none or a few in the others
+    uint32_t nanEvery = 1 + rng() % 8;
+    for (uint32_t i = 0; i < length; i++)
+        values[i] = rng() % nanEvery == 0 ? std::numeric_limits<T>::quiet_NaN() : static_cast<T>(data[i]) - T(1e9);
+
+    T low = std::numeric_limits<T>::infinity();
+    T high = -std::numeric_limits<T>::infinity();
+    for (T v : values)
+    {
+        if (v < low)
+            low = v;
+        if (v > high)
+            high = v;
+    }
+    double lowResult = findMinT(values.data(), length);
+    double highResult = findMaxT(values.data(), length);
+    if (!(lowResult == static_cast<double>(low)))
+        fail(minName, "expected " + std::to_string(low) + ", got " + std::to_string(lowResult));
+    if (!(highResult == static_cast<double>(high)))
+        fail(maxName, "expected " + std::to_string(high) + ", got " + std::to_string(highResult));
+}
+
+/**
+ * Sums of inputs far past 2^32, where 32-bit lane accumulators wrap
+ */
+static void checkLargeSums(uint32_t length, uint32_t threadCount)
+{
+    std::vector<uint32_t> data(length, UINT32_MAX);
+    uint64_t sum = static_cast<uint64_t>(length) * UINT32_MAX;
+    g_context = "all-max, length " + std::to_string(length);
+    expectEqual("sumArray", sum, sumArray(data.data(), length));
+    expectEqual("sumArraySIMD", sum, sumArraySIMD(data.data(), length));
+    expectEqual("sumArray_MT", sum, sumArray_MT(data.data(), length, threadCount));
+    expectClose("calculateAverageSIMD", UINT32_MAX, calculateAverageSIMD(data.data(), length));
+}
+
+static bool parseArgs(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        uint32_t value = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        if (arg == "--rounds")
+            options.rounds = value;
+        else if (arg == "--seed")
+            options.seed = value;
+        else if (arg == "--max-size")
+            options.maxSize = std::max<uint32_t>(value, 1);
+        else if (arg == "--large")
+            options.large = value;
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseArgs(argc, argv, options))
+        return 2;
+
+    std::mt19937 rng(options.seed);
+    // 0 = every pool thread; 3 gives uneven chunks
+    const uint32_t threadCounts[2] = {0, 3};
+
+    for (uint32_t round = 0; round < options.rounds; round++)
+    {
+        Input input;
+        input.distribution = static_cast<Distribution>(round % DISTRIBUTION_COUNT);
+        // Every third round stays short, so each tail length below a vector is hit
+        input.length = round % 3 == 0 ? rng() % 67 : rng() % (options.maxSize + 1);
+        input.offset = rng() % (MAX_ALIGNMENT_OFFSET + 1);
+        input.storage.assign(input.length + MAX_ALIGNMENT_OFFSET, 0xDEADBEEFu);
+        fillValues(input, rng);
+        uint32_t threadCount = threadCounts[round % 2];
+
+        g_context = "round " + std::to_string(round) + ", " + DISTRIBUTION_NAMES[input.distribution] +
+                    ", length " + std::to_string(input.length) + ", offset " + std::to_string(input.offset);
+        uint32_t failuresBefore = g_failures;
+        checkReductions(input, threadCount);
+        checkPredicates(input, threadCount, rng);
+        checkTransforms(input, threadCount, rng);
+        checkPipelines(input, threadCount, rng);
+        checkFloatMinMax<float>(input, rng, "findMinF32", "findMaxF32", findMinF32, findMaxF32);
+        checkFloatMinMax<double>(input, rng, "findMinF64", "findMaxF64", findMinF64, findMaxF64);
+        if (g_failures != failuresBefore)
+        {
+            std::fprintf(stderr, "Reproduce with --seed %u\n", options.seed);
+            return 1;
+        }
+    }
+
+    // 2^20 all-max elements overflow every 32-bit lane
+    checkLargeSums(1u << 20, 0);
+    if (options.large > 0)
+        checkLargeSums(options.large, 0);
+    if (g_failures > 0)
+        return 1;
+
+    std::printf("%u rounds passed (seed %u, max size %u)\n", options.rounds, options.seed, options.maxSize);
+    return 0;
+}
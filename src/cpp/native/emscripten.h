@@ -0,0 +1,25 @@
+/**
+ * Native stand-in for <emscripten.h>
+ * Lets array_processor.cpp build with the host compiler for profiling and
+ * native/WASM comparisons. Only the pieces the kernels use are provided.
+ */
+
+#ifndef ARRAY_PROCESSOR_NATIVE_EMSCRIPTEN_H
+#define ARRAY_PROCESSOR_NATIVE_EMSCRIPTEN_H
+
+#include <chrono>
+
+#ifndef EMSCRIPTEN_KEEPALIVE
+#define EMSCRIPTEN_KEEPALIVE __attribute__((used))
+#endif
+
+/**
+ * Monotonic time in milliseconds, same unit as performance.now()
+ */
+static inline double emscripten_get_now(void)
+{
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double, std::milli>(clock::now().time_since_epoch()).count();
+}
+
+#endif // ARRAY_PROCESSOR_NATIVE_EMSCRIPTEN_H
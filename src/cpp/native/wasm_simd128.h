@@ -0,0 +1,722 @@
+/**
+ * Native stand-in for <wasm_simd128.h>
+ * Maps the wasm_* SIMD intrinsics used by array_processor.cpp onto
+ * SSE4.1 (x86-64) or NEON (AArch64) so the kernels keep their 128-bit
+ * vector shape when built with the host compiler.
+ */
+
+#ifndef ARRAY_PROCESSOR_NATIVE_WASM_SIMD128_H
+#define ARRAY_PROCESSOR_NATIVE_WASM_SIMD128_H
+
+#include <cstdint>
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define WASM_SIMD_NATIVE_SSE 1
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define WASM_SIMD_NATIVE_NEON 1
+#else
+#error "Native wasm_simd128.h shim requires SSE4.1 (-msse4.1) or NEON"
+#endif
+
+#define WASM_SIMD_INLINE static inline __attribute__((always_inline))
+
+#if defined(WASM_SIMD_NATIVE_SSE)
+
+typedef __m128i v128_t;
+
+// ========== LOAD / STORE ==========
+
+WASM_SIMD_INLINE v128_t wasm_v128_load(const void *mem)
+{
+    return _mm_loadu_si128(static_cast<const __m128i *>(mem));
+}
+
+WASM_SIMD_INLINE void wasm_v128_store(void *mem, v128_t a)
+{
+    _mm_storeu_si128(static_cast<__m128i *>(mem), a);
+}
+
+// ========== INTEGER LANES ==========
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_splat(int8_t a)
+{
+    return _mm_set1_epi8(a);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_eq(v128_t a, v128_t b)
+{
+    return _mm_cmpeq_epi8(a, b);
+}
+
+WASM_SIMD_INLINE uint32_t wasm_i8x16_bitmask(v128_t a)
+{
+    return static_cast<uint32_t>(_mm_movemask_epi8(a));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_swizzle(v128_t a, v128_t b)
+{
+    // pshufb zeroes lanes whose index has the high bit set; wasm zeroes any
+    // index >= 16, so clamp those to 0x80 first
+    __m128i outOfRange = _mm_cmpgt_epi8(b, _mm_set1_epi8(15));
+    return _mm_shuffle_epi8(a, _mm_or_si128(b, outOfRange));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u8x16_max(v128_t a, v128_t b)
+{
+    return _mm_max_epu8(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_add(v128_t a, v128_t b)
+{
+    return _mm_add_epi8(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_min(v128_t a, v128_t b)
+{
+    return _mm_min_epi8(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_max(v128_t a, v128_t b)
+{
+    return _mm_max_epi8(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_splat(int16_t a)
+{
+    return _mm_set1_epi16(a);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_add(v128_t a, v128_t b)
+{
+    return _mm_add_epi16(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_mul(v128_t a, v128_t b)
+{
+    return _mm_mullo_epi16(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_min(v128_t a, v128_t b)
+{
+    return _mm_min_epi16(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_max(v128_t a, v128_t b)
+{
+    return _mm_max_epi16(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_extadd_pairwise_i8x16(v128_t a)
+{
+    // maddubs multiplies unsigned bytes of the first operand by signed bytes
+    // of the second and adds adjacent pairs
+    return _mm_maddubs_epi16(_mm_set1_epi8(1), a);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_splat(int32_t a)
+{
+    return _mm_set1_epi32(a);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_add(v128_t a, v128_t b)
+{
+    return _mm_add_epi32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_mul(v128_t a, v128_t b)
+{
+    return _mm_mullo_epi32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_min(v128_t a, v128_t b)
+{
+    return _mm_min_epi32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_max(v128_t a, v128_t b)
+{
+    return _mm_max_epi32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_extadd_pairwise_i16x8(v128_t a)
+{
+    return _mm_madd_epi16(a, _mm_set1_epi16(1));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_eq(v128_t a, v128_t b)
+{
+    return _mm_cmpeq_epi32(a, b);
+}
+
+WASM_SIMD_INLINE uint32_t wasm_i32x4_bitmask(v128_t a)
+{
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(a)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u32x4_max(v128_t a, v128_t b)
+{
+    return _mm_max_epu32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_u32x4_min(v128_t a, v128_t b)
+{
+    return _mm_min_epu32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_u32x4_gt(v128_t a, v128_t b)
+{
+    // SSE only has a signed compare; bias both sides into signed range
+    const __m128i bias = _mm_set1_epi32(static_cast<int32_t>(0x80000000u));
+    return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u32x4_shr(v128_t a, uint32_t b)
+{
+    return _mm_srl_epi32(a, _mm_cvtsi32_si128(static_cast<int32_t>(b & 31)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_v128_xor(v128_t a, v128_t b)
+{
+    return _mm_xor_si128(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_v128_and(v128_t a, v128_t b)
+{
+    return _mm_and_si128(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_v128_or(v128_t a, v128_t b)
+{
+    return _mm_or_si128(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_v128_not(v128_t a)
+{
+    return _mm_xor_si128(a, _mm_set1_epi32(-1));
+}
+
+WASM_SIMD_INLINE bool wasm_v128_any_true(v128_t a)
+{
+    return !_mm_testz_si128(a, a);
+}
+
+// ========== 64-BIT LANES ==========
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_splat(int64_t a)
+{
+    return _mm_set1_epi64x(a);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_extend_low_i32x4(v128_t a)
+{
+    return _mm_cvtepi32_epi64(a);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_extend_high_i32x4(v128_t a)
+{
+    return _mm_cvtepi32_epi64(_mm_srli_si128(a, 8));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u64x2_extend_low_u32x4(v128_t a)
+{
+    return _mm_cvtepu32_epi64(a);
+}
+
+WASM_SIMD_INLINE v128_t wasm_u64x2_extend_high_u32x4(v128_t a)
+{
+    return _mm_unpackhi_epi32(a, _mm_setzero_si128());
+}
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_add(v128_t a, v128_t b)
+{
+    return _mm_add_epi64(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_mul(v128_t a, v128_t b)
+{
+    // No 64-bit multiply before AVX-512: lo*lo + ((hi*lo + lo*hi) << 32)
+    __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+                                  _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+    return _mm_add_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(cross, 32));
+}
+
+// ========== FLOAT LANES ==========
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_splat(float a)
+{
+    return _mm_castps_si128(_mm_set1_ps(a));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_add(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_mul(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_mul_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_min(v128_t a, v128_t b)
+{
+    // minps returns b when either lane is NaN; wasm returns NaN
+    return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_max(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+// pmin / pmax: b < a ? b : a and a < b ? b : a, which minps / maxps give
+// with the operands swapped (a NaN b never replaces a)
+WASM_SIMD_INLINE v128_t wasm_f32x4_pmin(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(b), _mm_castsi128_ps(a)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_pmax(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(b), _mm_castsi128_ps(a)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_eq(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_gt(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_cmpgt_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_lt(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_cmplt_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_ge(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_cmpge_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_le(v128_t a, v128_t b)
+{
+    return _mm_castps_si128(_mm_cmple_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_splat(double a)
+{
+    return _mm_castpd_si128(_mm_set1_pd(a));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_add(v128_t a, v128_t b)
+{
+    return _mm_castpd_si128(_mm_add_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_sub(v128_t a, v128_t b)
+{
+    return _mm_castpd_si128(_mm_sub_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_mul(v128_t a, v128_t b)
+{
+    return _mm_castpd_si128(_mm_mul_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_min(v128_t a, v128_t b)
+{
+    return _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_max(v128_t a, v128_t b)
+{
+    return _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_pmin(v128_t a, v128_t b)
+{
+    return _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(b), _mm_castsi128_pd(a)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_pmax(v128_t a, v128_t b)
+{
+    return _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(b), _mm_castsi128_pd(a)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_promote_low_f32x4(v128_t a)
+{
+    return _mm_castpd_si128(_mm_cvtps_pd(_mm_castsi128_ps(a)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_convert_low_u32x4(v128_t a)
+{
+    // Only a signed conversion exists; bias into signed range and add 2^31 back
+    const __m128i bias = _mm_set1_epi32(static_cast<int32_t>(0x80000000u));
+    __m128d converted = _mm_cvtepi32_pd(_mm_xor_si128(a, bias));
+    return _mm_castpd_si128(_mm_add_pd(converted, _mm_set1_pd(2147483648.0)));
+}
+
+#else // WASM_SIMD_NATIVE_NEON
+
+typedef int32x4_t v128_t;
+
+// ========== LOAD / STORE ==========
+
+WASM_SIMD_INLINE v128_t wasm_v128_load(const void *mem)
+{
+    return vld1q_s32(static_cast<const int32_t *>(mem));
+}
+
+WASM_SIMD_INLINE void wasm_v128_store(void *mem, v128_t a)
+{
+    vst1q_s32(static_cast<int32_t *>(mem), a);
+}
+
+// ========== INTEGER LANES ==========
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_splat(int8_t a)
+{
+    return vreinterpretq_s32_s8(vdupq_n_s8(a));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_eq(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u8(vceqq_s8(vreinterpretq_s8_s32(a), vreinterpretq_s8_s32(b)));
+}
+
+WASM_SIMD_INLINE uint32_t wasm_i8x16_bitmask(v128_t a)
+{
+    // Move each lane's sign bit to its bit position, then sum each half
+    static const int8_t shifts[16] = {0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7};
+    uint8x16_t bits = vshrq_n_u8(vreinterpretq_u8_s32(a), 7);
+    uint8x16_t weighted = vshlq_u8(bits, vld1q_s8(shifts));
+    return static_cast<uint32_t>(vaddv_u8(vget_low_u8(weighted))) |
+           (static_cast<uint32_t>(vaddv_u8(vget_high_u8(weighted))) << 8);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_swizzle(v128_t a, v128_t b)
+{
+    // tbl returns 0 for indices >= 16, as wasm does
+    return vreinterpretq_s32_u8(vqtbl1q_u8(vreinterpretq_u8_s32(a), vreinterpretq_u8_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u8x16_max(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u8(vmaxq_u8(vreinterpretq_u8_s32(a), vreinterpretq_u8_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_add(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_s8(vaddq_s8(vreinterpretq_s8_s32(a), vreinterpretq_s8_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_min(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_s8(vminq_s8(vreinterpretq_s8_s32(a), vreinterpretq_s8_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i8x16_max(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_s8(vmaxq_s8(vreinterpretq_s8_s32(a), vreinterpretq_s8_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_splat(int16_t a)
+{
+    return vreinterpretq_s32_s16(vdupq_n_s16(a));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_add(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_s16(vaddq_s16(vreinterpretq_s16_s32(a), vreinterpretq_s16_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_mul(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_s16(vmulq_s16(vreinterpretq_s16_s32(a), vreinterpretq_s16_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_min(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_s16(vminq_s16(vreinterpretq_s16_s32(a), vreinterpretq_s16_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_max(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_s16(vmaxq_s16(vreinterpretq_s16_s32(a), vreinterpretq_s16_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i16x8_extadd_pairwise_i8x16(v128_t a)
+{
+    return vreinterpretq_s32_s16(vpaddlq_s8(vreinterpretq_s8_s32(a)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_splat(int32_t a)
+{
+    return vdupq_n_s32(a);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_add(v128_t a, v128_t b)
+{
+    return vaddq_s32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_mul(v128_t a, v128_t b)
+{
+    return vmulq_s32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_min(v128_t a, v128_t b)
+{
+    return vminq_s32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_max(v128_t a, v128_t b)
+{
+    return vmaxq_s32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_extadd_pairwise_i16x8(v128_t a)
+{
+    return vpaddlq_s16(vreinterpretq_s16_s32(a));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i32x4_eq(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u32(vceqq_s32(a, b));
+}
+
+WASM_SIMD_INLINE uint32_t wasm_i32x4_bitmask(v128_t a)
+{
+    static const int32_t shifts[4] = {0, 1, 2, 3};
+    uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_s32(a), 31);
+    return vaddvq_u32(vshlq_u32(bits, vld1q_s32(shifts)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u32x4_max(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u32(vmaxq_u32(vreinterpretq_u32_s32(a), vreinterpretq_u32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u32x4_min(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u32(vminq_u32(vreinterpretq_u32_s32(a), vreinterpretq_u32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u32x4_gt(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u32(vcgtq_u32(vreinterpretq_u32_s32(a), vreinterpretq_u32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u32x4_shr(v128_t a, uint32_t b)
+{
+    // NEON shifts right by a negative left-shift count
+    int32x4_t count = vdupq_n_s32(-static_cast<int32_t>(b & 31));
+    return vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(a), count));
+}
+
+WASM_SIMD_INLINE v128_t wasm_v128_xor(v128_t a, v128_t b)
+{
+    return veorq_s32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_v128_and(v128_t a, v128_t b)
+{
+    return vandq_s32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_v128_or(v128_t a, v128_t b)
+{
+    return vorrq_s32(a, b);
+}
+
+WASM_SIMD_INLINE v128_t wasm_v128_not(v128_t a)
+{
+    return vmvnq_s32(a);
+}
+
+WASM_SIMD_INLINE bool wasm_v128_any_true(v128_t a)
+{
+    return vmaxvq_u32(vreinterpretq_u32_s32(a)) != 0;
+}
+
+// ========== 64-BIT LANES ==========
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_splat(int64_t a)
+{
+    return vreinterpretq_s32_s64(vdupq_n_s64(a));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_extend_low_i32x4(v128_t a)
+{
+    return vreinterpretq_s32_s64(vmovl_s32(vget_low_s32(a)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_extend_high_i32x4(v128_t a)
+{
+    return vreinterpretq_s32_s64(vmovl_s32(vget_high_s32(a)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u64x2_extend_low_u32x4(v128_t a)
+{
+    return vreinterpretq_s32_u64(vmovl_u32(vget_low_u32(vreinterpretq_u32_s32(a))));
+}
+
+WASM_SIMD_INLINE v128_t wasm_u64x2_extend_high_u32x4(v128_t a)
+{
+    return vreinterpretq_s32_u64(vmovl_u32(vget_high_u32(vreinterpretq_u32_s32(a))));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_add(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_s64(vaddq_s64(vreinterpretq_s64_s32(a), vreinterpretq_s64_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_i64x2_mul(v128_t a, v128_t b)
+{
+    // NEON has no 64-bit lane multiply; multiply the lanes as scalars
+    uint64x2_t x = vreinterpretq_u64_s32(a);
+    uint64x2_t y = vreinterpretq_u64_s32(b);
+    uint64x2_t product = vdupq_n_u64(vgetq_lane_u64(x, 0) * vgetq_lane_u64(y, 0));
+    product = vsetq_lane_u64(vgetq_lane_u64(x, 1) * vgetq_lane_u64(y, 1), product, 1);
+    return vreinterpretq_s32_u64(product);
+}
+
+// ========== FLOAT LANES ==========
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_splat(float a)
+{
+    return vreinterpretq_s32_f32(vdupq_n_f32(a));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_add(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_f32(vaddq_f32(vreinterpretq_f32_s32(a), vreinterpretq_f32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_mul(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_f32(vmulq_f32(vreinterpretq_f32_s32(a), vreinterpretq_f32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_min(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_f32(vminq_f32(vreinterpretq_f32_s32(a), vreinterpretq_f32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_max(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_f32(vmaxq_f32(vreinterpretq_f32_s32(a), vreinterpretq_f32_s32(b)));
+}
+
+// pmin / pmax: b < a ? b : a and a < b ? b : a (a NaN b never replaces a)
+WASM_SIMD_INLINE v128_t wasm_f32x4_pmin(v128_t a, v128_t b)
+{
+    float32x4_t fa = vreinterpretq_f32_s32(a), fb = vreinterpretq_f32_s32(b);
+    return vreinterpretq_s32_f32(vbslq_f32(vcltq_f32(fb, fa), fb, fa));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_pmax(v128_t a, v128_t b)
+{
+    float32x4_t fa = vreinterpretq_f32_s32(a), fb = vreinterpretq_f32_s32(b);
+    return vreinterpretq_s32_f32(vbslq_f32(vcltq_f32(fa, fb), fb, fa));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_eq(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u32(vceqq_f32(vreinterpretq_f32_s32(a), vreinterpretq_f32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_gt(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u32(vcgtq_f32(vreinterpretq_f32_s32(a), vreinterpretq_f32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_lt(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u32(vcltq_f32(vreinterpretq_f32_s32(a), vreinterpretq_f32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_ge(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u32(vcgeq_f32(vreinterpretq_f32_s32(a), vreinterpretq_f32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f32x4_le(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_u32(vcleq_f32(vreinterpretq_f32_s32(a), vreinterpretq_f32_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_splat(double a)
+{
+    return vreinterpretq_s32_f64(vdupq_n_f64(a));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_add(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_f64(vaddq_f64(vreinterpretq_f64_s32(a), vreinterpretq_f64_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_sub(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_f64(vsubq_f64(vreinterpretq_f64_s32(a), vreinterpretq_f64_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_mul(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_f64(vmulq_f64(vreinterpretq_f64_s32(a), vreinterpretq_f64_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_min(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_f64(vminq_f64(vreinterpretq_f64_s32(a), vreinterpretq_f64_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_max(v128_t a, v128_t b)
+{
+    return vreinterpretq_s32_f64(vmaxq_f64(vreinterpretq_f64_s32(a), vreinterpretq_f64_s32(b)));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_pmin(v128_t a, v128_t b)
+{
+    float64x2_t fa = vreinterpretq_f64_s32(a), fb = vreinterpretq_f64_s32(b);
+    return vreinterpretq_s32_f64(vbslq_f64(vcltq_f64(fb, fa), fb, fa));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_pmax(v128_t a, v128_t b)
+{
+    float64x2_t fa = vreinterpretq_f64_s32(a), fb = vreinterpretq_f64_s32(b);
+    return vreinterpretq_s32_f64(vbslq_f64(vcltq_f64(fa, fb), fb, fa));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_promote_low_f32x4(v128_t a)
+{
+    return vreinterpretq_s32_f64(vcvt_f64_f32(vget_low_f32(vreinterpretq_f32_s32(a))));
+}
+
+WASM_SIMD_INLINE v128_t wasm_f64x2_convert_low_u32x4(v128_t a)
+{
+    return vreinterpretq_s32_f64(vcvtq_f64_u64(vmovl_u32(vget_low_u32(vreinterpretq_u32_s32(a)))));
+}
+
+#endif
+
+// ========== SHUFFLES ==========
+
+// wasm_i32x4_shuffle takes compile-time lane indices (0-3 pick from a,
+// 4-7 from b); both GCC (12+) and Clang lower this to shufps/blend or
+// the NEON equivalents
+template <int C0, int C1, int C2, int C3>
+WASM_SIMD_INLINE v128_t wasm_simd_native_shuffle_i32x4(v128_t a, v128_t b)
+{
+    typedef int32_t lanes_t __attribute__((vector_size(16)));
+    return (v128_t)__builtin_shufflevector((lanes_t)a, (lanes_t)b, C0, C1, C2, C3);
+}
+
+#define wasm_i32x4_shuffle(a, b, c0, c1, c2, c3) \
+    wasm_simd_native_shuffle_i32x4<(c0), (c1), (c2), (c3)>((a), (b))
+
+#endif // ARRAY_PROCESSOR_NATIVE_WASM_SIMD128_H
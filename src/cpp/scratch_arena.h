@@ -0,0 +1,237 @@
+/**
+ * Per-thread scratch arena for kernel temporaries
+ *
+ * Kernels open a ScratchScope, bump-allocate their O(n) temporaries
+ * (traversal stacks, sort buffers, copies) from the calling thread's arena
+ * and release everything when the scope closes. The arena keeps a single
+ * block sized to the most it ever had in use at once (its high-water
+ * mark), so once a kernel has run at a given size, further calls do no
+ * malloc / free and cannot make the heap trigger memory.grow.
+ *
+ * A request that does not fit while other scratch is live goes to an
+ * overflow block. When the outermost scope closes, the overflow blocks are
+ * freed and the main block is replaced with one of the new high-water size.
+ *
+ * Counters are process-wide, summed over threads, and read through
+ * ScratchCounters::instance().
+ */
+
+#ifndef ARRAY_PROCESSOR_SCRATCH_ARENA_H
+#define ARRAY_PROCESSOR_SCRATCH_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+
+struct ScratchCounters
+{
+    // Bytes handed out by arenas (cumulative, after alignment)
+    std::atomic<uint64_t> bytesRequested{0};
+    // Heap bytes arenas hold right now
+    std::atomic<uint64_t> bytesReserved{0};
+    // Heap allocations made by arenas (main block replacements + overflow blocks)
+    std::atomic<uint64_t> grows{0};
+    // Most bytes one arena had in use at once
+    std::atomic<uint64_t> highWater{0};
+
+    static ScratchCounters &instance()
+    {
+        static ScratchCounters counters;
+        return counters;
+    }
+
+    void reset()
+    {
+        bytesRequested = 0;
+        grows = 0;
+        highWater = 0;
+    }
+};
+
+class ScratchArena
+{
+public:
+    static const size_t ALIGNMENT = 16;
+
+    static ScratchArena &local()
+    {
+        static thread_local ScratchArena arena;
+        return arena;
+    }
+
+    ScratchArena(const ScratchArena &) = delete;
+    ScratchArena &operator=(const ScratchArena &) = delete;
+
+    ~ScratchArena()
+    {
+        releaseOverflow();
+        releaseBlock();
+    }
+
+    /**
+     * 16-byte aligned, uninitialized bytes valid until the enclosing scope
+     * closes. Aborts when the heap is exhausted, as new[] does.
+     */
+    void *allocate(size_t bytes)
+    {
+        bytes = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        ScratchCounters &counters = ScratchCounters::instance();
+        counters.bytesRequested += bytes;
+
+        // Nothing is live: the main block can be replaced freely
+        if (used_ == 0 && capacity_ < bytes)
+            replaceBlock(bytes > highWater_ ? bytes : highWater_);
+
+        void *ptr;
+        if (used_ + bytes <= capacity_)
+            ptr = block_ + used_;
+        else
+            ptr = allocateOverflow(bytes);
+
+        used_ += bytes;
+        if (used_ > highWater_)
+            highWater_ = used_;
+        // The process-wide mark can be reset below this arena's own
+        uint64_t seen = counters.highWater.load(std::memory_order_relaxed);
+        while (seen < used_ && !counters.highWater.compare_exchange_weak(seen, used_))
+        {
+        }
+        return ptr;
+    }
+
+    size_t mark() const
+    {
+        return used_;
+    }
+
+    /**
+     * Release everything allocated after mark
+     */
+    void rewind(size_t mark)
+    {
+        used_ = mark;
+        if (used_ == 0)
+        {
+            releaseOverflow();
+            // Grow to the high-water mark now that nothing is live, so the
+            // next call of the same size fits without an overflow block
+            if (capacity_ < highWater_)
+                replaceBlock(highWater_);
+        }
+    }
+
+    /**
+     * Return the idle block to the heap (no scope may be open)
+     */
+    void trim()
+    {
+        if (used_ == 0)
+        {
+            releaseOverflow();
+            releaseBlock();
+            highWater_ = 0;
+        }
+    }
+
+private:
+    struct OverflowBlock
+    {
+        OverflowBlock *next;
+        size_t bytes;
+    };
+    // Overflow payloads start one alignment unit after their header
+    static_assert(sizeof(OverflowBlock) <= ALIGNMENT, "overflow header must fit the alignment");
+
+    ScratchArena() = default;
+
+    static uint8_t *heapAllocate(size_t bytes)
+    {
+        void *ptr = std::aligned_alloc(ALIGNMENT, bytes);
+        if (!ptr)
+            std::abort();
+        ScratchCounters &counters = ScratchCounters::instance();
+        counters.grows++;
+        counters.bytesReserved += bytes;
+        return static_cast<uint8_t *>(ptr);
+    }
+
+    static void heapFree(void *ptr, size_t bytes)
+    {
+        std::free(ptr);
+        ScratchCounters::instance().bytesReserved -= bytes;
+    }
+
+    void replaceBlock(size_t bytes)
+    {
+        releaseBlock();
+        block_ = heapAllocate(bytes);
+        capacity_ = bytes;
+    }
+
+    void releaseBlock()
+    {
+        if (block_)
+            heapFree(block_, capacity_);
+        block_ = nullptr;
+        capacity_ = 0;
+    }
+
+    void *allocateOverflow(size_t bytes)
+    {
+        uint8_t *raw = heapAllocate(bytes + ALIGNMENT);
+        OverflowBlock *header = reinterpret_cast<OverflowBlock *>(raw);
+        header->next = overflow_;
+        header->bytes = bytes + ALIGNMENT;
+        overflow_ = header;
+        return raw + ALIGNMENT;
+    }
+
+    void releaseOverflow()
+    {
+        while (overflow_)
+        {
+            OverflowBlock *next = overflow_->next;
+            heapFree(overflow_, overflow_->bytes);
+            overflow_ = next;
+        }
+    }
+
+    uint8_t *block_ = nullptr;
+    size_t capacity_ = 0;
+    // Bytes live in this arena, main block and overflow blocks together
+    size_t used_ = 0;
+    size_t highWater_ = 0;
+    OverflowBlock *overflow_ = nullptr;
+};
+
+/**
+ * Scratch allocations of one kernel call, released together at scope exit
+ */
+class ScratchScope
+{
+public:
+    ScratchScope() : arena_(ScratchArena::local()), mark_(arena_.mark()) {}
+    ~ScratchScope() { arena_.rewind(mark_); }
+
+    ScratchScope(const ScratchScope &) = delete;
+    ScratchScope &operator=(const ScratchScope &) = delete;
+
+    /**
+     * Uninitialized array of count elements
+     */
+    template <typename T>
+    T *allocate(size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                      "scratch memory is neither constructed nor destroyed");
+        return static_cast<T *>(arena_.allocate(count * sizeof(T)));
+    }
+
+private:
+    ScratchArena &arena_;
+    size_t mark_;
+};
+
+#endif // ARRAY_PROCESSOR_SCRATCH_ARENA_H
@@ -0,0 +1,262 @@
+/**
+ * Persistent work-stealing thread pool for the *_MT kernels
+ *
+ * Each thread (the calling thread included) owns a task deque. The owner
+ * pops from the back, idle threads steal from the front of the others.
+ * Workers are created once and sleep between jobs.
+ *
+ * Without pthreads (default single-threaded WASM build) the pool has no
+ * workers and parallelFor runs every task inline on the caller.
+ */
+
+#ifndef ARRAY_PROCESSOR_THREAD_POOL_H
+#define ARRAY_PROCESSOR_THREAD_POOL_H
+
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define ARRAY_PROCESSOR_THREADS 0
+#else
+#define ARRAY_PROCESSOR_THREADS 1
+#endif
+
+#if ARRAY_PROCESSOR_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+class WorkStealingPool
+{
+public:
+    typedef void (*TaskFn)(void *context, uint32_t taskIndex);
+
+    static WorkStealingPool &instance()
+    {
+        static WorkStealingPool pool;
+        return pool;
+    }
+
+    /**
+     * Threads available to a job: the workers plus the calling thread
+     */
+    uint32_t maxThreads() const
+    {
+#if ARRAY_PROCESSOR_THREADS
+        return static_cast<uint32_t>(workers_.size()) + 1;
+#else
+        return 1;
+#endif
+    }
+
+    /**
+     * True on the pool's worker threads; false on the thread that started
+     * a job, even while it runs that job's tasks
+     */
+    static bool onWorkerThread()
+    {
+#if ARRAY_PROCESSOR_THREADS
+        return workerThread();
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Clamp a requested thread count to [1, maxThreads()]; 0 means all
+     */
+    uint32_t resolveThreadCount(uint32_t threadCount) const
+    {
+        uint32_t max = maxThreads();
+        if (threadCount == 0 || threadCount > max)
+            return max;
+        return threadCount;
+    }
+
+    /**
+     * Run fn(context, i) for every i in [0, taskCount) on at most
+     * threadCount threads and return once all tasks have finished.
+     * Must be called from outside the pool (no nested jobs).
+     */
+    void parallelFor(uint32_t taskCount, uint32_t threadCount, TaskFn fn, void *context)
+    {
+#if ARRAY_PROCESSOR_THREADS
+        uint32_t active = resolveThreadCount(threadCount);
+        if (active <= 1 || taskCount <= 1)
+        {
+            for (uint32_t i = 0; i < taskCount; i++)
+                fn(context, i);
+            return;
+        }
+
+        pending_.store(taskCount, std::memory_order_relaxed);
+        activeThreads_.store(active, std::memory_order_relaxed);
+
+        // Round-robin distribution; imbalance is fixed up by stealing
+        for (uint32_t i = 0; i < taskCount; i++)
+        {
+            Queue &queue = *queues_[i % active];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(Task{fn, context, i});
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            generation_++;
+        }
+        wakeCondition_.notify_all();
+
+        drain(0);
+#else
+        (void)threadCount;
+        for (uint32_t i = 0; i < taskCount; i++)
+            fn(context, i);
+#endif
+    }
+
+    /**
+     * Convenience overload for lambdas: body(taskIndex)
+     */
+    template <typename Body>
+    void parallelFor(uint32_t taskCount, uint32_t threadCount, Body &&body)
+    {
+        typedef typename std::remove_reference<Body>::type BodyType;
+        parallelFor(
+            taskCount, threadCount,
+            [](void *context, uint32_t taskIndex)
+            { (*static_cast<BodyType *>(context))(taskIndex); },
+            const_cast<void *>(static_cast<const void *>(&body)));
+    }
+
+private:
+#if ARRAY_PROCESSOR_THREADS
+    struct Task
+    {
+        TaskFn fn;
+        void *context;
+        uint32_t index;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    WorkStealingPool()
+    {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        uint32_t threadCount = hardwareThreads > 1 ? hardwareThreads : 1;
+
+        for (uint32_t i = 0; i < threadCount; i++)
+            queues_.emplace_back(new Queue());
+        for (uint32_t id = 1; id < threadCount; id++)
+            workers_.emplace_back([this, id]()
+                                  { workerLoop(id); });
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            stop_ = true;
+        }
+        wakeCondition_.notify_all();
+        for (std::thread &worker : workers_)
+            worker.join();
+    }
+
+    bool popLocal(uint32_t id, Task &task)
+    {
+        Queue &queue = *queues_[id];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            return false;
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(uint32_t id, uint32_t active, Task &task)
+    {
+        for (uint32_t offset = 1; offset < active; offset++)
+        {
+            Queue &queue = *queues_[(id + offset) % active];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Execute tasks until the current job has no pending work left
+     */
+    void drain(uint32_t id)
+    {
+        Task task;
+        while (pending_.load(std::memory_order_acquire) > 0)
+        {
+            uint32_t active = activeThreads_.load(std::memory_order_relaxed);
+            if (id >= active)
+                return;
+
+            if (popLocal(id, task) || steal(id, active, task))
+            {
+                task.fn(task.context, task.index);
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    static bool &workerThread()
+    {
+        static thread_local bool isWorker = false;
+        return isWorker;
+    }
+
+    void workerLoop(uint32_t id)
+    {
+        workerThread() = true;
+        uint64_t seenGeneration = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                wakeCondition_.wait(lock, [&]()
+                                    { return stop_ || generation_ != seenGeneration; });
+                if (stop_)
+                    return;
+                seenGeneration = generation_;
+            }
+            drain(id);
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<uint32_t> pending_{0};
+    std::atomic<uint32_t> activeThreads_{1};
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+#else
+    WorkStealingPool() {}
+#endif
+};
+
+#endif // ARRAY_PROCESSOR_THREAD_POOL_H
@@ -0,0 +1,277 @@
+/**
+ * Parallel traversals of CSR trees (childOffsets / children, rooted at 0)
+ *
+ * parallelTreeBfs is level-synchronous. Each level's frontier is split into
+ * chunks, and every chunk visits its nodes and then copies their children
+ * into its own slice of the next frontier. The slices are placed by a prefix
+ * sum of the chunks' child counts, so the per-chunk frontier buffers need no
+ * merge step.
+ *
+ * parallelTreeDfs runs one depth-first worker per thread. A worker keeps a
+ * private stack and, while another worker is idle, hands the bottom half of
+ * it (the shallowest pending nodes, i.e. the largest subtrees) to a shared
+ * pool that idle workers take from.
+ *
+ * Both call visitor.visit(node, depth) once per reachable node, in no
+ * particular order across threads. Visitors are plain structs, one per task
+ * (treeTraversalVisitors(threadCount) of them); the caller initializes and
+ * merges them. Tasks work on a local copy, so adjacent visitors do not
+ * false-share while the traversal runs.
+ */
+
+#ifndef ARRAY_PROCESSOR_TREE_PARALLEL_H
+#define ARRAY_PROCESSOR_TREE_PARALLEL_H
+
+#include <algorithm>
+#include <cstdint>
+#include "thread_pool.h"
+#include "scratch_arena.h"
+
+struct CsrTree
+{
+    const uint32_t *childOffsets;
+    const uint32_t *children;
+    uint32_t nodeCount;
+};
+
+// Frontier chunks per thread, so stealing can even out uneven fan-out
+static const uint32_t TREE_TASKS_PER_THREAD = 4;
+// Frontier nodes per BFS chunk; narrower levels run on the calling thread
+static const uint32_t TREE_BFS_MIN_CHUNK = 4096;
+// Nodes a DFS worker visits between checks for idle workers
+static const uint32_t TREE_DFS_SHARE_INTERVAL = 256;
+// Initial private DFS stack, grown on demand
+static const uint32_t TREE_DFS_INITIAL_STACK = 1024;
+
+/**
+ * Visitors the traversals need for threadCount (0 = all pool threads)
+ */
+inline uint32_t treeTraversalVisitors(uint32_t threadCount)
+{
+    return WorkStealingPool::instance().resolveThreadCount(threadCount) * TREE_TASKS_PER_THREAD;
+}
+
+struct TreePendingNode
+{
+    uint32_t node;
+    uint32_t depth;
+};
+
+template <typename Visitor>
+void parallelTreeBfs(const CsrTree &tree, uint32_t threadCount, Visitor *visitors)
+{
+    if (tree.nodeCount == 0)
+        return;
+
+    WorkStealingPool &pool = WorkStealingPool::instance();
+    uint32_t threads = pool.resolveThreadCount(threadCount);
+    uint32_t maxChunks = threads * TREE_TASKS_PER_THREAD;
+
+    ScratchScope scratch;
+    uint32_t *frontier = scratch.allocate<uint32_t>(tree.nodeCount);
+    uint32_t *next = scratch.allocate<uint32_t>(tree.nodeCount);
+    uint32_t *chunkOffsets = scratch.allocate<uint32_t>(maxChunks + 1);
+    frontier[0] = 0;
+    uint32_t frontierSize = 1;
+
+    for (uint32_t depth = 0; frontierSize > 0; depth++)
+    {
+        uint32_t chunks = threads > 1 ? std::min(maxChunks, frontierSize / TREE_BFS_MIN_CHUNK) : 1;
+        if (chunks == 0)
+            chunks = 1;
+        uint32_t chunkLength = frontierSize / chunks + (frontierSize % chunks != 0);
+
+        if (chunks == 1)
+        {
+            // One chunk writes the next frontier directly
+            Visitor visitor = visitors[0];
+            uint32_t *out = next;
+            for (uint32_t i = 0; i < frontierSize; i++)
+            {
+                uint32_t node = frontier[i];
+                visitor.visit(node, depth);
+                out = std::copy(tree.children + tree.childOffsets[node], tree.children + tree.childOffsets[node + 1], out);
+            }
+            visitors[0] = visitor;
+            std::swap(frontier, next);
+            frontierSize = static_cast<uint32_t>(out - frontier);
+            continue;
+        }
+
+        // Visit, and size each chunk's slice of the next frontier
+        chunkOffsets[0] = 0;
+        pool.parallelFor(chunks, threads, [&](uint32_t chunk)
+        {
+            uint32_t start = chunk * chunkLength;
+            uint32_t end = std::min(frontierSize, start + chunkLength);
+            Visitor visitor = visitors[chunk];
+            uint32_t childCount = 0;
+            for (uint32_t i = start; i < end; i++)
+            {
+                uint32_t node = frontier[i];
+                visitor.visit(node, depth);
+                childCount += tree.childOffsets[node + 1] - tree.childOffsets[node];
+            }
+            visitors[chunk] = visitor;
+            chunkOffsets[chunk + 1] = childCount;
+        });
+        for (uint32_t chunk = 0; chunk < chunks; chunk++)
+            chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+
+        pool.parallelFor(chunks, threads, [&](uint32_t chunk)
+        {
+            uint32_t start = chunk * chunkLength;
+            uint32_t end = std::min(frontierSize, start + chunkLength);
+            uint32_t *out = next + chunkOffsets[chunk];
+            for (uint32_t i = start; i < end; i++)
+            {
+                uint32_t node = frontier[i];
+                out = std::copy(tree.children + tree.childOffsets[node], tree.children + tree.childOffsets[node + 1], out);
+            }
+        });
+
+        std::swap(frontier, next);
+        frontierSize = chunkOffsets[chunks];
+    }
+}
+
+/**
+ * Depth-first visit of the subtree under start on the calling thread
+ */
+template <typename Visitor>
+void sequentialTreeDfs(const CsrTree &tree, TreePendingNode start, Visitor &visitor)
+{
+    ScratchScope scratch;
+    // Every pushed node is distinct, so nodeCount bounds the stack
+    TreePendingNode *stack = scratch.allocate<TreePendingNode>(tree.nodeCount);
+    uint32_t stackSize = 0;
+    stack[stackSize++] = start;
+
+    while (stackSize > 0)
+    {
+        TreePendingNode current = stack[--stackSize];
+        visitor.visit(current.node, current.depth);
+        uint32_t begin = tree.childOffsets[current.node];
+        for (uint32_t childCursor = tree.childOffsets[current.node + 1]; childCursor > begin; childCursor--)
+            stack[stackSize++] = TreePendingNode{tree.children[childCursor - 1], current.depth + 1};
+    }
+}
+
+template <typename Visitor>
+void parallelTreeDfs(const CsrTree &tree, uint32_t threadCount, Visitor *visitors)
+{
+    if (tree.nodeCount == 0)
+        return;
+
+    WorkStealingPool &pool = WorkStealingPool::instance();
+    uint32_t threads = pool.resolveThreadCount(threadCount);
+    if (threads <= 1)
+    {
+        Visitor visitor = visitors[0];
+        sequentialTreeDfs(tree, TreePendingNode{0, 0}, visitor);
+        visitors[0] = visitor;
+        return;
+    }
+
+#if ARRAY_PROCESSOR_THREADS
+    ScratchScope scratch;
+    std::mutex sharedMutex;
+    // Donated nodes; each pending node is in exactly one stack or here
+    TreePendingNode *shared = scratch.allocate<TreePendingNode>(tree.nodeCount);
+    uint32_t sharedCount = 0;
+    // Workers holding a subtree (guarded by sharedMutex)
+    uint32_t busy = 0;
+    std::atomic<uint32_t> idle{0};
+    shared[sharedCount++] = TreePendingNode{0, 0};
+
+    pool.parallelFor(threads, threads, [&](uint32_t worker)
+    {
+        Visitor visitor = visitors[worker];
+        ScratchScope workerScratch;
+        size_t capacity = TREE_DFS_INITIAL_STACK;
+        TreePendingNode *stack = workerScratch.allocate<TreePendingNode>(capacity);
+        bool waiting = false;
+
+        while (true)
+        {
+            TreePendingNode start;
+            {
+                std::lock_guard<std::mutex> lock(sharedMutex);
+                if (sharedCount == 0)
+                {
+                    // Nothing shared and nobody left to share: done
+                    if (busy == 0)
+                        break;
+                    if (!waiting)
+                    {
+                        waiting = true;
+                        idle.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    start.node = UINT32_MAX;
+                }
+                else
+                {
+                    start = shared[--sharedCount];
+                    busy++;
+                    if (waiting)
+                    {
+                        waiting = false;
+                        idle.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+            if (start.node == UINT32_MAX)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            size_t stackSize = 0;
+            stack[stackSize++] = start;
+            uint32_t untilShare = TREE_DFS_SHARE_INTERVAL;
+            while (stackSize > 0)
+            {
+                TreePendingNode current = stack[--stackSize];
+                visitor.visit(current.node, current.depth);
+
+                uint32_t begin = tree.childOffsets[current.node];
+                uint32_t end = tree.childOffsets[current.node + 1];
+                if (stackSize + (end - begin) > capacity)
+                {
+                    size_t grownCapacity = std::max(capacity * 2, stackSize + (end - begin));
+                    TreePendingNode *grown = workerScratch.allocate<TreePendingNode>(grownCapacity);
+                    std::copy(stack, stack + stackSize, grown);
+                    stack = grown;
+                    capacity = grownCapacity;
+                }
+                for (uint32_t childCursor = end; childCursor > begin; childCursor--)
+                    stack[stackSize++] = TreePendingNode{tree.children[childCursor - 1], current.depth + 1};
+
+                if (--untilShare == 0)
+                {
+                    untilShare = TREE_DFS_SHARE_INTERVAL;
+                    if (stackSize > 1 && idle.load(std::memory_order_relaxed) > 0)
+                    {
+                        // The bottom of the stack holds the largest subtrees
+                        size_t donated = stackSize / 2;
+                        {
+                            std::lock_guard<std::mutex> lock(sharedMutex);
+                            std::copy(stack, stack + donated, shared + sharedCount);
+                            sharedCount += static_cast<uint32_t>(donated);
+                        }
+                        std::copy(stack + donated, stack + stackSize, stack);
+                        stackSize -= donated;
+                    }
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(sharedMutex);
+            busy--;
+        }
+
+        visitors[worker] = visitor;
+    });
+#endif
+}
+
+#endif // ARRAY_PROCESSOR_TREE_PARALLEL_H
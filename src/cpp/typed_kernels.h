@@ -0,0 +1,634 @@
+/**
+ * Compile-time specialized reduce / map kernels and filter predicates
+ *
+ * reduce<T, Op> and map<T, Op> are written once and instantiated per element
+ * type. ElementLanes<T> fixes the 128-bit lane layout of T (16 x int8 ...
+ * 2 x double), and the vector loops keep UNROLL independent accumulators so
+ * consecutive vector ops do not wait on each other. Operators that have no
+ * wasm SIMD instruction for T (8-bit multiply, 64-bit min/max) fall back to
+ * the scalar loop at compile time.
+ *
+ * Float min / max skip NaN elements: the vector loops use pmin / pmax
+ * (b < a ? b : a), the same comparison as the scalar step, so a NaN never
+ * replaces the accumulator in either. An all-NaN input gives the identity
+ * (+/-infinity).
+ *
+ * Templates cannot have C linkage, so the exported shims live in
+ * array_processor.cpp (TYPED KERNELS and FILTER ENGINE sections).
+ */
+
+#ifndef ARRAY_PROCESSOR_TYPED_KERNELS_H
+#define ARRAY_PROCESSOR_TYPED_KERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <wasm_simd128.h>
+
+namespace typed_kernels
+{
+
+// Vector accumulators per loop iteration (acc0..acc3 below)
+static const uint32_t UNROLL = 4;
+
+// Sums accumulate in 64-bit integers, or double for floating point
+template <typename T>
+struct SumOf
+{
+    typedef int64_t type;
+};
+template <>
+struct SumOf<uint32_t>
+{
+    typedef uint64_t type;
+};
+template <>
+struct SumOf<uint64_t>
+{
+    typedef uint64_t type;
+};
+template <>
+struct SumOf<float>
+{
+    typedef double type;
+};
+template <>
+struct SumOf<double>
+{
+    typedef double type;
+};
+
+/**
+ * 128-bit lane layout of T. Each specialization gives the lane count, splat
+ * and the vector operators T has in wasm SIMD: add / mul / min / max in T's
+ * own lanes (wrapping like the scalar type), and sumStep / sumTotal that
+ * widen into SumOf<T> lanes. Narrow sums accumulate in i32 lanes, which
+ * reduce drains to the scalar total every sumBlock elements. The 32-bit
+ * column types also provide the comparisons (all-ones lane when true) used
+ * by the filter predicates.
+ */
+template <typename T>
+struct ElementLanes;
+
+template <>
+struct ElementLanes<int8_t>
+{
+    static const uint32_t count = 16;
+    static const bool hasAdd = true, hasMul = false, hasMinMax = true;
+    // Each acc lane gains at most 4 * 128 per step: 2^27 per block
+    static const uint32_t sumBlock = 1u << 24;
+
+    static v128_t splat(int8_t v) { return wasm_i8x16_splat(v); }
+    static v128_t add(v128_t a, v128_t b) { return wasm_i8x16_add(a, b); }
+    static v128_t min(v128_t a, v128_t b) { return wasm_i8x16_min(a, b); }
+    static v128_t max(v128_t a, v128_t b) { return wasm_i8x16_max(a, b); }
+    static v128_t sumZero() { return wasm_i32x4_splat(0); }
+    static v128_t sumStep(v128_t acc, v128_t v)
+    {
+        return wasm_i32x4_add(acc, wasm_i32x4_extadd_pairwise_i16x8(wasm_i16x8_extadd_pairwise_i8x16(v)));
+    }
+    static int64_t sumTotal(v128_t acc)
+    {
+        int32_t lanes[4];
+        wasm_v128_store(lanes, acc);
+        return static_cast<int64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+};
+
+template <>
+struct ElementLanes<int16_t>
+{
+    static const uint32_t count = 8;
+    static const bool hasAdd = true, hasMul = true, hasMinMax = true;
+    // Each acc lane gains at most 2 * 32768 per step: 2^29 per block
+    static const uint32_t sumBlock = 1u << 18;
+
+    static v128_t splat(int16_t v) { return wasm_i16x8_splat(v); }
+    static v128_t add(v128_t a, v128_t b) { return wasm_i16x8_add(a, b); }
+    static v128_t mul(v128_t a, v128_t b) { return wasm_i16x8_mul(a, b); }
+    static v128_t min(v128_t a, v128_t b) { return wasm_i16x8_min(a, b); }
+    static v128_t max(v128_t a, v128_t b) { return wasm_i16x8_max(a, b); }
+    static v128_t sumZero() { return wasm_i32x4_splat(0); }
+    static v128_t sumStep(v128_t acc, v128_t v)
+    {
+        return wasm_i32x4_add(acc, wasm_i32x4_extadd_pairwise_i16x8(v));
+    }
+    static int64_t sumTotal(v128_t acc)
+    {
+        return ElementLanes<int8_t>::sumTotal(acc);
+    }
+};
+
+template <>
+struct ElementLanes<int32_t>
+{
+    static const uint32_t count = 4;
+    static const bool hasAdd = true, hasMul = true, hasMinMax = true;
+    // i64 lanes never need draining
+    static const uint32_t sumBlock = UINT32_MAX;
+
+    static v128_t splat(int32_t v) { return wasm_i32x4_splat(v); }
+    static v128_t add(v128_t a, v128_t b) { return wasm_i32x4_add(a, b); }
+    static v128_t mul(v128_t a, v128_t b) { return wasm_i32x4_mul(a, b); }
+    static v128_t min(v128_t a, v128_t b) { return wasm_i32x4_min(a, b); }
+    static v128_t max(v128_t a, v128_t b) { return wasm_i32x4_max(a, b); }
+    static v128_t sumZero() { return wasm_i64x2_splat(0); }
+    static v128_t sumStep(v128_t acc, v128_t v)
+    {
+        return wasm_i64x2_add(acc, wasm_i64x2_add(wasm_i64x2_extend_low_i32x4(v), wasm_i64x2_extend_high_i32x4(v)));
+    }
+    static int64_t sumTotal(v128_t acc)
+    {
+        int64_t lanes[2];
+        wasm_v128_store(lanes, acc);
+        return lanes[0] + lanes[1];
+    }
+};
+
+template <>
+struct ElementLanes<uint32_t>
+{
+    static const uint32_t count = 4;
+    static const bool hasAdd = true, hasMul = true, hasMinMax = true;
+    static const uint32_t sumBlock = UINT32_MAX;
+
+    static v128_t splat(uint32_t v) { return wasm_i32x4_splat(static_cast<int32_t>(v)); }
+    static v128_t add(v128_t a, v128_t b) { return wasm_i32x4_add(a, b); }
+    static v128_t mul(v128_t a, v128_t b) { return wasm_i32x4_mul(a, b); }
+    static v128_t min(v128_t a, v128_t b) { return wasm_u32x4_min(a, b); }
+    static v128_t max(v128_t a, v128_t b) { return wasm_u32x4_max(a, b); }
+    static v128_t eq(v128_t a, v128_t b) { return wasm_i32x4_eq(a, b); }
+    static v128_t gt(v128_t a, v128_t b) { return wasm_u32x4_gt(a, b); }
+    static v128_t lt(v128_t a, v128_t b) { return wasm_u32x4_gt(b, a); }
+    static v128_t ge(v128_t a, v128_t b) { return wasm_i32x4_eq(wasm_u32x4_max(a, b), a); }
+    static v128_t le(v128_t a, v128_t b) { return wasm_i32x4_eq(wasm_u32x4_min(a, b), a); }
+    static v128_t sumZero() { return wasm_i64x2_splat(0); }
+    static v128_t sumStep(v128_t acc, v128_t v)
+    {
+        return wasm_i64x2_add(acc, wasm_i64x2_add(wasm_u64x2_extend_low_u32x4(v), wasm_u64x2_extend_high_u32x4(v)));
+    }
+    static uint64_t sumTotal(v128_t acc)
+    {
+        uint64_t lanes[2];
+        wasm_v128_store(lanes, acc);
+        return lanes[0] + lanes[1];
+    }
+};
+
+template <>
+struct ElementLanes<uint64_t>
+{
+    static const uint32_t count = 2;
+    // wasm SIMD has no 64-bit unsigned min/max
+    static const bool hasAdd = true, hasMul = true, hasMinMax = false;
+    static const uint32_t sumBlock = UINT32_MAX;
+
+    static v128_t splat(uint64_t v) { return wasm_i64x2_splat(static_cast<int64_t>(v)); }
+    static v128_t add(v128_t a, v128_t b) { return wasm_i64x2_add(a, b); }
+    static v128_t mul(v128_t a, v128_t b) { return wasm_i64x2_mul(a, b); }
+    static v128_t sumZero() { return wasm_i64x2_splat(0); }
+    static v128_t sumStep(v128_t acc, v128_t v) { return wasm_i64x2_add(acc, v); }
+    static uint64_t sumTotal(v128_t acc)
+    {
+        return ElementLanes<uint32_t>::sumTotal(acc);
+    }
+};
+
+template <>
+struct ElementLanes<float>
+{
+    static const uint32_t count = 4;
+    static const bool hasAdd = true, hasMul = true, hasMinMax = true;
+    static const uint32_t sumBlock = UINT32_MAX;
+
+    static v128_t splat(float v) { return wasm_f32x4_splat(v); }
+    static v128_t add(v128_t a, v128_t b) { return wasm_f32x4_add(a, b); }
+    static v128_t mul(v128_t a, v128_t b) { return wasm_f32x4_mul(a, b); }
+    static v128_t min(v128_t a, v128_t b) { return wasm_f32x4_pmin(a, b); }
+    static v128_t max(v128_t a, v128_t b) { return wasm_f32x4_pmax(a, b); }
+    static v128_t eq(v128_t a, v128_t b) { return wasm_f32x4_eq(a, b); }
+    static v128_t gt(v128_t a, v128_t b) { return wasm_f32x4_gt(a, b); }
+    static v128_t lt(v128_t a, v128_t b) { return wasm_f32x4_lt(a, b); }
+    static v128_t ge(v128_t a, v128_t b) { return wasm_f32x4_ge(a, b); }
+    static v128_t le(v128_t a, v128_t b) { return wasm_f32x4_le(a, b); }
+    static v128_t sumZero() { return wasm_f64x2_splat(0.0); }
+    static v128_t sumStep(v128_t acc, v128_t v)
+    {
+        v128_t high = wasm_i32x4_shuffle(v, v, 2, 3, 0, 1);
+        return wasm_f64x2_add(acc, wasm_f64x2_add(wasm_f64x2_promote_low_f32x4(v), wasm_f64x2_promote_low_f32x4(high)));
+    }
+    static double sumTotal(v128_t acc)
+    {
+        double lanes[2];
+        wasm_v128_store(lanes, acc);
+        return lanes[0] + lanes[1];
+    }
+};
+
+template <>
+struct ElementLanes<double>
+{
+    static const uint32_t count = 2;
+    static const bool hasAdd = true, hasMul = true, hasMinMax = true;
+    static const uint32_t sumBlock = UINT32_MAX;
+
+    static v128_t splat(double v) { return wasm_f64x2_splat(v); }
+    static v128_t add(v128_t a, v128_t b) { return wasm_f64x2_add(a, b); }
+    static v128_t mul(v128_t a, v128_t b) { return wasm_f64x2_mul(a, b); }
+    static v128_t min(v128_t a, v128_t b) { return wasm_f64x2_pmin(a, b); }
+    static v128_t max(v128_t a, v128_t b) { return wasm_f64x2_pmax(a, b); }
+    static v128_t sumZero() { return wasm_f64x2_splat(0.0); }
+    static v128_t sumStep(v128_t acc, v128_t v) { return wasm_f64x2_add(acc, v); }
+    static double sumTotal(v128_t acc)
+    {
+        return ElementLanes<float>::sumTotal(acc);
+    }
+};
+
+// Integer arithmetic wraps modulo 2^bits like the vector lanes (and like a
+// JS typed-array store); signed overflow is done in uint64_t to stay defined
+template <typename T>
+static inline T wrapAdd(T a, T b)
+{
+    if constexpr (std::is_integral<T>::value)
+        return static_cast<T>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+    else
+        return a + b;
+}
+
+template <typename T>
+static inline T wrapMul(T a, T b)
+{
+    if constexpr (std::is_integral<T>::value)
+        return static_cast<T>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b));
+    else
+        return a * b;
+}
+
+/**
+ * Convert a JS number operand to T: floats round, integers truncate and wrap
+ * modulo 2^bits (NaN and infinities become 0), as a typed-array store would
+ */
+template <typename T>
+static inline T fromDouble(double value)
+{
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        return static_cast<T>(value);
+    }
+    else
+    {
+        if (!std::isfinite(value))
+            return 0;
+        const double twoPow63 = 9223372036854775808.0;
+        const double twoPow64 = 18446744073709551616.0;
+        double truncated = std::trunc(value);
+        if (std::fabs(truncated) < twoPow63)
+            return static_cast<T>(static_cast<uint64_t>(static_cast<int64_t>(truncated)));
+        double wrapped = std::fmod(truncated, twoPow64);
+        if (wrapped < 0)
+            wrapped += twoPow64;
+        return static_cast<T>(static_cast<uint64_t>(wrapped));
+    }
+}
+
+// ========== REDUCE OPERATORS ==========
+// Op::On<T> gives the scalar form (identity / step / merge) and, when
+// vectorized, the vector form over ElementLanes<T>
+
+template <typename T, typename Kernel>
+static inline T foldLanes(v128_t acc)
+{
+    T lanes[ElementLanes<T>::count];
+    wasm_v128_store(lanes, acc);
+    T result = Kernel::identity();
+    for (uint32_t i = 0; i < ElementLanes<T>::count; i++)
+        result = Kernel::step(result, lanes[i]);
+    return result;
+}
+
+struct Sum
+{
+    template <typename T>
+    struct On
+    {
+        typedef typename SumOf<T>::type Result;
+        static const bool vectorized = true;
+        static const uint32_t vectorBlock = ElementLanes<T>::sumBlock;
+
+        static Result identity() { return 0; }
+        static Result step(Result acc, T v) { return acc + static_cast<Result>(v); }
+        static Result merge(Result a, Result b) { return a + b; }
+        static v128_t vectorIdentity() { return ElementLanes<T>::sumZero(); }
+        static v128_t vectorStep(v128_t acc, v128_t v) { return ElementLanes<T>::sumStep(acc, v); }
+        static Result vectorTotal(v128_t acc) { return ElementLanes<T>::sumTotal(acc); }
+    };
+};
+
+struct Min
+{
+    template <typename T>
+    struct On
+    {
+        typedef T Result;
+        static const bool vectorized = ElementLanes<T>::hasMinMax;
+        static const uint32_t vectorBlock = UINT32_MAX;
+
+        static T identity()
+        {
+            return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                        : std::numeric_limits<T>::max();
+        }
+        static T step(T acc, T v) { return v < acc ? v : acc; }
+        static T merge(T a, T b) { return step(a, b); }
+        static v128_t vectorIdentity() { return ElementLanes<T>::splat(identity()); }
+        static v128_t vectorStep(v128_t acc, v128_t v) { return ElementLanes<T>::min(acc, v); }
+        static T vectorTotal(v128_t acc) { return foldLanes<T, On>(acc); }
+    };
+};
+
+struct Max
+{
+    template <typename T>
+    struct On
+    {
+        typedef T Result;
+        static const bool vectorized = ElementLanes<T>::hasMinMax;
+        static const uint32_t vectorBlock = UINT32_MAX;
+
+        static T identity()
+        {
+            return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                        : std::numeric_limits<T>::lowest();
+        }
+        static T step(T acc, T v) { return v > acc ? v : acc; }
+        static T merge(T a, T b) { return step(a, b); }
+        static v128_t vectorIdentity() { return ElementLanes<T>::splat(identity()); }
+        static v128_t vectorStep(v128_t acc, v128_t v) { return ElementLanes<T>::max(acc, v); }
+        static T vectorTotal(v128_t acc) { return foldLanes<T, On>(acc); }
+    };
+};
+
+// ========== MAP OPERATORS ==========
+
+struct Add
+{
+    template <typename T>
+    struct On
+    {
+        static const bool vectorized = ElementLanes<T>::hasAdd;
+
+        static T apply(T v, T operand) { return wrapAdd(v, operand); }
+        static v128_t vectorApply(v128_t v, v128_t operand) { return ElementLanes<T>::add(v, operand); }
+    };
+};
+
+struct Multiply
+{
+    template <typename T>
+    struct On
+    {
+        static const bool vectorized = ElementLanes<T>::hasMul;
+
+        static T apply(T v, T operand) { return wrapMul(v, operand); }
+        static v128_t vectorApply(v128_t v, v128_t operand) { return ElementLanes<T>::mul(v, operand); }
+    };
+};
+
+// ========== KERNELS ==========
+
+/**
+ * Fold arr with Op; an empty array gives Op's identity
+ */
+template <typename T, typename Op>
+typename Op::template On<T>::Result reduce(const T *arr, uint32_t length)
+{
+    typedef typename Op::template On<T> Kernel;
+    typename Kernel::Result result = Kernel::identity();
+    uint32_t i = 0;
+
+    if constexpr (Kernel::vectorized)
+    {
+        const uint32_t lanes = ElementLanes<T>::count;
+        const uint32_t stride = lanes * UNROLL;
+        const uint32_t vectorEnd = length - length % stride;
+        while (i < vectorEnd)
+        {
+            // vectorBlock is a multiple of stride, so blocks end on whole strides
+            uint32_t blockEnd = vectorEnd - i > Kernel::vectorBlock ? i + Kernel::vectorBlock : vectorEnd;
+            v128_t acc0 = Kernel::vectorIdentity();
+            v128_t acc1 = acc0;
+            v128_t acc2 = acc0;
+            v128_t acc3 = acc0;
+            for (; i < blockEnd; i += stride)
+            {
+                acc0 = Kernel::vectorStep(acc0, wasm_v128_load(arr + i));
+                acc1 = Kernel::vectorStep(acc1, wasm_v128_load(arr + i + lanes));
+                acc2 = Kernel::vectorStep(acc2, wasm_v128_load(arr + i + 2 * lanes));
+                acc3 = Kernel::vectorStep(acc3, wasm_v128_load(arr + i + 3 * lanes));
+            }
+            result = Kernel::merge(result, Kernel::merge(Kernel::merge(Kernel::vectorTotal(acc0), Kernel::vectorTotal(acc1)),
+                                                         Kernel::merge(Kernel::vectorTotal(acc2), Kernel::vectorTotal(acc3))));
+        }
+    }
+
+    for (; i < length; i++)
+        result = Kernel::step(result, arr[i]);
+    return result;
+}
+
+/**
+ * Apply Op with a scalar operand to every element (in place)
+ */
+template <typename T, typename Op>
+void map(T *arr, uint32_t length, T operand)
+{
+    typedef typename Op::template On<T> Kernel;
+    uint32_t i = 0;
+
+    if constexpr (Kernel::vectorized)
+    {
+        const uint32_t lanes = ElementLanes<T>::count;
+        const uint32_t stride = lanes * UNROLL;
+        const v128_t vectorOperand = ElementLanes<T>::splat(operand);
+        for (; length - i >= stride; i += stride)
+        {
+            v128_t v0 = wasm_v128_load(arr + i);
+            v128_t v1 = wasm_v128_load(arr + i + lanes);
+            v128_t v2 = wasm_v128_load(arr + i + 2 * lanes);
+            v128_t v3 = wasm_v128_load(arr + i + 3 * lanes);
+            wasm_v128_store(arr + i, Kernel::vectorApply(v0, vectorOperand));
+            wasm_v128_store(arr + i + lanes, Kernel::vectorApply(v1, vectorOperand));
+            wasm_v128_store(arr + i + 2 * lanes, Kernel::vectorApply(v2, vectorOperand));
+            wasm_v128_store(arr + i + 3 * lanes, Kernel::vectorApply(v3, vectorOperand));
+        }
+        for (; length - i >= lanes; i += lanes)
+            wasm_v128_store(arr + i, Kernel::vectorApply(wasm_v128_load(arr + i), vectorOperand));
+    }
+
+    for (; i < length; i++)
+        arr[i] = Kernel::apply(arr[i], operand);
+}
+
+// ========== FILTER PREDICATES ==========
+// Row tests over 32-bit columns; test() is the scalar form, vector() gives
+// an all-ones lane per match. NaN never matches a float predicate.
+
+template <typename T>
+struct GreaterThan
+{
+    T value;
+    v128_t splatValue;
+
+    explicit GreaterThan(T v) : value(v), splatValue(ElementLanes<T>::splat(v)) {}
+    bool test(T x) const { return x > value; }
+    v128_t vector(v128_t v) const { return ElementLanes<T>::gt(v, splatValue); }
+};
+
+template <typename T>
+struct LessThan
+{
+    T value;
+    v128_t splatValue;
+
+    explicit LessThan(T v) : value(v), splatValue(ElementLanes<T>::splat(v)) {}
+    bool test(T x) const { return x < value; }
+    v128_t vector(v128_t v) const { return ElementLanes<T>::lt(v, splatValue); }
+};
+
+template <typename T>
+struct EqualTo
+{
+    T value;
+    v128_t splatValue;
+
+    explicit EqualTo(T v) : value(v), splatValue(ElementLanes<T>::splat(v)) {}
+    bool test(T x) const { return x == value; }
+    v128_t vector(v128_t v) const { return ElementLanes<T>::eq(v, splatValue); }
+};
+
+// Inclusive on both ends, like SQL BETWEEN
+template <typename T>
+struct Between
+{
+    T low, high;
+    v128_t splatLow, splatHigh;
+
+    Between(T lo, T hi)
+        : low(lo), high(hi), splatLow(ElementLanes<T>::splat(lo)), splatHigh(ElementLanes<T>::splat(hi)) {}
+    bool test(T x) const { return x >= low && x <= high; }
+    v128_t vector(v128_t v) const
+    {
+        return wasm_v128_and(ElementLanes<T>::ge(v, splatLow), ElementLanes<T>::le(v, splatHigh));
+    }
+};
+
+// IN over a few values: one lane compare per value, ORed. Vectors with no
+// lane inside [min, max] of the set skip the compares.
+static const uint32_t IN_SET_VECTOR_MAX = 16;
+
+template <typename T>
+struct InSmallSet
+{
+    const T *values;
+    uint32_t count;
+    // Empty (or all-NaN) sets get low > high, which no row satisfies
+    T low = std::numeric_limits<T>::max();
+    T high = std::numeric_limits<T>::lowest();
+    v128_t splatLow, splatHigh;
+    v128_t splats[IN_SET_VECTOR_MAX];
+
+    InSmallSet(const T *set, uint32_t setCount) : values(set), count(std::min(setCount, IN_SET_VECTOR_MAX))
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            splats[i] = ElementLanes<T>::splat(values[i]);
+            if (values[i] < low)
+                low = values[i];
+            if (values[i] > high)
+                high = values[i];
+        }
+        splatLow = ElementLanes<T>::splat(low);
+        splatHigh = ElementLanes<T>::splat(high);
+    }
+    bool test(T x) const
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (x == values[i])
+                return true;
+        }
+        return false;
+    }
+    v128_t vector(v128_t v) const
+    {
+        v128_t inRange = wasm_v128_and(ElementLanes<T>::ge(v, splatLow), ElementLanes<T>::le(v, splatHigh));
+        if (!wasm_v128_any_true(inRange))
+            return inRange;
+        v128_t match = wasm_i32x4_splat(0);
+        for (uint32_t i = 0; i < count; i++)
+            match = wasm_v128_or(match, ElementLanes<T>::eq(v, splats[i]));
+        return match;
+    }
+};
+
+// IN over a larger set: binary search in sorted, NaN-free values
+template <typename T>
+struct InSortedSet
+{
+    const T *values;
+    uint32_t count;
+
+    InSortedSet(const T *sorted, uint32_t sortedCount) : values(sorted), count(sortedCount) {}
+    // x == x rejects NaN, which binary_search would report as found
+    bool test(T x) const { return x == x && std::binary_search(values, values + count, x); }
+    v128_t vector(v128_t v) const
+    {
+        T lanes[4];
+        int32_t match[4];
+        wasm_v128_store(lanes, v);
+        for (uint32_t i = 0; i < 4; i++)
+            match[i] = test(lanes[i]) ? -1 : 0;
+        return wasm_v128_load(match);
+    }
+};
+
+/**
+ * Fill bitmap (bit i % 32 of word i / 32 is row i) with pred over column,
+ * 32 rows per word; bits past length in the last word are cleared
+ * @return Number of matching rows
+ */
+template <typename T, typename Pred>
+uint32_t compareToBitmap(const T *column, uint32_t length, const Pred &pred, uint32_t *bitmap)
+{
+    static_assert(ElementLanes<T>::count == 4, "bitmap filters take 32-bit columns");
+    const uint32_t fullWords = length / 32;
+    uint32_t count = 0;
+
+    for (uint32_t w = 0; w < fullWords; w++)
+    {
+        const T *rows = column + static_cast<size_t>(w) * 32;
+        uint32_t bits = 0;
+        for (uint32_t k = 0; k < 8; k++)
+            bits |= wasm_i32x4_bitmask(pred.vector(wasm_v128_load(rows + k * 4))) << (k * 4);
+        bitmap[w] = bits;
+        count += static_cast<uint32_t>(__builtin_popcount(bits));
+    }
+
+    if (length % 32 != 0)
+    {
+        uint32_t bits = 0;
+        for (uint32_t i = fullWords * 32; i < length; i++)
+            bits |= static_cast<uint32_t>(pred.test(column[i])) << (i % 32);
+        bitmap[fullWords] = bits;
+        count += static_cast<uint32_t>(__builtin_popcount(bits));
+    }
+    return count;
+}
+
+} // namespace typed_kernels
+
+#endif // ARRAY_PROCESSOR_TYPED_KERNELS_H
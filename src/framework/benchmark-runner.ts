@@ -8,17 +8,55 @@ import type {
   BenchmarkResult,
   TestConfig,
   ProgressCallback,
+  StatisticsOptions,
 } from './types';
+import {
+  DEFAULT_MEASUREMENT_ORDER,
+  MemoryProbe,
+  roundOrder,
+  type MeasurementOrder,
+  type MemorySample,
+} from './measurement';
+import { bootstrapRatioCI, rejectOutliers, summarizeSamples, type SampleStatistics } from './statistics';
+import { readScratchStats, resetScratchStats } from './wasm-bridge';
+import { profileWasmCalls } from './wasm-profile';
+
+export const DEFAULT_STATISTICS_OPTIONS: StatisticsOptions = {
+  minSampleTimeMs: 2,
+  maxSamples: 200,
+  maxTimeMs: 5000,
+  targetRelativeCI: 0.02,
+  maxRelativeCI: 0.1,
+  outlierThreshold: 3.5,
+  bootstrapResamples: 2000,
+  failOnNoise: true,
+};
 
 /**
- * Calculate median
+ * Thrown by runBenchmarks when results are too noisy to trust; still carries them
  */
-function calculateMedian(times: number[]): number {
-  const sorted = [...times].sort((a, b) => a - b);
-  const mid = Math.floor(sorted.length / 2);
-  return sorted.length % 2 === 0
-    ? (sorted[mid - 1] + sorted[mid]) / 2
-    : sorted[mid];
+export class BenchmarkNoiseError extends Error {
+  readonly results: BenchmarkResult[];
+  readonly noisyTests: string[];
+
+  constructor(results: BenchmarkResult[], noisyTests: string[]) {
+    super(`Benchmark noise above threshold in: ${noisyTests.join(', ')}`);
+    this.name = 'BenchmarkNoiseError';
+    this.results = results;
+    this.noisyTests = noisyTests;
+  }
+}
+
+/**
+ * Per-call samples of one implementation
+ */
+export interface SampleSet {
+  // Milliseconds per call, one entry per timed batch
+  samples: number[];
+  repetitions: number;
+  stats: SampleStatistics;
+  // Counters per sample, same order as samples
+  memory: MemorySample[];
 }
 
 /**
@@ -34,6 +72,143 @@ export function formatTime(ms: number): string {
   }
 }
 
+/**
+ * One implementation under measurement; setup runs untimed before every call
+ * (e.g. to restore the input of an in-place kernel)
+ */
+export interface MeasuredSide {
+  run: () => unknown;
+  setup?: () => void;
+}
+
+/**
+ * Total timed milliseconds for `repetitions` calls
+ */
+function timeBatch(side: MeasuredSide, repetitions: number): number {
+  const { run, setup } = side;
+  if (!setup) {
+    const start = performance.now();
+    for (let i = 0; i < repetitions; i++) {
+      run();
+    }
+    return performance.now() - start;
+  }
+
+  // Time each call separately so the reset stays out of the sample
+  let elapsed = 0;
+  for (let i = 0; i < repetitions; i++) {
+    setup();
+    const start = performance.now();
+    run();
+    elapsed += performance.now() - start;
+  }
+  return elapsed;
+}
+
+/**
+ * Double the calls per sample until one sample lasts minSampleTimeMs,
+ * keeping sub-millisecond kernels well above timer resolution
+ */
+export function calibrateRepetitions(side: MeasuredSide, minSampleTimeMs: number): number {
+  let repetitions = 1;
+  while (repetitions < 1 << 20) {
+    const elapsed = timeBatch(side, repetitions);
+    if (elapsed >= minSampleTimeMs) {
+      break;
+    }
+    // Jump close to the target once the batch is measurable
+    repetitions = elapsed > minSampleTimeMs / 16
+      ? Math.ceil(repetitions * minSampleTimeMs / elapsed)
+      : repetitions * 2;
+  }
+  return repetitions;
+}
+
+interface SideState {
+  side: MeasuredSide;
+  probe: MemoryProbe;
+  samples: number[];
+  repetitions: number;
+  stats: SampleStatistics | null;
+}
+
+/**
+ * Take rounds of one sample per side (in `order`) until every side's 95% CI
+ * of the mean is tight enough, or the sample / time budget runs out; at
+ * least minSamples are always taken
+ */
+function sampleRounds(
+  states: SideState[],
+  minSamples: number,
+  options: StatisticsOptions,
+  order: MeasurementOrder
+): void {
+  const deadline = performance.now() + options.maxTimeMs * states.length;
+  const floor = Math.max(minSamples, 2);
+
+  for (let round = 0; round < options.maxSamples; round++) {
+    for (const index of roundOrder(states.length, round, order)) {
+      const state = states[index];
+      state.samples.push(state.probe.measure(() => timeBatch(state.side, state.repetitions)) / state.repetitions);
+    }
+
+    if (round + 1 >= floor) {
+      for (const state of states) {
+        state.stats = summarizeSamples(state.samples, options.outlierThreshold);
+      }
+      const stable = states.every(state => state.stats!.relativeCiHalfWidth <= options.targetRelativeCI);
+      if (stable || performance.now() >= deadline) {
+        break;
+      }
+    }
+  }
+}
+
+/**
+ * Sample every side. Interleaved orders share rounds so drift hits all
+ * sides equally; 'sequential' finishes each side before the next.
+ */
+export async function collectSamples(
+  sides: MeasuredSide[],
+  minSamples: number,
+  options: StatisticsOptions,
+  order: MeasurementOrder = DEFAULT_MEASUREMENT_ORDER
+): Promise<SampleSet[]> {
+  const states: SideState[] = sides.map(side => ({
+    side,
+    probe: new MemoryProbe(),
+    samples: [],
+    repetitions: calibrateRepetitions(side, options.minSampleTimeMs),
+    stats: null,
+  }));
+
+  for (const state of states) {
+    state.probe.start();
+  }
+  if (order === 'sequential') {
+    for (const state of states) {
+      sampleRounds([state], minSamples, options, order);
+    }
+  } else {
+    sampleRounds(states, minSamples, options, order);
+  }
+
+  const sets: SampleSet[] = [];
+  for (const state of states) {
+    sets.push({
+      samples: state.samples,
+      repetitions: state.repetitions,
+      stats: state.stats ?? summarizeSamples(state.samples, options.outlierThreshold),
+      memory: await state.probe.finish(),
+    });
+  }
+  return sets;
+}
+
+export function resolveStatisticsOptions(config: TestConfig): StatisticsOptions {
+  return { ...DEFAULT_STATISTICS_OPTIONS, ...config.statistics };
+}
+
 /**
  * Run single benchmark test
  */
@@ -41,88 +216,121 @@ export async function runBenchmark(
   test: BenchmarkTest,
   config: TestConfig
 ): Promise<BenchmarkResult> {
-  const tsTimes: number[] = [];
-  const wasmTimes: number[] = [];
+  const wasmImpl = test.wasmImpl;
+  if (!wasmImpl) {
+    throw new Error(`${test.name} WASM test failed: WASM implementation not found for ${test.name}`);
+  }
 
   // Prepare data
   const data = test.prepare(config);
+  try {
+    return await measureBenchmark(test, wasmImpl, data, config);
+  } finally {
+    test.cleanup?.(data);
+  }
+}
+
+async function measureBenchmark(
+  test: BenchmarkTest,
+  wasmImpl: (data: any) => unknown,
+  data: unknown,
+  config: TestConfig
+): Promise<BenchmarkResult> {
+  const options = resolveStatisticsOptions(config);
+  const order = config.order ?? DEFAULT_MEASUREMENT_ORDER;
+
+  // Failures name the side that threw
+  const guarded = (label: string, fn: (data: any) => unknown) => () => {
+    try {
+      return fn(data);
+    } catch (error) {
+      console.error(`❌ ${label} test failed for ${test.name}:`, error);
+      throw new Error(`${test.name} ${label} test failed: ${(error as Error).message}`);
+    }
+  };
+  const ts: MeasuredSide = {
+    run: guarded('TypeScript', test.tsImpl),
+    setup: test.tsSetup && guarded('TypeScript', test.tsSetup),
+  };
+  const wasm: MeasuredSide = {
+    run: guarded('WASM', wasmImpl),
+    setup: test.wasmSetup && guarded('WASM', test.wasmSetup),
+  };
 
   // Warmup phase
   console.log(`🔥 Warming up ${test.name}...`);
   try {
     for (let i = 0; i < config.warmupIterations; i++) {
-      test.tsImpl(data);
-      if (test.wasmImpl) {
-        test.wasmImpl(data);
-      }
+      ts.setup?.();
+      ts.run();
+      wasm.setup?.();
+      wasm.run();
     }
   } catch (error) {
     console.error(`❌ Warmup failed for ${test.name}:`, error);
     throw new Error(`${test.name} warmup failed: ${(error as Error).message}`);
   }
 
-  // TypeScript benchmark
-  console.log(`📊 Testing TypeScript ${test.name}...`);
-  try {
-    for (let i = 0; i < config.iterations; i++) {
-      const start = performance.now();
-      test.tsImpl(data);
-      const end = performance.now();
-      tsTimes.push(end - start);
-    }
-  } catch (error) {
-    console.error(`❌ TypeScript test failed for ${test.name}:`, error);
-    throw new Error(`${test.name} TypeScript test failed: ${(error as Error).message}`);
-  }
-
-  // WASM benchmark
-  console.log(`📊 Testing WASM ${test.name}...`);
-  try {
-    if (!test.wasmImpl) {
-      throw new Error(`WASM implementation not found for ${test.name}`);
-    }
+  // Warmup has sized the scratch arenas; count only the measured calls
+  console.log(`📊 Testing ${test.name} (${order})...`);
+  resetScratchStats();
+  const [tsSet, wasmSet] = await collectSamples([ts, wasm], config.iterations, options, order);
+  const wasmScratch = readScratchStats();
+  // One sample's worth of calls, timed in pieces
+  const wasmProfile = profileWasmCalls(wasm.run, wasm.setup, wasmSet.repetitions);
 
-    for (let i = 0; i < config.iterations; i++) {
-      const start = performance.now();
-      test.wasmImpl(data);
-      const end = performance.now();
-      wasmTimes.push(end - start);
-    }
-  } catch (error) {
-    console.error(`❌ WASM test failed for ${test.name}:`, error);
-    throw new Error(`${test.name} WASM test failed: ${(error as Error).message}`);
-  }
+  return { ...buildResult(test, tsSet, wasmSet, options), wasmScratch, wasmProfile };
+}
 
-  // Calculate statistics
-  const tsAvg = tsTimes.reduce((a, b) => a + b, 0) / tsTimes.length;
-  const wasmAvg = wasmTimes.reduce((a, b) => a + b, 0) / wasmTimes.length;
-  const tsMin = Math.min(...tsTimes);
-  const wasmMin = Math.min(...wasmTimes);
-  const tsMax = Math.max(...tsTimes);
-  const wasmMax = Math.max(...wasmTimes);
-  const tsMedian = calculateMedian(tsTimes);
-  const wasmMedian = calculateMedian(wasmTimes);
-  const speedup = tsAvg / wasmAvg;
+/**
+ * Assemble a result from both sides' samples: outlier-filtered means drive
+ * the speedup, the bootstrap CI gives its error bars
+ */
+export function buildResult(
+  test: BenchmarkTest,
+  ts: SampleSet,
+  wasm: SampleSet,
+  options: StatisticsOptions
+): BenchmarkResult {
+  const tsStats = ts.stats;
+  const wasmStats = wasm.stats;
+  const speedupCI = bootstrapRatioCI(
+    rejectOutliers(ts.samples, options.outlierThreshold).kept,
+    rejectOutliers(wasm.samples, options.outlierThreshold).kept,
+    options.bootstrapResamples
+  );
+  const speedup = tsStats.mean / wasmStats.mean;
   const winner = speedup >= 1 ? 'WASM' : 'TypeScript';
+  const noisy =
+    tsStats.relativeCiHalfWidth > options.maxRelativeCI ||
+    wasmStats.relativeCiHalfWidth > options.maxRelativeCI;
 
   return {
     testName: test.name,
     testNameChinese: test.nameChinese,
     category: test.category,
-    tsTime: tsAvg,
-    wasmTime: wasmAvg,
-    tsTimes,
-    wasmTimes,
-    tsAvg,
-    wasmAvg,
-    tsMin,
-    wasmMin,
-    tsMax,
-    wasmMax,
-    tsMedian,
-    wasmMedian,
+    tsTime: tsStats.mean,
+    wasmTime: wasmStats.mean,
+    tsTimes: ts.samples,
+    wasmTimes: wasm.samples,
+    tsAvg: tsStats.mean,
+    wasmAvg: wasmStats.mean,
+    tsMin: tsStats.min,
+    wasmMin: wasmStats.min,
+    tsMax: tsStats.max,
+    wasmMax: wasmStats.max,
+    tsMedian: tsStats.median,
+    wasmMedian: wasmStats.median,
     speedup,
     winner,
+    tsStats,
+    wasmStats,
+    speedupCI,
+    tsRepetitions: ts.repetitions,
+    wasmRepetitions: wasm.repetitions,
+    tsMemory: ts.memory,
+    wasmMemory: wasm.memory,
+    noisy,
   };
 }
 
@@ -146,7 +354,14 @@ export async function runBenchmarks(
     const result = await runBenchmark(test, config);
     results.push(result);
 
-    console.log(`✅ ${test.name}: WASM ${result.speedup.toFixed(2)}x`);
+    const ci = result.speedupCI;
+    const range = ci ? ` [${ci.low.toFixed(2)}, ${ci.high.toFixed(2)}]` : '';
+    console.log(`${result.noisy ? '⚠️' : '✅'} ${test.name}: WASM ${result.speedup.toFixed(2)}x${range}`);
+  }
+
+  const noisyTests = results.filter(r => r.noisy).map(r => r.testName);
+  if (noisyTests.length > 0 && resolveStatisticsOptions(config).failOnNoise) {
+    throw new BenchmarkNoiseError(results, noisyTests);
   }
 
   return results;
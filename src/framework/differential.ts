@@ -0,0 +1,129 @@
+/**
+ * JS vs WASM Benchmark Framework - Differential Comparison
+ * Compares the result of a TypeScript implementation with its WASM
+ * counterpart. Integers compare exactly, across number and bigint; other
+ * numbers within a relative tolerance, since SIMD and threaded float
+ * reductions add in a different order. Typed arrays and arrays compare
+ * element by element, objects by the keys both sides return.
+ */
+
+export interface DifferentialOptions {
+  // Relative tolerance for non-integer numbers
+  relativeTolerance: number;
+}
+
+export const DEFAULT_DIFFERENTIAL_OPTIONS: DifferentialOptions = {
+  // float32 results carry ~7 significant digits
+  relativeTolerance: 1e-5,
+};
+
+export interface ResultMismatch {
+  // Where the results differ, e.g. "[12]" or ".histogram[3]"
+  path: string;
+  expected: string;
+  actual: string;
+}
+
+function isListLike(value: unknown): value is ArrayLike<unknown> {
+  return Array.isArray(value) || (ArrayBuffer.isView(value) && !(value instanceof DataView));
+}
+
+function describe(value: unknown): string {
+  if (typeof value === 'bigint') {
+    return `${value}n`;
+  }
+  if (isListLike(value)) {
+    return `${value.constructor.name}(${value.length})`;
+  }
+  return typeof value === 'object' && value !== null ? 'object' : String(value);
+}
+
+function toExactInteger(value: number | bigint): bigint | null {
+  if (typeof value === 'bigint') {
+    return value;
+  }
+  // Larger doubles are float results, compared with the tolerance
+  return Number.isSafeInteger(value) ? BigInt(value) : null;
+}
+
+function compareNumbers(expected: number | bigint, actual: number | bigint, options: DifferentialOptions): boolean {
+  const expectedInteger = toExactInteger(expected);
+  const actualInteger = toExactInteger(actual);
+  if (expectedInteger !== null && actualInteger !== null) {
+    return expectedInteger === actualInteger;
+  }
+
+  const a = Number(expected);
+  const b = Number(actual);
+  if (Number.isNaN(a) || Number.isNaN(b)) {
+    return Number.isNaN(a) && Number.isNaN(b);
+  }
+  return Math.abs(a - b) <= options.relativeTolerance * Math.max(1, Math.abs(a));
+}
+
+function compareAt(
+  expected: unknown,
+  actual: unknown,
+  path: string,
+  options: DifferentialOptions
+): ResultMismatch | null {
+  const mismatch = (): ResultMismatch => ({ path: path || '(result)', expected: describe(expected), actual: describe(actual) });
+
+  const expectedNumeric = typeof expected === 'number' || typeof expected === 'bigint';
+  const actualNumeric = typeof actual === 'number' || typeof actual === 'bigint';
+  if (expectedNumeric || actualNumeric) {
+    return expectedNumeric && actualNumeric && compareNumbers(expected, actual, options) ? null : mismatch();
+  }
+
+  if (isListLike(expected) || isListLike(actual)) {
+    if (!isListLike(expected) || !isListLike(actual) || expected.length !== actual.length) {
+      return mismatch();
+    }
+    for (let i = 0; i < expected.length; i++) {
+      const result = compareAt(expected[i], actual[i], `${path}[${i}]`, options);
+      if (result) {
+        return result;
+      }
+    }
+    return null;
+  }
+
+  if (typeof expected === 'object' && expected !== null && typeof actual === 'object' && actual !== null) {
+    const expectedRecord = expected as Record<string, unknown>;
+    const actualRecord = actual as Record<string, unknown>;
+    // Fused and separate kernels return different subsets of the same fields
+    const keys = Object.keys(expectedRecord).filter(key => key in actualRecord);
+    if (keys.length === 0) {
+      return mismatch();
+    }
+    for (const key of keys) {
+      const result = compareAt(expectedRecord[key], actualRecord[key], `${path}.${key}`, options);
+      if (result) {
+        return result;
+      }
+    }
+    return null;
+  }
+
+  return Object.is(expected, actual) ? null : mismatch();
+}
+
+/**
+ * First difference between a reference result and an optimized one, or
+ * null when they agree
+ */
+export function compareResults(
+  expected: unknown,
+  actual: unknown,
+  options: DifferentialOptions = DEFAULT_DIFFERENTIAL_OPTIONS
+): ResultMismatch | null {
+  return compareAt(expected, actual, '', options);
+}
+
+/**
+ * Results worth comparing: undefined / null mean the implementation
+ * returns nothing (e.g. a map insert that only times the work)
+ */
+export function isComparableResult(value: unknown): boolean {
+  return value !== undefined && value !== null;
+}
@@ -11,19 +11,69 @@ export type {
   TestModule,
   ProgressCallback,
   DataType,
+  StatisticsOptions,
 } from './types';
 
+// Export measurement ordering and memory counters
+export {
+  DEFAULT_MEASUREMENT_ORDER,
+  MemoryProbe,
+  readHeapUsed,
+  roundOrder,
+  type MeasurementOrder,
+  type MemorySample,
+} from './measurement';
+
+// Export statistics
+export {
+  mean,
+  standardDeviation,
+  percentile,
+  median,
+  medianAbsoluteDeviation,
+  rejectOutliers,
+  summarizeSamples,
+  bootstrapRatioCI,
+  type SampleStatistics,
+  type ConfidenceInterval,
+} from './statistics';
+
 // Export test registry
 export { testRegistry } from './test-registry';
 
 // Export WASM loader
 export {
   initWasmModule,
+  compileWasmModule,
   getWasmModuleInstance,
+  getWasmStartupTiming,
+  formatStartupTiming,
+  lazyKernelGroup,
   WasmLoader,
   type WasmModuleInstance,
+  type WasmLoadOptions,
+  type WasmStartupTiming,
 } from './wasm-loader';
 
+// Export worker kernel host
+export {
+  WasmWorkerHost,
+  measureWorkerDispatch,
+  runKernelCommand,
+  DEFAULT_WORKER_DISPATCH_OPTIONS,
+  type KernelArg,
+  type KernelArray,
+  type KernelArrayArg,
+  type KernelCommand,
+  type KernelResult,
+  type WorkerCallOptions,
+  type WorkerDispatchOptions,
+  type WorkerDispatchStats,
+} from './wasm-worker-host';
+
+// Export persistent buffers
+export { WasmBuffer, type WasmBufferArray } from './wasm-buffer';
+
 // Export WASM bridge
 export {
   getWasmModule,
@@ -32,15 +82,70 @@ export {
   readUint32Array,
   readFloat32Array,
   clearMemoryPools,
+  readScratchStats,
+  resetScratchStats,
   createWasmWrapper,
   createAdvancedWasmWrapper,
+  bindExport,
+  type WasmExport,
+  type ExportNoArgs,
+  type ExportPtrLen,
+  type ExportPtrLenScalar,
+  type ExportPtrLenScalars,
+  type ScratchStats,
 } from './wasm-bridge';
 
+// Export the in-module profile
+export {
+  measureReadBandwidth,
+  profileWasmCalls,
+  readCopyCounters,
+  readKernelProfile,
+  resetProfile,
+  setProfilingEnabled,
+  type CopyCounters,
+  type KernelProfile,
+  type KernelProfileEntry,
+  type KernelProfileEvent,
+  type WasmCallBreakdown,
+} from './wasm-profile';
+
+// Export differential result comparison
+export {
+  DEFAULT_DIFFERENTIAL_OPTIONS,
+  compareResults,
+  isComparableResult,
+  type DifferentialOptions,
+  type ResultMismatch,
+} from './differential';
+
+// Export reports and baseline comparison
+export {
+  DEFAULT_REGRESSION_THRESHOLDS,
+  compareToBaseline,
+  recordKey,
+  recordsToCsv,
+  toBenchmarkRecord,
+  type BaselineComparison,
+  type BaselineReport,
+  type BenchmarkRecord,
+  type BenchmarkReport,
+  type EnvironmentInfo,
+  type RegressionMetric,
+  type RegressionThresholds,
+} from './report';
+
 // Export benchmark runner
 export {
   runBenchmark,
   runBenchmarks,
   formatTime,
   generateSummary,
+  collectSamples,
+  calibrateRepetitions,
+  BenchmarkNoiseError,
+  DEFAULT_STATISTICS_OPTIONS,
   type BenchmarkSummary,
+  type MeasuredSide,
+  type SampleSet,
 } from './benchmark-runner';
@@ -0,0 +1,131 @@
+/**
+ * JS vs WASM Benchmark Framework - Measurement
+ * Sample ordering between implementations and per-sample GC / heap counters
+ */
+
+/**
+ * How TypeScript and WASM samples are ordered
+ * - sequential: every TypeScript sample, then every WASM sample
+ * - abba: alternate which side goes first each round (TS WASM, WASM TS, ...)
+ * - random: shuffle the sides every round
+ */
+export type MeasurementOrder = 'sequential' | 'abba' | 'random';
+
+export const DEFAULT_MEASUREMENT_ORDER: MeasurementOrder = 'abba';
+
+/**
+ * Counters recorded around one timed sample
+ */
+export interface MemorySample {
+  // performance.now() at the start / end of the sample window
+  startTime: number;
+  endTime: number;
+  // JS heap growth across the sample, null where the host has no heap counter
+  heapDeltaBytes: number | null;
+  // Collections that started during the sample, null where the host reports none
+  gcCount: number | null;
+  gcTimeMs: number | null;
+}
+
+interface GcEvent {
+  startTime: number;
+  duration: number;
+}
+
+/**
+ * Side indices for one round; ABBA order cancels linear drift
+ * (JIT tier-up, clock ramp, heap growth) between two sides
+ */
+export function roundOrder(sideCount: number, round: number, order: MeasurementOrder): number[] {
+  const sides = Array.from({ length: sideCount }, (_, i) => i);
+  if (order === 'abba') {
+    return round % 2 === 0 ? sides : sides.reverse();
+  }
+  if (order === 'random') {
+    for (let i = sides.length - 1; i > 0; i--) {
+      const j = Math.floor(Math.random() * (i + 1));
+      [sides[i], sides[j]] = [sides[j], sides[i]];
+    }
+  }
+  return sides;
+}
+
+/**
+ * Current JS heap usage: process.memoryUsage() on Node, performance.memory
+ * on Chromium (coarse unless the page is cross-origin isolated)
+ */
+export function readHeapUsed(): number | null {
+  if (typeof process !== 'undefined' && typeof process.memoryUsage === 'function') {
+    return process.memoryUsage().heapUsed;
+  }
+  const memory = (performance as Performance & { memory?: { usedJSHeapSize: number } }).memory;
+  return memory ? memory.usedJSHeapSize : null;
+}
+
+/**
+ * Watches garbage collections (Node 'gc' performance entries) and the heap
+ * counter while samples are taken. GC entries are delivered asynchronously,
+ * so counts are attributed to samples by timestamp in finish().
+ */
+export class MemoryProbe {
+  private readonly events: GcEvent[] = [];
+  private observer: PerformanceObserver | null = null;
+  readonly samples: MemorySample[] = [];
+
+  start(): void {
+    if (typeof PerformanceObserver === 'undefined' ||
+        !PerformanceObserver.supportedEntryTypes?.includes('gc')) {
+      return;
+    }
+    this.observer = new PerformanceObserver(list => {
+      for (const entry of list.getEntries()) {
+        this.events.push({ startTime: entry.startTime, duration: entry.duration });
+      }
+    });
+    this.observer.observe({ entryTypes: ['gc'] });
+  }
+
+  /**
+   * Run one sample and record its counters; returns what fn returns
+   */
+  measure<T>(fn: () => T): T {
+    const heapBefore = readHeapUsed();
+    const startTime = performance.now();
+    const result = fn();
+    const endTime = performance.now();
+    const heapAfter = readHeapUsed();
+
+    this.samples.push({
+      startTime,
+      endTime,
+      heapDeltaBytes: heapBefore !== null && heapAfter !== null ? heapAfter - heapBefore : null,
+      gcCount: null,
+      gcTimeMs: null,
+    });
+    return result;
+  }
+
+  /**
+   * Stop observing and fill gcCount / gcTimeMs of every recorded sample
+   */
+  async finish(): Promise<MemorySample[]> {
+    if (this.observer) {
+      // Let pending gc entries reach the observer
+      await new Promise(resolve => setTimeout(resolve, 0));
+      this.observer.disconnect();
+      this.observer = null;
+
+      for (const sample of this.samples) {
+        sample.gcCount = 0;
+        sample.gcTimeMs = 0;
+        for (const event of this.events) {
+          if (event.startTime >= sample.startTime && event.startTime < sample.endTime) {
+            sample.gcCount++;
+            sample.gcTimeMs += event.duration;
+          }
+        }
+      }
+    }
+    return this.samples;
+  }
+}
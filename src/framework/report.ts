@@ -0,0 +1,220 @@
+/**
+ * JS vs WASM Benchmark Framework - Reports
+ * Flat result records, JSON/CSV serialization and baseline comparison
+ */
+
+import type { BenchmarkResult, TestConfig } from './types';
+import type { WasmStartupTiming } from './wasm-loader';
+import type { WorkerDispatchStats } from './wasm-worker-host';
+
+/**
+ * Where a report was produced
+ */
+export interface EnvironmentInfo {
+  timestamp: string;
+  runtime: string;
+  runtimeVersion: string;
+  platform: string;
+  arch: string;
+  cpuModel: string;
+  cpuCount: number;
+  totalMemoryBytes: number;
+  gitCommit: string | null;
+  // Threads available to the *_MT kernels (1 without pthreads)
+  wasmThreads: number | null;
+  // Fetch / compile / instantiate split of module startup
+  wasmStartup?: WasmStartupTiming | null;
+}
+
+/**
+ * One test at one size; times in milliseconds per call
+ */
+export interface BenchmarkRecord {
+  test: string;
+  category: string;
+  // null for tests whose input size is fixed
+  size: number | null;
+  tsMean: number;
+  tsMedian: number;
+  tsP90: number;
+  tsCiLow: number;
+  tsCiHigh: number;
+  tsSamples: number;
+  wasmMean: number;
+  wasmMedian: number;
+  wasmP90: number;
+  wasmCiLow: number;
+  wasmCiHigh: number;
+  wasmSamples: number;
+  speedup: number;
+  speedupLow: number;
+  speedupHigh: number;
+  noisy: boolean;
+  // Heap allocations by the WASM scratch arenas while sampling (0 when the
+  // kernel reuses its scratch), and their peak use in bytes
+  wasmScratchGrows: number | null;
+  wasmScratchHighWater: number | null;
+  // Per WASM call: JS copies into and out of WASM memory and the kernel
+  // itself (null without a profile), the kernel's GB/s and its share of
+  // the module's read bandwidth
+  wasmCopyInMs: number | null;
+  wasmKernelMs: number | null;
+  wasmCopyOutMs: number | null;
+  wasmKernelGBps: number | null;
+  wasmBandwidthShare: number | null;
+}
+
+export interface BenchmarkReport {
+  environment: EnvironmentInfo;
+  config: Omit<TestConfig, 'arraySize'> & { sizes: number[] };
+  records: BenchmarkRecord[];
+  // Batched dispatch to a worker-hosted instance (--worker)
+  workerDispatch?: WorkerDispatchStats;
+}
+
+export type RegressionMetric = 'mean' | 'median';
+
+export interface RegressionThresholds {
+  // Allowed relative slowdown before a change counts (0.1 = 10%)
+  maxSlowdown: number;
+  metric: RegressionMetric;
+  // Also require the 95% CIs not to overlap (mean metric only)
+  requireSignificance: boolean;
+  // Sides to gate on
+  sides: Array<'ts' | 'wasm'>;
+}
+
+export const DEFAULT_REGRESSION_THRESHOLDS: RegressionThresholds = {
+  maxSlowdown: 0.1,
+  metric: 'mean',
+  requireSignificance: true,
+  sides: ['wasm'],
+};
+
+export interface BaselineComparison {
+  test: string;
+  size: number | null;
+  side: 'ts' | 'wasm';
+  baseline: number;
+  current: number;
+  // current / baseline - 1
+  change: number;
+  status: 'regression' | 'improvement' | 'unchanged';
+}
+
+export interface BaselineReport {
+  comparisons: BaselineComparison[];
+  regressions: BaselineComparison[];
+  // Records without a baseline entry, and baseline entries no longer run
+  added: string[];
+  missing: string[];
+}
+
+/**
+ * Flatten a runner result; statistics fall back to the plain fields when a
+ * result was produced without the adaptive sampler
+ */
+export function toBenchmarkRecord(result: BenchmarkResult, size: number | null): BenchmarkRecord {
+  const ts = result.tsStats;
+  const wasm = result.wasmStats;
+  return {
+    test: result.testName,
+    category: result.category,
+    size,
+    tsMean: result.tsAvg,
+    tsMedian: result.tsMedian,
+    tsP90: ts?.p90 ?? result.tsMax,
+    tsCiLow: ts?.ciLow ?? result.tsMin,
+    tsCiHigh: ts?.ciHigh ?? result.tsMax,
+    tsSamples: result.tsTimes.length,
+    wasmMean: result.wasmAvg,
+    wasmMedian: result.wasmMedian,
+    wasmP90: wasm?.p90 ?? result.wasmMax,
+    wasmCiLow: wasm?.ciLow ?? result.wasmMin,
+    wasmCiHigh: wasm?.ciHigh ?? result.wasmMax,
+    wasmSamples: result.wasmTimes.length,
+    speedup: result.speedup,
+    speedupLow: result.speedupCI?.low ?? result.speedup,
+    speedupHigh: result.speedupCI?.high ?? result.speedup,
+    noisy: result.noisy ?? false,
+    wasmScratchGrows: result.wasmScratch?.grows ?? null,
+    wasmScratchHighWater: result.wasmScratch?.highWater ?? null,
+    wasmCopyInMs: result.wasmProfile?.copyInMs ?? null,
+    wasmKernelMs: result.wasmProfile?.kernelMs ?? null,
+    wasmCopyOutMs: result.wasmProfile?.copyOutMs ?? null,
+    wasmKernelGBps: result.wasmProfile?.kernelGBps ?? null,
+    wasmBandwidthShare: result.wasmProfile?.bandwidthShare ?? null,
+  };
+}
+
+export function recordKey(record: Pick<BenchmarkRecord, 'test' | 'size'>): string {
+  return record.size === null ? record.test : `${record.test} @ ${record.size}`;
+}
+
+function csvField(value: unknown): string {
+  const text = String(value ?? '');
+  return /[",\n]/.test(text) ? `"${text.replace(/"/g, '""')}"` : text;
+}
+
+/**
+ * One header row plus one row per record
+ */
+export function recordsToCsv(records: BenchmarkRecord[]): string {
+  if (records.length === 0) {
+    return '';
+  }
+  const columns = Object.keys(records[0]) as Array<keyof BenchmarkRecord>;
+  const lines = [columns.join(',')];
+  for (const record of records) {
+    lines.push(columns.map(column => csvField(record[column])).join(','));
+  }
+  return lines.join('\n') + '\n';
+}
+
+/**
+ * Compare records against a stored report. A side regresses when its metric
+ * slows down by more than maxSlowdown and, with requireSignificance, the
+ * current CI lies entirely above the baseline CI.
+ */
+export function compareToBaseline(
+  records: BenchmarkRecord[],
+  baseline: BenchmarkRecord[],
+  thresholds: RegressionThresholds = DEFAULT_REGRESSION_THRESHOLDS
+): BaselineReport {
+  const baselineByKey = new Map(baseline.map(record => [recordKey(record), record]));
+  const currentKeys = new Set(records.map(recordKey));
+  const comparisons: BaselineComparison[] = [];
+  const added: string[] = [];
+
+  for (const record of records) {
+    const previous = baselineByKey.get(recordKey(record));
+    if (!previous) {
+      added.push(recordKey(record));
+      continue;
+    }
+
+    for (const side of thresholds.sides) {
+      const metric = thresholds.metric === 'mean' ? 'Mean' : 'Median';
+      const current = record[`${side}${metric}` as const];
+      const before = previous[`${side}${metric}` as const];
+      const change = current / before - 1;
+      const separated = !thresholds.requireSignificance || thresholds.metric !== 'mean' ||
+        record[`${side}CiLow` as const] > previous[`${side}CiHigh` as const];
+
+      let status: BaselineComparison['status'] = 'unchanged';
+      if (change > thresholds.maxSlowdown && separated) {
+        status = 'regression';
+      } else if (change < -thresholds.maxSlowdown) {
+        status = 'improvement';
+      }
+      comparisons.push({ test: record.test, size: record.size, side, baseline: before, current, change, status });
+    }
+  }
+
+  return {
+    comparisons,
+    regressions: comparisons.filter(comparison => comparison.status === 'regression'),
+    added,
+    missing: baseline.map(recordKey).filter(key => !currentKeys.has(key)),
+  };
+}
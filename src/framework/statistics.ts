@@ -0,0 +1,211 @@
+/**
+ * JS vs WASM Benchmark Framework - Statistics
+ * Robust summaries, confidence intervals and bootstrap estimates for timing samples
+ */
+
+/**
+ * Summary of one side's samples after outlier rejection
+ */
+export interface SampleStatistics {
+  // Samples kept / rejected by the MAD filter
+  count: number;
+  outliers: number;
+  mean: number;
+  stdDev: number;
+  min: number;
+  max: number;
+  median: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  // Median absolute deviation of the raw samples
+  mad: number;
+  // 95% confidence interval of the mean
+  ciLow: number;
+  ciHigh: number;
+  // CI half-width divided by the mean
+  relativeCiHalfWidth: number;
+}
+
+export interface ConfidenceInterval {
+  estimate: number;
+  low: number;
+  high: number;
+}
+
+// Two-sided 95% Student t critical values for 1..30 degrees of freedom
+const T_CRITICAL_95 = [
+  12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+  2.201, 2.179, 2.16, 2.145, 2.131, 2.12, 2.11, 2.101, 2.093, 2.086,
+  2.08, 2.074, 2.069, 2.064, 2.06, 2.056, 2.052, 2.048, 2.045, 2.042,
+];
+
+// Scales MAD to a standard-deviation estimate for normal data
+const MAD_TO_SIGMA = 1.4826;
+
+export function mean(values: number[]): number {
+  let sum = 0;
+  for (const value of values) {
+    sum += value;
+  }
+  return values.length > 0 ? sum / values.length : NaN;
+}
+
+/**
+ * Sample standard deviation (n - 1)
+ */
+export function standardDeviation(values: number[], valuesMean: number = mean(values)): number {
+  if (values.length < 2) {
+    return 0;
+  }
+  let sumSquares = 0;
+  for (const value of values) {
+    const diff = value - valuesMean;
+    sumSquares += diff * diff;
+  }
+  return Math.sqrt(sumSquares / (values.length - 1));
+}
+
+/**
+ * Percentile of an ascending array with linear interpolation (p in [0, 100])
+ */
+export function percentile(sorted: number[], p: number): number {
+  if (sorted.length === 0) {
+    return NaN;
+  }
+  const rank = (p / 100) * (sorted.length - 1);
+  const lower = Math.floor(rank);
+  const upper = Math.min(lower + 1, sorted.length - 1);
+  return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - lower);
+}
+
+export function median(values: number[]): number {
+  return percentile([...values].sort((a, b) => a - b), 50);
+}
+
+export function medianAbsoluteDeviation(values: number[], center: number = median(values)): number {
+  return median(values.map(value => Math.abs(value - center)));
+}
+
+/**
+ * Split samples with the modified z-score |x - median| / (1.4826 * MAD)
+ * Nothing is rejected when MAD is 0 (the spread is below timer resolution)
+ */
+export function rejectOutliers(values: number[], threshold: number = 3.5): { kept: number[]; rejected: number[] } {
+  const center = median(values);
+  const scale = MAD_TO_SIGMA * medianAbsoluteDeviation(values, center);
+  if (scale === 0) {
+    return { kept: [...values], rejected: [] };
+  }
+
+  const kept: number[] = [];
+  const rejected: number[] = [];
+  for (const value of values) {
+    (Math.abs(value - center) / scale > threshold ? rejected : kept).push(value);
+  }
+  return { kept, rejected };
+}
+
+/**
+ * Two-sided 95% critical value of Student's t (normal beyond 30 df)
+ */
+export function tCritical95(degreesOfFreedom: number): number {
+  if (degreesOfFreedom < 1) {
+    return Infinity;
+  }
+  if (degreesOfFreedom <= T_CRITICAL_95.length) {
+    return T_CRITICAL_95[degreesOfFreedom - 1];
+  }
+  // 1/df approximation, within 0.005 of the exact value
+  return 1.96 + 2.4 / degreesOfFreedom;
+}
+
+/**
+ * Outlier-filtered summary with percentiles and a t-based 95% CI of the mean
+ */
+export function summarizeSamples(values: number[], outlierThreshold: number = 3.5): SampleStatistics {
+  const { kept, rejected } = rejectOutliers(values, outlierThreshold);
+  const sorted = [...kept].sort((a, b) => a - b);
+  const keptMean = mean(kept);
+  const stdDev = standardDeviation(kept, keptMean);
+  const halfWidth = kept.length > 1 ? tCritical95(kept.length - 1) * stdDev / Math.sqrt(kept.length) : Infinity;
+
+  return {
+    count: kept.length,
+    outliers: rejected.length,
+    mean: keptMean,
+    stdDev,
+    min: sorted[0],
+    max: sorted[sorted.length - 1],
+    median: percentile(sorted, 50),
+    p50: percentile(sorted, 50),
+    p90: percentile(sorted, 90),
+    p99: percentile(sorted, 99),
+    mad: medianAbsoluteDeviation(values),
+    ciLow: keptMean - halfWidth,
+    ciHigh: keptMean + halfWidth,
+    relativeCiHalfWidth: keptMean > 0 ? halfWidth / keptMean : Infinity,
+  };
+}
+
+/**
+ * Small deterministic PRNG (mulberry32) of uint32 values, so bootstrap
+ * intervals are reproducible and a failing differential run can be replayed
+ */
+export function mulberry32(seed: number): () => number {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return (t ^ (t >>> 14)) >>> 0;
+  };
+}
+
+/**
+ * mulberry32 scaled to [0, 1)
+ */
+function createRandom(seed: number): () => number {
+  const next = mulberry32(seed);
+  return () => next() / 4294967296;
+}
+
+function resampleMean(values: number[], random: () => number): number {
+  let sum = 0;
+  for (let i = 0; i < values.length; i++) {
+    sum += values[Math.floor(random() * values.length)];
+  }
+  return sum / values.length;
+}
+
+/**
+ * Percentile bootstrap CI of mean(numerator) / mean(denominator),
+ * resampling both sides independently (e.g. speedup = ts / wasm)
+ */
+export function bootstrapRatioCI(
+  numerator: number[],
+  denominator: number[],
+  resamples: number = 2000,
+  confidence: number = 0.95,
+  seed: number = 0x5eed
+): ConfidenceInterval {
+  const estimate = mean(numerator) / mean(denominator);
+  if (numerator.length < 2 || denominator.length < 2 || resamples < 1) {
+    return { estimate, low: estimate, high: estimate };
+  }
+
+  const random = createRandom(seed);
+  const ratios = new Array<number>(resamples);
+  for (let i = 0; i < resamples; i++) {
+    ratios[i] = resampleMean(numerator, random) / resampleMean(denominator, random);
+  }
+  ratios.sort((a, b) => a - b);
+
+  const tail = ((1 - confidence) / 2) * 100;
+  return {
+    estimate,
+    low: percentile(ratios, tail),
+    high: percentile(ratios, 100 - tail),
+  };
+}
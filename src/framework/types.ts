@@ -3,13 +3,42 @@
  * 核心类型定义
  */
 
+import type { MeasurementOrder, MemorySample } from './measurement';
+import type { ConfidenceInterval, SampleStatistics } from './statistics';
+import type { ScratchStats } from './wasm-bridge';
+import type { WasmCallBreakdown } from './wasm-profile';
+
 /**
  * 测试配置
  */
 export interface TestConfig {
   arraySize: number;
+  // Minimum samples per side (the adaptive runner may take more)
   iterations: number;
   warmupIterations: number;
+  // Sample ordering between TypeScript and WASM (default 'abba')
+  order?: MeasurementOrder;
+  statistics?: Partial<StatisticsOptions>;
+}
+
+/**
+ * Adaptive sampling / noise control
+ */
+export interface StatisticsOptions {
+  // Inner repetitions are batched until one sample takes at least this long
+  minSampleTimeMs: number;
+  // Stop sampling a side after this many samples or this much time
+  maxSamples: number;
+  maxTimeMs: number;
+  // Stop early once the 95% CI half-width / mean drops below this
+  targetRelativeCI: number;
+  // A side still above this when sampling stops is too noisy
+  maxRelativeCI: number;
+  // Modified z-score above which a sample is an outlier
+  outlierThreshold: number;
+  bootstrapResamples: number;
+  // Throw from runBenchmarks when any test is too noisy
+  failOnNoise: boolean;
 }
 
 /**
@@ -33,6 +62,24 @@ export interface BenchmarkResult {
   wasmMedian: number;
   speedup: number;
   winner: 'TypeScript' | 'WASM';
+  // Outlier-filtered statistics (per-call times)
+  tsStats?: SampleStatistics;
+  wasmStats?: SampleStatistics;
+  // Bootstrap 95% CI of the speedup ratio
+  speedupCI?: ConfidenceInterval;
+  // Calls per timed sample on each side
+  tsRepetitions?: number;
+  wasmRepetitions?: number;
+  // GC / heap counters per sample
+  tsMemory?: MemorySample[];
+  wasmMemory?: MemorySample[];
+  // WASM scratch arena counters over the measured samples (after warmup)
+  wasmScratch?: ScratchStats;
+  // Copy-in / kernel / copy-out split of a WASM call, from profiled calls
+  // run after sampling
+  wasmProfile?: WasmCallBreakdown;
+  // Set when either side missed maxRelativeCI
+  noisy?: boolean;
 }
 
 /**
@@ -59,6 +106,10 @@ export interface BenchmarkTest<TData = any> {
   // TypeScript 实现
   tsImpl: (data: TData) => any;
 
+  // 每次计时前的未计时重置（原地修改输入的内核需要）
+  tsSetup?: (data: TData) => void;
+  wasmSetup?: (data: TData) => void;
+
   // WASM 函数名称
   wasmFuncName: string;
 
@@ -73,6 +124,12 @@ export interface BenchmarkTest<TData = any> {
 
   // 数据类型（用于自动生成 WASM 包装器）
   dataType?: DataType;
+
+  // 释放 prepare 分配的资源（如 WasmBuffer）
+  cleanup?: (data: TData) => void;
+
+  // 数据规模固定，不随 arraySize 变化（尺寸扫描时只运行一次）
+  sizeIndependent?: boolean;
 }
 
 /**
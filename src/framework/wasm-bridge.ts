@@ -5,6 +5,8 @@
 
 import type { DataType } from './types';
 import { getWasmModuleInstance, type WasmModuleInstance } from './wasm-loader';
+import { WasmBuffer } from './wasm-buffer';
+import { copyTimerStart, recordCopyIn, recordCopyOut } from './wasm-profile';
 
 /**
  * Get WASM module instance
@@ -13,6 +15,47 @@ export function getWasmModule(): WasmModuleInstance {
   return getWasmModuleInstance();
 }
 
+// ========== DIRECT EXPORTS ==========
+// ccall looks the export up by name, converts every argument and allocates
+// argument arrays on each call. The raw `_name` exports take numbers (and
+// bigints for 64-bit values, WASM_BIGINT) directly, so they are resolved
+// once and called as plain functions.
+
+// Raw export signatures. uint32_t results arrive as signed i32, exactly as
+// through ccall; uint64_t results arrive as bigint.
+export type WasmExport = (...args: number[]) => number | bigint | void;
+export type ExportNoArgs<R = void> = () => R;
+export type ExportPtrLen<R = number> = (ptr: number, length: number) => R;
+export type ExportPtrLenScalar<R = number> = (ptr: number, length: number, value: number) => R;
+export type ExportPtrLenScalars<R = number> = (ptr: number, length: number, value: number, value2: number) => R;
+
+// Resolved exports per module instance (a worker holds its own)
+const boundExports = new WeakMap<WasmModuleInstance, Map<string, WasmExport>>();
+
+/**
+ * Raw export of funcName, resolved on first use and cached
+ */
+export function bindExport<F extends WasmExport = WasmExport>(
+  funcName: string,
+  module: WasmModuleInstance = getWasmModule()
+): F {
+  let exports = boundExports.get(module);
+  if (!exports) {
+    exports = new Map();
+    boundExports.set(module, exports);
+  }
+  let fn = exports.get(funcName);
+  if (!fn) {
+    const candidate = (module as unknown as Record<string, unknown>)[`_${funcName}`];
+    if (typeof candidate !== 'function') {
+      throw new Error(`WASM export _${funcName} not found`);
+    }
+    fn = candidate as WasmExport;
+    exports.set(funcName, fn);
+  }
+  return fn as F;
+}
+
 /**
  * Memory pool - avoid frequent malloc/free
  */
@@ -33,7 +76,9 @@ export function allocateUint32Array(arr: Uint32Array, poolId: string = 'default'
     memoryPools.set(poolId, heap);
   }
 
+  const copyStart = copyTimerStart();
   heap.set(arr);
+  recordCopyIn(copyStart, byteSize);
   return heap.byteOffset;
 }
 
@@ -52,7 +97,9 @@ export function allocateFloat32Array(arr: Float32Array, poolId: string = 'defaul
     memoryPools.set(poolId, heap);
   }
 
+  const copyStart = copyTimerStart();
   heap.set(arr);
+  recordCopyIn(copyStart, byteSize);
   return heap.byteOffset;
 }
 
@@ -61,8 +108,11 @@ export function allocateFloat32Array(arr: Float32Array, poolId: string = 'defaul
  */
 export function readUint32Array(ptr: number, length: number): Uint32Array {
   const module = getWasmModule();
+  const copyStart = copyTimerStart();
   const heap = new Uint32Array(module.HEAPU32.buffer, ptr, length);
-  return new Uint32Array(heap);
+  const result = new Uint32Array(heap);
+  recordCopyOut(copyStart, result.byteLength);
+  return result;
 }
 
 /**
@@ -70,8 +120,11 @@ export function readUint32Array(ptr: number, length: number): Uint32Array {
  */
 export function readFloat32Array(ptr: number, length: number): Float32Array {
   const module = getWasmModule();
+  const copyStart = copyTimerStart();
   const heap = new Float32Array(module.HEAPF32.buffer, ptr, length);
-  return new Float32Array(heap);
+  const result = new Float32Array(heap);
+  recordCopyOut(copyStart, result.byteLength);
+  return result;
 }
 
 /**
@@ -85,21 +138,79 @@ export function clearMemoryPools(): void {
   memoryPools.clear();
 }
 
+/**
+ * Counters of the per-thread scratch arenas the C++ kernels allocate
+ * temporaries from (getScratchStats); bytes unless noted
+ */
+export interface ScratchStats {
+  // Handed out since the last reset
+  bytesRequested: number;
+  // Held from the heap right now
+  bytesReserved: number;
+  // Heap allocations since the last reset (0 in a steady state)
+  grows: number;
+  // Most scratch one thread had in use at once since the last reset
+  highWater: number;
+  // WASM linear memory size
+  memoryBytes: number;
+}
+
+const SCRATCH_STATS_BYTES = 5 * 8;
+
+export function readScratchStats(): ScratchStats {
+  const module = getWasmModule();
+  const ptr = module._malloc(SCRATCH_STATS_BYTES);
+  if (!ptr) {
+    throw new Error('Failed to allocate memory in WASM');
+  }
+  try {
+    module.ccall('getScratchStats', null, ['number'], [ptr]);
+    const [bytesRequested, bytesReserved, grows, highWater, memoryBytes] =
+      module.HEAPF64.subarray(ptr / 8, ptr / 8 + 5);
+    return { bytesRequested, bytesReserved, grows, highWater, memoryBytes };
+  } finally {
+    module._free(ptr);
+  }
+}
+
+/**
+ * Zero the cumulative scratch counters (bytesReserved is live state and stays)
+ */
+export function resetScratchStats(): void {
+  getWasmModule().ccall('resetScratchStats', null, [], []);
+}
+
 /**
  * WASM function wrapper generator
- * Automatically handle memory allocation and data conversion
+ * Automatically handle memory allocation and data conversion.
+ * WasmBuffer inputs are passed through without copying, and in-place
+ * results come back as the buffer's live view.
  */
 export function createWasmWrapper<TInput, TOutput>(
   funcName: string,
   inputType: DataType,
   outputType: 'void' | 'number' | 'array'
 ): (input: TInput) => TOutput {
-  const module = getWasmModule();
+  const kernel = bindExport<ExportPtrLen<number | bigint | void>>(funcName);
 
   return (input: TInput): TOutput => {
     let ptr: number;
     let length: number = 0;
 
+    // Zero-copy path
+    if (input instanceof WasmBuffer) {
+      try {
+        if (outputType === 'number') {
+          return kernel(input.ptr, input.length) as TOutput;
+        }
+        kernel(input.ptr, input.length);
+        return input.view as TOutput;
+      } catch (error) {
+        console.error(`WASM function ${funcName} failed:`, error);
+        throw error;
+      }
+    }
+
     // Handle input
     if (inputType === 'uint32array' && input instanceof Uint32Array) {
       length = input.length;
@@ -114,19 +225,11 @@ export function createWasmWrapper<TInput, TOutput>(
     // Call WASM function
     let result: any;
     try {
-      if (outputType === 'void') {
-        module.ccall(funcName, null, ['number', 'number'], [ptr, length]);
-
-        // 如果是 in-place 操作，读取修改后的数据
-        if (inputType === 'uint32array') {
-          result = readUint32Array(ptr, length) as TOutput;
-        } else if (inputType === 'float32array') {
-          result = readFloat32Array(ptr, length) as TOutput;
-        }
-      } else if (outputType === 'number') {
-        result = module.ccall(funcName, 'number', ['number', 'number'], [ptr, length]) as TOutput;
-      } else if (outputType === 'array') {
-        module.ccall(funcName, null, ['number', 'number'], [ptr, length]);
+      if (outputType === 'number') {
+        result = kernel(ptr, length) as TOutput;
+      } else {
+        // void (in-place) and array outputs read the modified data back
+        kernel(ptr, length);
         if (inputType === 'uint32array') {
           result = readUint32Array(ptr, length) as TOutput;
         } else if (inputType === 'float32array') {
@@ -155,39 +258,41 @@ export interface WasmFuncConfig {
 }
 
 export function createAdvancedWasmWrapper(config: WasmFuncConfig): (...args: any[]) => any {
-  const module = getWasmModule();
+  const kernel = bindExport(config.funcName);
+  // Arrays expand to (ptr, length); the argument list is reused across calls
+  const callArgs: number[] = new Array(
+    config.args.reduce((slots, arg) => slots + (arg.type === 'number' ? 1 : 2), 0)
+  ).fill(0);
 
   return (...args: any[]): any => {
-    const ptrs: number[] = [];
-    const argTypes: string[] = [];
-    const argValues: any[] = [];
-
     try {
       // Process all parameters
-      args.forEach((arg, index) => {
+      let slot = 0;
+      for (let index = 0; index < args.length; index++) {
+        const arg = args[index];
         const argConfig = config.args[index];
 
-        if (argConfig.type === 'uint32array' && arg instanceof Uint32Array) {
-          const ptr = allocateUint32Array(arg, argConfig.poolId || `arg${index}`);
-          ptrs.push(ptr);
-          argTypes.push('number', 'number');
-          argValues.push(ptr, arg.length);
+        if (arg instanceof WasmBuffer) {
+          callArgs[slot++] = arg.ptr;
+          callArgs[slot++] = arg.length;
+        } else if (argConfig.type === 'uint32array' && arg instanceof Uint32Array) {
+          callArgs[slot++] = allocateUint32Array(arg, argConfig.poolId || `arg${index}`);
+          callArgs[slot++] = arg.length;
         } else if (argConfig.type === 'float32array' && arg instanceof Float32Array) {
-          const ptr = allocateFloat32Array(arg, argConfig.poolId || `arg${index}`);
-          ptrs.push(ptr);
-          argTypes.push('number', 'number');
-          argValues.push(ptr, arg.length);
+          callArgs[slot++] = allocateFloat32Array(arg, argConfig.poolId || `arg${index}`);
+          callArgs[slot++] = arg.length;
         } else if (argConfig.type === 'number') {
-          argTypes.push('number');
-          argValues.push(arg);
+          callArgs[slot++] = arg;
         }
-      });
+      }
 
       // Call function
-      const returnTypeStr = config.returnType === 'void' ? null : 'number';
-      const result = module.ccall(config.funcName, returnTypeStr, argTypes, argValues);
+      const result = kernel.apply(null, callArgs);
 
       // Handle return value
+      if (config.returnType === 'void') {
+        return undefined;
+      }
       if (config.returnType === 'bigint' && typeof result === 'number') {
         return BigInt(result);
       }
@@ -0,0 +1,170 @@
+/**
+ * JS vs WASM Benchmark Framework - Persistent WASM Buffers
+ * Zero-copy buffer handles backed by createBuffer/resizeBuffer/freeBuffer
+ */
+
+import { getWasmModuleInstance } from './wasm-loader';
+
+export type WasmBufferArray =
+  | Uint8Array
+  | Int8Array
+  | Int16Array
+  | Int32Array
+  | Uint32Array
+  | Float32Array
+  | Float64Array
+  | BigUint64Array;
+
+// TypedArray.set of any element type (number or bigint source)
+type ArraySetter = (array: ArrayLike<number> | ArrayLike<bigint>, offset?: number) => void;
+
+interface WasmBufferArrayConstructor<T extends WasmBufferArray> {
+  new (buffer: ArrayBufferLike, byteOffset: number, length: number): T;
+  readonly BYTES_PER_ELEMENT: number;
+}
+
+/**
+ * Typed-array view over a C++-owned buffer.
+ * Kernels run directly on `ptr`; results are read through `view` without copying.
+ * The view is rebuilt whenever WASM memory has grown (which detaches old views).
+ */
+export class WasmBuffer<T extends WasmBufferArray = Uint32Array> {
+  private handle: number;
+  private dataPtr: number;
+  private elementCount: number;
+  private cachedView: T | null = null;
+
+  private constructor(
+    private readonly arrayType: WasmBufferArrayConstructor<T>,
+    length: number
+  ) {
+    const module = getWasmModuleInstance();
+    this.handle = module.ccall('createBuffer', 'number', ['number'], [length * arrayType.BYTES_PER_ELEMENT]);
+    if (!this.handle) {
+      throw new Error('Failed to create buffer in WASM');
+    }
+    this.dataPtr = module.ccall('getBufferData', 'number', ['number'], [this.handle]);
+    this.elementCount = length;
+  }
+
+  /**
+   * Create a zeroed Uint32 buffer
+   */
+  static uint32(length: number): WasmBuffer<Uint32Array> {
+    return new WasmBuffer(Uint32Array, length);
+  }
+
+  /**
+   * Create a zeroed Int32 buffer (index/result arrays where -1 means "none")
+   */
+  static int32(length: number): WasmBuffer<Int32Array> {
+    return new WasmBuffer(Int32Array, length);
+  }
+
+  /**
+   * Create a zeroed Float32 buffer
+   */
+  static float32(length: number): WasmBuffer<Float32Array> {
+    return new WasmBuffer(Float32Array, length);
+  }
+
+  /**
+   * Create a zeroed Float64 buffer
+   */
+  static float64(length: number): WasmBuffer<Float64Array> {
+    return new WasmBuffer(Float64Array, length);
+  }
+
+  /**
+   * Create a zeroed uint64 buffer (the U64 typed kernels)
+   */
+  static uint64(length: number): WasmBuffer<BigUint64Array> {
+    return new WasmBuffer(BigUint64Array, length);
+  }
+
+  /**
+   * Create a zeroed byte buffer
+   */
+  static uint8(length: number): WasmBuffer<Uint8Array> {
+    return new WasmBuffer(Uint8Array, length);
+  }
+
+  /**
+   * Create a buffer holding a copy of `source` (the only copy in its lifetime)
+   */
+  static from<T extends WasmBufferArray>(source: T): WasmBuffer<T> {
+    const buffer = new WasmBuffer(source.constructor as unknown as WasmBufferArrayConstructor<T>, source.length);
+    buffer.set(source as ArrayLike<number> | ArrayLike<bigint>);
+    return buffer;
+  }
+
+  /**
+   * Heap address of the first element (pass this to kernels)
+   */
+  get ptr(): number {
+    this.assertAlive();
+    return this.dataPtr;
+  }
+
+  get length(): number {
+    return this.elementCount;
+  }
+
+  get byteLength(): number {
+    return this.elementCount * this.arrayType.BYTES_PER_ELEMENT;
+  }
+
+  /**
+   * Live view over the buffer contents
+   */
+  get view(): T {
+    this.assertAlive();
+    const heap = getWasmModuleInstance().HEAPU8.buffer;
+    if (!this.cachedView || this.cachedView.buffer !== heap) {
+      this.cachedView = new this.arrayType(heap, this.dataPtr, this.elementCount);
+    }
+    return this.cachedView;
+  }
+
+  /**
+   * Copy values into the buffer (bigints for a BigUint64Array buffer)
+   */
+  set(source: ArrayLike<number> | ArrayLike<bigint>, offset: number = 0): void {
+    (this.view.set as ArraySetter).call(this.view, source, offset);
+  }
+
+  /**
+   * Resize in place; existing contents are kept, new elements are zeroed
+   */
+  resize(length: number): void {
+    this.assertAlive();
+    const module = getWasmModuleInstance();
+    const ok = module.ccall(
+      'resizeBuffer',
+      'number',
+      ['number', 'number'],
+      [this.handle, length * this.arrayType.BYTES_PER_ELEMENT]
+    );
+    if (!ok) {
+      throw new Error('Failed to resize buffer in WASM');
+    }
+    this.dataPtr = module.ccall('getBufferData', 'number', ['number'], [this.handle]);
+    this.elementCount = length;
+    this.cachedView = null;
+  }
+
+  dispose(): void {
+    if (this.handle) {
+      getWasmModuleInstance().ccall('freeBuffer', null, ['number'], [this.handle]);
+      this.handle = 0;
+      this.dataPtr = 0;
+      this.cachedView = null;
+    }
+  }
+
+  private assertAlive(): void {
+    if (!this.handle) {
+      throw new Error('WasmBuffer has been disposed');
+    }
+  }
+}
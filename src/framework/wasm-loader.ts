@@ -1,6 +1,15 @@
 /**
  * WASM Module Loader - Vite standard loading method
  * Use ES Module import, can be used as third-party library
+ *
+ * The loader compiles array_processor.wasm itself and hands the compiled
+ * module to the Emscripten factory (instantiateWasm), so startup can be
+ * timed phase by phase and the compiled module reused:
+ *   - browsers compile while the bytes download (compileStreaming) and keep
+ *     the compiled module in IndexedDB where the browser can store one;
+ *   - Node reads the file from disk;
+ *   - within a process the compiled module is kept, so later instances
+ *     (workers) skip the compile.
  */
 
 // Import WASM module (ES6 module generated by Emscripten)
@@ -22,17 +31,273 @@ export interface WasmModuleInstance {
     returnType: string | null,
     argTypes: string[]
   ): (...args: any[]) => any;
+  HEAPU8: Uint8Array;
   HEAPF32: Float32Array;
   HEAP32: Int32Array;
   HEAPU32: Uint32Array;
+  HEAPF64: Float64Array;
 }
 
+// Where the compiled module came from; message: posted to a worker
+export type WasmModuleSource = 'network' | 'disk' | 'indexeddb' | 'message';
+
+// hit: loaded from IndexedDB; stored: compiled and written to it;
+// unsupported: the browser cannot store compiled modules; off: not used
+export type WasmCacheStatus = 'hit' | 'stored' | 'unsupported' | 'off';
+
+/**
+ * Startup phases of initWasmModule, in milliseconds
+ */
+export interface WasmStartupTiming {
+  source: WasmModuleSource;
+  cache: WasmCacheStatus;
+  // compileStreaming overlaps the download with compilation: fetchMs ends
+  // at the response headers and compileMs covers the body and compile
+  streaming: boolean;
+  fetchMs: number;
+  compileMs: number;
+  instantiateMs: number;
+  // Emscripten runtime start after instantiation (memory views, constructors)
+  runtimeInitMs: number;
+  totalMs: number;
+  // 0 for a cache hit or an unknown Content-Length
+  wasmBytes: number;
+  // Lazy kernel groups initialized so far, by name
+  groups: Record<string, number>;
+}
+
+export interface WasmLoadOptions {
+  // Use the IndexedDB module cache in browsers (default true)
+  cache?: boolean;
+  // Instantiate this compiled module instead of loading one (workers)
+  module?: WebAssembly.Module;
+}
+
+/**
+ * A compiled array_processor module and how it was obtained
+ */
+export interface CompiledWasm {
+  module: WebAssembly.Module;
+  source: WasmModuleSource;
+  cache: WasmCacheStatus;
+  streaming: boolean;
+  fetchMs: number;
+  compileMs: number;
+  wasmBytes: number;
+}
+
+// Resolved by Vite to the emitted (hashed) asset, by Node to the file
+const WASM_URL = new URL('../wasm/array_processor.wasm', import.meta.url);
+
+const CACHE_DB_NAME = 'typescript-wasm-benchmark';
+const CACHE_STORE = 'compiled-modules';
+
 let wasmModuleInstance: WasmModuleInstance | null = null;
+let startupTiming: WasmStartupTiming | null = null;
+let compiledModule: Promise<CompiledWasm> | null = null;
+const groupTimings: Record<string, number> = {};
+
+export function isNode(): boolean {
+  return typeof process !== 'undefined' && !!process.versions?.node;
+}
+
+async function readWasmFile(): Promise<CompiledWasm> {
+  // Kept out of the browser bundle
+  const fsModule = 'node:fs/promises';
+  const { readFile } = await import(/* @vite-ignore */ fsModule);
+  const start = performance.now();
+  const bytes: Uint8Array = await readFile(WASM_URL);
+  const read = performance.now();
+  const module = await WebAssembly.compile(bytes);
+  return {
+    module,
+    source: 'disk',
+    cache: 'off',
+    streaming: false,
+    fetchMs: read - start,
+    compileMs: performance.now() - read,
+    wasmBytes: bytes.byteLength,
+  };
+}
+
+async function fetchWasm(): Promise<CompiledWasm> {
+  const start = performance.now();
+  const response = await fetch(WASM_URL);
+  if (!response.ok) {
+    throw new Error(`Failed to fetch ${WASM_URL.href}: ${response.status}`);
+  }
+  const headers = performance.now();
+  const wasmBytes = Number(response.headers.get('Content-Length') ?? 0);
+
+  // Streaming needs the application/wasm MIME type; otherwise compile the bytes
+  if (typeof WebAssembly.compileStreaming === 'function' &&
+      response.headers.get('Content-Type')?.startsWith('application/wasm')) {
+    const module = await WebAssembly.compileStreaming(response);
+    return {
+      module,
+      source: 'network',
+      cache: 'off',
+      streaming: true,
+      fetchMs: headers - start,
+      compileMs: performance.now() - headers,
+      wasmBytes,
+    };
+  }
+  const bytes = await response.arrayBuffer();
+  const downloaded = performance.now();
+  const module = await WebAssembly.compile(bytes);
+  return {
+    module,
+    source: 'network',
+    cache: 'off',
+    streaming: false,
+    fetchMs: downloaded - start,
+    compileMs: performance.now() - downloaded,
+    wasmBytes: bytes.byteLength,
+  };
+}
+
+function requestToPromise<T>(request: IDBRequest<T>): Promise<T> {
+  return new Promise((resolve, reject) => {
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => reject(request.error);
+  });
+}
+
+function openCacheDatabase(): Promise<IDBDatabase> {
+  const request = indexedDB.open(CACHE_DB_NAME, 1);
+  request.onupgradeneeded = () => request.result.createObjectStore(CACHE_STORE);
+  return requestToPromise(request);
+}
+
+/**
+ * Identity of the deployed .wasm without downloading it: production asset
+ * URLs are content-hashed, the dev server changes ETag / Last-Modified
+ */
+async function readWasmVersion(): Promise<string | null> {
+  try {
+    const response = await fetch(WASM_URL, { method: 'HEAD', cache: 'no-cache' });
+    if (!response.ok) {
+      return null;
+    }
+    return response.headers.get('ETag') ?? response.headers.get('Last-Modified') ?? response.headers.get('Content-Length');
+  } catch {
+    return null;
+  }
+}
+
+// Set once the browser refused to store a compiled module
+const CACHE_REFUSED_KEY = `${CACHE_DB_NAME}:wasm-cache-refused`;
+
+function isCacheRefused(): boolean {
+  try {
+    return localStorage.getItem(CACHE_REFUSED_KEY) === '1';
+  } catch {
+    return false;
+  }
+}
+
+function rememberCacheRefused(): void {
+  try {
+    localStorage.setItem(CACHE_REFUSED_KEY, '1');
+  } catch {
+    // Without storage the refusal is simply met again next load
+  }
+}
+
+/**
+ * Browser load through the IndexedDB cache. Most engines refuse to store
+ * a WebAssembly.Module (DataCloneError); they cache the code of streamed
+ * modules themselves, so a refused store is remembered and not retried.
+ */
+async function loadThroughCache(): Promise<CompiledWasm> {
+  let database: IDBDatabase;
+  try {
+    database = await openCacheDatabase();
+  } catch {
+    return fetchWasm();
+  }
+
+  try {
+    const version = await readWasmVersion();
+    const key = WASM_URL.href;
+    if (version !== null) {
+      const start = performance.now();
+      const entry = await requestToPromise(
+        database.transaction(CACHE_STORE, 'readonly').objectStore(CACHE_STORE).get(key)
+      ) as { version: string; module: WebAssembly.Module } | undefined;
+      if (entry && entry.version === version && entry.module instanceof WebAssembly.Module) {
+        return {
+          module: entry.module,
+          source: 'indexeddb',
+          cache: 'hit',
+          streaming: false,
+          fetchMs: performance.now() - start,
+          compileMs: 0,
+          wasmBytes: 0,
+        };
+      }
+    }
+
+    const compiled = await fetchWasm();
+    if (version === null) {
+      return compiled;
+    }
+    try {
+      await requestToPromise(
+        database.transaction(CACHE_STORE, 'readwrite').objectStore(CACHE_STORE).put({ version, module: compiled.module }, key)
+      );
+      return { ...compiled, cache: 'stored' };
+    } catch (error) {
+      if (error instanceof DOMException && error.name === 'DataCloneError') {
+        rememberCacheRefused();
+        return { ...compiled, cache: 'unsupported' };
+      }
+      return compiled;
+    }
+  } finally {
+    database.close();
+  }
+}
+
+/**
+ * The compiled array_processor module, compiled once per process; workers
+ * can instantiate it without compiling again
+ */
+export function compileWasmModule(options: WasmLoadOptions = {}): Promise<CompiledWasm> {
+  if (!compiledModule) {
+    const useCache = options.cache !== false && typeof indexedDB !== 'undefined';
+    if (options.module) {
+      compiledModule = Promise.resolve({
+        module: options.module,
+        source: 'message',
+        cache: 'off',
+        streaming: false,
+        fetchMs: 0,
+        compileMs: 0,
+        wasmBytes: 0,
+      });
+    } else if (isNode()) {
+      compiledModule = readWasmFile();
+    } else if (!useCache) {
+      compiledModule = fetchWasm();
+    } else if (isCacheRefused()) {
+      compiledModule = fetchWasm().then(compiled => ({ ...compiled, cache: 'unsupported' as const }));
+    } else {
+      compiledModule = loadThroughCache();
+    }
+    // A failed load can be retried
+    compiledModule.catch(() => {
+      compiledModule = null;
+    });
+  }
+  return compiledModule;
+}
 
 /**
  * Initialize WASM module
  */
-export async function initWasmModule(): Promise<WasmModuleInstance> {
+export async function initWasmModule(options: WasmLoadOptions = {}): Promise<WasmModuleInstance> {
   if (wasmModuleInstance) {
     return wasmModuleInstance;
   }
@@ -40,16 +305,52 @@ export async function initWasmModule(): Promise<WasmModuleInstance> {
   console.log('🔄 Loading WASM module...');
 
   try {
-    // Call Emscripten-generated factory function
-    const module = await createWasmModule();
+    const start = performance.now();
+    const compiled = await compileWasmModule(options);
+    let instantiateMs = 0;
+    let instantiated = 0;
+    let rejectInstantiate: (error: unknown) => void = () => {};
+    const instantiateFailed = new Promise<never>((_, reject) => {
+      rejectInstantiate = reject;
+    });
+
+    // Call Emscripten-generated factory function with the compiled module
+    const module = await Promise.race([
+      createWasmModule({
+        instantiateWasm(imports, receiveInstance) {
+          const instantiateStart = performance.now();
+          WebAssembly.instantiate(compiled.module, imports).then(instance => {
+            instantiated = performance.now();
+            instantiateMs = instantiated - instantiateStart;
+            receiveInstance(instance, compiled.module);
+          }, rejectInstantiate);
+          // Exports are delivered asynchronously through receiveInstance
+          return {};
+        },
+      }),
+      instantiateFailed,
+    ]);
 
     if (!module) {
       throw new Error('WASM module factory returned null');
     }
 
+    const end = performance.now();
+    startupTiming = {
+      source: compiled.source,
+      cache: compiled.cache,
+      streaming: compiled.streaming,
+      fetchMs: compiled.fetchMs,
+      compileMs: compiled.compileMs,
+      instantiateMs,
+      runtimeInitMs: instantiated > 0 ? end - instantiated : 0,
+      totalMs: end - start,
+      wasmBytes: compiled.wasmBytes,
+      groups: groupTimings,
+    };
     wasmModuleInstance = module as WasmModuleInstance;
 
-    console.log('✅ WASM module loaded successfully');
+    console.log(`✅ WASM module loaded successfully (${formatStartupTiming(startupTiming)})`);
 
     return wasmModuleInstance;
   } catch (error) {
@@ -68,10 +369,52 @@ export function getWasmModuleInstance(): WasmModuleInstance {
   return wasmModuleInstance;
 }
 
+/**
+ * Startup phases of the loaded module; null before initWasmModule resolves
+ */
+export function getWasmStartupTiming(): WasmStartupTiming | null {
+  return startupTiming ? { ...startupTiming, groups: { ...groupTimings } } : null;
+}
+
+export function formatStartupTiming(timing: WasmStartupTiming): string {
+  const parts = [
+    `${timing.source}${timing.cache === 'off' ? '' : ` (cache ${timing.cache})`}`,
+    `fetch ${timing.fetchMs.toFixed(1)} ms`,
+    `compile ${timing.compileMs.toFixed(1)} ms${timing.streaming ? ' streaming' : ''}`,
+    `instantiate ${timing.instantiateMs.toFixed(1)} ms`,
+    `runtime ${timing.runtimeInitMs.toFixed(1)} ms`,
+    `total ${timing.totalMs.toFixed(1)} ms`,
+  ];
+  for (const [name, ms] of Object.entries(timing.groups)) {
+    parts.push(`${name} ${ms.toFixed(1)} ms`);
+  }
+  return parts.join(', ');
+}
+
+/**
+ * A kernel group whose setup (thread pool start, calibration, tables) is
+ * deferred to its first use. The returned getter runs init once, after
+ * initWasmModule, and records its time in the startup timing.
+ */
+export function lazyKernelGroup<T>(name: string, init: (module: WasmModuleInstance) => T): () => T {
+  let initialized = false;
+  let value: T;
+  return () => {
+    if (!initialized) {
+      const start = performance.now();
+      value = init(getWasmModuleInstance());
+      groupTimings[name] = performance.now() - start;
+      initialized = true;
+    }
+    return value;
+  };
+}
+
 /**
  * Export interface for external use
  */
 export const WasmLoader = {
   init: initWasmModule,
   getInstance: getWasmModuleInstance,
+  getStartupTiming: getWasmStartupTiming,
 };
@@ -0,0 +1,232 @@
+/**
+ * JS vs WASM Benchmark Framework - WASM Profile
+ * Reads the in-module kernel profile (src/cpp/kernel_profiler.h) and times
+ * the JS side of a call, the copies into and out of WASM memory, so a WASM
+ * result can be split into copy-in, kernel and copy-out time
+ */
+
+import { getWasmModuleInstance, lazyKernelGroup } from './wasm-loader';
+
+// ProfileBuffer layout in kernel_profiler.h
+const PROFILE_KERNELS_OFFSET = 24;
+const PROFILE_KERNEL_BYTES = 72;
+const PROFILE_NAME_BYTES = 48;
+const PROFILE_MAX_KERNELS = 128;
+const PROFILE_EVENTS_OFFSET = PROFILE_KERNELS_OFFSET + PROFILE_MAX_KERNELS * PROFILE_KERNEL_BYTES;
+const PROFILE_EVENT_BYTES = 32;
+
+// Reference read bandwidth: 32 MB, fastest of 5 passes
+const BANDWIDTH_BYTES = 32 << 20;
+const BANDWIDTH_PASSES = 5;
+
+/**
+ * Counters of one kernel since the last reset
+ */
+export interface KernelProfileEntry {
+  name: string;
+  calls: number;
+  // Array payload read and written, as declared by the kernel
+  bytes: number;
+  totalMs: number;
+}
+
+export interface KernelProfileEvent {
+  kernel: string;
+  // emscripten_get_now() clock, the same as performance.now()
+  startMs: number;
+  durationMs: number;
+  bytes: number;
+}
+
+export interface KernelProfile {
+  // Kernels called since the last reset
+  kernels: KernelProfileEntry[];
+  // Oldest first; only the newest eventCapacity events are kept
+  events: KernelProfileEvent[];
+  droppedEvents: number;
+}
+
+/**
+ * Time and bytes the JS marshaling helpers spent copying while profiling
+ */
+export interface CopyCounters {
+  copyInMs: number;
+  copyInBytes: number;
+  copyOutMs: number;
+  copyOutBytes: number;
+}
+
+/**
+ * Where the time of one WASM call goes, averaged over the profiled calls;
+ * milliseconds per call
+ */
+export interface WasmCallBreakdown {
+  calls: number;
+  totalMs: number;
+  copyInMs: number;
+  kernelMs: number;
+  copyOutMs: number;
+  // ccall argument conversion, malloc / free and everything else
+  otherMs: number;
+  // Kernel payload per call, and its rate over the kernel time
+  kernelBytes: number;
+  kernelGBps: number;
+  // Module read bandwidth and the share of it the kernel reaches
+  bandwidthGBps: number;
+  bandwidthShare: number;
+}
+
+let profiling = false;
+const copyCounters: CopyCounters = { copyInMs: 0, copyInBytes: 0, copyOutMs: 0, copyOutBytes: 0 };
+// Calibrated on first use; the run takes tens of milliseconds
+const readBandwidth = lazyKernelGroup('bandwidth', module =>
+  module.ccall('measureReadBandwidth', 'number', ['number', 'number'], [BANDWIDTH_BYTES, BANDWIDTH_PASSES]) as number
+);
+
+function profileBase(): number {
+  return getWasmModuleInstance().ccall('getProfileBuffer', 'number', [], []);
+}
+
+/**
+ * Turn kernel timing in the module and copy timing in JS on or off
+ */
+export function setProfilingEnabled(enabled: boolean): void {
+  getWasmModuleInstance().ccall('setProfilingEnabled', null, ['number'], [enabled ? 1 : 0]);
+  profiling = enabled;
+}
+
+/**
+ * Zero the kernel and copy counters and drop the recorded events
+ */
+export function resetProfile(): void {
+  getWasmModuleInstance().ccall('resetProfile', null, [], []);
+  copyCounters.copyInMs = 0;
+  copyCounters.copyInBytes = 0;
+  copyCounters.copyOutMs = 0;
+  copyCounters.copyOutBytes = 0;
+}
+
+export function readCopyCounters(): CopyCounters {
+  return { ...copyCounters };
+}
+
+function readName(heap: Uint8Array, ptr: number): string {
+  const bytes = heap.subarray(ptr, ptr + PROFILE_NAME_BYTES);
+  const end = bytes.indexOf(0);
+  return new TextDecoder().decode(bytes.subarray(0, end < 0 ? PROFILE_NAME_BYTES : end));
+}
+
+export function readKernelProfile(): KernelProfile {
+  const module = getWasmModuleInstance();
+  const base = profileBase();
+  const u32 = module.HEAPU32;
+  const f64 = module.HEAPF64;
+  const kernelCount = u32[base / 4 + 1];
+  const eventCapacity = u32[base / 4 + 2];
+  const eventCount = f64[base / 8 + 2];
+
+  const names: string[] = [];
+  const kernels: KernelProfileEntry[] = [];
+  for (let i = 0; i < kernelCount; i++) {
+    const ptr = base + PROFILE_KERNELS_OFFSET + i * PROFILE_KERNEL_BYTES;
+    const counters = (ptr + PROFILE_NAME_BYTES) / 8;
+    names.push(readName(module.HEAPU8, ptr));
+    if (f64[counters] > 0) {
+      kernels.push({ name: names[i], calls: f64[counters], bytes: f64[counters + 1], totalMs: f64[counters + 2] });
+    }
+  }
+
+  const kept = Math.min(eventCount, eventCapacity);
+  const events: KernelProfileEvent[] = [];
+  for (let i = eventCount - kept; i < eventCount; i++) {
+    const ptr = base + PROFILE_EVENTS_OFFSET + (i % eventCapacity) * PROFILE_EVENT_BYTES;
+    events.push({
+      kernel: names[u32[ptr / 4]],
+      startMs: f64[ptr / 8 + 1],
+      durationMs: f64[ptr / 8 + 2],
+      bytes: f64[ptr / 8 + 3],
+    });
+  }
+
+  return { kernels, events, droppedEvents: eventCount - kept };
+}
+
+/**
+ * Start of a timed copy; 0 when profiling is off
+ */
+export function copyTimerStart(): number {
+  return profiling ? performance.now() : 0;
+}
+
+export function recordCopyIn(start: number, bytes: number): void {
+  if (profiling) {
+    copyCounters.copyInMs += performance.now() - start;
+    copyCounters.copyInBytes += bytes;
+  }
+}
+
+export function recordCopyOut(start: number, bytes: number): void {
+  if (profiling) {
+    copyCounters.copyOutMs += performance.now() - start;
+    copyCounters.copyOutBytes += bytes;
+  }
+}
+
+/**
+ * Read bandwidth of the module in GB/s, measured on first use
+ */
+export function measureReadBandwidth(): number {
+  return readBandwidth();
+}
+
+/**
+ * Run a WASM implementation calls times with profiling on and split its
+ * time. Separate from sampling, so the timers never touch measured calls;
+ * setup runs untimed before each call.
+ */
+export function profileWasmCalls(run: () => unknown, setup: (() => void) | undefined, calls: number): WasmCallBreakdown {
+  const bandwidthGBps = measureReadBandwidth();
+  let totalMs = 0;
+
+  resetProfile();
+  setProfilingEnabled(true);
+  try {
+    for (let i = 0; i < calls; i++) {
+      if (setup) {
+        // Setup copies and calls are not part of the measured call
+        setProfilingEnabled(false);
+        setup();
+        setProfilingEnabled(true);
+      }
+      const start = performance.now();
+      run();
+      totalMs += performance.now() - start;
+    }
+  } finally {
+    setProfilingEnabled(false);
+  }
+
+  const copies = readCopyCounters();
+  let kernelMs = 0;
+  let kernelBytes = 0;
+  for (const kernel of readKernelProfile().kernels) {
+    kernelMs += kernel.totalMs;
+    kernelBytes += kernel.bytes;
+  }
+  const copyInMs = copies.copyInMs / calls;
+  const copyOutMs = copies.copyOutMs / calls;
+  const kernelGBps = kernelMs > 0 ? kernelBytes / (kernelMs * 1e6) : 0;
+
+  return {
+    calls,
+    totalMs: totalMs / calls,
+    copyInMs,
+    kernelMs: kernelMs / calls,
+    copyOutMs,
+    otherMs: Math.max(0, (totalMs - copies.copyInMs - kernelMs - copies.copyOutMs) / calls),
+    kernelBytes: kernelBytes / calls,
+    kernelGBps,
+    bandwidthGBps,
+    bandwidthShare: bandwidthGBps > 0 ? kernelGBps / bandwidthGBps : 0,
+  };
+}
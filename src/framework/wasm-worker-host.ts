@@ -0,0 +1,428 @@
+/**
+ * JS vs WASM Benchmark Framework - Worker Kernel Host
+ * Runs kernels on an instance of the module inside a worker (Web Worker in
+ * browsers, worker_threads in Node), so long calls do not block the main
+ * thread. Calls made in the same task are queued and posted as one batch:
+ * one message round trip covers every kernel in it. Typed array arguments
+ * are copied into the worker's heap and passed as (pointer, length). Arrays
+ * on a SharedArrayBuffer reach the worker without a message copy and inOut
+ * results are written straight back into them; others are cloned or, with
+ * transfer, moved to the worker (inOut arrays come back with the result).
+ * Call terminate() when done; a live worker keeps Node running.
+ */
+
+import { median } from './statistics';
+import { compileWasmModule, isNode, type WasmModuleInstance } from './wasm-loader';
+
+export type KernelArray =
+  | Int8Array
+  | Uint8Array
+  | Int16Array
+  | Uint16Array
+  | Int32Array
+  | Uint32Array
+  | Float32Array
+  | Float64Array;
+
+export interface KernelArrayArg {
+  array: KernelArray;
+  // Return the array as the kernel left it (in-place kernels)
+  inOut?: boolean;
+}
+
+// A number is passed as is; an array as its pointer and length
+export type KernelArg = number | KernelArrayArg;
+
+export interface KernelCommand {
+  kernel: string;
+  args: KernelArg[];
+  // ccall return type (default 'number')
+  returns?: 'number' | 'void';
+}
+
+export interface KernelResult {
+  // bigint for i64 results
+  value: number | bigint | null;
+  // inOut arrays in argument order; views of the caller's buffer when shared
+  arrays: KernelArray[];
+}
+
+export interface WorkerCallOptions {
+  // Move non-shared input buffers to the worker instead of cloning them;
+  // the caller's arrays are detached, inOut ones return in the result
+  transfer?: boolean;
+}
+
+type KernelOutcome = { result: KernelResult } | { error: string };
+
+export type WorkerRequest =
+  | { id: number; type: 'init'; module: WebAssembly.Module }
+  | { id: number; type: 'batch'; commands: KernelCommand[] };
+
+export interface WorkerResponse {
+  id: number;
+  outcomes?: KernelOutcome[];
+  // Time spent running the batch inside the worker
+  workerMs?: number;
+  error?: string;
+}
+
+function isShared(array: KernelArray): boolean {
+  return typeof SharedArrayBuffer !== 'undefined' && array.buffer instanceof SharedArrayBuffer;
+}
+
+function bytesOf(array: KernelArray): Uint8Array {
+  return new Uint8Array(array.buffer, array.byteOffset, array.byteLength);
+}
+
+/**
+ * Run one command on module; buffers to transfer back are added to transfer.
+ * Used by the worker, and on the calling thread for comparison.
+ */
+export function runKernelCommand(
+  module: WasmModuleInstance,
+  command: KernelCommand,
+  transfer: Set<ArrayBuffer> = new Set()
+): KernelResult {
+  const argTypes: string[] = [];
+  const argValues: number[] = [];
+  const copies: Array<{ ptr: number; arg: KernelArrayArg }> = [];
+
+  try {
+    for (const arg of command.args) {
+      if (typeof arg === 'number') {
+        argTypes.push('number');
+        argValues.push(arg);
+        continue;
+      }
+      const ptr = module._malloc(Math.max(arg.array.byteLength, 1));
+      if (!ptr) {
+        throw new Error(`Failed to allocate memory in WASM for ${command.kernel}`);
+      }
+      copies.push({ ptr, arg });
+      module.HEAPU8.set(bytesOf(arg.array), ptr);
+      argTypes.push('number', 'number');
+      argValues.push(ptr, arg.array.length);
+    }
+
+    const value = module.ccall(command.kernel, command.returns === 'void' ? null : 'number', argTypes, argValues);
+
+    const arrays: KernelArray[] = [];
+    for (const { ptr, arg } of copies) {
+      if (!arg.inOut) {
+        continue;
+      }
+      // Views are taken after the call, which may have grown memory
+      bytesOf(arg.array).set(module.HEAPU8.subarray(ptr, ptr + arg.array.byteLength));
+      arrays.push(arg.array);
+      if (!isShared(arg.array)) {
+        transfer.add(arg.array.buffer as ArrayBuffer);
+      }
+    }
+    return { value: value ?? null, arrays };
+  } finally {
+    for (const { ptr } of copies) {
+      module._free(ptr);
+    }
+  }
+}
+
+/**
+ * Handle one request inside the worker; the batch runs in order and a
+ * failing command does not stop the rest
+ */
+export function runWorkerBatch(
+  module: WasmModuleInstance,
+  commands: KernelCommand[]
+): { outcomes: KernelOutcome[]; workerMs: number; transfer: ArrayBuffer[] } {
+  const transfer = new Set<ArrayBuffer>();
+  const start = performance.now();
+  const outcomes = commands.map((command): KernelOutcome => {
+    try {
+      return { result: runKernelCommand(module, command, transfer) };
+    } catch (error) {
+      return { error: `${command.kernel}: ${(error as Error).message}` };
+    }
+  });
+  return { outcomes, workerMs: performance.now() - start, transfer: [...transfer] };
+}
+
+// The part of Worker (browser) and worker_threads.Worker the host uses
+interface WorkerHandle {
+  postMessage(message: WorkerRequest, transfer: Transferable[]): void;
+  terminate(): unknown;
+}
+
+interface QueuedCall {
+  command: KernelCommand;
+  transfer: ArrayBuffer[];
+  resolve(result: KernelResult): void;
+  reject(error: Error): void;
+}
+
+// Kept out of the browser bundle; Vite bundles the Web Worker below
+const NODE_WORKER_FILE = './wasm-worker.ts';
+
+async function spawnWorker(onMessage: (response: WorkerResponse) => void, onError: (error: Error) => void): Promise<WorkerHandle> {
+  if (isNode()) {
+    const workerThreads = 'node:worker_threads';
+    const { Worker: NodeWorker } = await import(/* @vite-ignore */ workerThreads);
+    const worker = new NodeWorker(new URL(NODE_WORKER_FILE, import.meta.url));
+    worker.on('message', onMessage);
+    worker.on('error', onError);
+    return worker;
+  }
+  const worker = new Worker(new URL('./wasm-worker.ts', import.meta.url), { type: 'module' });
+  worker.onmessage = event => onMessage(event.data as WorkerResponse);
+  worker.onerror = event => onError(new Error(event.message));
+  return worker;
+}
+
+/**
+ * Client side of a worker-hosted module instance. call() queues a command
+ * and resolves with its result; the queue is posted as one batch at the
+ * end of the current task, or by flush().
+ */
+export class WasmWorkerHost {
+  private worker: WorkerHandle | null = null;
+  private nextId = 1;
+  private queue: QueuedCall[] = [];
+  private flushScheduled = false;
+  private readonly pending = new Map<number, QueuedCall[]>();
+  private readonly requests = new Map<number, { resolve(): void; reject(error: Error): void }>();
+
+  // Batches and commands posted, and their time inside the worker
+  batchCount = 0;
+  commandCount = 0;
+  workerMs = 0;
+
+  private constructor() {}
+
+  /**
+   * Start a worker and instantiate the module there from the module this
+   * thread already compiled (no second fetch or compile)
+   */
+  static async create(): Promise<WasmWorkerHost> {
+    const host = new WasmWorkerHost();
+    const compiled = await compileWasmModule();
+    host.worker = await spawnWorker(
+      response => host.receive(response),
+      error => host.fail(error)
+    );
+    await new Promise<void>((resolve, reject) => {
+      const id = host.nextId++;
+      host.requests.set(id, { resolve, reject });
+      host.worker!.postMessage({ id, type: 'init', module: compiled.module }, []);
+    });
+    return host;
+  }
+
+  /**
+   * Queue one kernel call for the next batch
+   */
+  call(kernel: string, args: KernelArg[], returns: 'number' | 'void' = 'number', options: WorkerCallOptions = {}): Promise<KernelResult> {
+    return this.enqueue({ kernel, args, returns }, options);
+  }
+
+  /**
+   * Queue several commands; they go out in the same batch
+   */
+  submit(commands: KernelCommand[], options: WorkerCallOptions = {}): Promise<KernelResult[]> {
+    return Promise.all(commands.map(command => this.enqueue(command, options)));
+  }
+
+  /**
+   * Post the queued commands now instead of at the end of the task
+   */
+  flush(): void {
+    this.flushScheduled = false;
+    if (this.queue.length === 0) {
+      return;
+    }
+    if (!this.worker) {
+      this.rejectAll(this.queue, new Error('The worker host was terminated'));
+      this.queue = [];
+      return;
+    }
+    const calls = this.queue;
+    this.queue = [];
+    const id = this.nextId++;
+    this.pending.set(id, calls);
+    this.batchCount++;
+    this.commandCount += calls.length;
+    this.worker.postMessage(
+      { id, type: 'batch', commands: calls.map(call => call.command) },
+      [...new Set(calls.flatMap(call => call.transfer))]
+    );
+  }
+
+  terminate(): void {
+    this.worker?.terminate();
+    this.worker = null;
+    this.fail(new Error('The worker host was terminated'));
+  }
+
+  private enqueue(command: KernelCommand, options: WorkerCallOptions): Promise<KernelResult> {
+    const transfer = options.transfer
+      ? command.args.flatMap(arg =>
+        typeof arg === 'number' || isShared(arg.array) ? [] : [arg.array.buffer as ArrayBuffer])
+      : [];
+    return new Promise((resolve, reject) => {
+      this.queue.push({ command, transfer, resolve, reject });
+      if (!this.flushScheduled) {
+        this.flushScheduled = true;
+        queueMicrotask(() => this.flush());
+      }
+    });
+  }
+
+  private receive(response: WorkerResponse): void {
+    const request = this.requests.get(response.id);
+    if (request) {
+      this.requests.delete(response.id);
+      if (response.error) {
+        request.reject(new Error(response.error));
+      } else {
+        request.resolve();
+      }
+      return;
+    }
+
+    const calls = this.pending.get(response.id);
+    if (!calls) {
+      return;
+    }
+    this.pending.delete(response.id);
+    this.workerMs += response.workerMs ?? 0;
+    if (!response.outcomes) {
+      this.rejectAll(calls, new Error(response.error ?? 'Worker batch failed'));
+      return;
+    }
+    calls.forEach((call, index) => {
+      const outcome = response.outcomes![index];
+      if ('result' in outcome) {
+        call.resolve(outcome.result);
+      } else {
+        call.reject(new Error(outcome.error));
+      }
+    });
+  }
+
+  private fail(error: Error): void {
+    for (const request of this.requests.values()) {
+      request.reject(error);
+    }
+    this.requests.clear();
+    for (const calls of this.pending.values()) {
+      this.rejectAll(calls, error);
+    }
+    this.pending.clear();
+  }
+
+  private rejectAll(calls: QueuedCall[], error: Error): void {
+    for (const call of calls) {
+      call.reject(error);
+    }
+  }
+}
+
+// ========== DISPATCH BENCHMARK ==========
+
+export interface WorkerDispatchOptions {
+  // Elements of the uint32 array each sumArray command reads
+  arraySize: number;
+  batchSizes: number[];
+  // Timed batches per batch size
+  rounds: number;
+  // Pass the input on a SharedArrayBuffer (when available) instead of cloning it
+  shared: boolean;
+}
+
+export const DEFAULT_WORKER_DISPATCH_OPTIONS: WorkerDispatchOptions = {
+  arraySize: 100000,
+  batchSizes: [1, 8, 64],
+  rounds: 30,
+  shared: true,
+};
+
+export interface WorkerBatchTiming {
+  batchSize: number;
+  // Median wall time from call() to the last result of a batch
+  wallMs: number;
+  // Median time the batch ran inside the worker
+  workerMs: number;
+  // (wall - worker) / batchSize: messaging and copies per kernel
+  overheadPerKernelMs: number;
+  kernelsPerSecond: number;
+}
+
+export interface WorkerDispatchStats {
+  arraySize: number;
+  shared: boolean;
+  // Median round trip of a one-command batch that moves no data
+  roundTripMs: number;
+  // Median sumArray call (copy in + kernel) on the calling thread
+  localKernelMs: number;
+  batches: WorkerBatchTiming[];
+}
+
+/**
+ * Measure dispatch latency and throughput of host against running the
+ * same sumArray command on this thread's instance (module)
+ */
+export async function measureWorkerDispatch(
+  host: WasmWorkerHost,
+  module: WasmModuleInstance,
+  options: Partial<WorkerDispatchOptions> = {}
+): Promise<WorkerDispatchStats> {
+  const { arraySize, batchSizes, rounds, shared: wantShared } = { ...DEFAULT_WORKER_DISPATCH_OPTIONS, ...options };
+  const shared = wantShared && typeof SharedArrayBuffer !== 'undefined';
+  const input = shared ? new Uint32Array(new SharedArrayBuffer(arraySize * 4)) : new Uint32Array(arraySize);
+  for (let i = 0; i < arraySize; i++) {
+    input[i] = (i * 2654435761) >>> 0;
+  }
+  const command: KernelCommand = { kernel: 'sumArray', args: [{ array: input }] };
+
+  // Warm both sides (worker JIT, first-touch of its heap)
+  await host.submit(Array.from({ length: 4 }, () => command));
+  runKernelCommand(module, command);
+
+  const roundTrips: number[] = [];
+  for (let round = 0; round < rounds; round++) {
+    const start = performance.now();
+    await host.call('getMaxThreads', []);
+    roundTrips.push(performance.now() - start);
+  }
+
+  const localTimes: number[] = [];
+  for (let round = 0; round < rounds; round++) {
+    const start = performance.now();
+    runKernelCommand(module, command);
+    localTimes.push(performance.now() - start);
+  }
+
+  const batches: WorkerBatchTiming[] = [];
+  for (const batchSize of batchSizes) {
+    const commands = Array.from({ length: batchSize }, () => command);
+    const wallTimes: number[] = [];
+    const workerTimes: number[] = [];
+    for (let round = 0; round < rounds; round++) {
+      const workerBefore = host.workerMs;
+      const start = performance.now();
+      await host.submit(commands);
+      wallTimes.push(performance.now() - start);
+      workerTimes.push(host.workerMs - workerBefore);
+    }
+    const wallMs = median(wallTimes);
+    const workerMs = median(workerTimes);
+    batches.push({
+      batchSize,
+      wallMs,
+      workerMs,
+      overheadPerKernelMs: Math.max(0, wallMs - workerMs) / batchSize,
+      kernelsPerSecond: wallMs > 0 ? (batchSize * 1000) / wallMs : 0,
+    });
+  }
+
+  return { arraySize, shared, roundTripMs: median(roundTrips), localKernelMs: median(localTimes), batches };
+}
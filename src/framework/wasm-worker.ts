@@ -0,0 +1,35 @@
+/**
+ * JS vs WASM Benchmark Framework - Kernel Worker
+ * Worker entry of WasmWorkerHost: instantiates the module posted by the
+ * host and runs each batch of kernel commands in order.
+ */
+
+import { getWasmModuleInstance, initWasmModule, isNode } from './wasm-loader';
+import { runWorkerBatch, type WorkerRequest, type WorkerResponse } from './wasm-worker-host';
+
+type Reply = (response: WorkerResponse, transfer?: ArrayBuffer[]) => void;
+
+async function handle(request: WorkerRequest, reply: Reply): Promise<void> {
+  try {
+    if (request.type === 'init') {
+      await initWasmModule({ module: request.module });
+      reply({ id: request.id });
+      return;
+    }
+    const { outcomes, workerMs, transfer } = runWorkerBatch(getWasmModuleInstance(), request.commands);
+    reply({ id: request.id, outcomes, workerMs }, transfer);
+  } catch (error) {
+    reply({ id: request.id, error: (error as Error).message });
+  }
+}
+
+if (isNode()) {
+  const workerThreads = 'node:worker_threads';
+  const { parentPort } = await import(/* @vite-ignore */ workerThreads);
+  parentPort.on('message', (request: WorkerRequest) =>
+    handle(request, (response, transfer = []) => parentPort.postMessage(response, transfer))
+  );
+} else {
+  self.onmessage = (event: MessageEvent<WorkerRequest>) =>
+    handle(event.data, (response, transfer = []) => self.postMessage(response, { transfer }));
+}
@@ -4,17 +4,29 @@
  */
 
 import './style.css';
-import { initWasmModule } from './framework/wasm-loader';
-import { runAllBenchmarks, formatTime, type BenchmarkResult, type TestConfig } from './benchmark';
+import { formatStartupTiming, getWasmStartupTiming, initWasmModule } from './framework/wasm-loader';
+import { formatTime } from './framework/benchmark-runner';
+import type { BenchmarkResult, TestConfig } from './benchmark';
+import type { MeasurementOrder } from './framework/measurement';
 
 // DOM Elements
 let resultsContainer: HTMLDivElement;
 let runButton: HTMLButtonElement;
 let arraySizeSelect: HTMLSelectElement;
 let iterationsSelect: HTMLSelectElement;
+let orderSelect: HTMLSelectElement;
 let progressDiv: HTMLDivElement;
 let statusDiv: HTMLDivElement;
 
+// The benchmark suite (kernel wrappers and TS implementations) is loaded on
+// the first run, so it stays off the startup path
+let benchmarkSuite: Promise<typeof import('./benchmark')> | null = null;
+
+function loadBenchmarkSuite(): Promise<typeof import('./benchmark')> {
+  benchmarkSuite ??= import('./benchmark');
+  return benchmarkSuite;
+}
+
 /**
  * Initialize the application
  */
@@ -26,6 +38,7 @@ async function init() {
   runButton = document.getElementById('runButton') as HTMLButtonElement;
   arraySizeSelect = document.getElementById('arraySize') as HTMLSelectElement;
   iterationsSelect = document.getElementById('iterations') as HTMLSelectElement;
+  orderSelect = document.getElementById('order') as HTMLSelectElement;
   progressDiv = document.getElementById('progress') as HTMLDivElement;
   statusDiv = document.getElementById('status') as HTMLDivElement;
 
@@ -35,7 +48,11 @@ async function init() {
   try {
     // Initialize WASM module (using new ES Module loading method)
     await initWasmModule();
-    updateStatus('✅ WebAssembly module loaded successfully! Ready to test.', 'success');
+    const timing = getWasmStartupTiming();
+    updateStatus(
+      `✅ WebAssembly module loaded in ${timing ? timing.totalMs.toFixed(1) : '?'} ms! Ready to test.`,
+      'success'
+    );
 
     // Enable run button
     runButton.disabled = false;
@@ -81,6 +98,7 @@ async function runTests() {
     arraySize: parseInt(arraySizeSelect.value),
     iterations: parseInt(iterationsSelect.value),
     warmupIterations: 2,
+    order: orderSelect.value as MeasurementOrder,
   };
 
   updateStatus(
@@ -90,6 +108,7 @@ async function runTests() {
 
   try {
     // Run benchmarks
+    const { runAllBenchmarks } = await loadBenchmarkSuite();
     const results = await runAllBenchmarks(config, updateProgress);
 
     // Hide progress
@@ -117,6 +136,7 @@ function displayResults(results: BenchmarkResult[]) {
   const wasmWins = results.filter(r => r.winner === 'WASM').length;
   const tsWins = results.filter(r => r.winner === 'TypeScript').length;
   const avgSpeedup = results.reduce((sum, r) => sum + r.speedup, 0) / results.length;
+  const startup = getWasmStartupTiming();
 
   // Create summary card
   const summaryHTML = `
@@ -140,6 +160,7 @@ function displayResults(results: BenchmarkResult[]) {
           <div class="stat-value">${avgSpeedup.toFixed(2)}x</div>
         </div>
       </div>
+      ${startup ? `<div class="time-detail">WASM startup: ${formatStartupTiming(startup)}</div>` : ''}
     </div>
   `;
 
@@ -169,6 +190,21 @@ function convertToFuncName(testName: string): string {
     .join('');
 }
 
+/**
+ * Copy-in / kernel / copy-out split of the WASM side, when it was profiled
+ */
+function formatWasmProfile(result: BenchmarkResult): string {
+  const profile = result.wasmProfile;
+  if (!profile || profile.kernelMs === 0) {
+    return '';
+  }
+  const bandwidth = profile.kernelGBps > 0
+    ? ` | ${profile.kernelGBps.toFixed(1)} GB/s (${(profile.bandwidthShare * 100).toFixed(0)}% of read bandwidth)`
+    : '';
+  return `<span class="time-detail">copy in: ${formatTime(profile.copyInMs)} | kernel: ${formatTime(profile.kernelMs)} | ` +
+    `copy out: ${formatTime(profile.copyOutMs)}${bandwidth}</span>`;
+}
+
 /**
  * Create a result card for a single test
  */
@@ -218,9 +254,10 @@ function createResultCard(result: BenchmarkResult): HTMLDivElement {
       <div class="result-row">
         <div class="result-label">WASM</div>
         <div class="result-times">
-          <div class="func-name">wasmAlgorithms.${wasmFuncName}()</div>
+          <div class="func-name">${wasmFuncName.includes('.') ? wasmFuncName : `wasmAlgorithms.${wasmFuncName}`}()</div>
           <span class="time-avg">${formatTime(result.wasmAvg)}</span>
           <span class="time-detail">min: ${formatTime(result.wasmMin)} | max: ${formatTime(result.wasmMax)} | median: ${formatTime(result.wasmMedian)}</span>
+          ${formatWasmProfile(result)}
         </div>
       </div>
       <div class="performance-bars">
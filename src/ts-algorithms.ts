@@ -75,6 +75,145 @@ export function countGreaterThan(arr: Uint32Array, threshold: number): number {
   return count;
 }
 
+// ========== TYPED KERNELS ==========
+// Counterparts of the C++ sumArrayI8 ... multiplyArrayF64 family; stores
+// into the typed result wrap (or round) exactly like the WASM lanes
+
+/**
+ * Element types of the typed reduce / map kernels
+ */
+export type NumericArray = Int8Array | Int16Array | Int32Array | Uint32Array | Float32Array | Float64Array;
+
+/**
+ * Sum of any numeric typed array
+ */
+export function sumArrayTyped(arr: NumericArray): number {
+  let sum = 0;
+  for (let i = 0; i < arr.length; i++) {
+    sum += arr[i];
+  }
+  return sum;
+}
+
+// Float min / max skip NaN, like the WASM kernels; all-NaN gives +/-Infinity
+export function findMinTyped(arr: NumericArray): number {
+  if (arr.length === 0) return 0;
+  let min = Infinity;
+  for (let i = 0; i < arr.length; i++) {
+    if (arr[i] < min) {
+      min = arr[i];
+    }
+  }
+  return min;
+}
+
+export function findMaxTyped(arr: NumericArray): number {
+  if (arr.length === 0) return 0;
+  let max = -Infinity;
+  for (let i = 0; i < arr.length; i++) {
+    if (arr[i] > max) {
+      max = arr[i];
+    }
+  }
+  return max;
+}
+
+export function addToArrayTyped<T extends NumericArray>(arr: T, value: number): T {
+  const result = arr.slice() as T;
+  for (let i = 0; i < result.length; i++) {
+    result[i] += value;
+  }
+  return result;
+}
+
+export function multiplyArrayTyped<T extends NumericArray>(arr: T, factor: number): T {
+  const result = arr.slice() as T;
+  // 32-bit products can exceed 2^53; Math.imul keeps the low 32 bits exact
+  const wide = result instanceof Int32Array || result instanceof Uint32Array;
+  for (let i = 0; i < result.length; i++) {
+    result[i] = wide ? Math.imul(result[i], factor) : result[i] * factor;
+  }
+  return result;
+}
+
+// ========== FILTER ENGINE ==========
+// Counterparts of the C++ filter / compaction kernels. Predicate constants
+// are rounded to the column's element type first, as the WASM side
+// receives them; BETWEEN is inclusive and NaN never matches.
+
+export type FilterColumn = Uint32Array | Float32Array;
+
+export type FilterPredicate =
+  | { op: 'gt' | 'lt' | 'eq'; value: number }
+  | { op: 'between'; low: number; high: number }
+  | { op: 'in'; values: ArrayLike<number> };
+
+/**
+ * Row test for a predicate over the given column type
+ */
+export function compilePredicate(predicate: FilterPredicate, column: FilterColumn): (x: number) => boolean {
+  const coerce = column instanceof Float32Array ? Math.fround : (v: number) => v >>> 0;
+  switch (predicate.op) {
+    case 'gt': {
+      const value = coerce(predicate.value);
+      return x => x > value;
+    }
+    case 'lt': {
+      const value = coerce(predicate.value);
+      return x => x < value;
+    }
+    case 'eq': {
+      const value = coerce(predicate.value);
+      return x => x === value;
+    }
+    case 'between': {
+      const low = coerce(predicate.low);
+      const high = coerce(predicate.high);
+      return x => x >= low && x <= high;
+    }
+    case 'in': {
+      const set = new Set(Array.from(predicate.values, coerce));
+      // Set treats NaN as equal to itself; the kernels do not
+      return x => x === x && set.has(x);
+    }
+  }
+}
+
+/**
+ * Values of the rows matching predicate (Array.prototype.filter)
+ */
+export function filterRows<T extends FilterColumn>(column: T, predicate: FilterPredicate): T {
+  return column.filter(compilePredicate(predicate, column)) as T;
+}
+
+/**
+ * Indices of the rows matching predicate, ascending
+ */
+export function selectRows(column: FilterColumn, predicate: FilterPredicate): Uint32Array {
+  const test = compilePredicate(predicate, column);
+  const indices: number[] = [];
+  for (let i = 0; i < column.length; i++) {
+    if (test(column[i])) {
+      indices.push(i);
+    }
+  }
+  return Uint32Array.from(indices);
+}
+
+/**
+ * Indices of the rows matching every predicate (AND of the selections)
+ */
+export function selectRowsWhereAll(column: FilterColumn, predicates: FilterPredicate[]): Uint32Array {
+  const tests = predicates.map(predicate => compilePredicate(predicate, column));
+  const indices: number[] = [];
+  for (let i = 0; i < column.length; i++) {
+    if (tests.every(test => test(column[i]))) {
+      indices.push(i);
+    }
+  }
+  return Uint32Array.from(indices);
+}
+
 /**
  * Helper function for quicksort - partition
  */
@@ -191,6 +330,80 @@ export function binarySearch(arr: Uint32Array, target: number): number {
   return -1;
 }
 
+/**
+ * Binary search for many targets (assumes sorted array)
+ * Returns the first index of each target, or -1
+ */
+export function binarySearchBatch(arr: Uint32Array, targets: Uint32Array): Int32Array {
+  const out = new Int32Array(targets.length);
+  const length = arr.length;
+
+  for (let q = 0; q < targets.length; q++) {
+    const target = targets[q];
+    let base = 0;
+    let n = length;
+
+    while (n > 1) {
+      const half = n >>> 1;
+      base = arr[base + half] < target ? base + half : base;
+      n -= half;
+    }
+
+    const index = length > 0 && arr[base] < target ? base + 1 : base;
+    out[q] = index < length && arr[index] === target ? index : -1;
+  }
+
+  return out;
+}
+
+/**
+ * Permute a sorted array into Eytzinger (BFS) order
+ */
+export function eytzingerLayout(sorted: Uint32Array): Uint32Array {
+  const out = new Uint32Array(sorted.length);
+  let cursor = 0;
+
+  const fill = (node: number): void => {
+    if (node > sorted.length) {
+      return;
+    }
+    fill(node * 2);
+    out[node - 1] = sorted[cursor++];
+    fill(node * 2 + 1);
+  };
+
+  fill(1);
+  return out;
+}
+
+/**
+ * Search for many targets in an Eytzinger-ordered array
+ * Returns each target's index in the layout, or -1
+ */
+export function eytzingerSearchBatch(layout: Uint32Array, targets: Uint32Array): Int32Array {
+  const out = new Int32Array(targets.length);
+  const length = layout.length;
+
+  for (let q = 0; q < targets.length; q++) {
+    const target = targets[q];
+    let k = 1;
+
+    while (k <= length) {
+      k = 2 * k + (layout[k - 1] < target ? 1 : 0);
+    }
+
+    // Drop the trailing right turns (k can exceed 2^31, so stay in float math)
+    while (k % 2 === 1) {
+      k = (k - 1) / 2;
+    }
+    k /= 2;
+
+    out[q] = k !== 0 && layout[k - 1] === target ? k - 1 : -1;
+  }
+
+  return out;
+}
+
 /**
  * Add value to each element (in-place)
  */
@@ -221,6 +434,268 @@ export function countUnique(arr: Uint32Array): number {
   return unique;
 }
 
+/**
+ * Count unique values without sorting: a bitmap over [min, max] when the
+ * range is small, a Set otherwise
+ */
+export function countUniqueExact(arr: Uint32Array): number {
+  if (arr.length === 0) return 0;
+
+  const min = findMin(arr);
+  const range = findMax(arr) - min + 1;
+  if (range > Math.max(1 << 24, arr.length * 8)) {
+    return new Set(arr).size;
+  }
+
+  const words = new Uint32Array(Math.ceil(range / 32));
+  let unique = 0;
+  for (let i = 0; i < arr.length; i++) {
+    const offset = arr[i] - min;
+    const bit = 1 << (offset & 31);
+    if ((words[offset >>> 5] & bit) === 0) {
+      words[offset >>> 5] |= bit;
+      unique++;
+    }
+  }
+  return unique;
+}
+
+/**
+ * murmur3 fmix32 (same hash as the WASM sketch)
+ */
+function mixHash32(h: number): number {
+  h ^= h >>> 16;
+  h = Math.imul(h, 0x85ebca6b);
+  h ^= h >>> 13;
+  h = Math.imul(h, 0xc2b2ae35);
+  h ^= h >>> 16;
+  return h >>> 0;
+}
+
+/**
+ * Approximate unique count with a HyperLogLog sketch of 2^precision registers
+ * (standard error 1.04 / sqrt(2^precision)); precision 4-16, 0 = 14 like the
+ * WASM kernel
+ */
+export function countUniqueApprox(arr: Uint32Array, precision: number = 14): number {
+  if (precision === 0) {
+    precision = 14;
+  }
+  if (!Number.isInteger(precision) || precision < 4 || precision > 16) {
+    throw new Error(`countUniqueApprox: precision must be 4-16, got ${precision}`);
+  }
+  const m = 1 << precision;
+  const registers = new Uint8Array(m);
+  const indexShift = 32 - precision;
+  const guard = 1 << (precision - 1);
+  for (let i = 0; i < arr.length; i++) {
+    const hash = mixHash32(arr[i]);
+    const index = hash >>> indexShift;
+    const rank = Math.clz32((hash << precision) | guard) + 1;
+    if (rank > registers[index]) {
+      registers[index] = rank;
+    }
+  }
+
+  let inverseSum = 0;
+  let zeros = 0;
+  for (let j = 0; j < m; j++) {
+    inverseSum += 2 ** -registers[j];
+    if (registers[j] === 0) zeros++;
+  }
+  const alpha = m === 16 ? 0.673 : m === 32 ? 0.697 : m === 64 ? 0.709 : 0.7213 / (1 + 1.079 / m);
+  const estimate = alpha * m * m / inverseSum;
+  const hashSpace = 2 ** 32;
+  if (estimate <= 2.5 * m && zeros > 0) {
+    return m * Math.log(m / zeros);
+  }
+  if (estimate > hashSpace / 30) {
+    return estimate < hashSpace ? -hashSpace * Math.log(1 - estimate / hashSpace) : hashSpace;
+  }
+  return estimate;
+}
+
+/**
+ * Fixed-width histogram bins over [min, max]; values outside land in the edge bins
+ */
+export interface HistogramOptions {
+  bins: number;
+  min: number;
+  max: number;
+}
+
+/**
+ * Result of computeStats (population variance, as calculateVariance)
+ */
+export interface ArrayStats {
+  count: number;
+  sum: number;
+  min: number;
+  max: number;
+  mean: number;
+  variance: number;
+  histogram: Uint32Array | null;
+}
+
+/**
+ * Sum, min, max, mean, variance and optional histogram in one pass (Welford)
+ */
+export function computeStats(arr: Uint32Array, histogram?: HistogramOptions): ArrayStats {
+  const bins = histogram ? new Uint32Array(histogram.bins) : null;
+  const histogramMin = histogram ? histogram.min : 0;
+  const scale = histogram ? histogram.bins / (histogram.max - histogram.min + 1) : 0;
+  const lastBin = bins ? bins.length - 1 : 0;
+
+  let sum = 0;
+  let min = arr.length > 0 ? arr[0] : 0;
+  let max = arr.length > 0 ? arr[0] : 0;
+  let mean = 0;
+  let m2 = 0;
+
+  for (let i = 0; i < arr.length; i++) {
+    const value = arr[i];
+    sum += value;
+    if (value < min) min = value;
+    if (value > max) max = value;
+
+    const delta = value - mean;
+    mean += delta / (i + 1);
+    m2 += delta * (value - mean);
+
+    if (bins) {
+      const offset = value > histogramMin ? (value - histogramMin) * scale : 0;
+      bins[offset < lastBin ? Math.floor(offset) : lastBin]++;
+    }
+  }
+
+  return {
+    count: arr.length,
+    sum,
+    min,
+    max,
+    mean: arr.length > 0 ? sum / arr.length : 0,
+    variance: arr.length > 0 ? m2 / arr.length : 0,
+    histogram: bins,
+  };
+}
+
+// ========== FUSED PIPELINES ==========
+// Counterpart of the C++ pipeline engine: a chain of elementwise maps and
+// predicates ending in one reduction. Maps wrap modulo 2^32 like the uint32
+// kernels; predicates drop rows from the reduction.
+
+export type PipelineStage =
+  | { op: 'add' | 'multiply' | 'and' | 'xor' | 'shiftRight' | 'min' | 'max'; value: number }
+  | { op: 'gt' | 'lt' | 'eq'; value: number }
+  | { op: 'between'; low: number; high: number };
+
+export type PipelineReduce = 'sum' | 'count' | 'min' | 'max';
+
+export interface PipelineSpec {
+  stages: PipelineStage[];
+  reduce: PipelineReduce;
+}
+
+// Below this a float sum of uint32 values is still exact
+const PIPELINE_SUM_FLUSH = 2 ** 53 - 2 ** 32;
+
+/**
+ * Row function of a stage: the mapped value, or -1 when the row is dropped
+ */
+function compilePipelineStage(stage: PipelineStage): (x: number) => number {
+  switch (stage.op) {
+    case 'add': {
+      const value = stage.value >>> 0;
+      return x => (x + value) >>> 0;
+    }
+    case 'multiply': {
+      const value = stage.value >>> 0;
+      return x => Math.imul(x, value) >>> 0;
+    }
+    case 'and': {
+      const value = stage.value >>> 0;
+      return x => (x & value) >>> 0;
+    }
+    case 'xor': {
+      const value = stage.value >>> 0;
+      return x => (x ^ value) >>> 0;
+    }
+    case 'shiftRight': {
+      const value = stage.value & 31;
+      return x => x >>> value;
+    }
+    case 'min': {
+      const value = stage.value >>> 0;
+      return x => (x < value ? x : value);
+    }
+    case 'max': {
+      const value = stage.value >>> 0;
+      return x => (x > value ? x : value);
+    }
+    default: {
+      const test = compilePredicate(stage, new Uint32Array(0));
+      return x => (test(x) ? x : -1);
+    }
+  }
+}
+
+/**
+ * Run the chain over arr in one loop. sum is a bigint, like sumArray;
+ * min / max are 0 when no row is kept.
+ */
+export function runPipeline(arr: Uint32Array, pipeline: PipelineSpec): number | bigint {
+  const stages = pipeline.stages.map(compilePipelineStage);
+  let kept = 0;
+  let sum = 0;
+  let total = 0n;
+  let min = 0xffffffff;
+  let max = 0;
+
+  rows: for (let i = 0; i < arr.length; i++) {
+    let x = arr[i];
+    for (const stage of stages) {
+      x = stage(x);
+      if (x < 0) {
+        continue rows;
+      }
+    }
+    kept++;
+    sum += x;
+    if (sum >= PIPELINE_SUM_FLUSH) {
+      total += BigInt(sum);
+      sum = 0;
+    }
+    if (x < min) min = x;
+    if (x > max) max = x;
+  }
+
+  switch (pipeline.reduce) {
+    case 'sum':
+      return total + BigInt(sum);
+    case 'count':
+      return kept;
+    case 'min':
+      return kept > 0 ? min : 0;
+    case 'max':
+      return kept > 0 ? max : 0;
+  }
+}
+
+// ========== CALL BOUNDARY ==========
+// Plain-JS counterparts of the boundary* exports: the baseline the fixed
+// cost of a JS -> WASM call is measured against (a JIT may inline them).
+
+export function boundaryEmpty(): void {}
+
+export function boundaryPointerLength(arr: Uint32Array, length: number): number {
+  return length === 0 ? 0 : arr[length - 1];
+}
+
+export function boundaryReturnU64(value: number): bigint {
+  const half = BigInt(value >>> 0);
+  return (half << 32n) | half;
+}
+
 export interface NaryTreeData {
   values: Uint32Array;
   childOffsets: Uint32Array;
@@ -327,6 +802,340 @@ export function sumNaryTreeBfs(tree: NaryTreeData): number {
   return sum;
 }
 
+export interface NaryTreeStats {
+  sum: number;
+  nodeCount: number;
+  maxDepth: number;
+  // Nodes at each depth below levelCapacity
+  levelCounts: Uint32Array;
+}
+
+/**
+ * Value sum, node count, maximum depth and nodes per level of a CSR tree
+ * rooted at node 0, in one BFS
+ */
+export function computeNaryTreeStats(tree: NaryTreeData, levelCapacity: number): NaryTreeStats {
+  const { values, childOffsets, children } = tree;
+  const levelCounts = new Uint32Array(levelCapacity);
+  if (values.length === 0) return { sum: 0, nodeCount: 0, maxDepth: 0, levelCounts };
+
+  let sum = 0;
+  let depth = 0;
+  const queue = new Uint32Array(values.length);
+  let head = 0;
+  let tail = 0;
+  queue[tail++] = 0;
+
+  // Each pass drains one level
+  while (head < tail) {
+    const levelEnd = tail;
+    if (depth < levelCapacity) {
+      levelCounts[depth] = levelEnd - head;
+    }
+    for (; head < levelEnd; head++) {
+      const nodeIndex = queue[head];
+      sum += values[nodeIndex];
+      for (let childCursor = childOffsets[nodeIndex]; childCursor < childOffsets[nodeIndex + 1]; childCursor++) {
+        queue[tail++] = children[childCursor];
+      }
+    }
+    depth++;
+  }
+
+  return { sum, nodeCount: tail, maxDepth: depth - 1, levelCounts };
+}
+
+// ========== TREE LAYOUTS ==========
+// Counterparts of the C++ layout converters and kernels. Binary layouts are
+// described per depth (see TreeLayoutLevel in array_processor.cpp) and
+// padded to the perfect tree of the same height; the preorder layout keeps
+// subtree sizes instead of child lists.
+
+export type TreeLayout = 'veb' | 'blocked';
+
+export interface PreorderTreeData {
+  values: Uint32Array;
+  subtreeSizes: Uint32Array;
+}
+
+const TREE_BLOCK_LEVELS = 4;
+
+interface TreeLayoutTables {
+  levels: number;
+  topDepth: Uint32Array;
+  topSize: Uint32Array;
+  bottomIndexMask: Uint32Array;
+  bottomSize: Uint32Array;
+}
+
+function treeLevels(nodeCount: number): number {
+  return nodeCount === 0 ? 0 : 32 - Math.clz32(nodeCount);
+}
+
+function buildTreeLayoutTables(nodeCount: number, layout: TreeLayout): TreeLayoutTables {
+  const tables: TreeLayoutTables = {
+    levels: treeLevels(nodeCount),
+    topDepth: new Uint32Array(32),
+    topSize: new Uint32Array(32),
+    bottomIndexMask: new Uint32Array(32),
+    bottomSize: new Uint32Array(32),
+  };
+
+  const split = (rootDepth: number, levels: number): void => {
+    if (levels <= 1) return;
+    const bottomLevels = layout === 'veb'
+      ? levels - (levels >>> 1)
+      : levels > TREE_BLOCK_LEVELS ? TREE_BLOCK_LEVELS : 1;
+    const topLevels = levels - bottomLevels;
+    const depth = rootDepth + topLevels;
+    tables.topDepth[depth] = rootDepth;
+    tables.topSize[depth] = 2 ** topLevels - 1;
+    tables.bottomIndexMask[depth] = 2 ** topLevels - 1;
+    tables.bottomSize[depth] = 2 ** bottomLevels - 1;
+    split(rootDepth, topLevels);
+    split(depth, bottomLevels);
+  };
+  split(0, tables.levels);
+  return tables;
+}
+
+/**
+ * Position of a 1-based heap node given its ancestors' positions by depth
+ */
+function treeLayoutChildPosition(tables: TreeLayoutTables, positions: Uint32Array, node: number, depth: number): number {
+  return positions[tables.topDepth[depth]] + tables.topSize[depth] +
+    ((node & tables.bottomIndexMask[depth]) >>> 0) * tables.bottomSize[depth];
+}
+
+/**
+ * Slots of a relaid binary tree (the perfect tree holding nodeCount nodes)
+ */
+export function binaryTreeLayoutCapacity(nodeCount: number): number {
+  return 2 ** treeLevels(nodeCount) - 1;
+}
+
+/**
+ * Relayout a heap-ordered binary tree in van Emde Boas or blocked order;
+ * slots of missing last-level nodes are zero
+ */
+export function relayoutBinaryTree(values: Uint32Array, layout: TreeLayout): Uint32Array {
+  const tables = buildTreeLayoutTables(values.length, layout);
+  const out = new Uint32Array(binaryTreeLayoutCapacity(values.length));
+  for (let i = 0; i < values.length; i++) {
+    let node = i + 1;
+    let depth = 31 - Math.clz32(node);
+    let position = 0;
+    while (depth > 0) {
+      const top = tables.topDepth[depth];
+      position += tables.topSize[depth] + ((node & tables.bottomIndexMask[depth]) >>> 0) * tables.bottomSize[depth];
+      node >>>= depth - top;
+      depth = top;
+    }
+    out[position] = values[i];
+  }
+  return out;
+}
+
+/**
+ * Preorder DFS sum over a relaid binary tree (same visiting order as
+ * sumBinaryTreeDfs)
+ */
+export function sumBinaryTreeLayoutDfs(layoutValues: Uint32Array, nodeCount: number, layout: TreeLayout): number {
+  if (nodeCount === 0) return 0;
+
+  const tables = buildTreeLayoutTables(nodeCount, layout);
+  const positions = new Uint32Array(32);
+  const stackNodes = new Uint32Array(33);
+  const stackPositions = new Uint32Array(33);
+  const stackDepths = new Uint8Array(33);
+  let stackSize = 1;
+  stackNodes[0] = 1;
+
+  let sum = 0;
+  while (stackSize > 0) {
+    stackSize--;
+    const node = stackNodes[stackSize];
+    const depth = stackDepths[stackSize];
+    positions[depth] = stackPositions[stackSize];
+    sum += layoutValues[positions[depth]];
+
+    const left = node * 2;
+    if (left > nodeCount) continue;
+    if (left + 1 <= nodeCount) {
+      stackNodes[stackSize] = left + 1;
+      stackPositions[stackSize] = treeLayoutChildPosition(tables, positions, left + 1, depth + 1);
+      stackDepths[stackSize++] = depth + 1;
+    }
+    stackNodes[stackSize] = left;
+    stackPositions[stackSize] = treeLayoutChildPosition(tables, positions, left, depth + 1);
+    stackDepths[stackSize++] = depth + 1;
+  }
+
+  return sum;
+}
+
+/**
+ * Sum the values on the root-to-node path of every target (heap indices)
+ * in a heap-ordered binary tree
+ */
+export function sumBinaryTreePaths(values: Uint32Array, targets: Uint32Array): number {
+  let sum = 0;
+  for (let i = 0; i < targets.length; i++) {
+    if (targets[i] >= values.length) continue;
+    const node = targets[i] + 1;
+    const depth = 31 - Math.clz32(node);
+    for (let d = 0; d <= depth; d++) {
+      sum += values[(node >>> (depth - d)) - 1];
+    }
+  }
+  return sum;
+}
+
+/**
+ * sumBinaryTreePaths over a relaid binary tree
+ */
+export function sumBinaryTreeLayoutPaths(
+  layoutValues: Uint32Array,
+  nodeCount: number,
+  layout: TreeLayout,
+  targets: Uint32Array
+): number {
+  if (nodeCount === 0) return 0;
+
+  const tables = buildTreeLayoutTables(nodeCount, layout);
+  const positions = new Uint32Array(32);
+  let sum = 0;
+  for (let i = 0; i < targets.length; i++) {
+    if (targets[i] >= nodeCount) continue;
+    const node = targets[i] + 1;
+    const depth = 31 - Math.clz32(node);
+    sum += layoutValues[0];
+    for (let d = 1; d <= depth; d++) {
+      positions[d] = treeLayoutChildPosition(tables, positions, node >>> (depth - d), d);
+      sum += layoutValues[positions[d]];
+    }
+  }
+  return sum;
+}
+
+/**
+ * Relayout a CSR tree rooted at node 0 in DFS preorder with subtree sizes:
+ * node p's first child is p + 1 and each next sibling starts
+ * subtreeSizes[c] after the previous sibling c
+ */
+export function relayoutNaryTreePreorder(tree: NaryTreeData): PreorderTreeData {
+  const { values, childOffsets, children } = tree;
+  const nodeCount = values.length;
+  const stack = new Uint32Array(nodeCount);
+  const stackParents = new Uint32Array(nodeCount);
+  const parents = new Uint32Array(nodeCount);
+  const outValues = new Uint32Array(nodeCount);
+  const subtreeSizes = new Uint32Array(nodeCount);
+  if (nodeCount === 0) return { values: outValues, subtreeSizes };
+
+  let stackSize = 1;
+  let written = 0;
+  while (stackSize > 0) {
+    stackSize--;
+    const nodeIndex = stack[stackSize];
+    parents[written] = stackParents[stackSize];
+    outValues[written] = values[nodeIndex];
+    subtreeSizes[written] = 1;
+
+    const start = childOffsets[nodeIndex];
+    for (let childCursor = childOffsets[nodeIndex + 1]; childCursor > start; childCursor--) {
+      stack[stackSize] = children[childCursor - 1];
+      stackParents[stackSize++] = written;
+    }
+    written++;
+  }
+
+  for (let position = written - 1; position > 0; position--) {
+    subtreeSizes[parents[position]] += subtreeSizes[position];
+  }
+  return { values: outValues.subarray(0, written), subtreeSizes: subtreeSizes.subarray(0, written) };
+}
+
+/**
+ * BFS sum over a preorder tree (same visiting order as sumNaryTreeBfs)
+ */
+export function sumNaryTreePreorderBfs(tree: PreorderTreeData): number {
+  const { values, subtreeSizes } = tree;
+  if (values.length === 0) return 0;
+
+  let sum = 0;
+  const queue = new Uint32Array(values.length);
+  let head = 0;
+  let tail = 0;
+  queue[tail++] = 0;
+
+  while (head < tail) {
+    const position = queue[head++];
+    sum += values[position];
+
+    const end = position + subtreeSizes[position];
+    for (let child = position + 1; child < end; child += subtreeSizes[child]) {
+      queue[tail++] = child;
+    }
+  }
+
+  return sum;
+}
+
+/**
+ * Sum of every subtree of a CSR tree rooted at node 0, by node index
+ */
+export function subtreeSumsNary(tree: NaryTreeData, out: Float64Array): number {
+  const { values, childOffsets, children } = tree;
+  if (values.length === 0) return 0;
+
+  const stack = new Uint32Array(values.length);
+  const order = new Uint32Array(values.length);
+  let stackSize = 1;
+  let visited = 0;
+
+  while (stackSize > 0) {
+    const nodeIndex = stack[--stackSize];
+    order[visited++] = nodeIndex;
+
+    const start = childOffsets[nodeIndex];
+    for (let childCursor = childOffsets[nodeIndex + 1]; childCursor > start; childCursor--) {
+      stack[stackSize++] = children[childCursor - 1];
+    }
+  }
+
+  // Reverse preorder reaches every child before its parent
+  for (let i = visited - 1; i >= 0; i--) {
+    const nodeIndex = order[i];
+    let sum = values[nodeIndex];
+    for (let childCursor = childOffsets[nodeIndex]; childCursor < childOffsets[nodeIndex + 1]; childCursor++) {
+      sum += out[children[childCursor]];
+    }
+    out[nodeIndex] = sum;
+  }
+
+  return out[0];
+}
+
+/**
+ * Sum of every subtree of a preorder tree, by preorder position
+ */
+export function subtreeSumsPreorder(tree: PreorderTreeData, out: Float64Array): number {
+  const { values, subtreeSizes } = tree;
+  if (values.length === 0) return 0;
+
+  for (let node = values.length - 1; node >= 0; node--) {
+    let sum = values[node];
+    const end = node + subtreeSizes[node];
+    for (let child = node + 1; child < end; child += subtreeSizes[child]) {
+      sum += out[child];
+    }
+    out[node] = sum;
+  }
+
+  return out[0];
+}
+
 export interface StringMapData {
   keys: string[];
   values: Uint32Array;
@@ -414,6 +1223,108 @@ export function transformVectors(vectors: Float32Array, matrix: Float32Array): F
   return result;
 }
 
+/**
+ * Structure-of-arrays points: one array per component
+ */
+export interface SoAVectors {
+  x: Float32Array;
+  y: Float32Array;
+  z: Float32Array;
+  w?: Float32Array;
+}
+
+/**
+ * Split interleaved [x,y,z,...] points into component arrays
+ */
+export function aosToSoa(vectors: Float32Array): SoAVectors {
+  const count = vectors.length / 3;
+  const soa = { x: new Float32Array(count), y: new Float32Array(count), z: new Float32Array(count) };
+
+  for (let i = 0; i < count; i++) {
+    soa.x[i] = vectors[i * 3 + 0];
+    soa.y[i] = vectors[i * 3 + 1];
+    soa.z[i] = vectors[i * 3 + 2];
+  }
+
+  return soa;
+}
+
+/**
+ * Interleave component arrays back into [x,y,z,...] points
+ */
+export function soaToAos(soa: SoAVectors): Float32Array {
+  const count = soa.x.length;
+  const vectors = new Float32Array(count * 3);
+
+  for (let i = 0; i < count; i++) {
+    vectors[i * 3 + 0] = soa.x[i];
+    vectors[i * 3 + 1] = soa.y[i];
+    vectors[i * 3 + 2] = soa.z[i];
+  }
+
+  return vectors;
+}
+
+function transformSoaRange(soa: SoAVectors, matrix: Float32Array, matrixOffset: number, start: number, end: number): void {
+  const { x: xs, y: ys, z: zs } = soa;
+  const m = matrix;
+  const o = matrixOffset;
+
+  for (let i = start; i < end; i++) {
+    const x = xs[i];
+    const y = ys[i];
+    const z = zs[i];
+
+    xs[i] = m[o + 0] * x + m[o + 4] * y + m[o + 8]  * z + m[o + 12];
+    ys[i] = m[o + 1] * x + m[o + 5] * y + m[o + 9]  * z + m[o + 13];
+    zs[i] = m[o + 2] * x + m[o + 6] * y + m[o + 10] * z + m[o + 14];
+  }
+}
+
+/**
+ * Apply 4x4 transformation matrix to SoA points (in-place, assuming w = 1)
+ */
+export function transformVectorsSoA(soa: SoAVectors, matrix: Float32Array): SoAVectors {
+  transformSoaRange(soa, matrix, 0, 0, soa.x.length);
+  return soa;
+}
+
+/**
+ * Apply full 4x4 matrix to homogeneous SoA points (in-place, w is read and written)
+ */
+export function transformVectors4SoA(soa: SoAVectors, matrix: Float32Array): SoAVectors {
+  const { x: xs, y: ys, z: zs } = soa;
+  const ws = soa.w;
+  if (!ws) {
+    throw new Error('transformVectors4SoA requires a w component');
+  }
+
+  for (let i = 0; i < xs.length; i++) {
+    const x = xs[i];
+    const y = ys[i];
+    const z = zs[i];
+    const w = ws[i];
+
+    xs[i] = matrix[0] * x + matrix[4] * y + matrix[8]  * z + matrix[12] * w;
+    ys[i] = matrix[1] * x + matrix[5] * y + matrix[9]  * z + matrix[13] * w;
+    zs[i] = matrix[2] * x + matrix[6] * y + matrix[10] * z + matrix[14] * w;
+    ws[i] = matrix[3] * x + matrix[7] * y + matrix[11] * z + matrix[15] * w;
+  }
+
+  return soa;
+}
+
+/**
+ * Transform many objects (in-place): points [offsets[k], offsets[k + 1]) get matrix k
+ * `matrices` holds the 4x4 matrices back to back (16 floats each)
+ */
+export function transformVectorsSoABatch(soa: SoAVectors, matrices: Float32Array, offsets: Uint32Array): SoAVectors {
+  for (let k = 0; k + 1 < offsets.length; k++) {
+    transformSoaRange(soa, matrices, k * 16, offsets[k], offsets[k + 1]);
+  }
+  return soa;
+}
+
 /**
  * Create transformation matrix (scale, rotate, translate)
  */
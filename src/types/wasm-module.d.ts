@@ -24,11 +24,20 @@ declare module '*/wasm/array_processor.js' {
       returnType: string | null,
       argTypes: string[]
     ): (...args: any[]) => any;
+    HEAPU8: Uint8Array;
     HEAPF32: Float32Array;
     HEAP32: Int32Array;
     HEAPU32: Uint32Array;
   }
 
-  function createWasmModule(): Promise<WasmModule>;
+  // Module overrides; instantiateWasm replaces Emscripten's own fetch and compile
+  interface WasmModuleOptions {
+    instantiateWasm?(
+      imports: WebAssembly.Imports,
+      receiveInstance: (instance: WebAssembly.Instance, module: WebAssembly.Module) => void
+    ): WebAssembly.Exports | {};
+  }
+
+  function createWasmModule(options?: WasmModuleOptions): Promise<WasmModule>;
   export default createWasmModule;
 }
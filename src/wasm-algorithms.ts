@@ -1,13 +1,39 @@
 /**
  */
 
-import { getWasmModuleInstance } from './framework/wasm-loader';
-import type { NaryTreeData, NumberMapData, StringMapData } from './ts-algorithms';
+import { getWasmModuleInstance, lazyKernelGroup } from './framework/wasm-loader';
+import { WasmBuffer, type WasmBufferArray } from './framework/wasm-buffer';
+import { copyTimerStart, recordCopyIn, recordCopyOut } from './framework/wasm-profile';
+import {
+  bindExport,
+  type ExportNoArgs,
+  type ExportPtrLen,
+  type ExportPtrLenScalar,
+  type ExportPtrLenScalars,
+} from './framework/wasm-bridge';
+import type {
+  ArrayStats,
+  FilterColumn,
+  FilterPredicate,
+  HistogramOptions,
+  NaryTreeData,
+  NaryTreeStats,
+  NumberMapData,
+  NumericArray,
+  PipelineReduce,
+  PipelineSpec,
+  PipelineStage,
+  StringMapData,
+  TreeLayout,
+} from './ts-algorithms';
 
 function getWasmModule() {
   return getWasmModuleInstance();
 }
 
+// The first call starts the thread pool; later _MT calls reuse it
+const maxThreads = lazyKernelGroup('threads', module => module.ccall('getMaxThreads', 'number', [], []) as number);
+
 function toNumber(value: number | bigint): number {
   return Number(value);
 }
@@ -27,11 +53,13 @@ export function allocateArray(arr: Uint32Array): number {
   if (!ptr) {
     throw new Error('Failed to allocate memory in WASM');
   }
+  const copyStart = copyTimerStart();
 
   // Copy data from JS array to WASM memory using setValue
   for (let i = 0; i < arr.length; i++) {
     module.setValue(ptr + i * 4, arr[i], 'i32');
   }
+  recordCopyIn(copyStart, byteSize);
 
   return ptr;
 }
@@ -44,10 +72,12 @@ export function allocateArrayEx(arr: Uint32Array): number {
   if (!ptr) {
     throw new Error('Failed to allocate memory in WASM');
   }
+  const copyStart = copyTimerStart();
   const start = ptr / module.HEAPU32.BYTES_PER_ELEMENT;
   const end = (ptr + byteSize) / module.HEAPU32.BYTES_PER_ELEMENT;
   const arrS = module.HEAPU32.subarray(start, end);
   arrS.set(arr);
+  recordCopyIn(copyStart, byteSize);
 
   return ptr;
 }
@@ -64,23 +94,27 @@ export function freeArray(ptr: number): void {
  */
 export function readArray(ptr: number, length: number): Uint32Array {
   const module = getWasmModule();
+  const copyStart = copyTimerStart();
   const result = new Uint32Array(length);
 
   for (let i = 0; i < length; i++) {
     result[i] = module.getValue(ptr + i * 4, 'i32');
   }
+  recordCopyOut(copyStart, result.byteLength);
 
   return result;
 }
 
 export function readArrayEx(ptr: number, length: number): Uint32Array {
   const module = getWasmModule();
+  const copyStart = copyTimerStart();
   const result = new Uint32Array(length);
   const start = ptr / module.HEAPU32.BYTES_PER_ELEMENT;
   const end = start + length;
   const arrs = module.HEAPU32.subarray(start, end)
 
   result.set(arrs);
+  recordCopyOut(copyStart, result.byteLength);
 
   return result;
 }
@@ -94,11 +128,13 @@ export function allocateFloatArray(arr: Float32Array): number {
   if (!ptr) {
     throw new Error('Failed to allocate memory in WASM');
   }
+  const copyStart = copyTimerStart();
 
   // Copy data from JS array to WASM memory using setValue
   for (let i = 0; i < arr.length; i++) {
     module.setValue(ptr + i * 4, arr[i], 'float');
   }
+  recordCopyIn(copyStart, byteSize);
 
   return ptr;
 }
@@ -111,10 +147,12 @@ export function allocateFloatArrayEx(arr: Float32Array): number {
   if (!ptr) {
     throw new Error('Failed to allocate memory in WASM');
   }
+  const copyStart = copyTimerStart();
   const start = (ptr) / module.HEAPF32.BYTES_PER_ELEMENT;
   const end = (ptr + byteSize) / module.HEAPF32.BYTES_PER_ELEMENT;
   const arrS = module.HEAPF32.subarray(start, end);
   arrS.set(arr);
+  recordCopyIn(copyStart, byteSize);
   return ptr;
 }
 
@@ -123,20 +161,24 @@ export function allocateFloatArrayEx(arr: Float32Array): number {
  */
 export function readFloatArray(ptr: number, length: number): Float32Array {
   const module = getWasmModule();
+  const copyStart = copyTimerStart();
   const result = new Float32Array(length);
 
   for (let i = 0; i < length; i++) {
     result[i] = module.getValue(ptr + i * 4, 'float');
   }
+  recordCopyOut(copyStart, result.byteLength);
 
   return result;
 }
 
 export function readFloatArrayEx(ptr: number, length: number): Float32Array {
   const module = getWasmModule();
+  const copyStart = copyTimerStart();
   const result = new Float32Array(length);
   const heap_s = new Float32Array(module.HEAPF32.buffer, ptr, length);
   result.set(heap_s)
+  recordCopyOut(copyStart, result.byteLength);
 
   return result;
 }
@@ -168,17 +210,48 @@ function callBinaryTreeSum(functionName: string, tree: PreparedWasmBinaryTree):
   return toNumber(sum);
 }
 
-function callNaryTreeSum(functionName: string, tree: PreparedWasmNaryTree): number {
+// threads is passed to the *_MT kernels only
+function callNaryTreeSum(functionName: string, tree: PreparedWasmNaryTree, threads?: number): number {
   const module = getWasmModule();
-  const sum = module.ccall(
-    functionName,
-    'number',
-    ['number', 'number', 'number', 'number'],
-    [tree.valuesPtr, tree.childOffsetsPtr, tree.childrenPtr, tree.nodeCount]
-  );
+  const args = [tree.valuesPtr, tree.childOffsetsPtr, tree.childrenPtr, tree.nodeCount];
+  const sum = threads === undefined
+    ? module.ccall(functionName, 'number', ['number', 'number', 'number', 'number'], args)
+    : module.ccall(functionName, 'number', ['number', 'number', 'number', 'number', 'number'], [...args, threads]);
   return toNumber(sum);
 }
 
+// NaryTreeStats in array_processor.cpp: sum, nodeCount, maxDepth
+const NARY_TREE_STATS_BYTES = 3 * 8;
+
+function callNaryTreeStats(
+  functionName: string,
+  tree: PreparedWasmNaryTree,
+  levelCapacity: number,
+  threads: number
+): NaryTreeStats {
+  const module = getWasmModule();
+  const statsPtr = assertPointer(module._malloc(NARY_TREE_STATS_BYTES + levelCapacity * 4), 'tree stats');
+  const levelsPtr = levelCapacity > 0 ? statsPtr + NARY_TREE_STATS_BYTES : 0;
+  try {
+    module.ccall(
+      functionName,
+      null,
+      ['number', 'number', 'number', 'number', 'number', 'number', 'number', 'number'],
+      [tree.valuesPtr, tree.childOffsetsPtr, tree.childrenPtr, tree.nodeCount, statsPtr, levelsPtr, levelCapacity, threads]
+    );
+    const heap = module.HEAPF64;
+    const base = statsPtr / heap.BYTES_PER_ELEMENT;
+    return {
+      sum: heap[base],
+      nodeCount: heap[base + 1],
+      maxDepth: heap[base + 2],
+      levelCounts: levelCapacity > 0 ? readArrayEx(levelsPtr, levelCapacity) : new Uint32Array(0),
+    };
+  } finally {
+    module._free(statsPtr);
+  }
+}
+
 function createPreparedBinaryTree(values: Uint32Array): PreparedWasmBinaryTree {
   const valuesPtr = allocateArrayEx(values);
   let disposed = false;
@@ -263,6 +336,11 @@ export interface PreparedWasmNumberTreeMap {
   dispose: () => void;
 }
 
+export interface NumberTreeMapEntry {
+  key: number;
+  value: number;
+}
+
 const textEncoder = new TextEncoder();
 
 function createStringMapEncoding(data: StringMapData): { keyBytes: Uint8Array; keyOffsets: Uint32Array } {
@@ -296,7 +374,7 @@ function allocateBytes(bytes: Uint8Array): number {
   if (!ptr) {
     throw new Error('Failed to allocate memory in WASM');
   }
-  (module as typeof module & { HEAPU8: Uint8Array }).HEAPU8.set(bytes, ptr);
+  module.HEAPU8.set(bytes, ptr);
   return ptr;
 }
 
@@ -310,7 +388,11 @@ function callStringMapData(functionName: string, data: PreparedWasmStringMapData
   return toNumber(result);
 }
 
-function createPreparedStringMapData(data: StringMapData): PreparedWasmStringMapData {
+function createPreparedStringMapDataWith(
+  data: StringMapData,
+  createFunctionName: string,
+  freeFunctionName: string
+): PreparedWasmStringMapData {
   if (data.values.length !== data.keys.length) {
     throw new Error('StringMapData values length must match keys length');
   }
@@ -326,14 +408,14 @@ function createPreparedStringMapData(data: StringMapData): PreparedWasmStringMap
     keyOffsetsPtr = allocateArrayEx(keyOffsets);
     valuesPtr = data.values.length > 0 ? allocateArrayEx(data.values) : 0;
     dataPtr = assertPointer(toNumber(getWasmModule().ccall(
-      'createStringMapData',
+      createFunctionName,
       'number',
       ['number', 'number', 'number', 'number'],
       [keyBytesPtr, keyOffsetsPtr, valuesPtr, data.keys.length]
     )), 'string map data');
   } catch (error) {
     if (dataPtr) {
-      getWasmModule().ccall('freeStringMapData', null, ['number'], [dataPtr]);
+      getWasmModule().ccall(freeFunctionName, null, ['number'], [dataPtr]);
     }
     if (valuesPtr) freeArray(valuesPtr);
     if (keyOffsetsPtr) freeArray(keyOffsetsPtr);
@@ -350,7 +432,7 @@ function createPreparedStringMapData(data: StringMapData): PreparedWasmStringMap
     count: data.keys.length,
     dispose: () => {
       if (!disposed) {
-        getWasmModule().ccall('freeStringMapData', null, ['number'], [dataPtr]);
+        getWasmModule().ccall(freeFunctionName, null, ['number'], [dataPtr]);
         if (valuesPtr) freeArray(valuesPtr);
         freeArray(keyOffsetsPtr);
         if (keyBytesPtr) freeArray(keyBytesPtr);
@@ -360,6 +442,14 @@ function createPreparedStringMapData(data: StringMapData): PreparedWasmStringMap
   };
 }
 
+function createPreparedStringMapData(data: StringMapData): PreparedWasmStringMapData {
+  return createPreparedStringMapDataWith(data, 'createStringMapData', 'freeStringMapData');
+}
+
+function createPreparedFlatStringMapData(data: StringMapData): PreparedWasmStringMapData {
+  return createPreparedStringMapDataWith(data, 'createFlatStringMapData', 'freeFlatStringMapData');
+}
+
 function createPreparedStringMapWith(
   data: PreparedWasmStringMapData,
   prepareFunctionName: string,
@@ -389,6 +479,10 @@ function createPreparedStringMap(data: PreparedWasmStringMapData): PreparedWasmS
   return createPreparedStringMapWith(data, 'prepareStringMap', 'freePreparedStringMap', 'prepared string map');
 }
 
+function createPreparedFlatStringMap(data: PreparedWasmStringMapData): PreparedWasmStringMap {
+  return createPreparedStringMapWith(data, 'prepareFlatStringMap', 'freePreparedFlatStringMap', 'prepared flat string map');
+}
+
 function createPreparedNumberTreeMapData(data: NumberMapData): PreparedWasmNumberTreeMapData {
   if (data.values.length !== data.keys.length) {
     throw new Error('NumberMapData values length must match keys length');
@@ -450,6 +544,85 @@ function createPreparedNumberTreeMap(data: PreparedWasmNumberTreeMapData): Prepa
   return createPreparedNumberMapWith(data, 'prepareNumberTreeMap', 'freePreparedNumberTreeMap', 'prepared number tree map');
 }
 
+function callSearchBatch(functionName: string, table: Uint32Array, targets: Uint32Array): Int32Array {
+  const tablePtr = allocateArrayEx(table);
+  const targetsPtr = allocateArrayEx(targets);
+  const outPtr = getWasmModule()._malloc(Math.max(targets.length, 1) * 4);
+  try {
+    getWasmModule().ccall(
+      functionName,
+      null,
+      ['number', 'number', 'number', 'number', 'number'],
+      [tablePtr, table.length, targetsPtr, targets.length, outPtr]
+    );
+    return new Int32Array(readArrayEx(outPtr, targets.length).buffer);
+  } finally {
+    freeArray(tablePtr);
+    freeArray(targetsPtr);
+    freeArray(outPtr);
+  }
+}
+
+// ArrayStats in array_processor.cpp: count, sum, min, max, mean, m2, variance
+const STATS_BYTES = 7 * 8;
+const STATS_ARGS = ['number', 'number', 'number', 'number', 'number', 'number', 'number'];
+
+function readStats(statsPtr: number, binsPtr: number, binCount: number): ArrayStats {
+  const heap = getWasmModule().HEAPF64;
+  const base = statsPtr / heap.BYTES_PER_ELEMENT;
+  return {
+    count: heap[base],
+    sum: heap[base + 1],
+    min: heap[base + 2],
+    max: heap[base + 3],
+    mean: heap[base + 4],
+    variance: heap[base + 6],
+    histogram: binCount > 0 ? readArrayEx(binsPtr, binCount) : null,
+  };
+}
+
+/**
+ * Run computeStats / computeStats_MT on an array already in WASM memory
+ */
+function callComputeStats(
+  functionName: string,
+  arrayPtr: number,
+  length: number,
+  histogram?: HistogramOptions,
+  threads?: number
+): ArrayStats {
+  const module = getWasmModule();
+  const binCount = histogram ? histogram.bins : 0;
+  const statsPtr = assertPointer(module._malloc(STATS_BYTES + binCount * 4), 'stats');
+  const binsPtr = binCount > 0 ? statsPtr + STATS_BYTES : 0;
+  try {
+    const args = [arrayPtr, length, statsPtr, binsPtr, binCount, histogram?.min ?? 0, histogram?.max ?? 0];
+    if (threads === undefined) {
+      module.ccall(functionName, null, STATS_ARGS, args);
+    } else {
+      module.ccall(functionName, null, [...STATS_ARGS, 'number'], [...args, threads]);
+    }
+    return readStats(statsPtr, binsPtr, binCount);
+  } finally {
+    module._free(statsPtr);
+  }
+}
+
+const HLL_DEFAULT_PRECISION = 14;
+
+function callCountUniqueApprox(arrayPtr: number, length: number, precision: number): number {
+  const estimate = getWasmModule().ccall(
+    'countUniqueApprox',
+    'number',
+    ['number', 'number', 'number'],
+    [arrayPtr, length, precision]
+  );
+  if (estimate < 0) {
+    throw new Error(`countUniqueApprox: precision must be 4-16, got ${precision}`);
+  }
+  return estimate;
+}
+
 export const wasmAlgorithms = {
   /**
    */
@@ -480,7 +653,7 @@ export const wasmAlgorithms = {
         'number',
         ['number', 'number'],
         [ptr, arr.length]
-      );
+      ) >>> 0;
     } finally {
       freeArray(ptr);
     }
@@ -497,7 +670,7 @@ export const wasmAlgorithms = {
         'number',
         ['number', 'number'],
         [ptr, arr.length]
-      );
+      ) >>> 0;
     } finally {
       freeArray(ptr);
     }
@@ -573,6 +746,24 @@ export const wasmAlgorithms = {
     }
   },
 
+  /**
+   */
+  radixSortU32(arr: Uint32Array): Uint32Array {
+    const ptr = allocateArrayEx(arr);
+    try {
+      const module = getWasmModule();
+      module.ccall(
+        'radixSortU32',
+        null,
+        ['number', 'number'],
+        [ptr, arr.length]
+      );
+      return readArrayEx(ptr, arr.length);
+    } finally {
+      freeArray(ptr);
+    }
+  },
+
   /**
    */
   reverseArray(arr: Uint32Array): Uint32Array {
@@ -625,6 +816,41 @@ export const wasmAlgorithms = {
     }
   },
 
+  /**
+   * Search for every target in one call; -1 marks a miss
+   */
+  binarySearchBatch(arr: Uint32Array, targets: Uint32Array): Int32Array {
+    return callSearchBatch('binarySearchBatch', arr, targets);
+  },
+
+  /**
+   * Permute a sorted array into Eytzinger (BFS) order
+   */
+  eytzingerLayout(sorted: Uint32Array): Uint32Array {
+    const sortedPtr = allocateArrayEx(sorted);
+    const outPtr = getWasmModule()._malloc(Math.max(sorted.length, 1) * 4);
+    try {
+      const module = getWasmModule();
+      module.ccall(
+        'eytzingerLayout',
+        null,
+        ['number', 'number', 'number'],
+        [sortedPtr, sorted.length, outPtr]
+      );
+      return readArrayEx(outPtr, sorted.length);
+    } finally {
+      freeArray(sortedPtr);
+      freeArray(outPtr);
+    }
+  },
+
+  /**
+   * Search an Eytzinger-ordered array; results index the layout, -1 marks a miss
+   */
+  eytzingerSearchBatch(layout: Uint32Array, targets: Uint32Array): Int32Array {
+    return callSearchBatch('eytzingerSearchBatch', layout, targets);
+  },
+
   /**
    */
   addToArray(arr: Uint32Array, value: number): Uint32Array {
@@ -660,6 +886,36 @@ export const wasmAlgorithms = {
     }
   },
 
+  /**
+   * Exact unique count without sorting (bitmap or hash set)
+   */
+  countUniqueExact(arr: Uint32Array): number {
+    const ptr = allocateArrayEx(arr);
+    try {
+      const module = getWasmModule();
+      return module.ccall(
+        'countUniqueExact',
+        'number',
+        ['number', 'number'],
+        [ptr, arr.length]
+      ) >>> 0;
+    } finally {
+      freeArray(ptr);
+    }
+  },
+
+  /**
+   * HyperLogLog estimate of the unique count (precision 4-16)
+   */
+  countUniqueApprox(arr: Uint32Array, precision: number = HLL_DEFAULT_PRECISION): number {
+    const ptr = allocateArrayEx(arr);
+    try {
+      return callCountUniqueApprox(ptr, arr.length, precision);
+    } finally {
+      freeArray(ptr);
+    }
+  },
+
   prepareBinaryTree(values: Uint32Array): PreparedWasmBinaryTree {
     return createPreparedBinaryTree(values);
   },
@@ -759,6 +1015,45 @@ export const wasmAlgorithms = {
     return toNumber(result);
   },
 
+  prepareFlatStringMapData(data: StringMapData): PreparedWasmStringMapData {
+    return createPreparedFlatStringMapData(data);
+  },
+
+  prepareFlatStringMap(data: PreparedWasmStringMapData): PreparedWasmStringMap {
+    return createPreparedFlatStringMap(data);
+  },
+
+  resetFlatStringMap(map: PreparedWasmStringMap): void {
+    const next = createPreparedFlatStringMap(map.data);
+    map.dispose();
+    map.mapPtr = next.mapPtr;
+    map.dispose = next.dispose;
+  },
+
+  insertFlatStringMapEntries(data: PreparedWasmStringMapData): number {
+    return callStringMapData('insertFlatStringMapEntries', data);
+  },
+
+  lookupFlatStringMapEntries(map: PreparedWasmStringMap): number {
+    const result = getWasmModule().ccall(
+      'lookupFlatStringMapEntries',
+      'number',
+      ['number'],
+      [map.mapPtr]
+    );
+    return toNumber(result);
+  },
+
+  deleteFlatStringMapEntries(map: PreparedWasmStringMap): number {
+    const result = getWasmModule().ccall(
+      'deleteFlatStringMapEntries',
+      'number',
+      ['number'],
+      [map.mapPtr]
+    );
+    return toNumber(result);
+  },
+
   prepareNumberTreeMapData(data: NumberMapData): PreparedWasmNumberTreeMapData {
     return createPreparedNumberTreeMapData(data);
   },
@@ -804,6 +1099,61 @@ export const wasmAlgorithms = {
     return toNumber(result);
   },
 
+  /**
+   * First entry with key >= `key`, or null when every key is smaller
+   */
+  lowerBoundNumberTreeMap(map: PreparedWasmNumberTreeMap, key: number): NumberTreeMapEntry | null {
+    const module = getWasmModule();
+    const entryPtr = module._malloc(2 * 4);
+    try {
+      const found = module.ccall(
+        'lowerBoundNumberTreeMap',
+        'number',
+        ['number', 'number', 'number'],
+        [map.mapPtr, key >>> 0, entryPtr]
+      );
+      if (!found) {
+        return null;
+      }
+      const entry = readArrayEx(entryPtr, 2);
+      return { key: entry[0], value: entry[1] };
+    } finally {
+      freeArray(entryPtr);
+    }
+  },
+
+  /**
+   * Entries with minKey <= key <= maxKey in ascending key order (at most maxCount)
+   */
+  rangeScanNumberTreeMap(
+    map: PreparedWasmNumberTreeMap,
+    minKey: number,
+    maxKey: number,
+    maxCount: number = map.data.count
+  ): NumberMapData {
+    if (maxCount <= 0) {
+      return { keys: new Uint32Array(0), values: new Uint32Array(0) };
+    }
+    const module = getWasmModule();
+    const keysPtr = module._malloc(maxCount * 4);
+    const valuesPtr = module._malloc(maxCount * 4);
+    try {
+      const count = module.ccall(
+        'rangeScanNumberTreeMap',
+        'number',
+        ['number', 'number', 'number', 'number', 'number', 'number'],
+        [map.mapPtr, minKey >>> 0, maxKey >>> 0, keysPtr, valuesPtr, maxCount]
+      );
+      return {
+        keys: readArrayEx(keysPtr, count),
+        values: readArrayEx(valuesPtr, count),
+      };
+    } finally {
+      freeArray(keysPtr);
+      freeArray(valuesPtr);
+    }
+  },
+
   // ========== SIMD OPTIMIZED VERSIONS ==========
 
   /**
@@ -835,7 +1185,7 @@ export const wasmAlgorithms = {
         'number',
         ['number', 'number'],
         [ptr, arr.length]
-      );
+      ) >>> 0;
     } finally {
       freeArray(ptr);
     }
@@ -852,7 +1202,7 @@ export const wasmAlgorithms = {
         'number',
         ['number', 'number'],
         [ptr, arr.length]
-      );
+      ) >>> 0;
     } finally {
       freeArray(ptr);
     }
@@ -928,76 +1278,1328 @@ export const wasmAlgorithms = {
     }
   },
 
-  // ========== MATRIX TRANSFORMATION ==========
-
   /**
+   * Sum, min, max, mean, variance and optional histogram in one pass
    */
-  transformVectors(vectors: Float32Array, matrix: Float32Array): Float32Array {
-    const vectorsPtr = allocateFloatArrayEx(vectors);
-    const matrixPtr = allocateFloatArrayEx(matrix);
+  computeStats(arr: Uint32Array, histogram?: HistogramOptions): ArrayStats {
+    const ptr = allocateArrayEx(arr);
     try {
-      const module = getWasmModule();
-      const count = vectors.length / 3;
+      return callComputeStats('computeStats', ptr, arr.length, histogram);
+    } finally {
+      freeArray(ptr);
+    }
+  },
 
-      // Debug: Check if function exists
-      console.log('Calling transformVectors with count:', count);
+  // ========== MULTITHREADED VERSIONS ==========
+  // threads = 0 uses every pool thread; the single-threaded build always runs on one
 
-      module.ccall(
-        'transformVectors',
-        null,
+  /**
+   */
+  getMaxThreads(): number {
+    return maxThreads();
+  },
+
+  /**
+   */
+  sumArray_MT(arr: Uint32Array, threads: number = 0): bigint {
+    const ptr = allocateArrayEx(arr);
+    try {
+      const module = getWasmModule();
+      const sum = module.ccall(
+        'sumArray_MT',
+        'number',
         ['number', 'number', 'number'],
-        [vectorsPtr, matrixPtr, count]
+        [ptr, arr.length, threads]
       );
-      return readFloatArrayEx(vectorsPtr, vectors.length);
-    } catch (error) {
-      console.error('transformVectors error:', error);
-      throw error;
+      return BigInt(sum);
     } finally {
-      freeArray(vectorsPtr);
-      freeArray(matrixPtr);
+      freeArray(ptr);
     }
   },
 
   /**
    */
-  transformVectorsSIMD(vectors: Float32Array, matrix: Float32Array): Float32Array {
-    const vectorsPtr = allocateFloatArrayEx(vectors);
-    const matrixPtr = allocateFloatArrayEx(matrix);
+  calculateAverage_MT(arr: Uint32Array, threads: number = 0): number {
+    const ptr = allocateArrayEx(arr);
     try {
       const module = getWasmModule();
-      const count = vectors.length / 3;
-      module.ccall(
-        'transformVectorsSIMD',
-        null,
+      return module.ccall(
+        'calculateAverage_MT',
+        'number',
         ['number', 'number', 'number'],
-        [vectorsPtr, matrixPtr, count]
+        [ptr, arr.length, threads]
       );
-      return readFloatArrayEx(vectorsPtr, vectors.length);
     } finally {
-      freeArray(vectorsPtr);
-      freeArray(matrixPtr);
+      freeArray(ptr);
     }
   },
 
   /**
    */
-  createTransformMatrix(
-    scaleX: number, scaleY: number, scaleZ: number,
-    angleDeg: number,
-    transX: number, transY: number, transZ: number
-  ): Float32Array {
-    const matrixPtr = getWasmModule()._malloc(16 * 4); // 16 floats
+  findMax_MT(arr: Uint32Array, threads: number = 0): number {
+    const ptr = allocateArrayEx(arr);
     try {
       const module = getWasmModule();
-      module.ccall(
-        'createTransformMatrix',
-        null,
-        ['number', 'number', 'number', 'number', 'number', 'number', 'number', 'number'],
-        [matrixPtr, scaleX, scaleY, scaleZ, angleDeg, transX, transY, transZ]
+      return module.ccall(
+        'findMax_MT',
+        'number',
+        ['number', 'number', 'number'],
+        [ptr, arr.length, threads]
+      ) >>> 0;
+    } finally {
+      freeArray(ptr);
+    }
+  },
+
+  /**
+   */
+  findMin_MT(arr: Uint32Array, threads: number = 0): number {
+    const ptr = allocateArrayEx(arr);
+    try {
+      const module = getWasmModule();
+      return module.ccall(
+        'findMin_MT',
+        'number',
+        ['number', 'number', 'number'],
+        [ptr, arr.length, threads]
+      ) >>> 0;
+    } finally {
+      freeArray(ptr);
+    }
+  },
+
+  /**
+   */
+  countGreaterThan_MT(arr: Uint32Array, threshold: number, threads: number = 0): number {
+    const ptr = allocateArrayEx(arr);
+    try {
+      const module = getWasmModule();
+      return module.ccall(
+        'countGreaterThan_MT',
+        'number',
+        ['number', 'number', 'number', 'number'],
+        [ptr, arr.length, threshold, threads]
       );
-      return readFloatArrayEx(matrixPtr, 16);
     } finally {
-      freeArray(matrixPtr);
+      freeArray(ptr);
     }
   },
+
+  /**
+   */
+  mergeSort_MT(arr: Uint32Array, threads: number = 0): Uint32Array {
+    const ptr = allocateArrayEx(arr);
+    try {
+      const module = getWasmModule();
+      module.ccall(
+        'mergeSort_MT',
+        null,
+        ['number', 'number', 'number'],
+        [ptr, arr.length, threads]
+      );
+      return readArrayEx(ptr, arr.length);
+    } finally {
+      freeArray(ptr);
+    }
+  },
+
+  /**
+   */
+  computeStats_MT(arr: Uint32Array, histogram?: HistogramOptions, threads: number = 0): ArrayStats {
+    const ptr = allocateArrayEx(arr);
+    try {
+      return callComputeStats('computeStats_MT', ptr, arr.length, histogram, threads);
+    } finally {
+      freeArray(ptr);
+    }
+  },
+
+  /**
+   * Level-synchronous parallel BFS over a prepared tree
+   */
+  sumNaryTreeBfs_MT(tree: PreparedWasmNaryTree, threads: number = 0): number {
+    return callNaryTreeSum('sumNaryTreeBfs_MT', tree, threads);
+  },
+
+  /**
+   * Work-stealing parallel DFS over a prepared tree
+   */
+  sumNaryTreeDfs_MT(tree: PreparedWasmNaryTree, threads: number = 0): number {
+    return callNaryTreeSum('sumNaryTreeDfs_MT', tree, threads);
+  },
+
+  /**
+   */
+  computeNaryTreeStatsBfs_MT(tree: PreparedWasmNaryTree, levelCapacity: number, threads: number = 0): NaryTreeStats {
+    return callNaryTreeStats('computeNaryTreeStatsBfs_MT', tree, levelCapacity, threads);
+  },
+
+  /**
+   */
+  computeNaryTreeStatsDfs_MT(tree: PreparedWasmNaryTree, levelCapacity: number, threads: number = 0): NaryTreeStats {
+    return callNaryTreeStats('computeNaryTreeStatsDfs_MT', tree, levelCapacity, threads);
+  },
+
+  /**
+   */
+  transformVectors_MT(vectors: Float32Array, matrix: Float32Array, threads: number = 0): Float32Array {
+    const vectorsPtr = allocateFloatArrayEx(vectors);
+    const matrixPtr = allocateFloatArrayEx(matrix);
+    try {
+      const module = getWasmModule();
+      module.ccall(
+        'transformVectors_MT',
+        null,
+        ['number', 'number', 'number', 'number'],
+        [vectorsPtr, matrixPtr, vectors.length / 3, threads]
+      );
+      return readFloatArrayEx(vectorsPtr, vectors.length);
+    } finally {
+      freeArray(vectorsPtr);
+      freeArray(matrixPtr);
+    }
+  },
+
+  // ========== MATRIX TRANSFORMATION ==========
+
+  /**
+   */
+  transformVectors(vectors: Float32Array, matrix: Float32Array): Float32Array {
+    const vectorsPtr = allocateFloatArrayEx(vectors);
+    const matrixPtr = allocateFloatArrayEx(matrix);
+    try {
+      const module = getWasmModule();
+      const count = vectors.length / 3;
+      module.ccall(
+        'transformVectors',
+        null,
+        ['number', 'number', 'number'],
+        [vectorsPtr, matrixPtr, count]
+      );
+      return readFloatArrayEx(vectorsPtr, vectors.length);
+    } catch (error) {
+      console.error('transformVectors error:', error);
+      throw error;
+    } finally {
+      freeArray(vectorsPtr);
+      freeArray(matrixPtr);
+    }
+  },
+
+  /**
+   */
+  transformVectorsSIMD(vectors: Float32Array, matrix: Float32Array): Float32Array {
+    const vectorsPtr = allocateFloatArrayEx(vectors);
+    const matrixPtr = allocateFloatArrayEx(matrix);
+    try {
+      const module = getWasmModule();
+      const count = vectors.length / 3;
+      module.ccall(
+        'transformVectorsSIMD',
+        null,
+        ['number', 'number', 'number'],
+        [vectorsPtr, matrixPtr, count]
+      );
+      return readFloatArrayEx(vectorsPtr, vectors.length);
+    } finally {
+      freeArray(vectorsPtr);
+      freeArray(matrixPtr);
+    }
+  },
+
+  /**
+   */
+  createTransformMatrix(
+    scaleX: number, scaleY: number, scaleZ: number,
+    angleDeg: number,
+    transX: number, transY: number, transZ: number
+  ): Float32Array {
+    const matrixPtr = getWasmModule()._malloc(16 * 4); // 16 floats
+    try {
+      const module = getWasmModule();
+      module.ccall(
+        'createTransformMatrix',
+        null,
+        ['number', 'number', 'number', 'number', 'number', 'number', 'number', 'number'],
+        [matrixPtr, scaleX, scaleY, scaleZ, angleDeg, transX, transY, transZ]
+      );
+      return readFloatArrayEx(matrixPtr, 16);
+    } finally {
+      freeArray(matrixPtr);
+    }
+  },
+};
+
+// ========== ZERO-COPY BUFFER VERSIONS ==========
+// Same kernels, run in place on persistent WasmBuffer handles: no malloc,
+// copy-in or copy-out per call, and array results come back as live views.
+
+// Kernels are called through their raw exports (bindExport), which skip
+// ccall's per-call name lookup and argument conversion; that fixed cost is
+// what dominates small buffers and single lookups.
+
+function callBuffer(functionName: string, buffer: WasmBuffer<WasmBufferArray>): number {
+  return bindExport<ExportPtrLen>(functionName)(buffer.ptr, buffer.length);
+}
+
+function callBufferWith(functionName: string, buffer: WasmBuffer<WasmBufferArray>, value: number): number {
+  return bindExport<ExportPtrLenScalar>(functionName)(buffer.ptr, buffer.length, value);
+}
+
+function callBufferInPlace(functionName: string, buffer: WasmBuffer<Uint32Array>, value?: number): Uint32Array {
+  if (value === undefined) {
+    bindExport<ExportPtrLen<void>>(functionName)(buffer.ptr, buffer.length);
+  } else {
+    bindExport<ExportPtrLenScalar<void>>(functionName)(buffer.ptr, buffer.length, value);
+  }
+  return buffer.view;
+}
+
+function callTransformInPlace(
+  functionName: string,
+  vectors: WasmBuffer<Float32Array>,
+  matrix: WasmBuffer<Float32Array>,
+  threads?: number
+): Float32Array {
+  const count = vectors.length / 3;
+  if (threads === undefined) {
+    bindExport(functionName)(vectors.ptr, matrix.ptr, count);
+  } else {
+    bindExport(functionName)(vectors.ptr, matrix.ptr, count, threads);
+  }
+  return vectors.view;
+}
+
+function callBufferSearchBatch(
+  functionName: string,
+  table: WasmBuffer<Uint32Array>,
+  targets: WasmBuffer<Uint32Array>,
+  out: WasmBuffer<Int32Array>
+): Int32Array {
+  if (out.length < targets.length) {
+    throw new Error(`${functionName}: output buffer holds ${out.length} results, need ${targets.length}`);
+  }
+  bindExport(functionName)(table.ptr, table.length, targets.ptr, targets.length, out.ptr);
+  return out.view;
+}
+
+/**
+ * Element types with typed kernels: NumericArray plus uint64 columns, whose
+ * results and operands cross as numbers (exact up to 2^53)
+ */
+export type TypedKernelArray = NumericArray | BigUint64Array;
+
+// Export suffix of the typed kernels per element type (sumArrayI8, findMinF64, ...)
+const TYPED_KERNEL_SUFFIXES = new Map<Function, string>([
+  [Int8Array, 'I8'],
+  [Int16Array, 'I16'],
+  [Int32Array, 'I32'],
+  [Uint32Array, 'U32'],
+  [BigUint64Array, 'U64'],
+  [Float32Array, 'F32'],
+  [Float64Array, 'F64'],
+]);
+
+function typedKernelName(name: string, buffer: WasmBuffer<TypedKernelArray>): string {
+  const suffix = TYPED_KERNEL_SUFFIXES.get(buffer.view.constructor);
+  if (!suffix) {
+    throw new Error(`${name}: no typed kernel for ${buffer.view.constructor.name}`);
+  }
+  return name + suffix;
+}
+
+function callTypedInPlace<T extends TypedKernelArray>(name: string, buffer: WasmBuffer<T>, value: number): T {
+  bindExport<ExportPtrLenScalar<void>>(typedKernelName(name, buffer))(buffer.ptr, buffer.length, value);
+  return buffer.view;
+}
+
+/**
+ * SoA point storage in persistent WASM buffers (x, y, z and optional w)
+ */
+export interface WasmSoAVectors {
+  count: number;
+  x: WasmBuffer<Float32Array>;
+  y: WasmBuffer<Float32Array>;
+  z: WasmBuffer<Float32Array>;
+  w: WasmBuffer<Float32Array> | null;
+  dispose: () => void;
+}
+
+export function createWasmSoAVectors(count: number, withW: boolean = false): WasmSoAVectors {
+  const x = WasmBuffer.float32(count);
+  const y = WasmBuffer.float32(count);
+  const z = WasmBuffer.float32(count);
+  const w = withW ? WasmBuffer.float32(count) : null;
+  return {
+    count,
+    x,
+    y,
+    z,
+    w,
+    dispose: () => {
+      x.dispose();
+      y.dispose();
+      z.dispose();
+      w?.dispose();
+    },
+  };
+}
+
+/**
+ * Running statistics over a stream of chunks, kept in WASM memory.
+ * Chunks from other accumulators (e.g. one per worker) fold in with merge.
+ */
+export interface WasmStatsAccumulator {
+  add: (chunk: WasmBuffer<Uint32Array>) => void;
+  // Histograms merge only when both sides use the same options
+  merge: (other: WasmStatsAccumulator) => void;
+  read: () => ArrayStats;
+  reset: () => void;
+  dispose: () => void;
+  readonly statsPtr: number;
+  readonly binsPtr: number;
+  readonly histogram?: HistogramOptions;
+}
+
+function sameHistogram(a?: HistogramOptions, b?: HistogramOptions): boolean {
+  return a === b || (!!a && !!b && a.bins === b.bins && a.min === b.min && a.max === b.max);
+}
+
+export function createWasmStatsAccumulator(histogram?: HistogramOptions): WasmStatsAccumulator {
+  const module = getWasmModule();
+  const binCount = histogram ? histogram.bins : 0;
+  const statsPtr = assertPointer(module._malloc(STATS_BYTES + binCount * 4), 'stats accumulator');
+  const binsPtr = binCount > 0 ? statsPtr + STATS_BYTES : 0;
+  const reset = () => {
+    module.ccall('resetStats', null, ['number'], [statsPtr]);
+    module.HEAPU32.fill(0, binsPtr / 4, binsPtr / 4 + binCount);
+  };
+  reset();
+
+  return {
+    statsPtr,
+    binsPtr,
+    histogram,
+    add: (chunk) => {
+      module.ccall(
+        'accumulateStats',
+        null,
+        STATS_ARGS,
+        [statsPtr, chunk.ptr, chunk.length, binsPtr, binCount, histogram?.min ?? 0, histogram?.max ?? 0]
+      );
+    },
+    merge: (other) => {
+      if (!sameHistogram(histogram, other.histogram)) {
+        throw new Error('mergeStats: accumulators have different histogram options');
+      }
+      module.ccall('mergeStats', null, ['number', 'number'], [statsPtr, other.statsPtr]);
+      // mergeStats covers ArrayStats only; the bins add here
+      const bins = module.HEAPU32.subarray(binsPtr / 4, binsPtr / 4 + binCount);
+      const otherBins = module.HEAPU32.subarray(other.binsPtr / 4, other.binsPtr / 4 + binCount);
+      for (let i = 0; i < binCount; i++) {
+        bins[i] += otherBins[i];
+      }
+    },
+    read: () => readStats(statsPtr, binsPtr, binCount),
+    reset,
+    dispose: () => module._free(statsPtr),
+  };
+}
+
+// ========== STREAMING SESSIONS ==========
+// Data larger than WASM memory goes through one chunk-sized WasmBuffer:
+// push() copies any amount of input into it and hands every full chunk to
+// pushChunk, so WASM memory stays at chunkLength whatever the dataset size.
+
+export type StreamKind = 'sum' | 'minMax' | 'countGreaterThan' | 'stats';
+
+// StreamKind in array_processor.cpp
+const STREAM_KIND_CODES = { sum: 0, minMax: 1, countGreaterThan: 2, stats: 3, sortRuns: 4 };
+// StreamResult in array_processor.cpp: 3 x u64, 2 x u32, ArrayStats
+const STREAM_RESULT_BYTES = 32 + STATS_BYTES;
+const DEFAULT_STREAM_CHUNK_LENGTH = 1 << 20;
+
+export interface StreamOptions {
+  // Elements per chunk handed to WASM (default 1M = 4 MB)
+  chunkLength?: number;
+  // countGreaterThan threshold
+  threshold?: number;
+}
+
+/**
+ * finishStream result; fields a kind does not compute are 0
+ */
+export interface StreamResult {
+  count: number;
+  sum: bigint;
+  // countGreaterThan matches (sorted runs for an external sort)
+  matched: number;
+  min: number;
+  max: number;
+  stats: ArrayStats;
+}
+
+export interface WasmStream {
+  push: (data: Uint32Array) => void;
+  // Flush the last partial chunk, end the session and free its buffer
+  finish: () => StreamResult;
+}
+
+function readU64(heap: Uint32Array, index: number): bigint {
+  return (BigInt(heap[index + 1]) << 32n) | BigInt(heap[index]);
+}
+
+function createStreamSession(
+  kindCode: number,
+  options: StreamOptions,
+  onChunk?: (chunk: Uint32Array) => void
+): WasmStream {
+  const module = getWasmModule();
+  const chunkLength = options.chunkLength ?? DEFAULT_STREAM_CHUNK_LENGTH;
+  const chunk = WasmBuffer.uint32(chunkLength);
+  const session = module.ccall('beginStream', 'number', ['number', 'number'], [kindCode, options.threshold ?? 0]);
+  if (!session) {
+    chunk.dispose();
+    throw new Error('Failed to create stream session in WASM');
+  }
+  let filled = 0;
+
+  const flush = () => {
+    if (filled > 0) {
+      module.ccall('pushChunk', null, ['number', 'number', 'number'], [session, chunk.ptr, filled]);
+      onChunk?.(chunk.view.subarray(0, filled));
+      filled = 0;
+    }
+  };
+
+  return {
+    push: (data) => {
+      let offset = 0;
+      while (offset < data.length) {
+        const take = Math.min(chunkLength - filled, data.length - offset);
+        chunk.set(data.subarray(offset, offset + take), filled);
+        filled += take;
+        offset += take;
+        if (filled === chunkLength) {
+          flush();
+        }
+      }
+    },
+    finish: () => {
+      flush();
+      const resultPtr = assertPointer(module._malloc(STREAM_RESULT_BYTES), 'stream result');
+      try {
+        module.ccall('finishStream', null, ['number', 'number'], [session, resultPtr]);
+        const heap = module.HEAPU32;
+        const base = resultPtr / heap.BYTES_PER_ELEMENT;
+        return {
+          count: Number(readU64(heap, base)),
+          sum: readU64(heap, base + 2),
+          matched: Number(readU64(heap, base + 4)),
+          min: heap[base + 6],
+          max: heap[base + 7],
+          stats: readStats(resultPtr + 32, 0, 0),
+        };
+      } finally {
+        module._free(resultPtr);
+        chunk.dispose();
+      }
+    },
+  };
+}
+
+/**
+ * Streaming reduction: beginStream, pushChunk per chunk, finishStream
+ */
+export function createWasmStream(kind: StreamKind, options: StreamOptions = {}): WasmStream {
+  return createStreamSession(STREAM_KIND_CODES[kind], options);
+}
+
+export interface ExternalSortOptions {
+  // Elements per sorted run, and the WASM memory budget of the merge (default 1M)
+  chunkLength?: number;
+}
+
+export interface WasmExternalSort {
+  push: (data: Uint32Array) => void;
+  // Merge the runs, passing sorted output to sink in order; returns the element count
+  finish: (sink: (sorted: Uint32Array) => void) => number;
+}
+
+// Smallest per-run window worth a merge round trip; runs beyond
+// chunkLength / EXTERNAL_MERGE_MIN_WINDOW - 1 are merged in several passes
+const EXTERNAL_MERGE_MIN_WINDOW = 1024;
+
+/**
+ * k-way merge of sorted runs through one WASM merge whose k + 1 windows
+ * (k inputs, one output) fit in chunkLength
+ */
+function mergeRuns(runs: Uint32Array[], chunkLength: number, sink: (sorted: Uint32Array) => void): void {
+  const module = getWasmModule();
+  const windowLength = Math.max(1, Math.floor(chunkLength / (runs.length + 1)));
+  const merge = assertPointer(
+    module.ccall('createExternalMerge', 'number', ['number', 'number'], [runs.length, windowLength]),
+    'external merge'
+  );
+  const offsets = new Array<number>(runs.length).fill(0);
+  const fill = (run: number) => {
+    const part = runs[run].subarray(offsets[run], offsets[run] + windowLength);
+    const window = module.ccall('getExternalMergeWindow', 'number', ['number', 'number'], [merge, run]);
+    module.HEAPU32.set(part, window / 4);
+    offsets[run] += part.length;
+    module.ccall('fillExternalMergeRun', null, ['number', 'number', 'number'], [merge, run, part.length]);
+  };
+
+  try {
+    runs.forEach((_, run) => fill(run));
+    const output = module.ccall('getExternalMergeOutput', 'number', ['number'], [merge]) / 4;
+    for (;;) {
+      const written = module.ccall('externalMergeNext', 'number', ['number'], [merge]);
+      if (written > 0) {
+        sink(module.HEAPU32.slice(output, output + written));
+      }
+      const starved = module.ccall('getExternalMergeStarvedRun', 'number', ['number'], [merge]);
+      if (starved >= 0) {
+        fill(starved);
+      } else if (written === 0) {
+        return;
+      }
+    }
+  } finally {
+    module.ccall('freeExternalMerge', null, ['number'], [merge]);
+  }
+}
+
+/**
+ * External merge sort: pushed data is cut into chunkLength runs that are
+ * sorted in WASM and spilled to JS memory, then merged by a k-way heap
+ * through per-run windows sized so all windows fit in chunkLength. When
+ * there are too many runs for windows of EXTERNAL_MERGE_MIN_WINDOW, groups
+ * of runs are first merged into longer runs, one pass at a time.
+ */
+export function createWasmExternalSort(options: ExternalSortOptions = {}): WasmExternalSort {
+  const chunkLength = options.chunkLength ?? DEFAULT_STREAM_CHUNK_LENGTH;
+  const fanIn = Math.max(2, Math.floor(chunkLength / EXTERNAL_MERGE_MIN_WINDOW) - 1);
+  let runs: Uint32Array[] = [];
+  const stream = createStreamSession(STREAM_KIND_CODES.sortRuns, { chunkLength }, (run) => runs.push(run.slice()));
+
+  return {
+    push: stream.push,
+    finish: (sink) => {
+      const count = stream.finish().count;
+      if (runs.length === 0) {
+        return 0;
+      }
+
+      while (runs.length > fanIn) {
+        const merged: Uint32Array[] = [];
+        for (let first = 0; first < runs.length; first += fanIn) {
+          const group = runs.slice(first, first + fanIn);
+          if (group.length === 1) {
+            merged.push(group[0]);
+            continue;
+          }
+          const run = new Uint32Array(group.reduce((length, part) => length + part.length, 0));
+          let filled = 0;
+          mergeRuns(group, chunkLength, (sorted) => {
+            run.set(sorted, filled);
+            filled += sorted.length;
+          });
+          merged.push(run);
+        }
+        runs = merged;
+      }
+
+      if (runs.length === 1) {
+        sink(runs[0]);
+      } else {
+        mergeRuns(runs, chunkLength, sink);
+      }
+      return count;
+    },
+  };
+}
+
+// ========== DISTINCT COUNTING ==========
+
+/**
+ * Mergeable HyperLogLog sketch held in WASM memory
+ */
+export interface WasmHyperLogLog {
+  readonly precision: number;
+  readonly handle: number;
+  add: (values: WasmBuffer<Uint32Array>) => void;
+  // Union with another sketch of the same precision
+  merge: (other: WasmHyperLogLog) => void;
+  estimate: () => number;
+  // Copy of the 2^precision registers
+  registers: () => Uint8Array;
+  clear: () => void;
+  dispose: () => void;
+}
+
+export function createWasmHyperLogLog(precision: number = HLL_DEFAULT_PRECISION): WasmHyperLogLog {
+  const module = getWasmModule();
+  const handle = module.ccall('createHyperLogLog', 'number', ['number'], [precision]);
+  if (!handle) {
+    throw new Error(`createHyperLogLog: precision must be 4-16, got ${precision}`);
+  }
+
+  return {
+    precision,
+    handle,
+    add: (values) => {
+      module.ccall('hyperLogLogAdd', null, ['number', 'number', 'number'], [handle, values.ptr, values.length]);
+    },
+    merge: (other) => {
+      if (!module.ccall('mergeHyperLogLog', 'number', ['number', 'number'], [handle, other.handle])) {
+        throw new Error(`mergeHyperLogLog: precision ${other.precision} does not match ${precision}`);
+      }
+    },
+    estimate: () => module.ccall('hyperLogLogEstimate', 'number', ['number'], [handle]),
+    registers: () => {
+      const ptr = module.ccall('getHyperLogLogRegisters', 'number', ['number'], [handle]);
+      return module.HEAPU8.slice(ptr, ptr + (1 << precision));
+    },
+    clear: () => module.ccall('clearHyperLogLog', null, ['number'], [handle]),
+    dispose: () => module.ccall('freeHyperLogLog', null, ['number'], [handle]),
+  };
+}
+
+// ========== FILTER ENGINE ==========
+// Predicates write selection bitmaps (one bit per row) into WASM memory;
+// bitmaps combine with and / or / not and compact into row indices or
+// gathered values, so a multi-predicate query crosses the boundary once
+// per kernel and copies out only the selected rows.
+
+const FILTER_OP_CODES = { gt: 0, lt: 1, eq: 2, between: 3 };
+
+/**
+ * Selection bitmap over `length` rows
+ */
+export interface WasmBitmap {
+  readonly words: WasmBuffer<Uint32Array>;
+  readonly length: number;
+  // Selected rows, as returned by the kernel that last wrote the bitmap
+  count: number;
+  dispose: () => void;
+}
+
+export function createWasmBitmap(length: number): WasmBitmap {
+  const words = WasmBuffer.uint32(Math.max(Math.ceil(length / 32), 1));
+  return { words, length, count: 0, dispose: () => words.dispose() };
+}
+
+function assertSameLength(name: string, a: WasmBitmap, b: WasmBitmap): void {
+  if (a.length !== b.length) {
+    throw new Error(`${name}: bitmaps cover ${a.length} and ${b.length} rows`);
+  }
+}
+
+function callFilter(column: WasmBuffer<FilterColumn>, predicate: FilterPredicate, out: WasmBitmap): number {
+  const module = getWasmModule();
+  const isFloat = column.view instanceof Float32Array;
+  if (predicate.op === 'in') {
+    const values = isFloat ? Float32Array.from(predicate.values) : Uint32Array.from(predicate.values);
+    const valuesPtr = assertPointer(module._malloc(Math.max(values.length, 1) * 4), 'filter set');
+    try {
+      (isFloat ? module.HEAPF32 : module.HEAPU32).set(values, valuesPtr / 4);
+      return module.ccall(
+        isFloat ? 'filterInF32' : 'filterInU32',
+        'number',
+        ['number', 'number', 'number', 'number', 'number'],
+        [column.ptr, column.length, valuesPtr, values.length, out.words.ptr]
+      ) >>> 0;
+    } finally {
+      module._free(valuesPtr);
+    }
+  }
+
+  const [value, high] = predicate.op === 'between' ? [predicate.low, predicate.high] : [predicate.value, 0];
+  return module.ccall(
+    isFloat ? 'filterF32' : 'filterU32',
+    'number',
+    ['number', 'number', 'number', 'number', 'number', 'number'],
+    [column.ptr, column.length, FILTER_OP_CODES[predicate.op], value, high, out.words.ptr]
+  ) >>> 0;
+}
+
+/**
+ * Copy the selected rows (indices when column is null) into out, or into
+ * a fresh array when out is omitted
+ */
+function callCompact<T extends FilterColumn>(
+  column: WasmBuffer<T> | null,
+  bitmap: WasmBitmap,
+  out: WasmBuffer<T> | undefined,
+  create: (length: number) => T
+): T {
+  const module = getWasmModule();
+  const name = column ? 'gatherSelected' : 'bitmapToSelection';
+  const args = column ? [column.ptr, bitmap.words.ptr] : [bitmap.words.ptr];
+  const types = column ? ['number', 'number', 'number', 'number', 'number'] : ['number', 'number', 'number', 'number'];
+
+  if (out) {
+    const written = module.ccall(name, 'number', types, [...args, bitmap.length, out.ptr, out.length]) >>> 0;
+    return out.view.subarray(0, written) as T;
+  }
+
+  const outPtr = assertPointer(module._malloc(Math.max(bitmap.count, 1) * 4), 'selection');
+  try {
+    const written = module.ccall(name, 'number', types, [...args, bitmap.length, outPtr, bitmap.count]) >>> 0;
+    const result = create(written);
+    // Byte copy: float columns are gathered by bit pattern
+    new Uint8Array(result.buffer).set(module.HEAPU8.subarray(outPtr, outPtr + written * 4));
+    return result;
+  } finally {
+    module._free(outPtr);
+  }
+}
+
+export const wasmFilter = {
+  /**
+   * Bitmap of the rows of column matching predicate
+   */
+  where(column: WasmBuffer<FilterColumn>, predicate: FilterPredicate, out?: WasmBitmap): WasmBitmap {
+    const bitmap = out ?? createWasmBitmap(column.length);
+    if (bitmap.length !== column.length) {
+      throw new Error(`where: bitmap covers ${bitmap.length} rows, column has ${column.length}`);
+    }
+    bitmap.count = callFilter(column, predicate, bitmap);
+    return bitmap;
+  },
+
+  and(a: WasmBitmap, b: WasmBitmap, out: WasmBitmap = a): WasmBitmap {
+    assertSameLength('and', a, b);
+    assertSameLength('and', a, out);
+    out.count = getWasmModule().ccall(
+      'bitmapAnd',
+      'number',
+      ['number', 'number', 'number', 'number'],
+      [a.words.ptr, b.words.ptr, out.words.ptr, a.length]
+    ) >>> 0;
+    return out;
+  },
+
+  or(a: WasmBitmap, b: WasmBitmap, out: WasmBitmap = a): WasmBitmap {
+    assertSameLength('or', a, b);
+    assertSameLength('or', a, out);
+    out.count = getWasmModule().ccall(
+      'bitmapOr',
+      'number',
+      ['number', 'number', 'number', 'number'],
+      [a.words.ptr, b.words.ptr, out.words.ptr, a.length]
+    ) >>> 0;
+    return out;
+  },
+
+  not(a: WasmBitmap, out: WasmBitmap = a): WasmBitmap {
+    assertSameLength('not', a, out);
+    out.count = getWasmModule().ccall(
+      'bitmapNot',
+      'number',
+      ['number', 'number', 'number'],
+      [a.words.ptr, out.words.ptr, a.length]
+    ) >>> 0;
+    return out;
+  },
+
+  /**
+   * Indices of the selected rows; with out, a view over its first rows
+   * (capacity out.length)
+   */
+  select(bitmap: WasmBitmap, out?: WasmBuffer<Uint32Array>): Uint32Array {
+    return callCompact<Uint32Array>(null, bitmap, out, length => new Uint32Array(length));
+  },
+
+  /**
+   * Values of the selected rows of column; with out, a view over its first
+   * rows (capacity out.length)
+   */
+  gather<T extends FilterColumn>(column: WasmBuffer<T>, bitmap: WasmBitmap, out?: WasmBuffer<T>): T {
+    if (bitmap.length !== column.length) {
+      throw new Error(`gather: bitmap covers ${bitmap.length} rows, column has ${column.length}`);
+    }
+    return callCompact(column, bitmap, out, length => new (column.view.constructor as new (length: number) => T)(length));
+  },
+};
+
+// ========== FUSED PIPELINES ==========
+// A chain of maps, predicates and a reduction compiled once in WASM memory
+// (createPipeline) and run over any number of buffers, one call and one
+// memory pass each. Codes match fused_pipeline::Op / Reduce.
+
+const PIPELINE_OP_CODES: Record<PipelineStage['op'], number> = {
+  add: 0, multiply: 1, and: 2, xor: 3, shiftRight: 4, min: 5, max: 6,
+  gt: 16, lt: 17, eq: 18, between: 19,
+};
+const PIPELINE_REDUCE_CODES: Record<PipelineReduce, number> = { sum: 0, count: 1, min: 2, max: 3 };
+// op, operand, operand2
+const PIPELINE_STAGE_WORDS = 3;
+
+export interface WasmPipeline {
+  readonly handle: number;
+  readonly reduce: PipelineReduce;
+  // threads undefined runs runPipeline, otherwise runPipeline_MT (0 = all)
+  run: (values: WasmBuffer<Uint32Array>, threads?: number) => number | bigint;
+  dispose: () => void;
+}
+
+export function createWasmPipeline(pipeline: PipelineSpec): WasmPipeline {
+  const module = getWasmModule();
+  const words = new Uint32Array(Math.max(pipeline.stages.length, 1) * PIPELINE_STAGE_WORDS);
+  pipeline.stages.forEach((stage, index) => {
+    const offset = index * PIPELINE_STAGE_WORDS;
+    words[offset] = PIPELINE_OP_CODES[stage.op];
+    if (stage.op === 'between') {
+      words[offset + 1] = stage.low;
+      words[offset + 2] = stage.high;
+    } else {
+      words[offset + 1] = stage.value;
+    }
+  });
+
+  const stagesPtr = assertPointer(module._malloc(words.byteLength), 'pipeline stages');
+  let handle: number;
+  try {
+    module.HEAPU32.set(words, stagesPtr / 4);
+    handle = module.ccall(
+      'createPipeline',
+      'number',
+      ['number', 'number', 'number'],
+      [stagesPtr, pipeline.stages.length, PIPELINE_REDUCE_CODES[pipeline.reduce]]
+    );
+  } finally {
+    module._free(stagesPtr);
+  }
+  if (!handle) {
+    throw new Error(`createPipeline: unsupported pipeline (${pipeline.stages.length} stages, at most 32)`);
+  }
+
+  const reduce = pipeline.reduce;
+  return {
+    handle,
+    reduce,
+    run: (values, threads) => {
+      const result = threads === undefined
+        ? bindExport('runPipeline', module)(handle, values.ptr, values.length)
+        : bindExport('runPipeline_MT', module)(handle, values.ptr, values.length, threads);
+      return reduce === 'sum' ? BigInt(result as bigint) : toNumber(result as bigint);
+    },
+    dispose: () => module.ccall('freePipeline', null, ['number'], [handle]),
+  };
+}
+
+// ========== CALL BOUNDARY ==========
+// The boundary* exports do next to nothing, so count calls in a loop time
+// the fixed cost of one JS -> WASM call per signature: through the raw
+// export resolved once, or through ccall as most copying wrappers still do.
+
+export type BoundaryCallPath = 'direct' | 'ccall';
+
+export const wasmBoundary = {
+  /**
+   * count calls of an export without arguments or result
+   */
+  emptyCalls(count: number, path: BoundaryCallPath = 'direct'): number {
+    if (path === 'direct') {
+      const boundaryEmpty = bindExport<ExportNoArgs>('boundaryEmpty');
+      for (let i = 0; i < count; i++) {
+        boundaryEmpty();
+      }
+    } else {
+      const module = getWasmModule();
+      for (let i = 0; i < count; i++) {
+        module.ccall('boundaryEmpty', null, [], []);
+      }
+    }
+    return count;
+  },
+
+  /**
+   * count (ptr, length) calls returning a uint32; the sum of the results
+   */
+  pointerLengthCalls(buffer: WasmBuffer<Uint32Array>, count: number, path: BoundaryCallPath = 'direct'): number {
+    const ptr = buffer.ptr;
+    const length = buffer.length;
+    let sum = 0;
+    if (path === 'direct') {
+      const boundaryPointerLength = bindExport<ExportPtrLen>('boundaryPointerLength');
+      for (let i = 0; i < count; i++) {
+        sum += boundaryPointerLength(ptr, length) >>> 0;
+      }
+    } else {
+      const module = getWasmModule();
+      for (let i = 0; i < count; i++) {
+        sum += module.ccall('boundaryPointerLength', 'number', ['number', 'number'], [ptr, length]) >>> 0;
+      }
+    }
+    return sum;
+  },
+
+  /**
+   * count calls returning a uint64 (a BigInt per call); the XOR of the results
+   */
+  returnU64Calls(count: number, path: BoundaryCallPath = 'direct'): bigint {
+    let folded = 0n;
+    if (path === 'direct') {
+      const boundaryReturnU64 = bindExport<(value: number) => bigint>('boundaryReturnU64');
+      for (let i = 0; i < count; i++) {
+        folded ^= boundaryReturnU64(i);
+      }
+    } else {
+      const module = getWasmModule();
+      for (let i = 0; i < count; i++) {
+        folded ^= module.ccall('boundaryReturnU64', 'number', ['number'], [i]) as bigint;
+      }
+    }
+    return folded;
+  },
+};
+
+// ========== TREE LAYOUTS ==========
+// Relaid trees live in persistent buffers, so the layout benchmarks time
+// only the traversal. Layout codes match TreeLayout in array_processor.cpp.
+
+const TREE_LAYOUT_CODES: Record<TreeLayout, number> = { veb: 0, blocked: 1 };
+
+/**
+ * Binary tree relaid by relayoutBinaryTree; slots past the node count pad
+ * it to a perfect tree
+ */
+export interface WasmBinaryTreeLayout {
+  readonly values: WasmBuffer<Uint32Array>;
+  readonly nodeCount: number;
+  readonly layout: TreeLayout;
+  dispose: () => void;
+}
+
+/**
+ * N-ary tree in DFS preorder with subtree sizes
+ */
+export interface WasmPreorderTree {
+  readonly values: WasmBuffer<Uint32Array>;
+  readonly subtreeSizes: WasmBuffer<Uint32Array>;
+  readonly nodeCount: number;
+  dispose: () => void;
+}
+
+export const wasmTreeLayout = {
+  /**
+   * Relayout a heap-ordered binary tree in van Emde Boas or blocked order
+   */
+  relayoutBinary(values: WasmBuffer<Uint32Array>, layout: TreeLayout): WasmBinaryTreeLayout {
+    const module = getWasmModule();
+    const capacity = module.ccall('binaryTreeLayoutCapacity', 'number', ['number'], [values.length]) >>> 0;
+    const out = WasmBuffer.uint32(Math.max(capacity, 1));
+    module.ccall(
+      'relayoutBinaryTree',
+      'number',
+      ['number', 'number', 'number', 'number'],
+      [values.ptr, values.length, TREE_LAYOUT_CODES[layout], out.ptr]
+    );
+    return { values: out, nodeCount: values.length, layout, dispose: () => out.dispose() };
+  },
+
+  /**
+   * Preorder DFS sum (same visiting order as sumBinaryTreeDfs)
+   */
+  sumDfs(tree: WasmBinaryTreeLayout): number {
+    return toNumber(getWasmModule().ccall(
+      'sumBinaryTreeLayoutDfs',
+      'number',
+      ['number', 'number', 'number'],
+      [tree.values.ptr, tree.nodeCount, TREE_LAYOUT_CODES[tree.layout]]
+    ));
+  },
+
+  /**
+   * Sum of the root-to-node paths of targets (heap indices); pass the
+   * heap-ordered tree to measure the baseline
+   */
+  sumPaths(tree: WasmBinaryTreeLayout | PreparedWasmBinaryTree, targets: WasmBuffer<Uint32Array>): number {
+    const module = getWasmModule();
+    if ('layout' in tree) {
+      return toNumber(module.ccall(
+        'sumBinaryTreeLayoutPaths',
+        'number',
+        ['number', 'number', 'number', 'number', 'number'],
+        [tree.values.ptr, tree.nodeCount, TREE_LAYOUT_CODES[tree.layout], targets.ptr, targets.length]
+      ));
+    }
+    return toNumber(module.ccall(
+      'sumBinaryTreePaths',
+      'number',
+      ['number', 'number', 'number', 'number'],
+      [tree.valuesPtr, tree.nodeCount, targets.ptr, targets.length]
+    ));
+  },
+
+  /**
+   * Relayout a CSR tree rooted at node 0 in DFS preorder with subtree sizes
+   */
+  relayoutPreorder(tree: PreparedWasmNaryTree): WasmPreorderTree {
+    const values = WasmBuffer.uint32(Math.max(tree.nodeCount, 1));
+    const subtreeSizes = WasmBuffer.uint32(Math.max(tree.nodeCount, 1));
+    const nodeCount = getWasmModule().ccall(
+      'relayoutNaryTreePreorder',
+      'number',
+      ['number', 'number', 'number', 'number', 'number', 'number'],
+      [tree.valuesPtr, tree.childOffsetsPtr, tree.childrenPtr, tree.nodeCount, values.ptr, subtreeSizes.ptr]
+    ) >>> 0;
+    return {
+      values,
+      subtreeSizes,
+      nodeCount,
+      dispose: () => {
+        values.dispose();
+        subtreeSizes.dispose();
+      },
+    };
+  },
+
+  /**
+   * BFS sum over a preorder tree (same visiting order as sumNaryTreeBfs)
+   */
+  sumPreorderBfs(tree: WasmPreorderTree): number {
+    return toNumber(getWasmModule().ccall(
+      'sumNaryTreePreorderBfs',
+      'number',
+      ['number', 'number', 'number'],
+      [tree.values.ptr, tree.subtreeSizes.ptr, tree.nodeCount]
+    ));
+  },
+
+  /**
+   * Sum of every subtree into out: by node index for a CSR tree, by
+   * preorder position for a preorder tree. Returns the whole-tree sum.
+   */
+  subtreeSums(tree: PreparedWasmNaryTree | WasmPreorderTree, out: WasmBuffer<Float64Array>): number {
+    const module = getWasmModule();
+    if ('subtreeSizes' in tree) {
+      return module.ccall(
+        'subtreeSumsPreorder',
+        'number',
+        ['number', 'number', 'number', 'number'],
+        [tree.values.ptr, tree.subtreeSizes.ptr, tree.nodeCount, out.ptr]
+      );
+    }
+    return module.ccall(
+      'subtreeSumsNary',
+      'number',
+      ['number', 'number', 'number', 'number', 'number'],
+      [tree.valuesPtr, tree.childOffsetsPtr, tree.childrenPtr, tree.nodeCount, out.ptr]
+    );
+  },
+};
+
+export const wasmBufferAlgorithms = {
+  sumArray(buffer: WasmBuffer<Uint32Array>): bigint {
+    return BigInt(callBuffer('sumArray', buffer));
+  },
+
+  findMax(buffer: WasmBuffer<Uint32Array>): number {
+    return callBuffer('findMax', buffer) >>> 0;
+  },
+
+  findMin(buffer: WasmBuffer<Uint32Array>): number {
+    return callBuffer('findMin', buffer) >>> 0;
+  },
+
+  calculateAverage(buffer: WasmBuffer<Uint32Array>): number {
+    return callBuffer('calculateAverage', buffer);
+  },
+
+  multiplyArray(buffer: WasmBuffer<Uint32Array>, factor: number): Uint32Array {
+    return callBufferInPlace('multiplyArray', buffer, factor);
+  },
+
+  countGreaterThan(buffer: WasmBuffer<Uint32Array>, threshold: number): number {
+    return callBufferWith('countGreaterThan', buffer, threshold);
+  },
+
+  quickSort(buffer: WasmBuffer<Uint32Array>): Uint32Array {
+    return callBufferInPlace('quickSort', buffer);
+  },
+
+  radixSortU32(buffer: WasmBuffer<Uint32Array>): Uint32Array {
+    return callBufferInPlace('radixSortU32', buffer);
+  },
+
+  reverseArray(buffer: WasmBuffer<Uint32Array>): Uint32Array {
+    return callBufferInPlace('reverseArray', buffer);
+  },
+
+  calculateVariance(buffer: WasmBuffer<Uint32Array>): number {
+    return callBuffer('calculateVariance', buffer);
+  },
+
+  binarySearch(buffer: WasmBuffer<Uint32Array>, target: number): number {
+    return callBufferWith('binarySearch', buffer, target);
+  },
+
+  binarySearchBatch(
+    table: WasmBuffer<Uint32Array>,
+    targets: WasmBuffer<Uint32Array>,
+    out: WasmBuffer<Int32Array>
+  ): Int32Array {
+    return callBufferSearchBatch('binarySearchBatch', table, targets, out);
+  },
+
+  eytzingerSearchBatch(
+    layout: WasmBuffer<Uint32Array>,
+    targets: WasmBuffer<Uint32Array>,
+    out: WasmBuffer<Int32Array>
+  ): Int32Array {
+    return callBufferSearchBatch('eytzingerSearchBatch', layout, targets, out);
+  },
+
+  addToArray(buffer: WasmBuffer<Uint32Array>, value: number): Uint32Array {
+    return callBufferInPlace('addToArray', buffer, value);
+  },
+
+  countUnique(buffer: WasmBuffer<Uint32Array>): number {
+    return callBuffer('countUnique', buffer);
+  },
+
+  countUniqueExact(buffer: WasmBuffer<Uint32Array>): number {
+    return callBuffer('countUniqueExact', buffer) >>> 0;
+  },
+
+  countUniqueApprox(buffer: WasmBuffer<Uint32Array>, precision: number = HLL_DEFAULT_PRECISION): number {
+    return callCountUniqueApprox(buffer.ptr, buffer.length, precision);
+  },
+
+  sumArraySIMD(buffer: WasmBuffer<Uint32Array>): bigint {
+    return BigInt(callBuffer('sumArraySIMD', buffer));
+  },
+
+  findMaxSIMD(buffer: WasmBuffer<Uint32Array>): number {
+    return callBuffer('findMaxSIMD', buffer) >>> 0;
+  },
+
+  findMinSIMD(buffer: WasmBuffer<Uint32Array>): number {
+    return callBuffer('findMinSIMD', buffer) >>> 0;
+  },
+
+  calculateAverageSIMD(buffer: WasmBuffer<Uint32Array>): number {
+    return callBuffer('calculateAverageSIMD', buffer);
+  },
+
+  multiplyArraySIMD(buffer: WasmBuffer<Uint32Array>, factor: number): Uint32Array {
+    return callBufferInPlace('multiplyArraySIMD', buffer, factor);
+  },
+
+  addToArraySIMD(buffer: WasmBuffer<Uint32Array>, value: number): Uint32Array {
+    return callBufferInPlace('addToArraySIMD', buffer, value);
+  },
+
+  countGreaterThanSIMD(buffer: WasmBuffer<Uint32Array>, threshold: number): number {
+    return callBufferWith('countGreaterThanSIMD', buffer, threshold);
+  },
+
+  sumArray_MT(buffer: WasmBuffer<Uint32Array>, threads: number = 0): bigint {
+    return BigInt(callBufferWith('sumArray_MT', buffer, threads));
+  },
+
+  findMax_MT(buffer: WasmBuffer<Uint32Array>, threads: number = 0): number {
+    return callBufferWith('findMax_MT', buffer, threads) >>> 0;
+  },
+
+  findMin_MT(buffer: WasmBuffer<Uint32Array>, threads: number = 0): number {
+    return callBufferWith('findMin_MT', buffer, threads) >>> 0;
+  },
+
+  countGreaterThan_MT(buffer: WasmBuffer<Uint32Array>, threshold: number, threads: number = 0): number {
+    return bindExport<ExportPtrLenScalars>('countGreaterThan_MT')(buffer.ptr, buffer.length, threshold, threads);
+  },
+
+  computeStats(buffer: WasmBuffer<Uint32Array>, histogram?: HistogramOptions): ArrayStats {
+    return callComputeStats('computeStats', buffer.ptr, buffer.length, histogram);
+  },
+
+  computeStats_MT(buffer: WasmBuffer<Uint32Array>, histogram?: HistogramOptions, threads: number = 0): ArrayStats {
+    return callComputeStats('computeStats_MT', buffer.ptr, buffer.length, histogram, threads);
+  },
+
+  mergeSort_MT(buffer: WasmBuffer<Uint32Array>, threads: number = 0): Uint32Array {
+    return callBufferInPlace('mergeSort_MT', buffer, threads);
+  },
+
+  transformVectors(vectors: WasmBuffer<Float32Array>, matrix: WasmBuffer<Float32Array>): Float32Array {
+    return callTransformInPlace('transformVectors', vectors, matrix);
+  },
+
+  transformVectorsSIMD(vectors: WasmBuffer<Float32Array>, matrix: WasmBuffer<Float32Array>): Float32Array {
+    return callTransformInPlace('transformVectorsSIMD', vectors, matrix);
+  },
+
+  transformVectors_MT(
+    vectors: WasmBuffer<Float32Array>,
+    matrix: WasmBuffer<Float32Array>,
+    threads: number = 0
+  ): Float32Array {
+    return callTransformInPlace('transformVectors_MT', vectors, matrix, threads);
+  },
+
+  aosToSoa(vectors: WasmBuffer<Float32Array>, soa: WasmSoAVectors): WasmSoAVectors {
+    bindExport('aosToSoa')(vectors.ptr, soa.count, soa.x.ptr, soa.y.ptr, soa.z.ptr);
+    return soa;
+  },
+
+  soaToAos(soa: WasmSoAVectors, vectors: WasmBuffer<Float32Array>): Float32Array {
+    bindExport('soaToAos')(soa.x.ptr, soa.y.ptr, soa.z.ptr, soa.count, vectors.ptr);
+    return vectors.view;
+  },
+
+  transformVectorsSoA(soa: WasmSoAVectors, matrix: WasmBuffer<Float32Array>): WasmSoAVectors {
+    bindExport('transformVectorsSoA')(soa.x.ptr, soa.y.ptr, soa.z.ptr, matrix.ptr, soa.count);
+    return soa;
+  },
+
+  transformVectors4SoA(soa: WasmSoAVectors, matrix: WasmBuffer<Float32Array>): WasmSoAVectors {
+    if (!soa.w) {
+      throw new Error('transformVectors4SoA requires a w component');
+    }
+    bindExport('transformVectors4SoA')(soa.x.ptr, soa.y.ptr, soa.z.ptr, soa.w.ptr, matrix.ptr, soa.count);
+    return soa;
+  },
+
+  /**
+   * Points [offsets[k], offsets[k + 1]) get matrix k
+   */
+  transformVectorsSoABatch(
+    soa: WasmSoAVectors,
+    matrices: WasmBuffer<Float32Array>,
+    offsets: WasmBuffer<Uint32Array>
+  ): WasmSoAVectors {
+    bindExport('transformVectorsSoABatch')(
+      soa.x.ptr, soa.y.ptr, soa.z.ptr, matrices.ptr, offsets.ptr, Math.max(offsets.length - 1, 0)
+    );
+    return soa;
+  },
+  // Typed kernels: the buffer's element type picks the instantiation
+  // (WasmBuffer.uint64 columns run the U64 exports)
+
+  sumArrayTyped(buffer: WasmBuffer<TypedKernelArray>): number {
+    return callBuffer(typedKernelName('sumArray', buffer), buffer);
+  },
+
+  findMinTyped(buffer: WasmBuffer<TypedKernelArray>): number {
+    const result = callBuffer(typedKernelName('findMin', buffer), buffer);
+    return buffer.view instanceof Uint32Array ? result >>> 0 : result;
+  },
+
+  findMaxTyped(buffer: WasmBuffer<TypedKernelArray>): number {
+    const result = callBuffer(typedKernelName('findMax', buffer), buffer);
+    return buffer.view instanceof Uint32Array ? result >>> 0 : result;
+  },
+
+  addToArrayTyped<T extends TypedKernelArray>(buffer: WasmBuffer<T>, value: number): T {
+    return callTypedInPlace('addToArray', buffer, value);
+  },
+
+  multiplyArrayTyped<T extends TypedKernelArray>(buffer: WasmBuffer<T>, factor: number): T {
+    return callTypedInPlace('multiplyArray', buffer, factor);
+  },
 };
@@ -19,10 +19,19 @@ export interface WasmModule {
     returnType: string | null,
     argTypes: string[]
   ): (...args: any[]) => any;
+  HEAPU8: Uint8Array;
   HEAPF32: Float32Array;
   HEAP32: Int32Array;
   HEAPU32: Uint32Array;
 }
 
-declare function createWasmModule(): Promise<WasmModule>;
+// Module overrides; instantiateWasm replaces Emscripten's own fetch and compile
+export interface WasmModuleOptions {
+  instantiateWasm?(
+    imports: WebAssembly.Imports,
+    receiveInstance: (instance: WebAssembly.Instance, module: WebAssembly.Module) => void
+  ): WebAssembly.Exports | {};
+}
+
+declare function createWasmModule(options?: WasmModuleOptions): Promise<WasmModule>;
 export default createWasmModule;
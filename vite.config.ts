@@ -1,10 +1,20 @@
 import { defineConfig } from 'vite'
 
+// Cross-origin isolation enables SharedArrayBuffer for the pthreads build
+const crossOriginIsolationHeaders = {
+  'Cross-Origin-Opener-Policy': 'same-origin',
+  'Cross-Origin-Embedder-Policy': 'require-corp'
+}
+
 export default defineConfig({
   base: process.env.NODE_ENV === 'production' ? '/typescript-wasm-benchmark/' : '/',
   server: {
     port: 5173,
-    open: true
+    open: true,
+    headers: crossOriginIsolationHeaders
+  },
+  preview: {
+    headers: crossOriginIsolationHeaders
   },
   build: {
     target: 'esnext',